@@ -2,6 +2,7 @@
 # -*- coding: utf-8 -*-
 
 import os
+import sys
 import glob
 import platform
 import subprocess
@@ -27,6 +28,17 @@ LINUX_EXT = ".so"
 CPP_EXT = ".cpp"
 OBJ_EXT = ".o"
 
+CLI_NAME = "abcc-spi-decode"
+CLI_SOURCE_FOLDER = "source/cli"
+CLI_MAIN_FILE = "AbccSpiDecodeCli.cpp"
+
+BENCH_NAME = "abcc-spi-bench"
+BENCH_SOURCE_FOLDER = "source/bench"
+
+# In-repo replacement for the Analyzer SDK, see sdk/standin/README.md
+STANDIN_INCLUDE_PATH = "./sdk/standin/include"
+STANDIN_SOURCE_FOLDER = "sdk/standin/src"
+
 COMPILER = "g++ "
 CROSS_COMPILE_32BIT_FLAG = "-m32 "
 DYNAMIC_LIB_FLAG = "-dynamiclib "
@@ -317,6 +329,112 @@ def _gnu_build(release_path: str, release_path32: str = None, dylib_ext: str = L
     exit(build_error)
 
 
+def _build_cli(use_standin: bool = False) -> None:
+    '''
+    Builds the abcc-spi-decode command-line decoder for the current platform.
+    The decoder shares all sources in /source with the plugin and links
+    against the same Analyzer library.
+
+    Parameters
+    ----------
+    use_standin: bool
+        Compile against the in-repo stand-in SDK instead of the Saleae
+        Analyzer SDK. No Analyzer library is needed in this case.
+    '''
+
+    if platform.system().lower() == "windows":
+        print("ERROR: The command-line decoder is only built on GNU/Linux and macOS.")
+        exit(True)
+
+    is_mac = platform.system().lower() == "darwin"
+    is_64bit = platform.architecture()[0] == "64bit"
+
+    if is_mac:
+        output_path = "./cli/OSX/"
+        link_dependency = "-lAnalyzer"
+    elif is_64bit:
+        output_path = "./cli/Linux64/"
+        link_dependency = "-lAnalyzer64"
+    else:
+        output_path = "./cli/Linux32/"
+        link_dependency = "-lAnalyzer"
+
+    if not os.path.exists(output_path):
+        os.makedirs(output_path)
+
+    cpp_files = [f"source/{cpp_file}" for cpp_file in _get_cpp_file_list()]
+    cpp_files.extend(sorted(glob.glob(f"{CLI_SOURCE_FOLDER}/*{CPP_EXT}")))
+
+    command = COMPILER
+    command += f"-O3 -w -std={GNU_CPP_STD} -pthread "
+
+    if use_standin:
+        cpp_files.extend(sorted(glob.glob(f"{STANDIN_SOURCE_FOLDER}/*{CPP_EXT}")))
+        command += f"-I\"{STANDIN_INCLUDE_PATH}\" "
+        link_dependency = ""
+    else:
+        for path in INCLUDE_PATHS:
+            command += f"-I\"{path}\" "
+
+        for path in LINK_PATHS:
+            command += f"-L\"{path}\" -Wl,-rpath,\"{os.path.abspath(path)}\" "
+
+    command += f"-o \"{output_path}{CLI_NAME}\" "
+
+    for cpp_file in cpp_files:
+        command += f"\"{cpp_file}\" "
+
+    command += link_dependency
+
+    print(command)
+    retcode = os.system(command)
+
+    exit(_error_returned(retcode))
+
+
+def _build_bench() -> None:
+    '''
+    Builds the abcc-spi-bench decode throughput benchmark for the current
+    platform. The benchmark drives the analyzer the way Logic does and is
+    therefore always compiled against the in-repo stand-in SDK.
+    '''
+
+    if platform.system().lower() == "windows":
+        print("ERROR: The benchmark is only built on GNU/Linux and macOS.")
+        exit(True)
+
+    if platform.system().lower() == "darwin":
+        output_path = "./bench/OSX/"
+    elif platform.architecture()[0] == "64bit":
+        output_path = "./bench/Linux64/"
+    else:
+        output_path = "./bench/Linux32/"
+
+    if not os.path.exists(output_path):
+        os.makedirs(output_path)
+
+    cpp_files = [f"source/{cpp_file}" for cpp_file in _get_cpp_file_list()]
+    cpp_files.extend(sorted(glob.glob(f"{BENCH_SOURCE_FOLDER}/*{CPP_EXT}")))
+    cpp_files.extend(sorted(glob.glob(f"{STANDIN_SOURCE_FOLDER}/*{CPP_EXT}")))
+
+    # The range decode check runs the command-line decoder without its main()
+    cpp_files.extend(sorted(cpp_file for cpp_file in glob.glob(f"{CLI_SOURCE_FOLDER}/*{CPP_EXT}")
+                            if os.path.basename(cpp_file) != CLI_MAIN_FILE))
+
+    command = COMPILER
+    command += f"-O3 -w -std={GNU_CPP_STD} -pthread "
+    command += f"-I\"{STANDIN_INCLUDE_PATH}\" "
+    command += f"-o \"{output_path}{BENCH_NAME}\" "
+
+    for cpp_file in cpp_files:
+        command += f"\"{cpp_file}\" "
+
+    print(command)
+    retcode = os.system(command)
+
+    exit(_error_returned(retcode))
+
+
 def _error_returned(ret_code: int) -> bool:
     '''
     Determines if the return code from a system-call indicates an error.
@@ -453,4 +571,9 @@ def _clean_release_dir(release_path: str, dylib_ext: str) -> None:
 
 
 if __name__ == "__main__":
-    _build()
+    if len(sys.argv) > 1 and sys.argv[1] == "cli":
+        _build_cli("--standin" in sys.argv[2:])
+    elif len(sys.argv) > 1 and sys.argv[1] == "bench":
+        _build_bench()
+    else:
+        _build()
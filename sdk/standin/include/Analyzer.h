@@ -0,0 +1,74 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: Analyzer.h
+**    Summary: Stand-in SDK. Base classes of a protocol analyzer plugin.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ANALYZER
+#define ANALYZER
+
+#include <memory>
+
+#include "LogicPublicTypes.h"
+#include "SimulationChannelDescriptor.h"
+
+class AnalyzerChannelData;
+class AnalyzerSettings;
+class AnalyzerResults;
+class StandinHost;
+
+class LOGICAPI Analyzer
+{
+public:
+	Analyzer();
+	virtual ~Analyzer();
+
+	virtual void WorkerThread() = 0;
+
+	// Sample_rate: if there are multiple devices attached, and one is faster than the other,
+	// we can sample at the speed of the faster one; and pretend the slower one is the same speed.
+	virtual U32 GenerateSimulationData(U64 newest_sample_requested, U32 sample_rate, SimulationChannelDescriptor** simulation_channels) = 0;
+	virtual U32 GetMinimumSampleRateHz() = 0; // provide the sample rate required to generate good simulation data
+	virtual const char* GetAnalyzerName() const = 0;
+	virtual bool NeedsRerun() = 0;
+
+public: // Use these functions
+	void SetAnalyzerSettings(AnalyzerSettings* settings);
+	AnalyzerChannelData* GetAnalyzerChannelData(Channel& channel);
+	void ReportProgress(U64 sample_number);
+	void SetAnalyzerResults(AnalyzerResults* results);
+	U32 GetSimulationSampleRate();
+	U32 GetSampleRate();
+	U64 GetTriggerSample();
+
+	void CheckIfThreadShouldExit();
+
+public: // Don't use
+	virtual void SetupResults();
+
+	double GetAnalyzerProgress();
+	void StartProcessing();
+	void StopWorkerThread();
+	void KillThread();
+
+protected:
+	friend class StandinHost;
+
+	AnalyzerSettings* mAnalyzerSettings;
+	AnalyzerResults* mAnalyzerResults;
+	StandinHost* mHost;
+	U64 mProgressSample;
+};
+
+class LOGICAPI Analyzer2 : public Analyzer
+{
+public:
+	Analyzer2();
+	virtual void SetupResults();
+};
+
+#endif /* ANALYZER */
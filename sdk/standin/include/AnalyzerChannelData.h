@@ -0,0 +1,70 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AnalyzerChannelData.h
+**    Summary: Stand-in SDK. Sequential access to the transitions of one
+**             captured digital channel.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ANALYZER_CHANNEL_DATA
+#define ANALYZER_CHANNEL_DATA
+
+#include <vector>
+
+#include "LogicPublicTypes.h"
+
+/*
+** Thrown when the analyzer asks for data past the end of the capture.
+** Logic blocks the worker thread in this situation until it is killed,
+** the stand-in host unwinds the worker thread instead.
+*/
+class LOGICAPI AnalyzerEndOfData
+{
+};
+
+class LOGICAPI AnalyzerChannelData
+{
+public:
+	/*
+	** transitions holds the sample numbers at which the channel changes
+	** state (the first sample of the new state), in ascending order.
+	** end_sample is the first sample past the end of the capture.
+	*/
+	AnalyzerChannelData(BitState initial_state, const std::vector<U64>* transitions, U64 end_sample);
+	~AnalyzerChannelData();
+
+	// State
+	U64 GetSampleNumber();
+	BitState GetBitState();
+
+	// Basic: returns the number of transitions crossed
+	U32 Advance(U32 num_samples);
+	U32 AdvanceToAbsPosition(U64 sample_number);
+	void AdvanceToNextEdge();
+
+	// Fancier
+	U64 GetSampleOfNextEdge();
+	bool WouldAdvancingCauseTransition(U32 num_samples);
+	bool WouldAdvancingToAbsPositionCauseTransition(U64 sample_number);
+
+	// Minimum pulse tracking
+	void TrackMinimumPulseWidth();
+	U64 GetMinimumPulseWidthSoFar();
+
+	// Checks for more transitions without blocking
+	bool DoMoreTransitionsExistInCurrentData();
+
+protected:
+	const std::vector<U64>* mTransitions;
+	BitState mInitialState;
+	U64 mEndSample;
+	U64 mSampleNumber;
+	size_t mNextTransition;
+	bool mTrackMinimumPulseWidth;
+	U64 mMinimumPulseWidth;
+};
+
+#endif /* ANALYZER_CHANNEL_DATA */
@@ -0,0 +1,131 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AnalyzerResults.h
+**    Summary: Stand-in SDK. Storage for the frames, packets, and markers
+**             produced by an analyzer.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ANALYZER_RESULTS
+#define ANALYZER_RESULTS
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+
+#define DISPLAY_AS_ERROR_FLAG ( 1 << 7 )
+#define DISPLAY_AS_WARNING_FLAG ( 1 << 6 )
+
+#define INVALID_RESULT_INDEX 0xFFFFFFFFFFFFFFFFull
+
+class LOGICAPI Frame
+{
+public:
+	Frame();
+	Frame(const Frame& frame);
+	~Frame();
+
+	S64 mStartingSampleInclusive;
+	S64 mEndingSampleInclusive;
+	U64 mData1;
+	U64 mData2;
+	U8 mType;
+	U8 mFlags;
+
+	bool HasFlag(U8 flag);
+};
+
+class LOGICAPI AnalyzerResults
+{
+public:
+	enum MarkerType { Dot, ErrorDot, Square, ErrorSquare, UpArrow, DownArrow, X, ErrorX, Start, Stop, One, Zero };
+
+	AnalyzerResults();
+	virtual ~AnalyzerResults();
+
+	// Override
+	virtual void GenerateBubbleText(U64 frame_index, Channel& channel, DisplayBase display_base) = 0;
+	virtual void GenerateExportFile(const char* file, DisplayBase display_base, U32 export_type_user_id) = 0;
+	virtual void GenerateFrameTabularText(U64 frame_index, DisplayBase display_base) = 0;
+	virtual void GeneratePacketTabularText(U64 packet_id, DisplayBase display_base) = 0;
+	virtual void GenerateTransactionTabularText(U64 transaction_id, DisplayBase display_base) = 0;
+
+public: // Adding/setting data
+	void AddMarker(U64 sample_number, MarkerType marker_type, Channel& channel);
+
+	U64 AddFrame(const Frame& frame);
+	U64 CommitPacketAndStartNewPacket();
+	void CancelPacketAndStartNewPacket();
+	void AddPacketToTransaction(U64 transaction_id, U64 packet_id);
+	void AddChannelBubblesWillAppearOn(const Channel& channel);
+
+	void CommitResults();
+
+public: // Data access
+	U64 GetNumFrames();
+	U64 GetNumPackets();
+	Frame GetFrame(U64 frame_id);
+
+	U64 GetPacketContainingFrame(U64 frame_id);
+	U64 GetPacketContainingFrameSequential(U64 frame_id);
+	void GetFramesContainedInPacket(U64 packet_id, U64* first_frame_id, U64* last_frame_id);
+
+	U32 GetTransactionContainingPacket(U64 packet_id);
+	void GetPacketsContainedInTransaction(U64 transaction_id, U64** packet_id_array, U64* packet_id_count);
+
+	U64 GetNumMarkers(Channel& channel);
+	void GetMarker(Channel& channel, U64 marker_index, MarkerType* marker_type, U64* marker_sample);
+
+public: // Text results setting and access
+	void ClearResultStrings();
+	void AddResultString(const char* str1, const char* str2 = NULL, const char* str3 = NULL,
+		const char* str4 = NULL, const char* str5 = NULL, const char* str6 = NULL);
+
+	void ClearTabularText();
+	void AddTabularText(const char* str1, const char* str2 = NULL, const char* str3 = NULL,
+		const char* str4 = NULL, const char* str5 = NULL, const char* str6 = NULL);
+
+	// Stand-in only: read back the strings produced by the last Generate*Text() call
+	U32 GetNumResultStrings();
+	const char* GetResultString(U32 index);
+	const char* GetTabularText();
+
+	// Stand-in only: number of CommitResults() calls, and export cancellation
+	U64 GetNumCommits();
+	void CancelExport();
+
+protected: // Use these when exporting data
+	bool UpdateExportProgressAndCheckForCancel(U64 completed_frames, U64 total_frames);
+
+protected:
+	typedef struct Marker
+	{
+		U64 sample;
+		MarkerType type;
+	} Marker_t;
+
+	typedef struct Packet
+	{
+		U64 firstFrame;
+		U64 lastFrame;
+		U32 transactionId;
+	} Packet_t;
+
+	std::vector<Frame> mFrames;
+	std::vector<Packet_t> mPackets;
+	std::map<Channel, std::vector<Marker_t>> mMarkers;
+	std::vector<Channel> mBubbleChannels;
+	std::vector<U64> mTransactionPackets;
+	std::vector<std::string> mResultStrings;
+	std::string mTabularText;
+	U64 mPacketFirstFrame;
+	U64 mNumCommits;
+	bool mCancelExport;
+};
+
+#endif /* ANALYZER_RESULTS */
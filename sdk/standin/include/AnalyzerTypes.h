@@ -0,0 +1,26 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AnalyzerTypes.h
+**    Summary: Stand-in SDK. Enumerations shared by analyzers.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ANALYZER_TYPES
+#define ANALYZER_TYPES
+
+#include "LogicPublicTypes.h"
+
+namespace AnalyzerEnums
+{
+	enum ShiftOrder { MsbFirst, LsbFirst };
+	enum EdgeDirection { PosEdge, NegEdge };
+	enum Edge { LeadingEdge, TrailingEdge };
+	enum Parity { None, Even, Odd };
+	enum Acknowledge { Ack, Nak };
+	enum Sign { UnsignedInteger, SignedInteger };
+};
+
+#endif /* ANALYZER_TYPES */
@@ -0,0 +1,70 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: LogicPublicTypes.h
+**    Summary: Stand-in SDK. Basic types shared by all Analyzer SDK headers.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef LOGICPUBLICTYPES
+#define LOGICPUBLICTYPES
+
+#ifndef WIN32
+	#define __cdecl
+	#define __stdcall
+	#define __fastcall
+#endif
+
+#ifdef WIN32
+	#define LOGICAPI __declspec(dllexport)
+	#define ANALYZER_EXPORT __declspec(dllexport)
+#else
+	#define LOGICAPI
+	#define ANALYZER_EXPORT __attribute__ ((visibility("default")))
+#endif
+
+typedef signed char S8;
+typedef short S16;
+typedef int S32;
+typedef long long int S64;
+
+typedef unsigned char U8;
+typedef unsigned short U16;
+typedef unsigned int U32;
+typedef unsigned long long int U64;
+
+#ifndef NULL
+	#define NULL 0
+#endif
+
+enum DisplayBase { Binary, Decimal, Hexadecimal, ASCII, AsciiHex };
+
+enum BitState { BIT_LOW, BIT_HIGH };
+#define Toggle(x) ( x == BIT_LOW ? BIT_HIGH : BIT_LOW )
+#define Invert(x) ( x == BIT_LOW ? BIT_HIGH : BIT_LOW )
+
+enum ChannelDataType { ANALOG_CHANNEL, DIGITAL_CHANNEL };
+
+class LOGICAPI Channel
+{
+public:
+	Channel();
+	Channel(const Channel& channel);
+	Channel(U64 device_id, U32 channel_index);
+	~Channel();
+
+	Channel& operator=(const Channel& channel);
+	bool operator==(const Channel& channel) const;
+	bool operator!=(const Channel& channel) const;
+	bool operator>(const Channel& channel) const;
+	bool operator<(const Channel& channel) const;
+
+	U64 mDeviceId;
+	U32 mChannelIndex;
+};
+
+#define UNDEFINED_CHANNEL Channel(0xFFFFFFFFFFFFFFFFull, 0xFFFFFFFF)
+
+#endif /* LOGICPUBLICTYPES */
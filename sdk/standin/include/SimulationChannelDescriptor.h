@@ -0,0 +1,75 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: SimulationChannelDescriptor.h
+**    Summary: Stand-in SDK. Channel waveforms produced by an analyzer's
+**             simulation data generator.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef SIMULATION_CHANNEL_DESCRIPTOR
+#define SIMULATION_CHANNEL_DESCRIPTOR
+
+#include <vector>
+
+#include "LogicPublicTypes.h"
+
+class LOGICAPI SimulationChannelDescriptor
+{
+public:
+	SimulationChannelDescriptor();
+	SimulationChannelDescriptor(const SimulationChannelDescriptor& other);
+	~SimulationChannelDescriptor();
+	SimulationChannelDescriptor& operator=(const SimulationChannelDescriptor& other);
+
+	void Transition();
+	void TransitionIfNeeded(BitState bit_state);
+	void Advance(U32 num_samples_to_advance);
+
+	BitState GetCurrentBitState();
+	U64 GetCurrentSampleNumber();
+
+public: // Don't use
+	void SetChannel(Channel& channel);
+	void SetSampleRate(U32 sample_rate_hz);
+	void SetInitialBitState(BitState initial_bit_state);
+
+	Channel GetChannel();
+	U32 GetSampleRate();
+	BitState GetInitialBitState();
+
+	// Stand-in only: the sample numbers at which the channel toggled
+	const std::vector<U64>& GetTransitions() const;
+
+protected:
+	Channel mChannel;
+	U32 mSampleRate;
+	BitState mInitialBitState;
+	BitState mCurrentBitState;
+	U64 mCurrentSample;
+	std::vector<U64> mTransitions;
+};
+
+class LOGICAPI SimulationChannelDescriptorGroup
+{
+public:
+	SimulationChannelDescriptorGroup();
+	~SimulationChannelDescriptorGroup();
+
+	SimulationChannelDescriptor* Add(Channel& channel, U32 sample_rate, BitState intial_bit_state);
+
+	void AdvanceAll(U32 num_samples_to_advance);
+
+public: // Don't use
+	SimulationChannelDescriptor* GetArray();
+	U32 GetCount();
+
+protected:
+	// Descriptors are handed out by pointer, the storage must never reallocate
+	static const U32 MAX_CHANNELS = 16;
+	std::vector<SimulationChannelDescriptor> mChannels;
+};
+
+#endif /* SIMULATION_CHANNEL_DESCRIPTOR */
@@ -0,0 +1,83 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: StandinHost.h
+**    Summary: Stand-in SDK. Plays the role of the Logic application: holds
+**             a digital capture, generates simulation captures, and runs an
+**             analyzer's worker thread over them.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef STANDIN_HOST_H
+#define STANDIN_HOST_H
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "Analyzer.h"
+#include "AnalyzerChannelData.h"
+
+/*
+** A digital capture: per channel, the initial state and the samples at which
+** the channel toggles.
+*/
+class StandinCapture
+{
+public:
+	StandinCapture();
+
+	void AddChannel(const Channel& channel, BitState initial_state, const std::vector<U64>& transitions);
+	bool HasChannel(const Channel& channel) const;
+
+	BitState GetInitialBitState(const Channel& channel) const;
+	const std::vector<U64>& GetTransitions(const Channel& channel) const;
+
+	U32 mSampleRate;
+	U64 mTriggerSample;
+	U64 mNumSamples;
+
+protected:
+	typedef struct Trace
+	{
+		BitState initialState;
+		std::vector<U64> transitions;
+	} Trace_t;
+
+	std::map<Channel, Trace_t> mTraces;
+};
+
+class StandinHost
+{
+public:
+	StandinHost(Analyzer* analyzer, const StandinCapture* capture);
+	~StandinHost();
+
+	/*
+	** Runs SetupResults() and the analyzer's WorkerThread() until it asks
+	** for data past the end of the capture.
+	*/
+	void Run();
+
+	/*
+	** Generates num_samples of simulation data at the specified sample rate
+	** through the analyzer's GenerateSimulationData() and stores it in capture.
+	*/
+	static void Simulate(Analyzer* analyzer, U32 sample_rate, U64 num_samples, StandinCapture* capture);
+
+	AnalyzerChannelData* GetChannelData(const Channel& channel);
+	U32 GetSampleRate();
+	U64 GetTriggerSample();
+	U32 GetSimulationSampleRate();
+
+protected:
+	Analyzer* mAnalyzer;
+	const StandinCapture* mCapture;
+	U32 mSimulationSampleRate;
+	std::map<Channel, std::unique_ptr<AnalyzerChannelData>> mChannelData;
+};
+
+#endif /* STANDIN_HOST_H */
@@ -0,0 +1,101 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: Analyzer.cpp
+**    Summary: Stand-in SDK. Base classes of a protocol analyzer plugin; the
+**             host-facing calls are routed to the StandinHost running it.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "Analyzer.h"
+#include "AnalyzerHelpers.h"
+#include "StandinHost.h"
+
+Analyzer::Analyzer()
+	: mAnalyzerSettings(NULL),
+	mAnalyzerResults(NULL),
+	mHost(NULL),
+	mProgressSample(0)
+{
+}
+
+Analyzer::~Analyzer()
+{
+}
+
+void Analyzer::SetAnalyzerSettings(AnalyzerSettings* settings)
+{
+	mAnalyzerSettings = settings;
+}
+
+AnalyzerChannelData* Analyzer::GetAnalyzerChannelData(Channel& channel)
+{
+	if (mHost == NULL)
+	{
+		AnalyzerHelpers::Assert("No capture is attached to the analyzer.");
+	}
+
+	return mHost->GetChannelData(channel);
+}
+
+void Analyzer::ReportProgress(U64 sample_number)
+{
+	mProgressSample = sample_number;
+}
+
+void Analyzer::SetAnalyzerResults(AnalyzerResults* results)
+{
+	mAnalyzerResults = results;
+}
+
+U32 Analyzer::GetSimulationSampleRate()
+{
+	return (mHost != NULL) ? mHost->GetSimulationSampleRate() : 0;
+}
+
+U32 Analyzer::GetSampleRate()
+{
+	return (mHost != NULL) ? mHost->GetSampleRate() : 0;
+}
+
+U64 Analyzer::GetTriggerSample()
+{
+	return (mHost != NULL) ? mHost->GetTriggerSample() : 0;
+}
+
+void Analyzer::CheckIfThreadShouldExit()
+{
+	// The stand-in runs the worker thread synchronously, it is never asked to stop
+}
+
+void Analyzer::SetupResults()
+{
+}
+
+double Analyzer::GetAnalyzerProgress()
+{
+	return 0.0;
+}
+
+void Analyzer::StartProcessing()
+{
+	WorkerThread();
+}
+
+void Analyzer::StopWorkerThread()
+{
+}
+
+void Analyzer::KillThread()
+{
+}
+
+Analyzer2::Analyzer2()
+{
+}
+
+void Analyzer2::SetupResults()
+{
+}
@@ -0,0 +1,129 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AnalyzerChannelData.cpp
+**    Summary: Stand-in SDK. Sequential access to the transitions of one
+**             captured digital channel.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <algorithm>
+
+#include "AnalyzerChannelData.h"
+
+AnalyzerChannelData::AnalyzerChannelData(BitState initial_state, const std::vector<U64>* transitions, U64 end_sample)
+	: mTransitions(transitions),
+	mInitialState(initial_state),
+	mEndSample(end_sample),
+	mSampleNumber(0),
+	mNextTransition(0),
+	mTrackMinimumPulseWidth(false),
+	mMinimumPulseWidth(0xFFFFFFFFFFFFFFFFull)
+{
+	// A transition at sample 0 is folded into the initial state
+	while ((mNextTransition < mTransitions->size()) && ((*mTransitions)[mNextTransition] == 0))
+	{
+		mNextTransition++;
+	}
+}
+
+AnalyzerChannelData::~AnalyzerChannelData()
+{
+}
+
+U64 AnalyzerChannelData::GetSampleNumber()
+{
+	return mSampleNumber;
+}
+
+BitState AnalyzerChannelData::GetBitState()
+{
+	return ((mNextTransition & 1) == 0) ? mInitialState : Invert(mInitialState);
+}
+
+U32 AnalyzerChannelData::Advance(U32 num_samples)
+{
+	return AdvanceToAbsPosition(mSampleNumber + num_samples);
+}
+
+U32 AnalyzerChannelData::AdvanceToAbsPosition(U64 sample_number)
+{
+	U32 transitionCount = 0;
+
+	if (sample_number <= mSampleNumber)
+	{
+		return 0;
+	}
+
+	if (sample_number >= mEndSample)
+	{
+		throw AnalyzerEndOfData();
+	}
+
+	while ((mNextTransition < mTransitions->size()) && ((*mTransitions)[mNextTransition] <= sample_number))
+	{
+		if (mTrackMinimumPulseWidth && (mNextTransition > 0))
+		{
+			mMinimumPulseWidth = std::min(mMinimumPulseWidth,
+				(*mTransitions)[mNextTransition] - (*mTransitions)[mNextTransition - 1]);
+		}
+
+		mNextTransition++;
+		transitionCount++;
+	}
+
+	mSampleNumber = sample_number;
+	return transitionCount;
+}
+
+void AnalyzerChannelData::AdvanceToNextEdge()
+{
+	AdvanceToAbsPosition(GetSampleOfNextEdge());
+}
+
+U64 AnalyzerChannelData::GetSampleOfNextEdge()
+{
+	if (mNextTransition >= mTransitions->size())
+	{
+		throw AnalyzerEndOfData();
+	}
+
+	return (*mTransitions)[mNextTransition];
+}
+
+bool AnalyzerChannelData::WouldAdvancingCauseTransition(U32 num_samples)
+{
+	return WouldAdvancingToAbsPositionCauseTransition(mSampleNumber + num_samples);
+}
+
+bool AnalyzerChannelData::WouldAdvancingToAbsPositionCauseTransition(U64 sample_number)
+{
+	if ((mNextTransition < mTransitions->size()) && ((*mTransitions)[mNextTransition] <= sample_number))
+	{
+		return true;
+	}
+
+	if (sample_number >= mEndSample)
+	{
+		throw AnalyzerEndOfData();
+	}
+
+	return false;
+}
+
+void AnalyzerChannelData::TrackMinimumPulseWidth()
+{
+	mTrackMinimumPulseWidth = true;
+}
+
+U64 AnalyzerChannelData::GetMinimumPulseWidthSoFar()
+{
+	return mMinimumPulseWidth;
+}
+
+bool AnalyzerChannelData::DoMoreTransitionsExistInCurrentData()
+{
+	return (mNextTransition < mTransitions->size());
+}
@@ -0,0 +1,581 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AnalyzerHelpers.cpp
+**    Summary: Stand-in SDK. Helper routines and classes for analyzers.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+
+#include "AnalyzerHelpers.h"
+
+/*******************************************************************************
+**
+** AnalyzerHelpers
+**
+*******************************************************************************/
+
+bool AnalyzerHelpers::IsEven(U64 value)
+{
+	return ((value & 1) == 0);
+}
+
+bool AnalyzerHelpers::IsOdd(U64 value)
+{
+	return ((value & 1) != 0);
+}
+
+U32 AnalyzerHelpers::GetOnesCount(U64 value)
+{
+	U32 count = 0;
+
+	while (value != 0)
+	{
+		value &= (value - 1);
+		count++;
+	}
+
+	return count;
+}
+
+U32 AnalyzerHelpers::Diff32(U32 a, U32 b)
+{
+	return (a > b) ? (a - b) : (b - a);
+}
+
+void AnalyzerHelpers::GetNumberString(U64 number, DisplayBase display_base, U32 num_data_bits, char* result_string, U32 result_string_max_length)
+{
+	std::string str;
+
+	if (result_string_max_length == 0)
+	{
+		return;
+	}
+
+	if ((num_data_bits > 0) && (num_data_bits < 64))
+	{
+		number &= ((1ull << num_data_bits) - 1);
+	}
+
+	switch (display_base)
+	{
+	case Binary:
+		str = "0b";
+		for (S32 i = (S32)num_data_bits - 1; i >= 0; i--)
+		{
+			str.push_back(((number >> i) & 1) ? '1' : '0');
+		}
+		break;
+	case Decimal:
+		str = std::to_string(number);
+		break;
+	case ASCII:
+		if ((number >= 0x20) && (number < 0x7F))
+		{
+			str.push_back((char)number);
+		}
+		else
+		{
+			char hex[24];
+			snprintf(hex, sizeof(hex), "'%llu'", (unsigned long long)number);
+			str = hex;
+		}
+		break;
+	case AsciiHex:
+	case Hexadecimal:
+	default:
+	{
+		char hex[24];
+		U32 digits = (num_data_bits + 3) / 4;
+		snprintf(hex, sizeof(hex), "0x%0*llX", (int)((digits > 0) ? digits : 1), (unsigned long long)number);
+		str = hex;
+		break;
+	}
+	}
+
+	strncpy(result_string, str.c_str(), result_string_max_length - 1);
+	result_string[result_string_max_length - 1] = '\0';
+}
+
+void AnalyzerHelpers::GetTimeString(U64 sample, U64 trigger_sample, U32 sample_rate_hz, char* result_string, U32 result_string_max_length)
+{
+	double time_s = ((double)(S64)(sample - trigger_sample)) / (double)sample_rate_hz;
+
+	if (result_string_max_length == 0)
+	{
+		return;
+	}
+
+	snprintf(result_string, result_string_max_length, "%.9f", time_s);
+}
+
+void AnalyzerHelpers::Assert(const char* message)
+{
+	throw std::logic_error(message);
+}
+
+U64 AnalyzerHelpers::AdjustSimulationTargetSample(U64 target_sample, U32 sample_rate, U32 simulation_sample_rate)
+{
+	if (simulation_sample_rate == sample_rate)
+	{
+		return target_sample;
+	}
+
+	double ratio = (double)simulation_sample_rate / (double)sample_rate;
+	return (U64)std::ceil((double)target_sample * ratio);
+}
+
+bool AnalyzerHelpers::DoChannelsOverlap(const Channel* channel_array, U32 num_channels)
+{
+	for (U32 i = 0; i < num_channels; i++)
+	{
+		if (channel_array[i] == UNDEFINED_CHANNEL)
+		{
+			continue;
+		}
+
+		for (U32 j = i + 1; j < num_channels; j++)
+		{
+			if (channel_array[i] == channel_array[j])
+			{
+				return true;
+			}
+		}
+	}
+
+	return false;
+}
+
+void AnalyzerHelpers::SaveFile(const char* file_name, const U8* data, U32 data_length, bool is_binary)
+{
+	void* f = StartFile(file_name, is_binary);
+	AppendToFile(data, data_length, f);
+	EndFile(f);
+}
+
+S64 AnalyzerHelpers::ConvertToSignedNumber(U64 number, U32 num_bits)
+{
+	if ((num_bits == 0) || (num_bits >= 64))
+	{
+		return (S64)number;
+	}
+
+	U64 signBit = 1ull << (num_bits - 1);
+	U64 mask = (1ull << num_bits) - 1;
+
+	number &= mask;
+
+	if ((number & signBit) != 0)
+	{
+		return (S64)(number | ~mask);
+	}
+
+	return (S64)number;
+}
+
+void* AnalyzerHelpers::StartFile(const char* file_name, bool is_binary)
+{
+	FILE* f = fopen(file_name, is_binary ? "wb" : "w");
+
+	if (f == NULL)
+	{
+		Assert("Unable to open the export file.");
+	}
+
+	return f;
+}
+
+void AnalyzerHelpers::AppendToFile(const U8* data, U32 data_length, void* file)
+{
+	if ((file != NULL) && (data_length > 0))
+	{
+		fwrite(data, 1, data_length, (FILE*)file);
+	}
+}
+
+void AnalyzerHelpers::EndFile(void* file)
+{
+	if (file != NULL)
+	{
+		fclose((FILE*)file);
+	}
+}
+
+/*******************************************************************************
+**
+** ClockGenerator
+**
+*******************************************************************************/
+
+ClockGenerator::ClockGenerator()
+	: mSamplesPerHalfPeriod(0.0),
+	mSampleRate(0.0),
+	mCurrentTime(0.0),
+	mCurrentSample(0)
+{
+}
+
+ClockGenerator::~ClockGenerator()
+{
+}
+
+void ClockGenerator::Init(double target_frequency, U32 sample_rate_hz)
+{
+	mSampleRate = (double)sample_rate_hz;
+	mSamplesPerHalfPeriod = mSampleRate / (target_frequency * 2.0);
+	mCurrentTime = 0.0;
+	mCurrentSample = 0;
+}
+
+U32 ClockGenerator::AdvanceByHalfPeriod(double multiple)
+{
+	return AdvanceByTimeS((mSamplesPerHalfPeriod * multiple) / mSampleRate);
+}
+
+U32 ClockGenerator::AdvanceByTimeS(double time_s)
+{
+	// Accumulate in time so that rounding errors do not build up
+	mCurrentTime += time_s;
+
+	U64 targetSample = (U64)std::llround(mCurrentTime * mSampleRate);
+	U32 samples = (targetSample > mCurrentSample) ? (U32)(targetSample - mCurrentSample) : 0;
+
+	mCurrentSample += samples;
+	return samples;
+}
+
+/*******************************************************************************
+**
+** BitExtractor / DataBuilder
+**
+*******************************************************************************/
+
+BitExtractor::BitExtractor(U64 data, AnalyzerEnums::ShiftOrder shift_order, U32 num_bits)
+	: mData(data),
+	mShiftOrder(shift_order),
+	mNumBits(num_bits),
+	mIndex(0)
+{
+	if (shift_order == AnalyzerEnums::MsbFirst)
+	{
+		mMask = 1ull << (num_bits - 1);
+	}
+	else
+	{
+		mMask = 1;
+	}
+}
+
+BitExtractor::~BitExtractor()
+{
+}
+
+BitState BitExtractor::GetNextBit()
+{
+	BitState bit = ((mData & mMask) != 0) ? BIT_HIGH : BIT_LOW;
+
+	if (mShiftOrder == AnalyzerEnums::MsbFirst)
+	{
+		mMask >>= 1;
+	}
+	else
+	{
+		mMask <<= 1;
+	}
+
+	mIndex++;
+	return bit;
+}
+
+DataBuilder::DataBuilder()
+	: mData(NULL),
+	mMask(0),
+	mShiftOrder(AnalyzerEnums::MsbFirst),
+	mNumBits(0),
+	mIndex(0)
+{
+}
+
+DataBuilder::~DataBuilder()
+{
+}
+
+void DataBuilder::Reset(U64* data, AnalyzerEnums::ShiftOrder shift_order, U32 num_bits)
+{
+	mData = data;
+	mShiftOrder = shift_order;
+	mNumBits = num_bits;
+	mIndex = 0;
+	*mData = 0;
+
+	if (shift_order == AnalyzerEnums::MsbFirst)
+	{
+		mMask = 1ull << (num_bits - 1);
+	}
+	else
+	{
+		mMask = 1;
+	}
+}
+
+void DataBuilder::AddBit(BitState bit)
+{
+	if (bit == BIT_HIGH)
+	{
+		*mData |= mMask;
+	}
+
+	if (mShiftOrder == AnalyzerEnums::MsbFirst)
+	{
+		mMask >>= 1;
+	}
+	else
+	{
+		mMask <<= 1;
+	}
+
+	mIndex++;
+}
+
+/*******************************************************************************
+**
+** SimpleArchive
+**
+** Values are stored as newline-terminated tokens. Strings escape backslash
+** and newline so that any text survives a round trip.
+**
+*******************************************************************************/
+
+static const char* InternString(const std::string& str)
+{
+	// Strings handed out by operator>> must outlive the archive that read them
+	static std::mutex lock;
+	static std::set<std::string> pool;
+	std::lock_guard<std::mutex> guard(lock);
+	return pool.insert(str).first->c_str();
+}
+
+SimpleArchive::SimpleArchive()
+	: mReadPosition(0)
+{
+}
+
+SimpleArchive::~SimpleArchive()
+{
+}
+
+void SimpleArchive::SetString(const char* archive_string)
+{
+	mArchive.assign(archive_string);
+	mReadPosition = 0;
+}
+
+const char* SimpleArchive::GetString()
+{
+	mReturnString = mArchive;
+	return mReturnString.c_str();
+}
+
+bool SimpleArchive::NextToken(std::string& token)
+{
+	token.clear();
+
+	if (mReadPosition >= mArchive.size())
+	{
+		return false;
+	}
+
+	while (mReadPosition < mArchive.size())
+	{
+		char c = mArchive[mReadPosition++];
+
+		if (c == '\n')
+		{
+			return true;
+		}
+
+		if ((c == '\\') && (mReadPosition < mArchive.size()))
+		{
+			c = mArchive[mReadPosition++];
+			token.push_back((c == 'n') ? '\n' : c);
+		}
+		else
+		{
+			token.push_back(c);
+		}
+	}
+
+	return true;
+}
+
+bool SimpleArchive::operator<<(U64 data)
+{
+	mArchive.append(std::to_string(data)).push_back('\n');
+	return true;
+}
+
+bool SimpleArchive::operator<<(U32 data)
+{
+	mArchive.append(std::to_string(data)).push_back('\n');
+	return true;
+}
+
+bool SimpleArchive::operator<<(S64 data)
+{
+	mArchive.append(std::to_string(data)).push_back('\n');
+	return true;
+}
+
+bool SimpleArchive::operator<<(S32 data)
+{
+	mArchive.append(std::to_string(data)).push_back('\n');
+	return true;
+}
+
+bool SimpleArchive::operator<<(double data)
+{
+	char str[40];
+	snprintf(str, sizeof(str), "%.17g", data);
+	mArchive.append(str).push_back('\n');
+	return true;
+}
+
+bool SimpleArchive::operator<<(bool data)
+{
+	mArchive.append(data ? "1" : "0").push_back('\n');
+	return true;
+}
+
+bool SimpleArchive::operator<<(const char* data)
+{
+	for (const char* c = data; *c != '\0'; c++)
+	{
+		if (*c == '\\')
+		{
+			mArchive.append("\\\\");
+		}
+		else if (*c == '\n')
+		{
+			mArchive.append("\\n");
+		}
+		else
+		{
+			mArchive.push_back(*c);
+		}
+	}
+
+	mArchive.push_back('\n');
+	return true;
+}
+
+bool SimpleArchive::operator<<(Channel& data)
+{
+	*this << data.mDeviceId;
+	*this << data.mChannelIndex;
+	return true;
+}
+
+bool SimpleArchive::operator>>(U64& data)
+{
+	std::string token;
+
+	if (!NextToken(token) || token.empty())
+	{
+		return false;
+	}
+
+	data = strtoull(token.c_str(), NULL, 10);
+	return true;
+}
+
+bool SimpleArchive::operator>>(U32& data)
+{
+	U64 value;
+
+	if (!(*this >> value))
+	{
+		return false;
+	}
+
+	data = (U32)value;
+	return true;
+}
+
+bool SimpleArchive::operator>>(S64& data)
+{
+	std::string token;
+
+	if (!NextToken(token) || token.empty())
+	{
+		return false;
+	}
+
+	data = strtoll(token.c_str(), NULL, 10);
+	return true;
+}
+
+bool SimpleArchive::operator>>(S32& data)
+{
+	S64 value;
+
+	if (!(*this >> value))
+	{
+		return false;
+	}
+
+	data = (S32)value;
+	return true;
+}
+
+bool SimpleArchive::operator>>(double& data)
+{
+	std::string token;
+
+	if (!NextToken(token) || token.empty())
+	{
+		return false;
+	}
+
+	data = strtod(token.c_str(), NULL);
+	return true;
+}
+
+bool SimpleArchive::operator>>(bool& data)
+{
+	std::string token;
+
+	if (!NextToken(token) || token.empty())
+	{
+		return false;
+	}
+
+	data = (token != "0");
+	return true;
+}
+
+bool SimpleArchive::operator>>(char const** data)
+{
+	std::string token;
+
+	if (!NextToken(token))
+	{
+		return false;
+	}
+
+	*data = InternString(token);
+	return true;
+}
+
+bool SimpleArchive::operator>>(Channel& data)
+{
+	return (*this >> data.mDeviceId) && (*this >> data.mChannelIndex);
+}
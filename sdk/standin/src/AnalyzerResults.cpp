@@ -0,0 +1,276 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AnalyzerResults.cpp
+**    Summary: Stand-in SDK. Storage for the frames, packets, and markers
+**             produced by an analyzer.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <algorithm>
+
+#include "AnalyzerResults.h"
+
+Frame::Frame()
+	: mStartingSampleInclusive(0),
+	mEndingSampleInclusive(0),
+	mData1(0),
+	mData2(0),
+	mType(0),
+	mFlags(0)
+{
+}
+
+Frame::Frame(const Frame& frame)
+	: mStartingSampleInclusive(frame.mStartingSampleInclusive),
+	mEndingSampleInclusive(frame.mEndingSampleInclusive),
+	mData1(frame.mData1),
+	mData2(frame.mData2),
+	mType(frame.mType),
+	mFlags(frame.mFlags)
+{
+}
+
+Frame::~Frame()
+{
+}
+
+bool Frame::HasFlag(U8 flag)
+{
+	return ((mFlags & flag) != 0);
+}
+
+AnalyzerResults::AnalyzerResults()
+	: mPacketFirstFrame(0),
+	mNumCommits(0),
+	mCancelExport(false)
+{
+}
+
+AnalyzerResults::~AnalyzerResults()
+{
+}
+
+void AnalyzerResults::AddMarker(U64 sample_number, MarkerType marker_type, Channel& channel)
+{
+	mMarkers[channel].push_back({ sample_number, marker_type });
+}
+
+U64 AnalyzerResults::AddFrame(const Frame& frame)
+{
+	mFrames.push_back(frame);
+	return mFrames.size() - 1;
+}
+
+U64 AnalyzerResults::CommitPacketAndStartNewPacket()
+{
+	U64 numFrames = mFrames.size();
+
+	if (mPacketFirstFrame >= numFrames)
+	{
+		// A packet must contain at least one frame
+		return INVALID_RESULT_INDEX;
+	}
+
+	mPackets.push_back({ mPacketFirstFrame, numFrames - 1, 0xFFFFFFFF });
+	mPacketFirstFrame = numFrames;
+
+	return mPackets.size() - 1;
+}
+
+void AnalyzerResults::CancelPacketAndStartNewPacket()
+{
+	// The frames stay, they are just not part of any packet
+	mPacketFirstFrame = mFrames.size();
+}
+
+void AnalyzerResults::AddPacketToTransaction(U64 transaction_id, U64 packet_id)
+{
+	if (packet_id < mPackets.size())
+	{
+		mPackets[packet_id].transactionId = (U32)transaction_id;
+	}
+}
+
+void AnalyzerResults::AddChannelBubblesWillAppearOn(const Channel& channel)
+{
+	mBubbleChannels.push_back(channel);
+}
+
+void AnalyzerResults::CommitResults()
+{
+	mNumCommits++;
+}
+
+U64 AnalyzerResults::GetNumFrames()
+{
+	return mFrames.size();
+}
+
+U64 AnalyzerResults::GetNumPackets()
+{
+	return mPackets.size();
+}
+
+Frame AnalyzerResults::GetFrame(U64 frame_id)
+{
+	return mFrames.at(frame_id);
+}
+
+U64 AnalyzerResults::GetPacketContainingFrame(U64 frame_id)
+{
+	// Packets are stored in frame order, find the last packet starting at or before frame_id
+	auto it = std::upper_bound(mPackets.begin(), mPackets.end(), frame_id,
+		[](U64 id, const Packet_t& packet) { return id < packet.firstFrame; });
+
+	if (it == mPackets.begin())
+	{
+		return INVALID_RESULT_INDEX;
+	}
+
+	--it;
+
+	if (frame_id > it->lastFrame)
+	{
+		return INVALID_RESULT_INDEX;
+	}
+
+	return (U64)(it - mPackets.begin());
+}
+
+U64 AnalyzerResults::GetPacketContainingFrameSequential(U64 frame_id)
+{
+	return GetPacketContainingFrame(frame_id);
+}
+
+void AnalyzerResults::GetFramesContainedInPacket(U64 packet_id, U64* first_frame_id, U64* last_frame_id)
+{
+	if (packet_id < mPackets.size())
+	{
+		*first_frame_id = mPackets[packet_id].firstFrame;
+		*last_frame_id = mPackets[packet_id].lastFrame;
+	}
+	else
+	{
+		*first_frame_id = INVALID_RESULT_INDEX;
+		*last_frame_id = INVALID_RESULT_INDEX;
+	}
+}
+
+U32 AnalyzerResults::GetTransactionContainingPacket(U64 packet_id)
+{
+	if (packet_id < mPackets.size())
+	{
+		return mPackets[packet_id].transactionId;
+	}
+
+	return 0xFFFFFFFF;
+}
+
+void AnalyzerResults::GetPacketsContainedInTransaction(U64 transaction_id, U64** packet_id_array, U64* packet_id_count)
+{
+	mTransactionPackets.clear();
+
+	for (U64 i = 0; i < mPackets.size(); i++)
+	{
+		if (mPackets[i].transactionId == (U32)transaction_id)
+		{
+			mTransactionPackets.push_back(i);
+		}
+	}
+
+	*packet_id_array = mTransactionPackets.empty() ? nullptr : &mTransactionPackets[0];
+	*packet_id_count = mTransactionPackets.size();
+}
+
+U64 AnalyzerResults::GetNumMarkers(Channel& channel)
+{
+	auto it = mMarkers.find(channel);
+	return (it != mMarkers.end()) ? it->second.size() : 0;
+}
+
+void AnalyzerResults::GetMarker(Channel& channel, U64 marker_index, MarkerType* marker_type, U64* marker_sample)
+{
+	const Marker_t& marker = mMarkers.at(channel).at(marker_index);
+	*marker_type = marker.type;
+	*marker_sample = marker.sample;
+}
+
+void AnalyzerResults::ClearResultStrings()
+{
+	mResultStrings.clear();
+}
+
+void AnalyzerResults::AddResultString(const char* str1, const char* str2, const char* str3,
+	const char* str4, const char* str5, const char* str6)
+{
+	std::string result(str1);
+
+	for (const char* str : { str2, str3, str4, str5, str6 })
+	{
+		if (str != NULL)
+		{
+			result.append(str);
+		}
+	}
+
+	mResultStrings.push_back(result);
+}
+
+void AnalyzerResults::ClearTabularText()
+{
+	mTabularText.clear();
+}
+
+void AnalyzerResults::AddTabularText(const char* str1, const char* str2, const char* str3,
+	const char* str4, const char* str5, const char* str6)
+{
+	if (!mTabularText.empty())
+	{
+		mTabularText.push_back('\n');
+	}
+
+	mTabularText.append(str1);
+
+	for (const char* str : { str2, str3, str4, str5, str6 })
+	{
+		if (str != NULL)
+		{
+			mTabularText.append(str);
+		}
+	}
+}
+
+U32 AnalyzerResults::GetNumResultStrings()
+{
+	return (U32)mResultStrings.size();
+}
+
+const char* AnalyzerResults::GetResultString(U32 index)
+{
+	return mResultStrings.at(index).c_str();
+}
+
+const char* AnalyzerResults::GetTabularText()
+{
+	return mTabularText.c_str();
+}
+
+U64 AnalyzerResults::GetNumCommits()
+{
+	return mNumCommits;
+}
+
+void AnalyzerResults::CancelExport()
+{
+	mCancelExport = true;
+}
+
+bool AnalyzerResults::UpdateExportProgressAndCheckForCancel(U64 completed_frames, U64 total_frames)
+{
+	(void)completed_frames;
+	(void)total_frames;
+	return mCancelExport;
+}
@@ -0,0 +1,397 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AnalyzerSettings.cpp
+**    Summary: Stand-in SDK. Analyzer settings and their interfaces.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "AnalyzerSettings.h"
+
+/*******************************************************************************
+**
+** AnalyzerSettingInterface and derivatives
+**
+*******************************************************************************/
+
+AnalyzerSettingInterface::AnalyzerSettingInterface()
+	: mDisabled(false)
+{
+}
+
+AnalyzerSettingInterface::~AnalyzerSettingInterface()
+{
+}
+
+AnalyzerInterfaceTypeId AnalyzerSettingInterface::GetType()
+{
+	return INTERFACE_BASE;
+}
+
+const char* AnalyzerSettingInterface::GetToolTip()
+{
+	return mTooltip.c_str();
+}
+
+const char* AnalyzerSettingInterface::GetTitle()
+{
+	return mTitle.c_str();
+}
+
+bool AnalyzerSettingInterface::IsDisabled()
+{
+	return mDisabled;
+}
+
+void AnalyzerSettingInterface::SetTitleAndTooltip(const char* title, const char* tooltip)
+{
+	mTitle.assign(title);
+	mTooltip.assign(tooltip);
+}
+
+AnalyzerSettingInterfaceChannel::AnalyzerSettingInterfaceChannel()
+	: mChannel(UNDEFINED_CHANNEL),
+	mSelectionOfNoneIsAllowed(false)
+{
+}
+
+AnalyzerSettingInterfaceChannel::~AnalyzerSettingInterfaceChannel()
+{
+}
+
+AnalyzerInterfaceTypeId AnalyzerSettingInterfaceChannel::GetType()
+{
+	return INTERFACE_CHANNEL;
+}
+
+Channel AnalyzerSettingInterfaceChannel::GetChannel()
+{
+	return mChannel;
+}
+
+void AnalyzerSettingInterfaceChannel::SetChannel(const Channel& channel)
+{
+	mChannel = channel;
+}
+
+bool AnalyzerSettingInterfaceChannel::GetSelectionOfNoneIsAllowed()
+{
+	return mSelectionOfNoneIsAllowed;
+}
+
+void AnalyzerSettingInterfaceChannel::SetSelectionOfNoneIsAllowed(bool is_allowed)
+{
+	mSelectionOfNoneIsAllowed = is_allowed;
+}
+
+AnalyzerSettingInterfaceNumberList::AnalyzerSettingInterfaceNumberList()
+	: mNumber(0.0)
+{
+}
+
+AnalyzerSettingInterfaceNumberList::~AnalyzerSettingInterfaceNumberList()
+{
+}
+
+AnalyzerInterfaceTypeId AnalyzerSettingInterfaceNumberList::GetType()
+{
+	return INTERFACE_NUMBER_LIST;
+}
+
+double AnalyzerSettingInterfaceNumberList::GetNumber()
+{
+	return mNumber;
+}
+
+void AnalyzerSettingInterfaceNumberList::SetNumber(double number)
+{
+	mNumber = number;
+}
+
+U32 AnalyzerSettingInterfaceNumberList::GetListboxNumbersCount()
+{
+	return (U32)mNumbers.size();
+}
+
+double AnalyzerSettingInterfaceNumberList::GetListboxNumber(U32 index)
+{
+	return mNumbers.at(index);
+}
+
+U32 AnalyzerSettingInterfaceNumberList::GetListboxStringsCount()
+{
+	return (U32)mStrings.size();
+}
+
+const char* AnalyzerSettingInterfaceNumberList::GetListboxString(U32 index)
+{
+	return mStrings.at(index).c_str();
+}
+
+U32 AnalyzerSettingInterfaceNumberList::GetListboxTooltipsCount()
+{
+	return (U32)mTooltips.size();
+}
+
+const char* AnalyzerSettingInterfaceNumberList::GetListboxTooltip(U32 index)
+{
+	return mTooltips.at(index).c_str();
+}
+
+void AnalyzerSettingInterfaceNumberList::AddNumber(double number, const char* str, const char* tooltip)
+{
+	mNumbers.push_back(number);
+	mStrings.push_back(str);
+	mTooltips.push_back(tooltip);
+}
+
+void AnalyzerSettingInterfaceNumberList::ClearNumbers()
+{
+	mNumbers.clear();
+	mStrings.clear();
+	mTooltips.clear();
+}
+
+AnalyzerSettingInterfaceInteger::AnalyzerSettingInterfaceInteger()
+	: mInteger(0),
+	mMax(0x7FFFFFFF),
+	mMin(-0x7FFFFFFF)
+{
+}
+
+AnalyzerSettingInterfaceInteger::~AnalyzerSettingInterfaceInteger()
+{
+}
+
+AnalyzerInterfaceTypeId AnalyzerSettingInterfaceInteger::GetType()
+{
+	return INTERFACE_INTEGER;
+}
+
+int AnalyzerSettingInterfaceInteger::GetInteger()
+{
+	return mInteger;
+}
+
+void AnalyzerSettingInterfaceInteger::SetInteger(int integer)
+{
+	mInteger = integer;
+}
+
+int AnalyzerSettingInterfaceInteger::GetMax()
+{
+	return mMax;
+}
+
+int AnalyzerSettingInterfaceInteger::GetMin()
+{
+	return mMin;
+}
+
+void AnalyzerSettingInterfaceInteger::SetMax(int max)
+{
+	mMax = max;
+}
+
+void AnalyzerSettingInterfaceInteger::SetMin(int min)
+{
+	mMin = min;
+}
+
+AnalyzerSettingInterfaceText::AnalyzerSettingInterfaceText()
+	: mTextType(NormalText)
+{
+}
+
+AnalyzerSettingInterfaceText::~AnalyzerSettingInterfaceText()
+{
+}
+
+AnalyzerInterfaceTypeId AnalyzerSettingInterfaceText::GetType()
+{
+	return INTERFACE_TEXT;
+}
+
+const char* AnalyzerSettingInterfaceText::GetText()
+{
+	return mText.c_str();
+}
+
+void AnalyzerSettingInterfaceText::SetText(const char* text)
+{
+	mText.assign((text != NULL) ? text : "");
+}
+
+AnalyzerSettingInterfaceText::TextType AnalyzerSettingInterfaceText::GetTextType()
+{
+	return mTextType;
+}
+
+void AnalyzerSettingInterfaceText::SetTextType(TextType text_type)
+{
+	mTextType = text_type;
+}
+
+AnalyzerSettingInterfaceBool::AnalyzerSettingInterfaceBool()
+	: mValue(false)
+{
+}
+
+AnalyzerSettingInterfaceBool::~AnalyzerSettingInterfaceBool()
+{
+}
+
+AnalyzerInterfaceTypeId AnalyzerSettingInterfaceBool::GetType()
+{
+	return INTERFACE_BOOL;
+}
+
+bool AnalyzerSettingInterfaceBool::GetValue()
+{
+	return mValue;
+}
+
+void AnalyzerSettingInterfaceBool::SetValue(bool value)
+{
+	mValue = value;
+}
+
+const char* AnalyzerSettingInterfaceBool::GetCheckBoxText()
+{
+	return mCheckBoxText.c_str();
+}
+
+void AnalyzerSettingInterfaceBool::SetCheckBoxText(const char* text)
+{
+	mCheckBoxText.assign(text);
+}
+
+/*******************************************************************************
+**
+** AnalyzerSettings
+**
+*******************************************************************************/
+
+AnalyzerSettings::AnalyzerSettings()
+	: mUseSystemDisplayBase(true),
+	mAnalyzerDisplayBase(Hexadecimal)
+{
+}
+
+AnalyzerSettings::~AnalyzerSettings()
+{
+}
+
+U32 AnalyzerSettings::GetSettingsInterfacesCount()
+{
+	return (U32)mInterfaces.size();
+}
+
+AnalyzerSettingInterface* AnalyzerSettings::GetSettingsInterface(U32 index)
+{
+	return mInterfaces.at(index);
+}
+
+U32 AnalyzerSettings::GetFileExtensionCount()
+{
+	return (U32)mExportOptions.size();
+}
+
+void AnalyzerSettings::GetFileExtension(U32 index, char const** extension_type, char const** extension)
+{
+	*extension_type = mExportOptions.at(index).description.c_str();
+	*extension = mExportOptions.at(index).extension.c_str();
+}
+
+U32 AnalyzerSettings::GetChannelsCount()
+{
+	return (U32)mChannels.size();
+}
+
+Channel AnalyzerSettings::GetChannel(U32 index, char const** channel_label, bool* channel_is_used)
+{
+	*channel_label = mChannels.at(index).label.c_str();
+	*channel_is_used = mChannels.at(index).isUsed;
+	return mChannels.at(index).channel;
+}
+
+U32 AnalyzerSettings::GetExportOptionsCount()
+{
+	return (U32)mExportOptions.size();
+}
+
+void AnalyzerSettings::GetExportOption(U32 index, U32* user_id, char const** menu_text)
+{
+	*user_id = mExportOptions.at(index).userId;
+	*menu_text = mExportOptions.at(index).menuText.c_str();
+}
+
+const char* AnalyzerSettings::GetSaveErrorMessage()
+{
+	return mErrorText.c_str();
+}
+
+bool AnalyzerSettings::GetUseSystemDisplayBase()
+{
+	return mUseSystemDisplayBase;
+}
+
+void AnalyzerSettings::SetUseSystemDisplayBase(bool use_system_display_base)
+{
+	mUseSystemDisplayBase = use_system_display_base;
+}
+
+DisplayBase AnalyzerSettings::GetAnalyzerDisplayBase()
+{
+	return mAnalyzerDisplayBase;
+}
+
+void AnalyzerSettings::SetAnalyzerDisplayBase(DisplayBase analyzer_display_base)
+{
+	mAnalyzerDisplayBase = analyzer_display_base;
+}
+
+void AnalyzerSettings::ClearChannels()
+{
+	mChannels.clear();
+}
+
+void AnalyzerSettings::AddChannel(Channel& channel, const char* channel_label, bool is_used)
+{
+	mChannels.push_back({ channel, channel_label, is_used });
+}
+
+void AnalyzerSettings::SetErrorText(const char* error_text)
+{
+	mErrorText.assign(error_text);
+}
+
+void AnalyzerSettings::AddInterface(AnalyzerSettingInterface* analyzer_setting_interface)
+{
+	mInterfaces.push_back(analyzer_setting_interface);
+}
+
+void AnalyzerSettings::AddExportOption(U32 user_id, const char* menu_text)
+{
+	mExportOptions.push_back({ user_id, menu_text, "", "" });
+}
+
+void AnalyzerSettings::AddExportExtension(U32 user_id, const char* extension_description, const char* extension)
+{
+	for (ExportOption_t& option : mExportOptions)
+	{
+		if (option.userId == user_id)
+		{
+			option.description.assign(extension_description);
+			option.extension.assign(extension);
+		}
+	}
+}
+
+const char* AnalyzerSettings::SetReturnString(const char* str)
+{
+	mReturnString.assign(str);
+	return mReturnString.c_str();
+}
@@ -0,0 +1,162 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: SimulationChannelDescriptor.cpp
+**    Summary: Stand-in SDK. Channel waveforms produced by an analyzer's
+**             simulation data generator.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "SimulationChannelDescriptor.h"
+
+SimulationChannelDescriptor::SimulationChannelDescriptor()
+	: mChannel(UNDEFINED_CHANNEL),
+	mSampleRate(0),
+	mInitialBitState(BIT_LOW),
+	mCurrentBitState(BIT_LOW),
+	mCurrentSample(0)
+{
+}
+
+SimulationChannelDescriptor::SimulationChannelDescriptor(const SimulationChannelDescriptor& other)
+	: mChannel(other.mChannel),
+	mSampleRate(other.mSampleRate),
+	mInitialBitState(other.mInitialBitState),
+	mCurrentBitState(other.mCurrentBitState),
+	mCurrentSample(other.mCurrentSample),
+	mTransitions(other.mTransitions)
+{
+}
+
+SimulationChannelDescriptor::~SimulationChannelDescriptor()
+{
+}
+
+SimulationChannelDescriptor& SimulationChannelDescriptor::operator=(const SimulationChannelDescriptor& other)
+{
+	mChannel = other.mChannel;
+	mSampleRate = other.mSampleRate;
+	mInitialBitState = other.mInitialBitState;
+	mCurrentBitState = other.mCurrentBitState;
+	mCurrentSample = other.mCurrentSample;
+	mTransitions = other.mTransitions;
+	return *this;
+}
+
+void SimulationChannelDescriptor::Transition()
+{
+	mCurrentBitState = Invert(mCurrentBitState);
+
+	// Two toggles on the same sample cancel out
+	if (!mTransitions.empty() && (mTransitions.back() == mCurrentSample))
+	{
+		mTransitions.pop_back();
+	}
+	else
+	{
+		mTransitions.push_back(mCurrentSample);
+	}
+}
+
+void SimulationChannelDescriptor::TransitionIfNeeded(BitState bit_state)
+{
+	if (bit_state != mCurrentBitState)
+	{
+		Transition();
+	}
+}
+
+void SimulationChannelDescriptor::Advance(U32 num_samples_to_advance)
+{
+	mCurrentSample += num_samples_to_advance;
+}
+
+BitState SimulationChannelDescriptor::GetCurrentBitState()
+{
+	return mCurrentBitState;
+}
+
+U64 SimulationChannelDescriptor::GetCurrentSampleNumber()
+{
+	return mCurrentSample;
+}
+
+void SimulationChannelDescriptor::SetChannel(Channel& channel)
+{
+	mChannel = channel;
+}
+
+void SimulationChannelDescriptor::SetSampleRate(U32 sample_rate_hz)
+{
+	mSampleRate = sample_rate_hz;
+}
+
+void SimulationChannelDescriptor::SetInitialBitState(BitState initial_bit_state)
+{
+	mInitialBitState = initial_bit_state;
+	mCurrentBitState = initial_bit_state;
+}
+
+Channel SimulationChannelDescriptor::GetChannel()
+{
+	return mChannel;
+}
+
+U32 SimulationChannelDescriptor::GetSampleRate()
+{
+	return mSampleRate;
+}
+
+BitState SimulationChannelDescriptor::GetInitialBitState()
+{
+	return mInitialBitState;
+}
+
+const std::vector<U64>& SimulationChannelDescriptor::GetTransitions() const
+{
+	return mTransitions;
+}
+
+SimulationChannelDescriptorGroup::SimulationChannelDescriptorGroup()
+{
+	mChannels.reserve(MAX_CHANNELS);
+}
+
+SimulationChannelDescriptorGroup::~SimulationChannelDescriptorGroup()
+{
+}
+
+SimulationChannelDescriptor* SimulationChannelDescriptorGroup::Add(Channel& channel, U32 sample_rate, BitState intial_bit_state)
+{
+	if (mChannels.size() >= MAX_CHANNELS)
+	{
+		return nullptr;
+	}
+
+	mChannels.emplace_back();
+	mChannels.back().SetChannel(channel);
+	mChannels.back().SetSampleRate(sample_rate);
+	mChannels.back().SetInitialBitState(intial_bit_state);
+
+	return &mChannels.back();
+}
+
+void SimulationChannelDescriptorGroup::AdvanceAll(U32 num_samples_to_advance)
+{
+	for (SimulationChannelDescriptor& channel : mChannels)
+	{
+		channel.Advance(num_samples_to_advance);
+	}
+}
+
+SimulationChannelDescriptor* SimulationChannelDescriptorGroup::GetArray()
+{
+	return mChannels.empty() ? nullptr : &mChannels[0];
+}
+
+U32 SimulationChannelDescriptorGroup::GetCount()
+{
+	return (U32)mChannels.size();
+}
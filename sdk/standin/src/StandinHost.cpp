@@ -0,0 +1,154 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: StandinHost.cpp
+**    Summary: Stand-in SDK. Plays the role of the Logic application: holds
+**             a digital capture, generates simulation captures, and runs an
+**             analyzer's worker thread over them.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "StandinHost.h"
+#include "AnalyzerHelpers.h"
+
+/*******************************************************************************
+**
+** StandinCapture
+**
+*******************************************************************************/
+
+StandinCapture::StandinCapture()
+	: mSampleRate(0),
+	mTriggerSample(0),
+	mNumSamples(0)
+{
+}
+
+void StandinCapture::AddChannel(const Channel& channel, BitState initial_state, const std::vector<U64>& transitions)
+{
+	mTraces[channel] = { initial_state, transitions };
+}
+
+bool StandinCapture::HasChannel(const Channel& channel) const
+{
+	return (mTraces.find(channel) != mTraces.end());
+}
+
+BitState StandinCapture::GetInitialBitState(const Channel& channel) const
+{
+	return mTraces.at(channel).initialState;
+}
+
+const std::vector<U64>& StandinCapture::GetTransitions(const Channel& channel) const
+{
+	return mTraces.at(channel).transitions;
+}
+
+/*******************************************************************************
+**
+** StandinHost
+**
+*******************************************************************************/
+
+StandinHost::StandinHost(Analyzer* analyzer, const StandinCapture* capture)
+	: mAnalyzer(analyzer),
+	mCapture(capture),
+	mSimulationSampleRate(0)
+{
+	mAnalyzer->mHost = this;
+}
+
+StandinHost::~StandinHost()
+{
+	if (mAnalyzer->mHost == this)
+	{
+		mAnalyzer->mHost = NULL;
+	}
+}
+
+void StandinHost::Run()
+{
+	mAnalyzer->SetupResults();
+
+	try
+	{
+		mAnalyzer->WorkerThread();
+	}
+	catch (AnalyzerEndOfData&)
+	{
+		// Same as Logic: the worker thread is stopped once it runs out of data
+	}
+}
+
+void StandinHost::Simulate(Analyzer* analyzer, U32 sample_rate, U64 num_samples, StandinCapture* capture)
+{
+	StandinCapture emptyCapture;
+	StandinHost host(analyzer, &emptyCapture);
+	SimulationChannelDescriptor* simulationChannels = NULL;
+	U32 numChannels;
+
+	emptyCapture.mSampleRate = sample_rate;
+	host.mSimulationSampleRate = sample_rate;
+
+	numChannels = analyzer->GenerateSimulationData(num_samples, sample_rate, &simulationChannels);
+
+	capture->mSampleRate = sample_rate;
+	capture->mTriggerSample = 0;
+	capture->mNumSamples = num_samples;
+
+	for (U32 i = 0; i < numChannels; i++)
+	{
+		SimulationChannelDescriptor& descriptor = simulationChannels[i];
+		std::vector<U64> transitions;
+
+		// Only the requested range is kept; the generator may overshoot
+		for (U64 transition : descriptor.GetTransitions())
+		{
+			if (transition < num_samples)
+			{
+				transitions.push_back(transition);
+			}
+		}
+
+		capture->AddChannel(descriptor.GetChannel(), descriptor.GetInitialBitState(), transitions);
+	}
+}
+
+AnalyzerChannelData* StandinHost::GetChannelData(const Channel& channel)
+{
+	auto it = mChannelData.find(channel);
+
+	if (it != mChannelData.end())
+	{
+		return it->second.get();
+	}
+
+	if (!mCapture->HasChannel(channel))
+	{
+		AnalyzerHelpers::Assert("The capture does not contain the requested channel.");
+	}
+
+	std::unique_ptr<AnalyzerChannelData> data(new AnalyzerChannelData(
+		mCapture->GetInitialBitState(channel), &mCapture->GetTransitions(channel), mCapture->mNumSamples));
+	AnalyzerChannelData* rawData = data.get();
+
+	mChannelData[channel] = std::move(data);
+	return rawData;
+}
+
+U32 StandinHost::GetSampleRate()
+{
+	return mCapture->mSampleRate;
+}
+
+U64 StandinHost::GetTriggerSample()
+{
+	return mCapture->mTriggerSample;
+}
+
+U32 StandinHost::GetSimulationSampleRate()
+{
+	return mSimulationSampleRate;
+}
@@ -8,10 +8,9 @@
 *******************************************************************************
 ******************************************************************************/
 
-#include "Analyzer.h"
 #include "AbccCrc.h"
 
-static const U8 abBitReverseTable16[] =
+static constexpr U8 abBitReverseTable16[] =
 {
 	0x00, 0x08, 0x04, 0x0C,
 	0x02, 0x0A, 0x06, 0x0E,
@@ -19,7 +18,7 @@ static const U8 abBitReverseTable16[] =
 	0x03, 0x0B, 0x07, 0x0F
 };
 
-static const U32 adwCrcTable32[] =
+static constexpr U32 adwCrcTable32[] =
 {
 	0x4DBDF21CUL, 0x500AE278UL, 0x76D3D2D4UL, 0x6B64C2B0UL,
 	0x3B61B38CUL, 0x26D6A3E8UL, 0x000F9344UL, 0x1DB88320UL,
@@ -77,6 +76,393 @@ static const U8 abCrc16Lo[] =
 };
 #endif
 
+/*
+** The ABCC40 CRC32 is defined above as two 4-bit steps per byte, operating on
+** bit-reversed nibbles, with the bits of every byte reversed in the final
+** result. In that final (formatted) bit order the algorithm is CRC-32/BZIP2
+** (polynomial 0x04C11DB7, initial value and final XOR 0xFFFFFFFF, not
+** reflected) with the result stored little-endian; the nibble tables apply
+** the initial value and final XOR in every step. Keeping the state formatted
+** and XORed with 0xFFFFFFFF leaves a linear CRC on the raw data bytes which
+** can be processed a byte, eight bytes, or with carry-less multiplication,
+** sixteen bytes at a time. The tables below are derived from the nibble
+** tables at compile time.
+*/
+
+#define CRC32_POLYNOMIAL		0x104C11DB7ULL
+#define CRC32_XOR_MASK			0xFFFFFFFFUL
+
+/* Buffers shorter than this are not worth setting up the SIMD kernel for */
+#define CRC32_KERNEL_MIN_LENGTH	64
+
+#if (defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86))
+	#define ABCC_CRC_X86_CLMUL
+	#include <immintrin.h>
+	#ifdef _MSC_VER
+		#include <intrin.h>
+		#define CRC_TARGET_CLMUL
+	#else
+		#include <cpuid.h>
+		#define CRC_TARGET_CLMUL	__attribute__((target("pclmul,ssse3")))
+	#endif
+#elif (defined(__aarch64__) || defined(_M_ARM64)) && (defined(__ARM_FEATURE_CRYPTO) || defined(__ARM_FEATURE_AES))
+	/* Only when the compiler targets the crypto extension, e.g. Apple silicon */
+	#define ABCC_CRC_ARM_PMULL
+	#include <arm_neon.h>
+	#if defined(__linux__)
+		#include <sys/auxv.h>
+		#include <asm/hwcap.h>
+	#elif defined(__APPLE__)
+		#include <sys/sysctl.h>
+	#elif defined(_WIN32)
+		#include <windows.h>
+	#endif
+#endif
+
+static constexpr U8 ReverseBits8(U8 bData)
+{
+	return (U8)((abBitReverseTable16[bData & 0x0F] << 4) | abBitReverseTable16[bData >> 4]);
+}
+
+static constexpr U32 FormatCrc32(U32 lCrc)
+{
+	return	((U32)ReverseBits8((U8)(lCrc >> 0)) << 0) |
+			((U32)ReverseBits8((U8)(lCrc >> 8)) << 8) |
+			((U32)ReverseBits8((U8)(lCrc >> 16)) << 16) |
+			((U32)ReverseBits8((U8)(lCrc >> 24)) << 24);
+}
+
+static constexpr U32 SwapBytes32(U32 lValue)
+{
+	return	((lValue & 0x000000FFUL) << 24) | ((lValue & 0x0000FF00UL) << 8) |
+			((lValue & 0x00FF0000UL) >> 8) | ((lValue & 0xFF000000UL) >> 24);
+}
+
+static constexpr U32 NibbleCrc32(U32 lCrc, U8 bData)
+{
+	U8 bCrcReverseByte = 0;
+
+	// Process upper-nibble
+	bCrcReverseByte = (U8)(lCrc ^ abBitReverseTable16[(bData >> 4) & 0x0F]);
+	lCrc = (lCrc >> 4) ^ adwCrcTable32[bCrcReverseByte & 0x0F];
+
+	// Process lower-nibble
+	bCrcReverseByte = (U8)(lCrc ^ abBitReverseTable16[(bData >> 0) & 0x0F]);
+	lCrc = (lCrc >> 4) ^ adwCrcTable32[bCrcReverseByte & 0x0F];
+
+	return lCrc;
+}
+
+/*
+** Multiplies two polynomials modulo the CRC32 polynomial. Not reflected:
+** bit n is the coefficient of x^n.
+*/
+static constexpr U32 MultiplyModPoly(U32 lA, U32 lB)
+{
+	U64 lProduct = 0;
+
+	for (U32 i = 0; i < 32; i++)
+	{
+		if ((lB >> i) & 1)
+		{
+			lProduct ^= (U64)lA << i;
+		}
+	}
+
+	for (U32 i = 63; i >= 32; i--)
+	{
+		if ((lProduct >> i) & 1)
+		{
+			lProduct ^= CRC32_POLYNOMIAL << (i - 32);
+		}
+	}
+
+	return (U32)lProduct;
+}
+
+/*
+** x^n modulo the CRC32 polynomial, for small n.
+*/
+static constexpr U32 PowerOfXModPoly(U32 n)
+{
+	U64 lResult = 1;
+
+	for (U32 i = 0; i < n; i++)
+	{
+		lResult <<= 1;
+
+		if (lResult & 0x100000000ULL)
+		{
+			lResult ^= CRC32_POLYNOMIAL;
+		}
+	}
+
+	return (U32)lResult;
+}
+
+typedef struct CrcTables
+{
+	/*
+	** Byte-wise table: crc = (crc >> 8) ^ adwSlice[0][(crc ^ data) & 0xFF],
+	** followed by 1..7 zero bytes in adwSlice[1..7] for slice-by-8.
+	*/
+	U32 adwSlice[8][256];
+
+	/*
+	** x^(8 * 2^k) mod P, for shifting a CRC over 2^k zero bytes.
+	*/
+	U32 adwZeroBytesPower[32];
+} CrcTables_t;
+
+static constexpr CrcTables_t BuildCrcTables()
+{
+	CrcTables_t tables = {};
+
+	for (U32 i = 0; i < 256; i++)
+	{
+		tables.adwSlice[0][i] = FormatCrc32(NibbleCrc32(ReverseBits8((U8)i), 0)) ^
+			FormatCrc32(NibbleCrc32(0, 0));
+	}
+
+	for (U32 k = 1; k < 8; k++)
+	{
+		for (U32 i = 0; i < 256; i++)
+		{
+			U32 lPrev = tables.adwSlice[k - 1][i];
+			tables.adwSlice[k][i] = (lPrev >> 8) ^ tables.adwSlice[0][lPrev & 0xFF];
+		}
+	}
+
+	tables.adwZeroBytesPower[0] = PowerOfXModPoly(8);
+
+	for (U32 k = 1; k < 32; k++)
+	{
+		tables.adwZeroBytesPower[k] = MultiplyModPoly(tables.adwZeroBytesPower[k - 1], tables.adwZeroBytesPower[k - 1]);
+	}
+
+	return tables;
+}
+
+static constexpr CrcTables_t sCrcTables = BuildCrcTables();
+
+/*
+** FormatCrc32() only reverses bits within bytes, so it is its own inverse.
+*/
+static constexpr bool ByteTableMatchesNibbleCrc32(U32 lCrc)
+{
+	for (U32 i = 0; i < 256; i++)
+	{
+		U32 lExpected = FormatCrc32(NibbleCrc32(FormatCrc32(lCrc), (U8)i));
+		U32 lState = lCrc ^ CRC32_XOR_MASK;
+
+		lState = (lState >> 8) ^ sCrcTables.adwSlice[0][(lState ^ i) & 0xFF];
+
+		if ((lState ^ CRC32_XOR_MASK) != lExpected)
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static_assert(ByteTableMatchesNibbleCrc32(0x00000000UL) && ByteTableMatchesNibbleCrc32(0xA5C3961EUL),
+	"Byte-wise CRC32 table does not match the ABCC40 nibble algorithm");
+
+static_assert(sCrcTables.adwSlice[0][0x01] == SwapBytes32((U32)CRC32_POLYNOMIAL),
+	"Byte-wise CRC32 table does not use the CRC32 polynomial");
+
+/*------------------------------------------------------------------------------
+** CRC32 kernels. All operate on the linear state (formatted CRC XOR
+** CRC32_XOR_MASK) and return the updated state.
+**------------------------------------------------------------------------------
+*/
+
+typedef U32 (*Crc32Kernel)(U32 lCrc, const U8* pbBufferStart, U32 lLength);
+
+static U32 Crc32Slice8(U32 lCrc, const U8* pbBufferStart, U32 lLength)
+{
+	while (lLength >= 8)
+	{
+		U32 lLow = lCrc ^ ((U32)pbBufferStart[0] | ((U32)pbBufferStart[1] << 8) |
+			((U32)pbBufferStart[2] << 16) | ((U32)pbBufferStart[3] << 24));
+
+		lCrc = sCrcTables.adwSlice[7][(lLow >> 0) & 0xFF] ^
+			sCrcTables.adwSlice[6][(lLow >> 8) & 0xFF] ^
+			sCrcTables.adwSlice[5][(lLow >> 16) & 0xFF] ^
+			sCrcTables.adwSlice[4][(lLow >> 24) & 0xFF] ^
+			sCrcTables.adwSlice[3][pbBufferStart[4]] ^
+			sCrcTables.adwSlice[2][pbBufferStart[5]] ^
+			sCrcTables.adwSlice[1][pbBufferStart[6]] ^
+			sCrcTables.adwSlice[0][pbBufferStart[7]];
+
+		pbBufferStart += 8;
+		lLength -= 8;
+	}
+
+	while (lLength > 0)
+	{
+		lCrc = (lCrc >> 8) ^ sCrcTables.adwSlice[0][(lCrc ^ *pbBufferStart) & 0xFF];
+		pbBufferStart++;
+		lLength--;
+	}
+
+	return lCrc;
+}
+
+/*
+** The carry-less multiply kernels keep a 128-bit remainder, most significant
+** byte first, that is congruent to the data processed so far. Each step
+** multiplies the remainder by x^128 modulo P, i.e. folds its upper and lower
+** halves with x^192 mod P and x^128 mod P, and adds the next 16 bytes. The
+** final remainder is then processed as 16 data bytes by the table kernel.
+*/
+static constexpr U64 CRC32_FOLD_HIGH = PowerOfXModPoly(128 + 64);
+static constexpr U64 CRC32_FOLD_LOW = PowerOfXModPoly(128);
+
+#ifdef ABCC_CRC_X86_CLMUL
+CRC_TARGET_CLMUL static U32 Crc32Clmul(U32 lCrc, const U8* pbBufferStart, U32 lLength)
+{
+	const __m128i oByteSwap = _mm_set_epi8(0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11, 12, 13, 14, 15);
+	const __m128i oFold = _mm_set_epi64x((long long)CRC32_FOLD_HIGH, (long long)CRC32_FOLD_LOW);
+	U8 abRemainder[16];
+	__m128i oRemainder;
+
+	if (lLength < 32)
+	{
+		return Crc32Slice8(lCrc, pbBufferStart, lLength);
+	}
+
+	oRemainder = _mm_loadu_si128((const __m128i*)pbBufferStart);
+	oRemainder = _mm_xor_si128(oRemainder, _mm_cvtsi32_si128((int)lCrc));
+	oRemainder = _mm_shuffle_epi8(oRemainder, oByteSwap);
+	pbBufferStart += 16;
+	lLength -= 16;
+
+	while (lLength >= 16)
+	{
+		__m128i oData = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*)pbBufferStart), oByteSwap);
+		__m128i oHigh = _mm_clmulepi64_si128(oRemainder, oFold, 0x11);
+		__m128i oLow = _mm_clmulepi64_si128(oRemainder, oFold, 0x00);
+
+		oRemainder = _mm_xor_si128(oData, _mm_xor_si128(oHigh, oLow));
+		pbBufferStart += 16;
+		lLength -= 16;
+	}
+
+	_mm_storeu_si128((__m128i*)abRemainder, _mm_shuffle_epi8(oRemainder, oByteSwap));
+
+	lCrc = Crc32Slice8(0, abRemainder, sizeof(abRemainder));
+	return Crc32Slice8(lCrc, pbBufferStart, lLength);
+}
+
+static bool IsClmulSupported()
+{
+	const unsigned int CPUID_ECX_PCLMULQDQ = (1u << 1);
+	const unsigned int CPUID_ECX_SSSE3 = (1u << 9);
+	unsigned int dwEcx;
+
+#ifdef _MSC_VER
+	int aiRegisters[4];
+
+	__cpuid(aiRegisters, 1);
+	dwEcx = (unsigned int)aiRegisters[2];
+#else
+	unsigned int dwEax, dwEbx, dwEdx;
+
+	if (!__get_cpuid(1, &dwEax, &dwEbx, &dwEcx, &dwEdx))
+	{
+		return false;
+	}
+#endif
+
+	return ((dwEcx & CPUID_ECX_PCLMULQDQ) != 0) && ((dwEcx & CPUID_ECX_SSSE3) != 0);
+}
+#endif /* ABCC_CRC_X86_CLMUL */
+
+#ifdef ABCC_CRC_ARM_PMULL
+static inline uint8x16_t ReverseBytes128(uint8x16_t oValue)
+{
+	oValue = vrev64q_u8(oValue);
+	return vextq_u8(oValue, oValue, 8);
+}
+
+static U32 Crc32Pmull(U32 lCrc, const U8* pbBufferStart, U32 lLength)
+{
+	U8 abRemainder[16];
+	uint8x16_t oRemainder;
+
+	if (lLength < 32)
+	{
+		return Crc32Slice8(lCrc, pbBufferStart, lLength);
+	}
+
+	oRemainder = veorq_u8(vld1q_u8(pbBufferStart), vreinterpretq_u8_u32(vsetq_lane_u32(lCrc, vdupq_n_u32(0), 0)));
+	oRemainder = ReverseBytes128(oRemainder);
+	pbBufferStart += 16;
+	lLength -= 16;
+
+	while (lLength >= 16)
+	{
+		uint8x16_t oData = ReverseBytes128(vld1q_u8(pbBufferStart));
+		uint64x2_t oHalves = vreinterpretq_u64_u8(oRemainder);
+		poly128_t oHigh = vmull_p64((poly64_t)vgetq_lane_u64(oHalves, 1), (poly64_t)CRC32_FOLD_HIGH);
+		poly128_t oLow = vmull_p64((poly64_t)vgetq_lane_u64(oHalves, 0), (poly64_t)CRC32_FOLD_LOW);
+
+		oRemainder = veorq_u8(oData, veorq_u8(vreinterpretq_u8_p128(oHigh), vreinterpretq_u8_p128(oLow)));
+		pbBufferStart += 16;
+		lLength -= 16;
+	}
+
+	vst1q_u8(abRemainder, ReverseBytes128(oRemainder));
+
+	lCrc = Crc32Slice8(0, abRemainder, sizeof(abRemainder));
+	return Crc32Slice8(lCrc, pbBufferStart, lLength);
+}
+
+static bool IsPmullSupported()
+{
+#if defined(__linux__)
+	return (getauxval(AT_HWCAP) & HWCAP_PMULL) != 0;
+#elif defined(__APPLE__)
+	int iSupported = 0;
+	size_t nSize = sizeof(iSupported);
+
+	return (sysctlbyname("hw.optional.arm.FEAT_PMULL", &iSupported, &nSize, nullptr, 0) == 0) && (iSupported != 0);
+#elif defined(_WIN32)
+	return IsProcessorFeaturePresent(PF_ARM_V8_CRYPTO_INSTRUCTIONS_AVAILABLE) != FALSE;
+#else
+	// No known way to ask, use the portable kernel
+	return false;
+#endif
+}
+#endif /* ABCC_CRC_ARM_PMULL */
+
+typedef struct Crc32KernelInfo
+{
+	Crc32Kernel pfKernel;
+	const char* pcName;
+} Crc32KernelInfo_t;
+
+static Crc32KernelInfo_t SelectCrc32Kernel()
+{
+#ifdef ABCC_CRC_X86_CLMUL
+	if (IsClmulSupported())
+	{
+		return { Crc32Clmul, "pclmulqdq" };
+	}
+#endif
+#ifdef ABCC_CRC_ARM_PMULL
+	if (IsPmullSupported())
+	{
+		return { Crc32Pmull, "pmull" };
+	}
+#endif
+	return { Crc32Slice8, "slice-by-8" };
+}
+
+static const Crc32KernelInfo_t sCrc32Kernel = SelectCrc32Kernel();
+
 void AbccCrc::Init()
 {
 	mCrc32 = 0;
@@ -85,11 +471,11 @@ void AbccCrc::Init()
 #endif
 }
 
-void AbccCrc::Update(U8* pbBufferStart, U16 iLength)
+void AbccCrc::Update(const U8* pbBufferStart, U32 lLength)
 {
-	mCrc32 = CRC_Crc32(mCrc32, pbBufferStart, iLength);
+	mCrc32 = CRC_Crc32(mCrc32, pbBufferStart, lLength);
 #if ABCC_CRC_ENABLE_CRC16
-	mCrc16 = CRC_Crc16(mCrc16, pbBufferStart, iLength);
+	mCrc16 = CRC_Crc16(mCrc16, pbBufferStart, (U16)lLength);
 #endif
 }
 
@@ -102,31 +488,80 @@ U16 AbccCrc::Crc16()
 
 U32 AbccCrc::Crc32()
 {
-	return CRC_FormatCrc32(mCrc32);
+	return mCrc32;
 }
 
-U32 AbccCrc::CRC_Crc32(U32 iInitCrc, U8* pbBufferStart, U16 iLength)
+U32 AbccCrc::Combine(U32 lCrc1, U32 lCrc2, U32 lLength2)
 {
-	U8 bCrcReverseByte;
-	U32 lCrc = iInitCrc;
+	U32 lShift = 1;
+	U32 lCrc;
 
-	for (U16 i = 0; i < iLength; i++)
+	// lCrc1 * x^(8 * lLength2) mod P, computed in non-reflected byte order
+	for (U32 k = 0; lLength2 != 0; k++, lLength2 >>= 1)
 	{
-		// Process upper-nibble
-		bCrcReverseByte = (U8)(lCrc ^ abBitReverseTable16[(*pbBufferStart >> 4) & 0x0F]);
-		lCrc = (lCrc >> 4) ^ adwCrcTable32[bCrcReverseByte & 0x0F];
+		if (lLength2 & 1)
+		{
+			lShift = MultiplyModPoly(lShift, sCrcTables.adwZeroBytesPower[k]);
+		}
+	}
 
-		// Process lower-nibble
-		bCrcReverseByte = (U8)(lCrc ^ abBitReverseTable16[(*pbBufferStart >> 0) & 0x0F]);
-		lCrc = (lCrc >> 4) ^ adwCrcTable32[bCrcReverseByte & 0x0F];
-		pbBufferStart++;
+	lCrc = MultiplyModPoly(SwapBytes32(lCrc1), lShift);
+
+	return SwapBytes32(lCrc) ^ lCrc2;
+}
+
+const char* AbccCrc::KernelName()
+{
+	return sCrc32Kernel.pcName;
+}
+
+U32 AbccCrc::Crc32With(Crc32Implementation eImplementation, const U8* pbBufferStart, U32 lLength)
+{
+	U32 lCrc = CRC32_XOR_MASK;
+
+	switch (eImplementation)
+	{
+	case Crc32Implementation::Nibble:
+	{
+		U32 lNibbleCrc = 0;
+
+		for (U32 i = 0; i < lLength; i++)
+		{
+			lNibbleCrc = NibbleCrc32(lNibbleCrc, pbBufferStart[i]);
+		}
+
+		return FormatCrc32(lNibbleCrc);
+	}
+	case Crc32Implementation::SliceBy8:
+		lCrc = Crc32Slice8(lCrc, pbBufferStart, lLength);
+		break;
+	default:
+	case Crc32Implementation::Selected:
+		lCrc = sCrc32Kernel.pfKernel(lCrc, pbBufferStart, lLength);
+		break;
 	}
 
-	return lCrc;
+	return lCrc ^ CRC32_XOR_MASK;
+}
+
+U32 AbccCrc::CRC_Crc32(U32 lInitCrc, const U8* pbBufferStart, U32 lLength)
+{
+	U32 lCrc = lInitCrc ^ CRC32_XOR_MASK;
+
+	if (lLength >= CRC32_KERNEL_MIN_LENGTH)
+	{
+		lCrc = sCrc32Kernel.pfKernel(lCrc, pbBufferStart, lLength);
+	}
+	else
+	{
+		lCrc = Crc32Slice8(lCrc, pbBufferStart, lLength);
+	}
+
+	return lCrc ^ CRC32_XOR_MASK;
 }
 
 #if ABCC_CRC_ENABLE_CRC16
-U16 AbccCrc::CRC_Crc16(U16 iInitCrc, U8* pbBufferStart, U16 iLength)
+U16 AbccCrc::CRC_Crc16(U16 iInitCrc, const U8* pbBufferStart, U16 iLength)
 {
 	U8 bIndex, bCrcLo, bCrcHi;
 
@@ -147,18 +582,6 @@ U16 AbccCrc::CRC_Crc16(U16 iInitCrc, U8* pbBufferStart, U16 iLength)
 }
 #endif
 
-U32 AbccCrc::CRC_FormatCrc32(U32 lCrc)
-{
-	return	((U32)abBitReverseTable16[(lCrc & 0x000000F0UL) >> 4]) |
-			((U32)abBitReverseTable16[(lCrc & 0x0000000FUL)]) << 4 |
-			((U32)abBitReverseTable16[(lCrc & 0x0000F000UL) >> 12] << 8) |
-			((U32)abBitReverseTable16[(lCrc & 0x00000F00UL) >> 8] << 12) |
-			((U32)abBitReverseTable16[(lCrc & 0x00F00000UL) >> 20] << 16) |
-			((U32)abBitReverseTable16[(lCrc & 0x000F0000UL) >> 16] << 20) |
-			((U32)abBitReverseTable16[(lCrc & 0xF0000000UL) >> 28] << 24) |
-			((U32)abBitReverseTable16[(lCrc & 0x0F000000UL) >> 24] << 28);
-}
-
 #if ABCC_CRC_ENABLE_CRC16
 U16 AbccCrc::CRC_FormatCrc16(U16 iCrc)
 {
@@ -12,12 +12,23 @@
 #ifndef ABCC_CRC_H
 #define ABCC_CRC_H
 
-#include "Analyzer.h"
+#include "LogicPublicTypes.h"
 
 #ifndef ABCC_CRC_ENABLE_CRC16
 	#define ABCC_CRC_ENABLE_CRC16	FALSE
 #endif
 
+/*
+** @brief The CRC32 implementations, see AbccCrc::Crc32With().
+*/
+enum class Crc32Implementation : U32
+{
+	Nibble,		// The ABCC40 definition, one nibble at a time
+	SliceBy8,	// The portable table kernel
+	Selected,	// The kernel selected for this CPU, see AbccCrc::KernelName()
+	SizeOfEnum
+};
+
 /*
 ** @brief A helper class for computing the CRC32 for ABCC SPI communication.
 */
@@ -31,13 +42,15 @@ public:
 	void Init();
 
 	/*******************************************************************************
-	** @brief Update the current CRC state with the specified data.
+	** @brief Update the current CRC state with the specified data. Buffers
+	**        of any length, e.g. a whole packet, are processed eight bytes at
+	**        a time.
 	**
 	** @param pbBufferStart - The start of a data buffer which to continue
 	**                        computing the CRC for.
-	** @param iLength       - The length of the data buffer.
+	** @param lLength       - The length of the data buffer.
 	*/
-	void Update(U8* pbBufferStart, U16 iLength);
+	void Update(const U8* pbBufferStart, U32 lLength);
 
 	/*******************************************************************************
 	** @brief The currently computed CRC32.
@@ -46,6 +59,35 @@ public:
 	*/
 	U32 Crc32();
 
+	/*******************************************************************************
+	** @brief Computes the CRC32 of two consecutive buffers from the CRC32 of
+	**        each, so that buffers can be checksummed independently.
+	**
+	** @param  lCrc1    - Crc32() of the first buffer, starting from Init().
+	** @param  lCrc2    - Crc32() of the second buffer, starting from Init().
+	** @param  lLength2 - The length of the second buffer.
+	** @return U32      - The CRC32 of both buffers.
+	*/
+	static U32 Combine(U32 lCrc1, U32 lCrc2, U32 lLength2);
+
+	/*******************************************************************************
+	** @brief The CRC32 implementation selected for this CPU: "pclmulqdq",
+	**        "pmull" or the portable "slice-by-8".
+	*/
+	static const char* KernelName();
+
+	/*******************************************************************************
+	** @brief Computes the CRC32 of a buffer, starting from Init(), with one
+	**        implementation regardless of the buffer length. Lets the
+	**        kernels be checked against the nibble definition.
+	**
+	** @param  eImplementation - The implementation to use.
+	** @param  pbBufferStart   - The start of the data buffer.
+	** @param  lLength         - The length of the data buffer.
+	** @return U32             - The CRC32, as Crc32() would return it.
+	*/
+	static U32 Crc32With(Crc32Implementation eImplementation, const U8* pbBufferStart, U32 lLength);
+
 #if ABCC_CRC_ENABLE_CRC16
 	/*******************************************************************************
 	** @brief The currently computed CRC16.
@@ -58,28 +100,20 @@ public:
 private:
 
 	/*
-	** @brief Internal CRC32 state.
+	** @brief Internal CRC32 state, kept in the formatted bit order.
 	*/
 	U32 mCrc32;
 
 	/*******************************************************************************
-	** @brief Computes and returns an unformatted CRC32.
+	** @brief Computes and returns a CRC32.
 	**
-	** @param  iInitCrc      - The initial CRC32 state.
+	** @param  lInitCrc      - The initial (formatted) CRC32 state.
 	** @param  pbBufferStart - The start of a data buffer which to continue
 	**                         computing the CRC32 for.
-	** @param  iLength       - The length of the data buffer.
-	** @return U32           - The (unformatted) CRC32.
-	*/
-	U32 CRC_Crc32(U32 iInitCrc, U8* pbBufferStart, U16 iLength);
-
-	/*******************************************************************************
-	** @brief Returns the formatted CRC32.
-	**
-	** @param  lCrc - The unformatted CRC32.
-	** @return U32  - The formatted CRC32.
+	** @param  lLength       - The length of the data buffer.
+	** @return U32           - The (formatted) CRC32.
 	*/
-	U32 CRC_FormatCrc32(U32 lCrc);
+	U32 CRC_Crc32(U32 lInitCrc, const U8* pbBufferStart, U32 lLength);
 
 #if ABCC_CRC_ENABLE_CRC16
 	/*
@@ -96,7 +130,7 @@ private:
 	** @param  iLength       - The length of the data buffer.
 	** @return U16           - The CRC16.
 	*/
-	U16 CRC_Crc16(U16 iInitCrc, U8* pbBufferStart, U16 iLength);
+	U16 CRC_Crc16(U16 iInitCrc, const U8* pbBufferStart, U16 iLength);
 
 	/*******************************************************************************
 	** @brief Returns the formatted CRC16.
@@ -0,0 +1,245 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccMessageTable.cpp
+**    Summary: Reassembles the fragments of the messages in a capture. Each
+**             table entry holds a message's decoded header, its fragments,
+**             and the location of the complete message in a payload arena.
+**             Message data frames refer to their entry by id.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "AbccMessageTable.h"
+
+/* Longest message that is stored, longer fragment sequences are truncated */
+#define MAX_STORED_MESSAGE_SIZE		(sizeof(ABP_MsgHeaderType) + ABP_MAX_MSG_DATA_BYTES)
+
+AbccMessageTable::AbccMessageTable()
+{
+	for (U32 i = 0; i < SpiChannel::NotSpecified; i++)
+	{
+		mOpenId[i] = ABCC_MSG_ID_NONE;
+		mLastId[i] = ABCC_MSG_ID_NONE;
+	}
+}
+
+AbccMessageTable::~AbccMessageTable()
+{
+}
+
+U32 AbccMessageTable::OpenMessage(SpiChannel_t channel, bool retransmission)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (channel >= SpiChannel::NotSpecified)
+	{
+		return ABCC_MSG_ID_NONE;
+	}
+
+	U32 id = mLastId[channel];
+
+	if (retransmission && (id != ABCC_MSG_ID_NONE) &&
+		(mEntries[id].asFragments.size() <= 1))
+	{
+		// The first fragment is sent again, start over with the same entry
+		MessageTableEntry_t& entry = mEntries[id];
+
+		entry.asFragments.clear();
+		entry.fComplete = false;
+		entry.dwLength = 0;
+		mOpenBytes[channel].clear();
+		mOpenId[channel] = id;
+
+		return id;
+	}
+
+	StoreMessage(channel);
+
+	MessageTableEntry_t entry;
+
+	entry.sHeader = {};
+	entry.eChannel = channel;
+	entry.fComplete = false;
+	entry.fChecksumError = false;
+	entry.lOffset = 0;
+	entry.dwLength = 0;
+
+	mEntries.push_back(entry);
+	mOpenId[channel] = (U32)(mEntries.size() - 1);
+	mLastId[channel] = mOpenId[channel];
+
+	return mOpenId[channel];
+}
+
+void AbccMessageTable::SetHeader(U32 message_id, const MsgHeaderInfo_t& header)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (message_id < mEntries.size())
+	{
+		mEntries[message_id].sHeader = header;
+	}
+}
+
+void AbccMessageTable::AddFragment(U32 message_id, const MessageFragmentInfo_t& fragment)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	MessageFragment_t entryFragment;
+
+	if (message_id >= mEntries.size())
+	{
+		return;
+	}
+
+	MessageTableEntry_t& entry = mEntries[message_id];
+	SpiChannel_t channel = entry.eChannel;
+	std::vector<U8>& bytes = mOpenBytes[channel];
+
+	if (mOpenId[channel] != message_id)
+	{
+		// The message was already closed
+		return;
+	}
+
+	if (fragment.fRetransmission && !entry.asFragments.empty())
+	{
+		// Replace the fragment that was added last
+		bytes.resize(entry.asFragments.back().dwOffset);
+		entry.asFragments.pop_back();
+	}
+
+	U32 length = fragment.dwLength;
+
+	if (bytes.size() + length > MAX_STORED_MESSAGE_SIZE)
+	{
+		length = (U32)(MAX_STORED_MESSAGE_SIZE - bytes.size());
+	}
+
+	entryFragment.lFirstSample = fragment.lFirstSample;
+	entryFragment.lLastSample = fragment.lLastSample;
+	entryFragment.dwOffset = (U32)bytes.size();
+	entryFragment.dwLength = length;
+	entry.asFragments.push_back(entryFragment);
+
+	bytes.insert(bytes.end(), fragment.pbData, fragment.pbData + length);
+	entry.fChecksumError |= fragment.fChecksumError;
+
+	if (fragment.fLastFragment)
+	{
+		entry.fComplete = true;
+		StoreMessage(channel);
+	}
+}
+
+/* Moves the message open on a channel to the arena and closes it */
+void AbccMessageTable::StoreMessage(SpiChannel_t channel)
+{
+	U32 id = mOpenId[channel];
+	std::vector<U8>& bytes = mOpenBytes[channel];
+
+	if (id != ABCC_MSG_ID_NONE)
+	{
+		U32 length = (U32)bytes.size();
+
+		if (length >= sizeof(ABP_MsgHeaderType))
+		{
+			// Drop the padding of the last fragment
+			U32 dataSize = (U32)bytes[0] | ((U32)bytes[1] << 8);
+
+			if (length > sizeof(ABP_MsgHeaderType) + dataSize)
+			{
+				length = (U32)sizeof(ABP_MsgHeaderType) + dataSize;
+			}
+		}
+
+		if (length > 0)
+		{
+			mEntries[id].lOffset = mMessages.AppendContiguous(bytes.data(), length);
+			mEntries[id].dwLength = length;
+		}
+
+		mOpenId[channel] = ABCC_MSG_ID_NONE;
+	}
+
+	bytes.clear();
+}
+
+bool AbccMessageTable::GetHeader(U32 message_id, MsgHeaderInfo_t* header) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (message_id >= mEntries.size())
+	{
+		return false;
+	}
+
+	*header = mEntries[message_id].sHeader;
+	return true;
+}
+
+bool AbccMessageTable::GetEntry(U32 message_id, MessageTableEntry_t* entry) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (message_id >= mEntries.size())
+	{
+		return false;
+	}
+
+	*entry = mEntries[message_id];
+	return true;
+}
+
+bool AbccMessageTable::GetView(U32 message_id, AbccMessageView_t* view) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if ((message_id >= mEntries.size()) ||
+		!mEntries[message_id].fComplete ||
+		(mEntries[message_id].dwLength < sizeof(ABP_MsgHeaderType)))
+	{
+		return false;
+	}
+
+	const MessageTableEntry_t& entry = mEntries[message_id];
+	const U8* message = mMessages.GetContiguous(entry.lOffset, entry.dwLength);
+
+	if (message == nullptr)
+	{
+		return false;
+	}
+
+	view->psHeader = reinterpret_cast<const ABP_MsgHeaderType*>(message);
+	view->pbData = message + sizeof(ABP_MsgHeaderType);
+	view->dwDataSize = entry.dwLength - (U32)sizeof(ABP_MsgHeaderType);
+	view->lFirstSample = entry.asFragments.front().lFirstSample;
+	view->lLastSample = entry.asFragments.back().lLastSample;
+	view->eChannel = entry.eChannel;
+	view->dwFragmentCount = (U32)entry.asFragments.size();
+	view->fChecksumError = entry.fChecksumError;
+
+	return true;
+}
+
+U32 AbccMessageTable::GetCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return (U32)mEntries.size();
+}
+
+void AbccMessageTable::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mEntries.clear();
+	mMessages.Clear();
+
+	for (U32 i = 0; i < SpiChannel::NotSpecified; i++)
+	{
+		mOpenId[i] = ABCC_MSG_ID_NONE;
+		mLastId[i] = ABCC_MSG_ID_NONE;
+		mOpenBytes[i].clear();
+	}
+}
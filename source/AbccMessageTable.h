@@ -0,0 +1,123 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccMessageTable.h
+**    Summary: Reassembles the fragments of the messages in a capture. Each
+**             table entry holds a message's decoded header, its fragments,
+**             and the location of the complete message in a payload arena.
+**             Message data frames refer to their entry by id.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_MESSAGE_TABLE_H
+#define ABCC_MESSAGE_TABLE_H
+
+#include <mutex>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "AbccSpiAnalyzerTypes.h"
+#include "AbccSpiDecoder.h"
+#include "AbccPayloadArena.h"
+#include "abcc_td.h"
+#include "abcc_abp/abp.h"
+
+/* One packet's share of a message */
+typedef struct MessageFragment
+{
+	S64 lFirstSample;
+	S64 lLastSample;
+	U32 dwOffset;			// Of the fragment's first byte within the message
+	U32 dwLength;
+} MessageFragment_t;
+
+typedef struct MessageTableEntry
+{
+	MsgHeaderInfo_t sHeader;	// As decoded, used to render the data frames
+	SpiChannel_t eChannel;
+	bool fComplete;				// The last fragment has been added
+	bool fChecksumError;		// A packet failed its CRC32 check, a fragment may be missing
+	U64 lOffset;				// Of the message in the payload arena
+	U32 dwLength;				// Header and data, zero until the message is stored
+	std::vector<MessageFragment_t> asFragments;
+} MessageTableEntry_t;
+
+/*
+** A complete message, laid out as an ABP_MsgType without the unused part
+** of the data buffer. The pointers refer to the table's arena and stay valid
+** until the table is cleared.
+*/
+typedef struct AbccMessageView
+{
+	const ABP_MsgHeaderType* psHeader;
+	const U8* pbData;
+	U32 dwDataSize;
+	S64 lFirstSample;
+	S64 lLastSample;
+	SpiChannel_t eChannel;
+	U32 dwFragmentCount;
+	bool fChecksumError;
+} AbccMessageView_t;
+
+/*
+** Messages are opened when their first field is decoded, and fragments are
+** added as the packets carrying them pass their checksum test. Packets that
+** are rolled back never get here; a retransmitted fragment replaces the one
+** added before it. The fragments are collected until the message is
+** complete, or until the next message on the same channel is opened, and
+** then stored in one piece so that views can point into the arena. Like the
+** arena, the table is filled by the analyzer's worker thread and read while
+** the results are rendered; all access is serialized.
+*/
+class AbccMessageTable
+{
+public:
+
+	AbccMessageTable();
+	~AbccMessageTable();
+
+	/*
+	** Adds a message and returns its id. A message still open on the same
+	** channel is stored as incomplete. A retransmission of the packet that
+	** started the last message on the channel restarts that message instead.
+	*/
+	U32 OpenMessage(SpiChannel_t channel, bool retransmission);
+
+	void SetHeader(U32 message_id, const MsgHeaderInfo_t& header);
+	void AddFragment(U32 message_id, const MessageFragmentInfo_t& fragment);
+
+	bool GetHeader(U32 message_id, MsgHeaderInfo_t* header) const;
+	bool GetEntry(U32 message_id, MessageTableEntry_t* entry) const;
+
+	/*
+	** Returns false unless the message is complete and holds at least a
+	** message header.
+	*/
+	bool GetView(U32 message_id, AbccMessageView_t* view) const;
+
+	U32 GetCount() const;
+
+	void Clear();
+
+protected:
+
+	void StoreMessage(SpiChannel_t channel);
+
+protected:
+
+	std::vector<MessageTableEntry_t> mEntries;
+
+	// Message open on each channel, and the bytes of its fragments so far
+	U32 mOpenId[SpiChannel::NotSpecified];
+	std::vector<U8> mOpenBytes[SpiChannel::NotSpecified];
+
+	// Last message opened on each channel
+	U32 mLastId[SpiChannel::NotSpecified];
+
+	AbccPayloadArena mMessages;
+	mutable std::mutex mMutex;
+};
+
+#endif /* ABCC_MESSAGE_TABLE_H */
@@ -0,0 +1,128 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccPacketDirectory.cpp
+**    Summary: Per-packet directory of the frame holding each MOSI and MISO
+**             field type, recorded while the packets are decoded.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <algorithm>
+
+#include "AbccPacketDirectory.h"
+
+/* Field offsets with a special meaning */
+#define FIELD_NOT_PRESENT					0xFFFF
+#define FIELD_NOT_RECORDED					0xFFFE	/* Too far from the first frame */
+
+AbccPacketDirectory::AbccPacketDirectory()
+{
+	ResetPendingPacket();
+}
+
+AbccPacketDirectory::~AbccPacketDirectory()
+{
+}
+
+bool AbccPacketDirectory::IsDirectoryType(U8 type)
+{
+	return (type < NUM_DIRECTORY_STATE_TYPES) ||
+		((type >= AbccSpiError::Generic) && (type <= AbccSpiError::EndOfTransfer));
+}
+
+U32 AbccPacketDirectory::GetFieldIndex(U8 type, bool mosi)
+{
+	U32 fieldType = (type < NUM_DIRECTORY_STATE_TYPES) ? type : (NUM_DIRECTORY_STATE_TYPES + type - AbccSpiError::Generic);
+
+	return fieldType * 2 + (mosi ? 0 : 1);
+}
+
+void AbccPacketDirectory::AddFrame(U64 frame_index, U8 type, bool mosi)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (mPendingFirstFrame == INVALID_RESULT_INDEX)
+	{
+		mPendingFirstFrame = frame_index;
+	}
+
+	if (!IsDirectoryType(type))
+	{
+		return;
+	}
+
+	U16& offset = maPendingOffsets[GetFieldIndex(type, mosi)];
+
+	// The first frame of a type is kept, like a scan of the packet finds it
+	if (offset == FIELD_NOT_PRESENT)
+	{
+		U64 distance = frame_index - mPendingFirstFrame;
+		offset = (distance < FIELD_NOT_RECORDED) ? (U16)distance : FIELD_NOT_RECORDED;
+	}
+}
+
+void AbccPacketDirectory::CommitPacket(U64 packet_index)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// The results number their packets in commit order
+	if ((packet_index != INVALID_RESULT_INDEX) && (packet_index == mFirstFrames.size()))
+	{
+		mFirstFrames.push_back(mPendingFirstFrame);
+		mFieldOffsets.insert(mFieldOffsets.end(), maPendingOffsets, maPendingOffsets + NUM_DIRECTORY_FIELDS);
+	}
+
+	ResetPendingPacket();
+}
+
+void AbccPacketDirectory::CancelPacket()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	ResetPendingPacket();
+}
+
+bool AbccPacketDirectory::Find(U64 packet_index, bool mosi, U8 type, U64* frame_index_ptr) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if ((packet_index >= mFirstFrames.size()) || !IsDirectoryType(type))
+	{
+		return false;
+	}
+
+	U16 offset = mFieldOffsets[(size_t)packet_index * NUM_DIRECTORY_FIELDS + GetFieldIndex(type, mosi)];
+
+	if (offset == FIELD_NOT_RECORDED)
+	{
+		return false;
+	}
+
+	*frame_index_ptr = (offset == FIELD_NOT_PRESENT) ? INVALID_RESULT_INDEX : mFirstFrames[(size_t)packet_index] + offset;
+
+	return true;
+}
+
+U64 AbccPacketDirectory::GetPacketCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return mFirstFrames.size();
+}
+
+void AbccPacketDirectory::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mFirstFrames.clear();
+	mFieldOffsets.clear();
+	ResetPendingPacket();
+}
+
+void AbccPacketDirectory::ResetPendingPacket()
+{
+	mPendingFirstFrame = INVALID_RESULT_INDEX;
+	std::fill(maPendingOffsets, maPendingOffsets + NUM_DIRECTORY_FIELDS, (U16)FIELD_NOT_PRESENT);
+}
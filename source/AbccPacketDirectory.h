@@ -0,0 +1,84 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccPacketDirectory.h
+**    Summary: Per-packet directory of the frame holding each MOSI and MISO
+**             field type, recorded while the packets are decoded.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_PACKET_DIRECTORY_H
+#define ABCC_PACKET_DIRECTORY_H
+
+#include <mutex>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "AnalyzerResults.h"
+#include "AbccSpiAnalyzerTypes.h"
+
+/* Frame types 0x00-0x16 of either channel, followed by the AbccSpiError types */
+#define NUM_DIRECTORY_STATE_TYPES			(AbccMosiStates::MessageField_DataNotValid + 1)
+#define NUM_DIRECTORY_ERROR_TYPES			(AbccSpiError::EndOfTransfer - AbccSpiError::Generic + 1)
+#define NUM_DIRECTORY_FIELD_TYPES			(NUM_DIRECTORY_STATE_TYPES + NUM_DIRECTORY_ERROR_TYPES)
+
+/* Fields of a packet, one per field type and data channel */
+#define NUM_DIRECTORY_FIELDS				(NUM_DIRECTORY_FIELD_TYPES * 2)
+
+/*
+** Each packet stores its first frame and, per field, the offset of the
+** first frame of that type from it. Packets are added in order by the
+** analyzer's worker thread and may be looked up while it runs; all access
+** is serialized.
+*/
+class AbccPacketDirectory
+{
+public:
+
+	AbccPacketDirectory();
+	~AbccPacketDirectory();
+
+	/* Records a frame of the packet being decoded */
+	void AddFrame(U64 frame_index, U8 type, bool mosi);
+
+	/*
+	** Ends the packet being decoded. packet_index is the index the results
+	** gave it, or INVALID_RESULT_INDEX if it was not committed.
+	*/
+	void CommitPacket(U64 packet_index);
+	void CancelPacket();
+
+	/*
+	** Returns true if the packet is in the directory. frame_index_ptr is
+	** then set to the first frame of the type on the channel in the packet,
+	** or INVALID_RESULT_INDEX if the packet has none.
+	*/
+	bool Find(U64 packet_index, bool mosi, U8 type, U64* frame_index_ptr) const;
+
+	/* Whether a frame type has a field in the directory */
+	static bool IsDirectoryType(U8 type);
+
+	U64 GetPacketCount() const;
+
+	void Clear();
+
+protected:
+
+	static U32 GetFieldIndex(U8 type, bool mosi);
+
+	void ResetPendingPacket();
+
+protected:
+
+	std::vector<U64> mFirstFrames;
+	std::vector<U16> mFieldOffsets;		// NUM_DIRECTORY_FIELDS per packet
+
+	U64 mPendingFirstFrame;
+	U16 maPendingOffsets[NUM_DIRECTORY_FIELDS];
+
+	mutable std::mutex mMutex;
+};
+
+#endif /* ABCC_PACKET_DIRECTORY_H */
@@ -0,0 +1,60 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccPacketSummaryTable.cpp
+**    Summary: Fixed-size summary of each committed packet, as handed over by
+**             the decoder. The packet tabular text and the packet export are
+**             generated from it without reading the packets' frames.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "AbccPacketSummaryTable.h"
+
+AbccPacketSummaryTable::AbccPacketSummaryTable()
+{
+}
+
+AbccPacketSummaryTable::~AbccPacketSummaryTable()
+{
+}
+
+void AbccPacketSummaryTable::Add(U64 packet_index, const PacketSummary_t& summary)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	// The results number their packets in commit order
+	if ((packet_index != INVALID_RESULT_INDEX) && (packet_index == mSummaries.size()))
+	{
+		mSummaries.push_back(summary);
+	}
+}
+
+bool AbccPacketSummaryTable::Get(U64 packet_index, PacketSummary_t* summary_ptr) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (packet_index >= mSummaries.size())
+	{
+		return false;
+	}
+
+	*summary_ptr = mSummaries[(size_t)packet_index];
+
+	return true;
+}
+
+U64 AbccPacketSummaryTable::GetPacketCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return mSummaries.size();
+}
+
+void AbccPacketSummaryTable::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mSummaries.clear();
+}
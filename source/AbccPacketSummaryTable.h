@@ -0,0 +1,53 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccPacketSummaryTable.h
+**    Summary: Fixed-size summary of each committed packet, as handed over by
+**             the decoder. The packet tabular text and the packet export are
+**             generated from it without reading the packets' frames.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_PACKET_SUMMARY_TABLE_H
+#define ABCC_PACKET_SUMMARY_TABLE_H
+
+#include <mutex>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "AnalyzerResults.h"
+#include "AbccSpiDecoder.h"
+
+/*
+** Summaries are added in packet order by the analyzer's worker thread and
+** may be read while it runs; all access is serialized.
+*/
+class AbccPacketSummaryTable
+{
+public:
+
+	AbccPacketSummaryTable();
+	~AbccPacketSummaryTable();
+
+	/*
+	** Adds the summary of a packet. packet_index is the index the results
+	** gave it, or INVALID_RESULT_INDEX if it was not committed.
+	*/
+	void Add(U64 packet_index, const PacketSummary_t& summary);
+
+	/* Returns false if the packet has no summary */
+	bool Get(U64 packet_index, PacketSummary_t* summary_ptr) const;
+
+	U64 GetPacketCount() const;
+
+	void Clear();
+
+protected:
+
+	std::vector<PacketSummary_t> mSummaries;
+	mutable std::mutex mMutex;
+};
+
+#endif /* ABCC_PACKET_SUMMARY_TABLE_H */
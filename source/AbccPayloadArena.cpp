@@ -0,0 +1,153 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccPayloadArena.cpp
+**    Summary: Append-only byte store for payloads that are referenced from
+**             frames by offset instead of being stored one byte per frame.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <cstring>
+
+#include "AbccPayloadArena.h"
+
+#define PAYLOAD_ARENA_CHUNK_SIZE		(64 * 1024)
+
+AbccPayloadArena::AbccPayloadArena()
+	: mSize(0)
+{
+}
+
+AbccPayloadArena::~AbccPayloadArena()
+{
+}
+
+U64 AbccPayloadArena::Append(const U8* data, U32 length)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return AppendUnlocked(data, length);
+}
+
+U64 AbccPayloadArena::AppendContiguous(const U8* data, U32 length)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	U64 offset = (mSize + 3) & ~(U64)3;
+
+	if (length <= PAYLOAD_ARENA_CHUNK_SIZE)
+	{
+		if ((offset % PAYLOAD_ARENA_CHUNK_SIZE) + length > PAYLOAD_ARENA_CHUNK_SIZE)
+		{
+			// Skip to the start of the next chunk
+			offset += PAYLOAD_ARENA_CHUNK_SIZE - (offset % PAYLOAD_ARENA_CHUNK_SIZE);
+		}
+
+		// The skipped bytes stay unused. A new chunk is added by the append
+		// if the offset is at a chunk boundary.
+		mSize = offset;
+	}
+
+	return AppendUnlocked(data, length);
+}
+
+U64 AbccPayloadArena::AppendUnlocked(const U8* data, U32 length)
+{
+	U64 offset = mSize;
+
+	while (length > 0)
+	{
+		U32 chunkOffset = (U32)(mSize % PAYLOAD_ARENA_CHUNK_SIZE);
+		U32 count = PAYLOAD_ARENA_CHUNK_SIZE - chunkOffset;
+
+		if (chunkOffset == 0)
+		{
+			mChunks.emplace_back(new U8[PAYLOAD_ARENA_CHUNK_SIZE]);
+		}
+
+		if (count > length)
+		{
+			count = length;
+		}
+
+		memcpy(&mChunks.back()[chunkOffset], data, count);
+
+		data += count;
+		length -= count;
+		mSize += count;
+	}
+
+	return offset;
+}
+
+U32 AbccPayloadArena::Read(U64 offset, U8* buffer, U32 length) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	U32 copied = 0;
+
+	if (offset >= mSize)
+	{
+		return 0;
+	}
+
+	if (length > mSize - offset)
+	{
+		length = (U32)(mSize - offset);
+	}
+
+	while (copied < length)
+	{
+		U32 chunkOffset = (U32)(offset % PAYLOAD_ARENA_CHUNK_SIZE);
+		U32 count = PAYLOAD_ARENA_CHUNK_SIZE - chunkOffset;
+
+		if (count > length - copied)
+		{
+			count = length - copied;
+		}
+
+		memcpy(&buffer[copied], &mChunks[(size_t)(offset / PAYLOAD_ARENA_CHUNK_SIZE)][chunkOffset], count);
+
+		offset += count;
+		copied += count;
+	}
+
+	return copied;
+}
+
+U8 AbccPayloadArena::GetByte(U64 offset) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (offset >= mSize)
+	{
+		return 0;
+	}
+
+	return mChunks[(size_t)(offset / PAYLOAD_ARENA_CHUNK_SIZE)][offset % PAYLOAD_ARENA_CHUNK_SIZE];
+}
+
+const U8* AbccPayloadArena::GetContiguous(U64 offset, U32 length) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if ((offset + length > mSize) ||
+		((offset % PAYLOAD_ARENA_CHUNK_SIZE) + length > PAYLOAD_ARENA_CHUNK_SIZE))
+	{
+		return nullptr;
+	}
+
+	return &mChunks[(size_t)(offset / PAYLOAD_ARENA_CHUNK_SIZE)][offset % PAYLOAD_ARENA_CHUNK_SIZE];
+}
+
+U64 AbccPayloadArena::GetSize() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mSize;
+}
+
+void AbccPayloadArena::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	mChunks.clear();
+	mSize = 0;
+}
@@ -0,0 +1,77 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccPayloadArena.h
+**    Summary: Append-only byte store for payloads that are referenced from
+**             frames by offset instead of being stored one byte per frame.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_PAYLOAD_ARENA_H
+#define ABCC_PAYLOAD_ARENA_H
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+
+/*
+** Bytes are stored in fixed size chunks that are never moved, so an offset
+** stays valid for the lifetime of the arena. The analyzer's worker thread
+** appends while the results are rendered on other threads; all access is
+** serialized.
+*/
+class AbccPayloadArena
+{
+public:
+
+	AbccPayloadArena();
+	~AbccPayloadArena();
+
+	/*
+	** Appends length bytes and returns the offset of the first one
+	*/
+	U64 Append(const U8* data, U32 length);
+
+	/*
+	** Appends length bytes so that they are stored in one chunk, starting at
+	** an offset aligned to four bytes. This allows them to be accessed in
+	** place with GetContiguous(). Returns the offset of the first byte.
+	*/
+	U64 AppendContiguous(const U8* data, U32 length);
+
+	/*
+	** Copies up to length bytes starting at offset into the buffer. Returns
+	** the number of bytes copied, which is less than length when the range
+	** runs past the end of the arena.
+	*/
+	U32 Read(U64 offset, U8* buffer, U32 length) const;
+
+	U8 GetByte(U64 offset) const;
+
+	/*
+	** Returns a pointer to the length bytes at offset, or nullptr if they are
+	** not stored in one chunk. Chunks are never moved, so the pointer stays
+	** valid until the arena is cleared.
+	*/
+	const U8* GetContiguous(U64 offset, U32 length) const;
+
+	U64 GetSize() const;
+
+	void Clear();
+
+protected:
+
+	U64 AppendUnlocked(const U8* data, U32 length);
+
+protected:
+
+	std::vector<std::unique_ptr<U8[]>> mChunks;
+	U64 mSize;
+	mutable std::mutex mMutex;
+};
+
+#endif /* ABCC_PAYLOAD_ARENA_H */
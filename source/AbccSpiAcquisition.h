@@ -0,0 +1,1114 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiAcquisition.h
+**    Summary: Acquires SPI bytes from the sampled MOSI, MISO, SCLK and NSS
+**             channels and answers the bus queries of the decoder. The
+**             channel type is a template parameter so that the same code
+**             runs on the Saleae AnalyzerChannelData and on offline
+**             captures.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_SPI_ACQUISITION_H
+#define ABCC_SPI_ACQUISITION_H
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "AbccSpiAnalyzerTypes.h"
+#include "AbccSpiDecoder.h"
+
+// Upper bound on the clock edges read ahead for one transaction (16 KiB
+// worth of SPI bytes); longer transactions continue edge by edge.
+#define MAX_TRANSACTION_CLOCK_EDGES			(1 << 18)
+
+enum class GetByteStatus : U32
+{
+	OK,		// BYTE was successfully read
+	Error,	// Reading BYTE resulted in a logical error (requires statemachine reset)
+	Reset,	// Reading BYTE resulted in a event that requires state machine reset
+	Skip,	// Enable line was toggle with no data clocked. It is an empty packet and can be skipped.
+	SizeOfEnum
+};
+
+/*
+** The wiring modes that the byte acquisition is specialized for. Chosen once
+** in Setup() from the enable channel and the 3-wire/4-wire overrides.
+*/
+enum class AcquisitionWiring : U32
+{
+	FourWire,				// MOSI, MISO, SCLK and NSS
+	ThreeWire,				// MOSI, MISO and SCLK, packets separated by idle gaps
+	ThreeWireOn4Channels,	// NSS is connected but ignored, decoded as 3-wire
+	FourWireOn3Channels,	// NSS is not connected, no idle gap checks
+	SizeOfEnum
+};
+
+constexpr bool IsThreeWireAcquisition(AcquisitionWiring wiring)
+{
+	return (wiring == AcquisitionWiring::ThreeWire) || (wiring == AcquisitionWiring::ThreeWireOn4Channels);
+}
+
+/*
+** Maps the result of a byte acquisition onto the status the decoder expects.
+** A skipped byte is not passed to the decoder at all.
+*/
+inline AcquisitionStatus GetAcquisitionStatus(GetByteStatus byte_status)
+{
+	switch (byte_status)
+	{
+	case GetByteStatus::OK:
+	case GetByteStatus::Skip:
+		return AcquisitionStatus::OK;
+	case GetByteStatus::Reset:
+		return AcquisitionStatus::Reset;
+	default:
+	case GetByteStatus::Error:
+		return AcquisitionStatus::Error;
+	}
+}
+
+/*
+** The subset of the analyzer settings that influences byte acquisition
+*/
+typedef struct AcquisitionConfig
+{
+	U32 dwSampleRate;
+	S32 lClockingAlertLimit;
+	bool f3WireOn4Channels;
+	bool f4WireOn3Channels;
+	bool fExpandBitFrames;
+	bool fTransactionAcquisition;	// Read each 4-wire transaction's clock edges in one pass
+	U32 dwIdleGapNs;				// Minimum 3-wire idle gap between packets
+	U32 dwClockIdleNs;				// Maximum 3-wire clock idle time within a packet
+	MarkerDensity eMarkerDensity;	// Which per-bit sample markers are placed
+	bool fGenericAcquisition;		// Use the generic per-bit loop, the reference for the specialized ones
+} AcquisitionConfig_t;
+
+/*
+** Wraps the clock channel. Fill() reads all clock edges up to a sample in one
+** pass, after which the same navigation methods are answered from memory
+** until the buffered edges are used up. From then on, and when nothing is
+** buffered, every call goes to the channel itself. The answers are the same
+** as the channel's in both cases.
+*/
+template <class ChannelData>
+class BufferedClockData
+{
+public:
+
+	BufferedClockData()
+		: mChannel(nullptr),
+		mSampleNumber(0),
+		mNextEdge(0),
+		mInitialState(BitState::BIT_LOW)
+	{
+	}
+
+	void Attach(ChannelData* channel)
+	{
+		mChannel = channel;
+		mEdges.clear();
+		mNextEdge = 0;
+	}
+
+	/*
+	** Reads the clock edges before end_sample, at most max_edges of them.
+	*/
+	void Fill(U64 end_sample, size_t max_edges)
+	{
+		mSampleNumber = mChannel->GetSampleNumber();
+		mInitialState = mChannel->GetBitState();
+		mEdges.clear();
+		mNextEdge = 0;
+
+		while ((mEdges.size() < max_edges) && mChannel->DoMoreTransitionsExistInCurrentData() &&
+			(mChannel->GetSampleOfNextEdge() < end_sample))
+		{
+			mChannel->AdvanceToNextEdge();
+			mEdges.push_back(mChannel->GetSampleNumber());
+		}
+	}
+
+	// True while buffered edges remain, i.e. the transaction is in progress
+	inline bool IsBuffering()
+	{
+		return (mNextEdge < mEdges.size());
+	}
+
+	inline U64 GetSampleNumber()
+	{
+		return IsBuffering() ? mSampleNumber : mChannel->GetSampleNumber();
+	}
+
+	inline BitState GetBitState()
+	{
+		if (!IsBuffering())
+		{
+			return mChannel->GetBitState();
+		}
+
+		if ((mNextEdge & 1) == 0)
+		{
+			return mInitialState;
+		}
+
+		return (mInitialState == BitState::BIT_HIGH) ? BitState::BIT_LOW : BitState::BIT_HIGH;
+	}
+
+	inline void AdvanceToNextEdge()
+	{
+		if (IsBuffering())
+		{
+			mSampleNumber = mEdges[mNextEdge++];
+		}
+		else
+		{
+			mChannel->AdvanceToNextEdge();
+		}
+	}
+
+	inline U32 AdvanceToAbsPosition(U64 sample_number)
+	{
+		U32 transitionCount = 0;
+
+		if (!IsBuffering())
+		{
+			return mChannel->AdvanceToAbsPosition(sample_number);
+		}
+
+		if (sample_number <= mSampleNumber)
+		{
+			return 0;
+		}
+
+		while (IsBuffering() && (mEdges[mNextEdge] <= sample_number))
+		{
+			mNextEdge++;
+			transitionCount++;
+		}
+
+		if (IsBuffering())
+		{
+			mSampleNumber = sample_number;
+		}
+		else if (sample_number > mChannel->GetSampleNumber())
+		{
+			// The channel stopped at the last buffered edge
+			transitionCount += mChannel->AdvanceToAbsPosition(sample_number);
+		}
+
+		return transitionCount;
+	}
+
+	inline U64 GetSampleOfNextEdge()
+	{
+		return IsBuffering() ? mEdges[mNextEdge] : mChannel->GetSampleOfNextEdge();
+	}
+
+	inline bool WouldAdvancingToAbsPositionCauseTransition(U64 sample_number)
+	{
+		// A buffered edge lies before the end of the data, so no end of data
+		// can be reached before it
+		return IsBuffering() ? (mEdges[mNextEdge] <= sample_number) : mChannel->WouldAdvancingToAbsPositionCauseTransition(sample_number);
+	}
+
+	inline bool DoMoreTransitionsExistInCurrentData()
+	{
+		return IsBuffering() || mChannel->DoMoreTransitionsExistInCurrentData();
+	}
+
+protected:
+
+	ChannelData* mChannel;
+	std::vector<U64> mEdges;
+	U64 mSampleNumber;
+	size_t mNextEdge;
+	BitState mInitialState;
+};
+
+/*
+** ChannelData must provide the navigation methods of the SDK's
+** AnalyzerChannelData: GetSampleNumber, GetBitState, AdvanceToNextEdge,
+** AdvanceToAbsPosition, GetSampleOfNextEdge,
+** WouldAdvancingToAbsPositionCauseTransition and
+** DoMoreTransitionsExistInCurrentData.
+*/
+template <class ChannelData>
+class AbccSpiAcquisition : public AbccSpiDecoderBus
+{
+public:
+
+	AbccSpiAcquisition(AbccSpiDecoderSink* sink);
+	virtual ~AbccSpiAcquisition();
+
+	void Setup(ChannelData* mosi, ChannelData* miso, ChannelData* clock, ChannelData* enable, const AcquisitionConfig_t& config);
+
+	void AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+
+	GetByteStatus GetByte(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr);
+
+	// True while the bytes of a transaction whose clock edges were read in
+	// one pass are being returned
+	bool IsTransactionInProgress();
+
+	static U64 IdleTimeToSampleCount(U32 idle_time_ns, U32 sample_rate);
+
+public: // AbccSpiDecoderBus
+
+	virtual bool HasEnableChannel();
+	virtual bool IsEnableActive();
+	virtual bool WouldAdvancingTheClockToggleEnable();
+	virtual bool IsIdleConditionDetected();
+
+	virtual U64 GetCurrentSample();
+	virtual U64 GetClockSampleNumber();
+	virtual U64 GetSampleOfNextClockEdge();
+	virtual U64 GetSampleOfNextEnableEdge();
+
+	virtual void CheckForIdleAfterPacket();
+
+	virtual void SetNextByteStartsFrame(bool mosi, bool miso);
+
+protected: // Types
+
+	typedef GetByteStatus (AbccSpiAcquisition::*GetByteKernel)(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr);
+
+protected: // Members
+
+	AbccSpiDecoderSink* mSink;
+	AcquisitionConfig_t mConfig;
+	AcquisitionWiring mWiring;
+	GetByteKernel mGetByteKernel;
+
+	ChannelData* mMosi;
+	ChannelData* mMiso;
+	BufferedClockData<ChannelData> mClock;
+	ChannelData* mEnable;
+
+	U64 mCurrentSample;
+	S32 mClockingErrorCount;
+	std::vector<U64> mArrowLocations;
+
+	// Set by the decoder, the next byte on the channel starts a frame
+	bool mMosiStartsFrame;
+	bool mMisoStartsFrame;
+
+	// 3-wire idle limits converted to sample counts in Setup()
+	U64 mIdleGapSamples;
+	U64 mClockIdleSamples;
+
+protected: // Methods
+
+	inline bool Is3WireMode();
+	inline bool IsPure4WireMode();
+
+	inline bool IsBitMarkerPlaced(U32 bit_index, bool starts_frame);
+
+	inline void ProcessSample(ChannelData* chn_data, U64* data_ptr, U64* bit_mask_ptr, DecoderChannel chn, bool add_marker);
+
+	void AdvanceToActiveEnableEdge();
+
+	bool IsInitialClockPolarityCorrect();
+
+	inline bool Is3WireIdleCondition(U64 idle_sample_count);
+
+	void AdvanceToNext3WireIdleGap();
+
+	/*
+	** GetByte() specialized for a wiring mode, and within a byte for the
+	** clock polarity, so that the per-bit loop has no mode checks.
+	*/
+	template <AcquisitionWiring Wiring>
+	GetByteStatus GetByteForWiring(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr);
+
+	template <AcquisitionWiring Wiring, bool ClockIdleHigh>
+	GetByteStatus AcquireBits(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr);
+
+	/*
+	** GetByte() with the wiring mode and clock polarity checked on every bit.
+	** It is the reference the specialized kernels must match bit for bit.
+	*/
+	GetByteStatus GetByteGeneric(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr);
+
+	template <AcquisitionWiring Wiring>
+	inline bool WouldAdvancingTheClockToggleEnableForWiring();
+};
+
+template <class ChannelData>
+AbccSpiAcquisition<ChannelData>::AbccSpiAcquisition(AbccSpiDecoderSink* sink)
+	: mSink(sink),
+	mConfig(),
+	mWiring(AcquisitionWiring::FourWire),
+	mGetByteKernel(&AbccSpiAcquisition::template GetByteForWiring<AcquisitionWiring::FourWire>),
+	mMosi(nullptr),
+	mMiso(nullptr),
+	mClock(),
+	mEnable(nullptr),
+	mCurrentSample(0),
+	mClockingErrorCount(0),
+	mMosiStartsFrame(true),
+	mMisoStartsFrame(true),
+	mIdleGapSamples(0),
+	mClockIdleSamples(0)
+{
+}
+
+template <class ChannelData>
+AbccSpiAcquisition<ChannelData>::~AbccSpiAcquisition()
+{
+}
+
+template <class ChannelData>
+void AbccSpiAcquisition<ChannelData>::Setup(ChannelData* mosi, ChannelData* miso, ChannelData* clock, ChannelData* enable, const AcquisitionConfig_t& config)
+{
+	mMosi = mosi;
+	mMiso = miso;
+	mClock.Attach(clock);
+	mEnable = enable;
+	mConfig = config;
+
+	mClockingErrorCount = 0;
+	mMosiStartsFrame = true;
+	mMisoStartsFrame = true;
+
+	if (mConfig.f4WireOn3Channels)
+	{
+		// Nothing can be inferred from the clock alone, never report idle
+		mIdleGapSamples = UINT64_MAX;
+		mClockIdleSamples = UINT64_MAX;
+	}
+	else
+	{
+		mIdleGapSamples = IdleTimeToSampleCount(mConfig.dwIdleGapNs, mConfig.dwSampleRate);
+		mClockIdleSamples = IdleTimeToSampleCount(mConfig.dwClockIdleNs, mConfig.dwSampleRate);
+	}
+
+	if (mEnable != nullptr)
+	{
+		mWiring = mConfig.f3WireOn4Channels ? AcquisitionWiring::ThreeWireOn4Channels : AcquisitionWiring::FourWire;
+	}
+	else
+	{
+		mWiring = (mConfig.f4WireOn3Channels && !mConfig.f3WireOn4Channels) ? AcquisitionWiring::FourWireOn3Channels : AcquisitionWiring::ThreeWire;
+	}
+
+	switch (mWiring)
+	{
+	default:
+	case AcquisitionWiring::FourWire:
+		mGetByteKernel = &AbccSpiAcquisition::template GetByteForWiring<AcquisitionWiring::FourWire>;
+		break;
+	case AcquisitionWiring::ThreeWire:
+		mGetByteKernel = &AbccSpiAcquisition::template GetByteForWiring<AcquisitionWiring::ThreeWire>;
+		break;
+	case AcquisitionWiring::ThreeWireOn4Channels:
+		mGetByteKernel = &AbccSpiAcquisition::template GetByteForWiring<AcquisitionWiring::ThreeWireOn4Channels>;
+		break;
+	case AcquisitionWiring::FourWireOn3Channels:
+		mGetByteKernel = &AbccSpiAcquisition::template GetByteForWiring<AcquisitionWiring::FourWireOn3Channels>;
+		break;
+	}
+
+	if (mConfig.fGenericAcquisition)
+	{
+		mGetByteKernel = &AbccSpiAcquisition::GetByteGeneric;
+	}
+}
+
+template <class ChannelData>
+inline bool AbccSpiAcquisition<ChannelData>::Is3WireMode()
+{
+	return ((mEnable == nullptr) && (mConfig.f4WireOn3Channels == false)) || (mConfig.f3WireOn4Channels == true);
+}
+
+template <class ChannelData>
+inline bool AbccSpiAcquisition<ChannelData>::IsPure4WireMode()
+{
+	return (mEnable != nullptr) && (mConfig.f3WireOn4Channels == false);
+}
+
+template <class ChannelData>
+inline bool AbccSpiAcquisition<ChannelData>::IsBitMarkerPlaced(U32 bit_index, bool starts_frame)
+{
+	return (mConfig.eMarkerDensity == MarkerDensity::AllBits) ||
+		((mConfig.eMarkerDensity == MarkerDensity::FirstBit) && (bit_index == 0) && starts_frame);
+}
+
+template <class ChannelData>
+inline void AbccSpiAcquisition<ChannelData>::ProcessSample(ChannelData* chn_data, U64* data_ptr, U64* bit_mask_ptr, DecoderChannel chn, bool add_marker)
+{
+	if (chn_data != nullptr)
+	{
+		chn_data->AdvanceToAbsPosition(mCurrentSample);
+
+		// Bits are shifted in MSB first
+		if (chn_data->GetBitState() == BitState::BIT_HIGH)
+		{
+			*data_ptr |= *bit_mask_ptr;
+
+			if (add_marker)
+			{
+				mSink->AddMarker(mCurrentSample, DecoderMarker::One, chn);
+			}
+		}
+		else if (add_marker)
+		{
+			mSink->AddMarker(mCurrentSample, DecoderMarker::Zero, chn);
+		}
+
+		*bit_mask_ptr >>= 1;
+	}
+}
+
+template <class ChannelData>
+void AbccSpiAcquisition<ChannelData>::AdvanceToActiveEnableEdgeWithCorrectClockPolarity()
+{
+	// NOTE: 3-wire requires correct clock polarity (IDLE HI),
+	// in 4-wire mode, the polarity does not matter.
+
+	AdvanceToActiveEnableEdge();
+
+	if (Is3WireMode())
+	{
+		// With no enable line an idle gap of at least >=10us is required
+		for (;;)
+		{
+			// First find idle gap
+			AdvanceToNext3WireIdleGap();
+
+			// If false, this function moves to the next enable-active edge.
+			if (IsInitialClockPolarityCorrect())
+			{
+				break;
+			}
+			else
+			{
+				mClock.AdvanceToNextEdge();
+			}
+		}
+
+		mCurrentSample = mClock.GetSampleNumber();
+	}
+}
+
+template <class ChannelData>
+void AbccSpiAcquisition<ChannelData>::AdvanceToActiveEnableEdge()
+{
+	if (IsPure4WireMode())
+	{
+		if (mEnable->GetBitState() == BitState::BIT_HIGH)
+		{
+			mEnable->AdvanceToNextEdge();
+		}
+		else
+		{
+			mEnable->AdvanceToNextEdge();
+			mEnable->AdvanceToNextEdge();
+		}
+
+		mClock.AdvanceToAbsPosition(mEnable->GetSampleNumber());
+
+		// Once the transaction has ended, read all of its clock edges at once
+		if (mConfig.fTransactionAcquisition && mEnable->DoMoreTransitionsExistInCurrentData())
+		{
+			mClock.Fill(mEnable->GetSampleOfNextEdge(), MAX_TRANSACTION_CLOCK_EDGES);
+		}
+	}
+
+	mCurrentSample = mClock.GetSampleNumber();
+}
+
+template <class ChannelData>
+bool AbccSpiAcquisition<ChannelData>::IsInitialClockPolarityCorrect()
+{
+	bool correctPolarity = true;
+
+	if (Is3WireMode())
+	{
+		// In 3-wire, clock must idle HIGH
+		if (mClock.GetBitState() == BitState::BIT_LOW)
+		{
+			mSink->AddMarker(mCurrentSample, DecoderMarker::ErrorSquare, DecoderChannel::Clock);
+			correctPolarity = false;
+		}
+	}
+
+	return correctPolarity;
+}
+
+template <class ChannelData>
+inline bool AbccSpiAcquisition<ChannelData>::Is3WireIdleCondition(U64 idle_sample_count)
+{
+	return (mClock.GetSampleOfNextEdge() - mClock.GetSampleNumber()) >= idle_sample_count;
+}
+
+template <class ChannelData>
+void AbccSpiAcquisition<ChannelData>::AdvanceToNext3WireIdleGap()
+{
+	// Walk the clock edges until the distance to the next one is an idle gap.
+	// Each edge's sample is only read once.
+	U64 edgeSample = mClock.GetSampleNumber();
+	U64 nextEdgeSample = mClock.GetSampleOfNextEdge();
+
+	while ((nextEdgeSample - edgeSample) < mIdleGapSamples)
+	{
+		mClock.AdvanceToNextEdge();
+		edgeSample = nextEdgeSample;
+		nextEdgeSample = mClock.GetSampleOfNextEdge();
+	}
+}
+
+/*
+** Returns the smallest sample distance that spans idle_time_ns at
+** sample_rate. The comparison is made the same way as the time based check
+** this replaces, (float)distance / (float)rate >= (float)seconds, so that
+** packet boundaries do not move by a sample because of rounding.
+*/
+template <class ChannelData>
+U64 AbccSpiAcquisition<ChannelData>::IdleTimeToSampleCount(U32 idle_time_ns, U32 sample_rate)
+{
+	const float idleTime = (float)idle_time_ns / 1.0e9f;
+	const float sampleRate = (float)sample_rate;
+	U64 sampleCount;
+
+	if (sample_rate == 0)
+	{
+		return 0;
+	}
+
+	sampleCount = (U64)ceil((double)idleTime * (double)sample_rate);
+
+	while ((sampleCount > 0) && ((float)(sampleCount - 1) / sampleRate >= idleTime))
+	{
+		sampleCount--;
+	}
+
+	while ((float)sampleCount / sampleRate < idleTime)
+	{
+		sampleCount++;
+	}
+
+	return sampleCount;
+}
+
+template <class ChannelData>
+GetByteStatus AbccSpiAcquisition<ChannelData>::GetByte(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr)
+{
+	// Clock is assumed to be in the idle state when entering this function
+	return (this->*mGetByteKernel)(mosi_data_ptr, miso_data_ptr, first_sample_ptr);
+}
+
+template <class ChannelData>
+template <AcquisitionWiring Wiring>
+GetByteStatus AbccSpiAcquisition<ChannelData>::GetByteForWiring(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr)
+{
+	GetByteStatus byteStatus;
+
+	*mosi_data_ptr = 0;
+	*miso_data_ptr = 0;
+	mArrowLocations.clear();
+
+	*first_sample_ptr = mClock.GetSampleNumber();
+
+	// On every logic transition, check that "enable" doesn't change state.
+	// Note: Advancing the enable line to the next edge is not appropriate here since there may not be another edge
+	if (WouldAdvancingTheClockToggleEnableForWiring<Wiring>())
+	{
+		// Advance forward to next transaction
+		AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+		byteStatus = GetByteStatus::Skip;
+	}
+	else if (mClock.GetBitState() == BitState::BIT_HIGH)
+	{
+		// The clock polarity is determined for each byte
+		byteStatus = AcquireBits<Wiring, true>(mosi_data_ptr, miso_data_ptr, first_sample_ptr);
+	}
+	else
+	{
+		byteStatus = AcquireBits<Wiring, false>(mosi_data_ptr, miso_data_ptr, first_sample_ptr);
+	}
+
+	if ((byteStatus == GetByteStatus::OK) && !mArrowLocations.empty())
+	{
+		// Add sample markers to the results
+		for (size_t bitIndex = 0; bitIndex < mArrowLocations.size(); bitIndex++)
+		{
+			mSink->AddMarker(mArrowLocations[bitIndex], DecoderMarker::UpArrow, DecoderChannel::Clock);
+		}
+	}
+
+	mSink->CommitResults();
+
+	return byteStatus;
+}
+
+template <class ChannelData>
+bool AbccSpiAcquisition<ChannelData>::IsTransactionInProgress()
+{
+	return mClock.IsBuffering();
+}
+
+template <class ChannelData>
+template <AcquisitionWiring Wiring, bool ClockIdleHigh>
+GetByteStatus AbccSpiAcquisition<ChannelData>::AcquireBits(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr)
+{
+	const U32 bitsPerTransfer = 8;
+	U64 mosiBitMask = 1ull << (bitsPerTransfer - 1);
+	U64 misoBitMask = 1ull << (bitsPerTransfer - 1);
+
+	for (U32 bitIndex = 0; bitIndex < bitsPerTransfer; bitIndex++)
+	{
+		// The enable line was checked for the first bit by the caller
+		if ((bitIndex > 0) && WouldAdvancingTheClockToggleEnableForWiring<Wiring>())
+		{
+			// The enable state changed in the middle of acquiring a byte;
+			// this suggests we are not byte-synchronized.
+			return GetByteStatus::Reset;
+		}
+
+		if constexpr (IsThreeWireAcquisition(Wiring))
+		{
+			// In 3-wire mode, idle condition is >=5us (during a transaction).
+			// On every advancement on clock, check for idle condition.
+			// If detected, a reset of the statemachines are need to re-sync
+			// If an idle condition is detected in the middle of receiving a
+			// byte an error status is signaled otherwise the routine can
+			// advance in the capture silently.
+			if (Is3WireIdleCondition(mClockIdleSamples))
+			{
+				if (bitIndex == 0)
+				{
+					AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+				}
+				else
+				{
+					return GetByteStatus::Error;
+				}
+			}
+		}
+
+		// Jump to the next clock phase
+		mClock.AdvanceToNextEdge();
+
+		if constexpr (!ClockIdleHigh)
+		{
+			// Sample on leading edge
+			mCurrentSample = mClock.GetSampleNumber();
+			ProcessSample(mMosi, mosi_data_ptr, &mosiBitMask, DecoderChannel::Mosi, IsBitMarkerPlaced(bitIndex, mMosiStartsFrame));
+			ProcessSample(mMiso, miso_data_ptr, &misoBitMask, DecoderChannel::Miso, IsBitMarkerPlaced(bitIndex, mMisoStartsFrame));
+
+			if (bitIndex == 0)
+			{
+				// Latch the first sample point in the byte
+				*first_sample_ptr = mCurrentSample;
+			}
+		}
+
+		if constexpr (IsThreeWireAcquisition(Wiring))
+		{
+			// In 3-wire mode idle condition is >=5us (during a transaction).
+			// On every advancement on clock, check for idle condition.
+			// If detected, a reset of the statemachines are need to re-sync
+			if (Is3WireIdleCondition(mClockIdleSamples))
+			{
+				// Error: reset everything and return.
+				return GetByteStatus::Error;
+			}
+		}
+		else if (WouldAdvancingTheClockToggleEnableForWiring<Wiring>())
+		{
+			// There are two potential error cases to check for here.
+			// If in clock idle high mode, and processing the first bit, just
+			// skip the acquisition, these are treated as glitches or aborted
+			// SPI packet transmissions and will be filtered.
+			// The second case is if the processing any bit other than
+			// the last bit in the byte. This indicates some communication
+			// interruption or logical error.
+			if (ClockIdleHigh && (bitIndex == 0))
+			{
+				AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+				return GetByteStatus::Skip;
+			}
+			else if (bitIndex < (bitsPerTransfer - 1))
+			{
+				return GetByteStatus::Error;
+			}
+		}
+
+		// Jump to the next clock phase
+		mClock.AdvanceToNextEdge();
+
+		if constexpr (ClockIdleHigh)
+		{
+			// Sample on tailing edge
+			mCurrentSample = mClock.GetSampleNumber();
+			ProcessSample(mMosi, mosi_data_ptr, &mosiBitMask, DecoderChannel::Mosi, IsBitMarkerPlaced(bitIndex, mMosiStartsFrame));
+			ProcessSample(mMiso, miso_data_ptr, &misoBitMask, DecoderChannel::Miso, IsBitMarkerPlaced(bitIndex, mMisoStartsFrame));
+
+			if (bitIndex == 0)
+			{
+				// Latch the first sample point in the byte
+				*first_sample_ptr = mCurrentSample;
+			}
+		}
+
+		if (IsBitMarkerPlaced(bitIndex, mMosiStartsFrame || mMisoStartsFrame))
+		{
+			mArrowLocations.push_back(mCurrentSample);
+		}
+	}
+
+	return GetByteStatus::OK;
+}
+
+template <class ChannelData>
+GetByteStatus AbccSpiAcquisition<ChannelData>::GetByteGeneric(U64* mosi_data_ptr, U64* miso_data_ptr, U64* first_sample_ptr)
+{
+	const U32 bitsPerTransfer = 8;
+	U64 mosiBitMask = 1ull << (bitsPerTransfer - 1);
+	U64 misoBitMask = 1ull << (bitsPerTransfer - 1);
+	GetByteStatus byteStatus = GetByteStatus::OK;
+	bool clkIdleHigh = false;
+
+	*mosi_data_ptr = 0;
+	*miso_data_ptr = 0;
+	mArrowLocations.clear();
+
+	*first_sample_ptr = mClock.GetSampleNumber();
+
+	for (U32 bitIndex = 0; bitIndex < bitsPerTransfer; bitIndex++)
+	{
+		// On every logic transition, check that "enable" doesn't change state.
+		// Note: Advancing the enable line to the next edge is not appropriate here since there may not be another edge
+
+		if (WouldAdvancingTheClockToggleEnable())
+		{
+			if (bitIndex == 0)
+			{
+				// Advance forward to next transaction
+				AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+				byteStatus = GetByteStatus::Skip;
+			}
+			else
+			{
+				// The enable state changed in the middle of acquiring a byte;
+				// this suggests we are not byte-synchronized.
+				byteStatus = GetByteStatus::Reset;
+			}
+
+			break;
+		}
+
+		if (bitIndex == 0)
+		{
+			// Determine the clock polarity to be used for the acquisition of this byte
+			clkIdleHigh = (mClock.GetBitState() == BitState::BIT_HIGH);
+		}
+
+		if (Is3WireMode())
+		{
+			// In 3-wire mode, idle condition is >=5us (during a transaction).
+			// On every advancement on clock, check for idle condition.
+			// If detected, a reset of the statemachines are need to re-sync
+			// If an idle condition is detected in the middle of receiving a
+			// byte an error status is signaled otherwise the routine can
+			// advance in the capture silently.
+			if (Is3WireIdleCondition(mClockIdleSamples))
+			{
+				if (bitIndex == 0)
+				{
+					AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+				}
+				else
+				{
+					byteStatus = GetByteStatus::Error;
+					break;
+				}
+			}
+		}
+
+		// Jump to the next clock phase
+		mClock.AdvanceToNextEdge();
+
+		if (!clkIdleHigh)
+		{
+			// Sample on leading edge
+			mCurrentSample = mClock.GetSampleNumber();
+			ProcessSample(mMosi, mosi_data_ptr, &mosiBitMask, DecoderChannel::Mosi, IsBitMarkerPlaced(bitIndex, mMosiStartsFrame));
+			ProcessSample(mMiso, miso_data_ptr, &misoBitMask, DecoderChannel::Miso, IsBitMarkerPlaced(bitIndex, mMisoStartsFrame));
+
+			if (bitIndex == 0)
+			{
+				// Latch the first sample point in the byte
+				*first_sample_ptr = mCurrentSample;
+			}
+		}
+
+		if (Is3WireMode())
+		{
+			// In 3-wire mode idle condition is >=5us (during a transaction).
+			// On every advancement on clock, check for idle condition.
+			// If detected, a reset of the statemachines are need to re-sync
+			if (Is3WireIdleCondition(mClockIdleSamples))
+			{
+				// Error: reset everything and return.
+				byteStatus = GetByteStatus::Error;
+				break;
+			}
+		}
+		else if (WouldAdvancingTheClockToggleEnable())
+		{
+			// There are two potential error cases to check for here.
+			// If in clock idle high mode, and processing the first bit, just
+			// skip the acquisition, these are treated as glitches or aborted
+			// SPI packet transmissions and will be filtered.
+			// The second case is if the processing any bit other than
+			// the last bit in the byte. This indicates some communication
+			// interruption or logical error.
+			if (clkIdleHigh && (bitIndex == 0))
+			{
+				AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+				byteStatus = GetByteStatus::Skip;
+				break;
+			}
+			else if (bitIndex < (bitsPerTransfer - 1))
+			{
+				byteStatus = GetByteStatus::Error;
+				break;
+			}
+		}
+
+		// Jump to the next clock phase
+		mClock.AdvanceToNextEdge();
+
+		if (clkIdleHigh)
+		{
+			// Sample on tailing edge
+			mCurrentSample = mClock.GetSampleNumber();
+			ProcessSample(mMosi, mosi_data_ptr, &mosiBitMask, DecoderChannel::Mosi, IsBitMarkerPlaced(bitIndex, mMosiStartsFrame));
+			ProcessSample(mMiso, miso_data_ptr, &misoBitMask, DecoderChannel::Miso, IsBitMarkerPlaced(bitIndex, mMisoStartsFrame));
+
+			if (bitIndex == 0)
+			{
+				// Latch the first sample point in the byte
+				*first_sample_ptr = mCurrentSample;
+			}
+		}
+
+		if (IsBitMarkerPlaced(bitIndex, mMosiStartsFrame || mMisoStartsFrame))
+		{
+			mArrowLocations.push_back(mCurrentSample);
+		}
+	}
+
+	if (byteStatus == GetByteStatus::OK)
+	{
+		// Add sample markers to the results
+		for (size_t bitIndex = 0; bitIndex < mArrowLocations.size(); bitIndex++)
+		{
+			mSink->AddMarker(mArrowLocations[bitIndex], DecoderMarker::UpArrow, DecoderChannel::Clock);
+		}
+	}
+
+	mSink->CommitResults();
+
+	return byteStatus;
+}
+
+template <class ChannelData>
+bool AbccSpiAcquisition<ChannelData>::HasEnableChannel()
+{
+	return (mEnable != nullptr);
+}
+
+template <class ChannelData>
+bool AbccSpiAcquisition<ChannelData>::IsEnableActive()
+{
+	if (IsPure4WireMode())
+	{
+		return (mEnable->GetBitState() == BitState::BIT_LOW);
+	}
+	else
+	{
+		return true;
+	}
+}
+
+template <class ChannelData>
+bool AbccSpiAcquisition<ChannelData>::WouldAdvancingTheClockToggleEnable()
+{
+	if (Is3WireMode())
+	{
+		return false;
+	}
+
+	if (mEnable != nullptr)
+	{
+		if (mClock.DoMoreTransitionsExistInCurrentData())
+		{
+			U64 nextEdge = mClock.GetSampleOfNextEdge();
+
+			return mEnable->WouldAdvancingToAbsPositionCauseTransition(nextEdge);
+		}
+		else
+		{
+			return mEnable->DoMoreTransitionsExistInCurrentData();
+		}
+	}
+	else
+	{
+		return false;
+	}
+}
+
+template <class ChannelData>
+template <AcquisitionWiring Wiring>
+inline bool AbccSpiAcquisition<ChannelData>::WouldAdvancingTheClockToggleEnableForWiring()
+{
+	if constexpr (Wiring == AcquisitionWiring::FourWire)
+	{
+		if (mClock.DoMoreTransitionsExistInCurrentData())
+		{
+			return mEnable->WouldAdvancingToAbsPositionCauseTransition(mClock.GetSampleOfNextEdge());
+		}
+		else
+		{
+			return mEnable->DoMoreTransitionsExistInCurrentData();
+		}
+	}
+	else
+	{
+		// Without an enable line, or with it ignored, there is nothing to toggle
+		return false;
+	}
+}
+
+template <class ChannelData>
+bool AbccSpiAcquisition<ChannelData>::IsIdleConditionDetected()
+{
+	return Is3WireMode() && Is3WireIdleCondition(mClockIdleSamples);
+}
+
+template <class ChannelData>
+U64 AbccSpiAcquisition<ChannelData>::GetCurrentSample()
+{
+	return mCurrentSample;
+}
+
+template <class ChannelData>
+U64 AbccSpiAcquisition<ChannelData>::GetClockSampleNumber()
+{
+	return mClock.GetSampleNumber();
+}
+
+template <class ChannelData>
+U64 AbccSpiAcquisition<ChannelData>::GetSampleOfNextClockEdge()
+{
+	return mClock.GetSampleOfNextEdge();
+}
+
+template <class ChannelData>
+U64 AbccSpiAcquisition<ChannelData>::GetSampleOfNextEnableEdge()
+{
+	return mEnable->GetSampleOfNextEdge();
+}
+
+template <class ChannelData>
+void AbccSpiAcquisition<ChannelData>::CheckForIdleAfterPacket()
+{
+	DecoderFrame_t errorFrame;
+	U64 markerSample = 0;
+	DecoderChannel chn = DecoderChannel::Clock;
+	bool addError = false;
+
+	if (IsPure4WireMode())
+	{
+		U64 nextSample = mEnable->GetSampleOfNextEdge();
+
+		if (nextSample <= mClock.GetSampleNumber())
+		{
+			mEnable->AdvanceToAbsPosition(mClock.GetSampleNumber());
+			nextSample = mEnable->GetSampleOfNextEdge();
+		}
+
+		if (mClock.WouldAdvancingToAbsPositionCauseTransition(nextSample))
+		{
+			U32 maxAllowedTransitions = 0;
+			U32 transitionCount;
+
+			if (mClock.GetBitState() == BitState::BIT_HIGH)
+			{
+				maxAllowedTransitions = 1;
+			}
+
+			errorFrame.mStartingSampleInclusive = mClock.GetSampleOfNextEdge();
+			transitionCount = mClock.AdvanceToAbsPosition(nextSample);
+
+			if (transitionCount > maxAllowedTransitions)
+			{
+				chn = DecoderChannel::Enable;
+				errorFrame.mEndingSampleInclusive = mEnable->GetSampleOfNextEdge();
+				markerSample = errorFrame.mEndingSampleInclusive;
+				addError = true;
+			}
+		}
+
+		AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+	}
+	else
+	{
+		// Skip idle check when m4WireOn3Channels is being used, since it is
+		// impossible to infer if the enable line had toggled or not
+		if (mConfig.f4WireOn3Channels == false)
+		{
+			if (!Is3WireIdleCondition(mIdleGapSamples))
+			{
+				chn = DecoderChannel::Clock;
+				errorFrame.mStartingSampleInclusive = mClock.GetSampleOfNextEdge();
+				AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+				errorFrame.mEndingSampleInclusive = mClock.GetSampleOfNextEdge();
+				markerSample = errorFrame.mStartingSampleInclusive + (errorFrame.mEndingSampleInclusive - errorFrame.mStartingSampleInclusive) / 2;
+				addError = true;
+			}
+		}
+	}
+
+	if (addError)
+	{
+		if ((mConfig.lClockingAlertLimit < 0) ||
+			(mClockingErrorCount < mConfig.lClockingAlertLimit))
+		{
+			mClockingErrorCount++;
+			errorFrame.mFlags = (SPI_ERROR_FLAG | DISPLAY_AS_ERROR_FLAG);
+			errorFrame.mType = AbccSpiError::EndOfTransfer;
+
+			if (mConfig.fExpandBitFrames)
+			{
+				const int minFrameSpan = 8;
+
+				if (errorFrame.mEndingSampleInclusive - errorFrame.mStartingSampleInclusive < minFrameSpan)
+				{
+					errorFrame.mEndingSampleInclusive = errorFrame.mStartingSampleInclusive + minFrameSpan;
+				}
+			}
+
+			mSink->AddFrame(errorFrame);
+			mSink->AddMarker(markerSample, DecoderMarker::ErrorSquare, chn);
+		}
+	}
+}
+
+template <class ChannelData>
+void AbccSpiAcquisition<ChannelData>::SetNextByteStartsFrame(bool mosi, bool miso)
+{
+	mMosiStartsFrame = mosi;
+	mMisoStartsFrame = miso;
+}
+
+#endif /* ABCC_SPI_ACQUISITION_H */
@@ -19,6 +19,7 @@
 #include "AbccSpiAnalyzerResults.h"
 #include "AbccSpiAnalyzerSettings.h"
 #include "AbccSpiAnalyzerLookup.h"
+#include "AbccTextBuilder.h"
 
 #include "abcc_td.h"
 #include "abcc_abp/abp.h"
@@ -275,7 +276,7 @@ static const LookupTable_t asLedStsNames[] =
 **
 *******************************************************************************/
 
-static const LookupTable_t asObjectNames[] =
+static constexpr LookupTable_t asObjectNames[] =
 {
 	/*--------------------------------------------------------------------------
 	** Anybus module objects
@@ -572,7 +573,7 @@ NcInstNameTable_t asNcInstNameTables[] =
 **
 *******************************************************************************/
 
-static const AttrLookupTable_t asObjAttrNames[] =
+static constexpr AttrLookupTable_t asObjAttrNames[] =
 {
 	{ ABP_OA_NAME,			"Name",						BaseType::Character,	NotifEvent::None },
 	{ ABP_OA_REV,			"Revision",					BaseType::Numeric,		NotifEvent::None },
@@ -586,14 +587,14 @@ static const AttrLookupTable_t asObjAttrNames[] =
 **
 *******************************************************************************/
 
-static const AttrLookupTable_t asAddObjAttrNames[] =
+static constexpr AttrLookupTable_t asAddObjAttrNames[] =
 {
 	{ ABP_ADD_OA_MAX_INST,			"Max Instance",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ADD_OA_EXT_DIAG_OVERFLOW,	"Ext Diag Overflow",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ADD_OA_STATIC_DIAG,		"Static Diag",			BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asAddInstAttrNames[] =
+static constexpr AttrLookupTable_t asAddInstAttrNames[] =
 {
 	{ ABP_ADD_IA_MODULE_NUMBER,		"Module Number",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ADD_IA_IO_TYPE,			"IO Type",			BaseType::Numeric,	NotifEvent::None },
@@ -602,7 +603,7 @@ static const AttrLookupTable_t asAddInstAttrNames[] =
 	{ ABP_ADD_IA_ERROR_TYPE,		"Error Type",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asAnbInstAttrNames[] =
+static constexpr AttrLookupTable_t asAnbInstAttrNames[] =
 {
 	{ ABP_ANB_IA_MODULE_TYPE,		"Module Type",				BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ANB_IA_FW_VERSION,		"Firmware Version",			BaseType::Numeric,	NotifEvent::None },
@@ -627,7 +628,7 @@ static const AttrLookupTable_t asAnbInstAttrNames[] =
 	{ ABP_ANB_IA_ABIP_LICENSE,		"Anybus IP License",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asAppInstAttrNames[] =
+static constexpr AttrLookupTable_t asAppInstAttrNames[] =
 {
 	{ ABP_APP_IA_CONFIGURED,	"Configured",						BaseType::Numeric,		NotifEvent::None },
 	{ ABP_APP_IA_SUP_LANG,		"Supported Languages",				BaseType::Numeric,		NotifEvent::None },
@@ -642,14 +643,14 @@ static const AttrLookupTable_t asAppInstAttrNames[] =
 	{ ABP_APP_IA_HW_VERSION,	"HW Version",						BaseType::Numeric,		NotifEvent::None },
 };
 
-static const AttrLookupTable_t asAppdObjAttrNames[] =
+static constexpr AttrLookupTable_t asAppdObjAttrNames[] =
 {
 	{ ABP_APPD_OA_NR_READ_PD_MAPPABLE_INSTANCES,	"No. of RD PD Mappable Instances",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_APPD_OA_NR_WRITE_PD_MAPPABLE_INSTANCES,	"No. of WR PD Mappable Instances",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_APPD_OA_NR_NV_INSTANCES,					"No. of Non-Volatile Instances",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asAppdInstAttrNames[] =
+static constexpr AttrLookupTable_t asAppdInstAttrNames[] =
 {
 	{ ABP_APPD_IA_NAME,			"Name",						BaseType::Character,	NotifEvent::None },
 	{ ABP_APPD_IA_DATA_TYPE,	"Data Type",				BaseType::Numeric,		NotifEvent::None },
@@ -663,13 +664,13 @@ static const AttrLookupTable_t asAppdInstAttrNames[] =
 	{ ABP_APPD_IA_ELEM_NAME,	"Element Name",				BaseType::Character,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asAsmObjAttrNames[] =
+static constexpr AttrLookupTable_t asAsmObjAttrNames[] =
 {
 	{ ABP_ASM_OA_WRITE_PD_INST_LIST,	"Write PD Instance List",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ASM_OA_READ_PD_INST_LIST,		"Read PD Instance List",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asAsmInstAttrNames[] =
+static constexpr AttrLookupTable_t asAsmInstAttrNames[] =
 {
 	{ ABP_ASM_IA_DESCRIPTOR,		"Assembly Descriptor",			BaseType::Numeric,		NotifEvent::None },
 	{ ABP_ASM_IA_ADI_MAP_XX + 0,	"ADI Map 0",					BaseType::Numeric,		NotifEvent::None },
@@ -687,7 +688,7 @@ static const AttrLookupTable_t asAsmInstAttrNames[] =
 	{ ABP_ASM_IA_MAX_NUM_ADI_MAPS,	"Max Number of ADI Mappings",	BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asBacInstAttrNames[] =
+static constexpr AttrLookupTable_t asBacInstAttrNames[] =
 {
 	{ ABP_BAC_IA_OBJECT_NAME,			"Object Name",				BaseType::Character,	NotifEvent::None },
 	{ ABP_BAC_IA_VENDOR_NAME,			"Vendor Name",				BaseType::Character,	NotifEvent::None },
@@ -700,7 +701,7 @@ static const AttrLookupTable_t asBacInstAttrNames[] =
 	{ ABP_BAC_IA_PASSWORD,				"Password",					BaseType::Character,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCclInstAttrNames[] =
+static constexpr AttrLookupTable_t asCclInstAttrNames[] =
 {
 	{ ABP_CCL_IA_VENDOR_CODE,			"Vendor Code",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_CCL_IA_SOFTWARE_VERSION,		"Software Version",		BaseType::Numeric,	NotifEvent::None },
@@ -710,7 +711,7 @@ static const AttrLookupTable_t asCclInstAttrNames[] =
 	{ ABP_CCL_IA_HOLD_CLEAR_SETTING,	"Hold Clear Setting",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCfnInstAttrNames[] =
+static constexpr AttrLookupTable_t asCfnInstAttrNames[] =
 {
 	{ ABP_CFN_IA_VENDOR_CODE,		"Vendor Code",			BaseType::Numeric,		NotifEvent::None },
 	{ ABP_CFN_IA_VENDOR_NAME,		"Vendor Name",			BaseType::Character,	NotifEvent::None },
@@ -722,7 +723,7 @@ static const AttrLookupTable_t asCfnInstAttrNames[] =
 	{ ABP_CFN_IA_ENA_SLMP_FORWARD,	"Enable SLMP Forward",	BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCipIdInstAttrNames[] =
+static constexpr AttrLookupTable_t asCipIdInstAttrNames[] =
 {
 	{ ABP_CIPID_IA_VENDOR_ID,		"Vendor ID",		BaseType::Numeric,		NotifEvent::None },
 	{ ABP_CIPID_IA_DEVICE_TYPE,		"Device Type",		BaseType::Numeric,		NotifEvent::None },
@@ -733,7 +734,7 @@ static const AttrLookupTable_t asCipIdInstAttrNames[] =
 	{ ABP_CIPID_IA_PRODUCT_NAME,	"Product Name",		BaseType::Character,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCntInstAttrNames[] =
+static constexpr AttrLookupTable_t asCntInstAttrNames[] =
 {
 	{ ABP_CNT_IA_VENDOR_ID,					"Vendor ID",						BaseType::Numeric,		NotifEvent::None },
 	{ ABP_CNT_IA_DEVICE_TYPE,				"Device Type",						BaseType::Numeric,		NotifEvent::None },
@@ -748,7 +749,7 @@ static const AttrLookupTable_t asCntInstAttrNames[] =
 	{ ABP_CNT_IA_CONFIG_INSTANCE,			"Configuration Instance",			BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCopInstAttrNames[] =
+static constexpr AttrLookupTable_t asCopInstAttrNames[] =
 {
 	{ ABP_COP_IA_VENDOR_ID,				"Vendor ID",							BaseType::Numeric,		NotifEvent::None },
 	{ ABP_COP_IA_PRODUCT_CODE,			"Product Code",							BaseType::Numeric,		NotifEvent::None },
@@ -763,12 +764,12 @@ static const AttrLookupTable_t asCopInstAttrNames[] =
 	{ ABP_COP_IA_READ_PD_BUF_INIT_VAL,	"Read PD Buffer Init Value",			BaseType::Character,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCpcObjAttrNames[] =
+static constexpr AttrLookupTable_t asCpcObjAttrNames[] =
 {
 	{ ABP_CPC_OA_MAX_INST, "Maximum Number of Instances",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCpcInstAttrNames[] =
+static constexpr AttrLookupTable_t asCpcInstAttrNames[] =
 {
 	{ ABP_CPC_IA_PORT_TYPE,					"Port Type",					BaseType::Numeric,		NotifEvent::None },
 	{ ABP_CPC_IA_PORT_NUMBER,				"Port Number",					BaseType::Numeric,		NotifEvent::None },
@@ -779,7 +780,7 @@ static const AttrLookupTable_t asCpcInstAttrNames[] =
 	{ ABP_CPC_IA_PORT_ROUTING_CAPABILITIES,	"Port Routing Capabilities",	BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asCpnInstAttrNames[] =
+static constexpr AttrLookupTable_t asCpnInstAttrNames[] =
 {
 	{ ABP_CPN_IA_VENDOR_ID,					"Vendor ID",						BaseType::Numeric,		NotifEvent::None },
 	{ ABP_CPN_IA_DEVICE_TYPE,				"Device Type",						BaseType::Numeric,		NotifEvent::None },
@@ -794,7 +795,7 @@ static const AttrLookupTable_t asCpnInstAttrNames[] =
 	{ ABP_CPN_IA_BIT_SLAVE,					"Bit Slave",						BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asDevInstAttrNames[] =
+static constexpr AttrLookupTable_t asDevInstAttrNames[] =
 {
 	{ ABP_DEV_IA_VENDOR_ID,					"Vendor ID",						BaseType::Numeric,		NotifEvent::None },
 	{ ABP_DEV_IA_DEVICE_TYPE,				"Device Type",						BaseType::Numeric,		NotifEvent::None },
@@ -816,13 +817,13 @@ static const AttrLookupTable_t asDevInstAttrNames[] =
 	{ ABP_DEV_IA_CONS_INSTANCE_LIST,		"Consuming Instance List",			BaseType::Numeric,		NotifEvent::None },
 };
 
-static const AttrLookupTable_t asDiObjAttrNames[] =
+static constexpr AttrLookupTable_t asDiObjAttrNames[] =
 {
 	{ ABP_DI_OA_MAX_INST,		"Maximum Number of Instances",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_DI_OA_SUPPORT_FUNC,	"Supported Functionality",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asDiInstAttrNames[] =
+static constexpr AttrLookupTable_t asDiInstAttrNames[] =
 {
 	{ ABP_DI_IA_SEVERITY,			"Severity",						BaseType::Numeric,	NotifEvent::None },
 	{ ABP_DI_IA_EVENT_CODE,			"Event Code",					BaseType::Numeric,	NotifEvent::None },
@@ -833,7 +834,7 @@ static const AttrLookupTable_t asDiInstAttrNames[] =
 	{ ABP_DI_IA_BIT,				"Bit",							BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asDpv1InstAttrNames[] =
+static constexpr AttrLookupTable_t asDpv1InstAttrNames[] =
 {
 	{ ABP_DPV1_IA_IDENT_NUMBER,			"Identity Number",					BaseType::Numeric,		NotifEvent::None },
 	{ ABP_DPV1_IA_PRM_DATA,				"Parameter Data",					BaseType::Numeric,		NotifEvent::None },
@@ -857,7 +858,7 @@ static const AttrLookupTable_t asDpv1InstAttrNames[] =
 	{ ABP_DPV1_IA_RESERVED,				"Reserved",							BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asEcoObjAttrNames[] =
+static constexpr AttrLookupTable_t asEcoObjAttrNames[] =
 {
 	{ ABP_ECO_OA_CURRENT_ENERGY_SAVING_MODE,		"Current Energy Saving Mode",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ECO_OA_REMAINING_TIME_TO_DEST,			"Remaining Time to Destination",		BaseType::Numeric,	NotifEvent::None },
@@ -865,7 +866,7 @@ static const AttrLookupTable_t asEcoObjAttrNames[] =
 	{ ABP_ECO_OA_TRANSITION_TO_POWER_OFF_SUPPORTED,	"Transition To Power Off Supported",	BaseType::Numeric,	NotifEvent::None },
 };
 
-static const AttrLookupTable_t asEcoInstAttrNames[] =
+static constexpr AttrLookupTable_t asEcoInstAttrNames[] =
 {
 	{ ABP_ECO_IA_MODE_ATTRIBUTES,			"Mode Attributes",					BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ECO_IA_TIME_MIN_PAUSE,			"Time Min Pause",					BaseType::Numeric,	NotifEvent::None },
@@ -880,7 +881,7 @@ static const AttrLookupTable_t asEcoInstAttrNames[] =
 	{ ABP_ECO_IA_POWER_CONSUMPTION,			"Power Consumption",				BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asEipInstAttrNames[] =
+static constexpr AttrLookupTable_t asEipInstAttrNames[] =
 {
 	{ ABP_EIP_IA_VENDOR_ID,						"Vendor ID",										BaseType::Numeric,		NotifEvent::None },
 	{ ABP_EIP_IA_DEVICE_TYPE,					"Device Type",										BaseType::Numeric,		NotifEvent::None },
@@ -915,7 +916,7 @@ static const AttrLookupTable_t asEipInstAttrNames[] =
 	{ ABP_EIP_IA_ABCC_ENABLE_CIP_SYNC,			"ABCC Enable CIP Sync",								BaseType::Numeric,		NotifEvent::None },
 };
 
-static const AttrLookupTable_t asEmeInstAttrNames[] =
+static constexpr AttrLookupTable_t asEmeInstAttrNames[] =
 {
 	{ ABP_EME_IA_VOLTAGE_PHASE_NEUTRAL,			"Voltage Phase Neutral",		BaseType::Numeric,	NotifEvent::None },
 	{ ABP_EME_IA_VOLTAGE_PHASE_NEUTRAL_MIN,		"Voltage Phase Neutral Min",	BaseType::Numeric,	NotifEvent::None },
@@ -950,7 +951,7 @@ static const AttrLookupTable_t asEmeInstAttrNames[] =
 	{ ABP_EME_IA_TOTAL_APPARENT_ENERGY,			"Total Apparent Energy",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asEplInstAttrNames[] =
+static constexpr AttrLookupTable_t asEplInstAttrNames[] =
 {
 	{ ABP_EPL_IA_VENDOR_ID,			"Vendor ID",						BaseType::Numeric,		NotifEvent::None },
 	{ ABP_EPL_IA_PRODUCT_CODE,		"Product Code",						BaseType::Numeric,		NotifEvent::None },
@@ -967,7 +968,7 @@ static const AttrLookupTable_t asEplInstAttrNames[] =
 	{ ABP_EPL_APP_SW_DATE_AND_TIME,	"Application SW Date and Time",		BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asErInstAttrNames[] =
+static constexpr AttrLookupTable_t asErInstAttrNames[] =
 {
 	{ ABP_ER_IA_ENERGY_READING,				"Energy Reading",				BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ER_IA_DIRECTION,					"Direction",					BaseType::Numeric,	NotifEvent::None },
@@ -976,7 +977,7 @@ static const AttrLookupTable_t asErInstAttrNames[] =
 	{ ABP_ER_IA_NOMINAL_POWER_CONSUMPTION,	"Nominal Power Consumption",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asEtcInstAttrNames[] =
+static constexpr AttrLookupTable_t asEtcInstAttrNames[] =
 {
 	{ ABP_ECT_IA_VENDOR_ID,				"Vendor ID",								BaseType::Numeric,		NotifEvent::None },
 	{ ABP_ECT_IA_PRODUCT_CODE,			"Product Code",								BaseType::Numeric,		NotifEvent::None },
@@ -1009,7 +1010,7 @@ static const AttrLookupTable_t asEtcInstAttrNames[] =
 	{ ABP_ECT_IA_SII_COE_DETAILS,		"SII CoE Details",							BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asEtnInstAttrNames[] =
+static constexpr AttrLookupTable_t asEtnInstAttrNames[] =
 {
 	{ ABP_ETN_IA_MAC_ADDRESS,					"MAC Address",						BaseType::Numeric,		NotifEvent::None },
 	{ ABP_ETN_IA_ENABLE_HICP,					"Enable HICP",						BaseType::Numeric,		NotifEvent::None },
@@ -1037,7 +1038,7 @@ static const AttrLookupTable_t asEtnInstAttrNames[] =
 	{ ABP_ETN_IA_ENABLE_WEBDAV,					"Enable WebDAV",					BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asFsiObjAttrNames[] =
+static constexpr AttrLookupTable_t asFsiObjAttrNames[] =
 {
 	{ ABP_FSI_OA_MAX_INST,						"Max Number of Instances",		BaseType::Numeric,	NotifEvent::None },
 	{ ABP_FSI_OA_DISABLE_VFS,					"Disable Virtual File System",	BaseType::Numeric,	NotifEvent::None },
@@ -1048,14 +1049,14 @@ static const AttrLookupTable_t asFsiObjAttrNames[] =
 	{ ABP_FSI_OA_DISC_FAULT_TOLERANCE_LEVEL,	"Disc Fault Tolerance Level",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asFsiInstAttrNames[] =
+static constexpr AttrLookupTable_t asFsiInstAttrNames[] =
 {
 	{ ABP_FSI_IA_TYPE,		"Instance Type",			BaseType::Numeric,		NotifEvent::None },
 	{ ABP_FSI_IA_FILE_SIZE,	"File Size",				BaseType::Numeric,		NotifEvent::None },
 	{ ABP_FSI_IA_PATH,		"Current Instance Path",	BaseType::Character,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asFusmInstAttrNames[] =
+static constexpr AttrLookupTable_t asFusmInstAttrNames[] =
 {
 	{ ABP_FUSM_IA_STATE,		"State",					BaseType::Numeric,		NotifEvent::None },
 	{ ABP_FUSM_IA_VENDOR_ID,	"Vendor ID",				BaseType::Numeric,		NotifEvent::None },
@@ -1072,13 +1073,13 @@ static const AttrLookupTable_t asFusmInstAttrNames[] =
 	{ ABP_FUSM_IA_VENDOR_BLK_2,	"Vendor Block Safe uC2",	BaseType::Character,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asMddObjAttrNames[] =
+static constexpr AttrLookupTable_t asMddObjAttrNames[] =
 {
 	{ ABP_MDD_OA_NUM_SLOTS,			"Number of Slots",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_MDD_OA_NUM_ADIS_PER_SLOT,	"Number of ADIs Per Slot",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asModInstAttrNames[] =
+static constexpr AttrLookupTable_t asModInstAttrNames[] =
 {
 	{ ABP_MOD_IA_VENDOR_NAME,			"Vendor Name",									BaseType::Character,	NotifEvent::None },
 	{ ABP_MOD_IA_PRODUCT_CODE,			"Product Code",									BaseType::Character,	NotifEvent::None },
@@ -1094,7 +1095,7 @@ static const AttrLookupTable_t asModInstAttrNames[] =
 	{ ABP_MOD_IA_DISABLE_DEVICE_ID_FC,	"Disable Device ID Function Code",				BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asNcInstAttrNames[] =
+static constexpr AttrLookupTable_t asNcInstAttrNames[] =
 {
 	{ ABP_NC_VAR_IA_NAME,			"Name",					BaseType::Character,	NotifEvent::None },
 	{ ABP_NC_VAR_IA_DATA_TYPE,		"Data Type",			BaseType::Numeric,		NotifEvent::None },
@@ -1104,7 +1105,7 @@ static const AttrLookupTable_t asNcInstAttrNames[] =
 	{ ABP_NC_VAR_IA_CONFIG_VALUE,	"Configured Value",		BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asNwInstAttrNames[] =
+static constexpr AttrLookupTable_t asNwInstAttrNames[] =
 {
 	{ ABP_NW_IA_NW_TYPE,		"Network Type",				BaseType::Numeric,		NotifEvent::None },
 	{ ABP_NW_IA_NW_TYPE_STR,	"Network Type String",		BaseType::Character,	NotifEvent::None },
@@ -1115,7 +1116,7 @@ static const AttrLookupTable_t asNwInstAttrNames[] =
 	{ ABP_NW_IA_EXCEPTION_INFO,	"Exception Information",	BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asNwCclInstAttrNames[] =
+static constexpr AttrLookupTable_t asNwCclInstAttrNames[] =
 {
 	{ ABP_NWCCL_IA_NETWORK_SETTINGS,	"Network Settings",				BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWCCL_IA_SYSTEM_AREA_HANDLER,	"System Area Handler",			BaseType::Numeric,	NotifEvent::None },
@@ -1125,14 +1126,14 @@ static const AttrLookupTable_t asNwCclInstAttrNames[] =
 	{ ABP_NWCCL_IA_ERROR_INFO,			"Error Information",			BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asNwCfnInstAttrNames[] =
+static constexpr AttrLookupTable_t asNwCfnInstAttrNames[] =
 {
 	{ ABP_NWCFN_IA_IO_DATA_SIZES,	"IO Data Sizes",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWCFN_IA_APP_OP_STATUS,	"Application OP Status",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWCFN_IA_SLMP_REC_LOCK,	"SLMP Reception Lock",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asNwDpv1InstAttrNames[] =
+static constexpr AttrLookupTable_t asNwDpv1InstAttrNames[] =
 {
    { ABP_DPV1_IA_IDENT_NUMBER,			"PNO Identity Number",		BaseType::Numeric,		NotifEvent::None },
    { ABP_DPV1_IA_PRM_DATA,				"Parameterization Data",	BaseType::Numeric,		NotifEvent::None },
@@ -1156,7 +1157,7 @@ static const AttrLookupTable_t asNwDpv1InstAttrNames[] =
    { ABP_DPV1_IA_RESERVED,				"Reserved",					BaseType::Numeric,		NotifEvent::Alert }
 };
 
-static const AttrLookupTable_t asNwEtnInstAttrNames[] =
+static constexpr AttrLookupTable_t asNwEtnInstAttrNames[] =
 {
 	{ ABP_NWETN_IA_MAC_ID,				"MAC Address",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWETN_IA_PORT1_MAC_ID,		"Port 1 MAC Address",	BaseType::Numeric,	NotifEvent::None },
@@ -1166,7 +1167,7 @@ static const AttrLookupTable_t asNwEtnInstAttrNames[] =
 	{ ABP_NWETN_IA_MEDIA_COUNTERS,		"Media Counters",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asNwPnioInstAttrNames[] =
+static constexpr AttrLookupTable_t asNwPnioInstAttrNames[] =
 {
 	{ ABP_NWPNIO_IA_ONLINE_TRANS,			"Number of on-line transitions",		BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWPNIO_IA_OFFLINE_TRANS,			"Number of off-line transitions",		BaseType::Numeric,	NotifEvent::None },
@@ -1181,13 +1182,13 @@ static const AttrLookupTable_t asNwPnioInstAttrNames[] =
 	{ ABP_NWPNIO_IA_PORT2_MAC_ADDRESS,		"PROFINET IO port 2 MAC address",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asMqttInstAttrNames[] =
+static constexpr AttrLookupTable_t asMqttInstAttrNames[] =
 {
 	{ ABP_MQTT_IA_MODE,			"Mode",				BaseType::Numeric,	NotifEvent::None },
 	{ APB_MQTT_IA_LAST_WILL,	"Last Will",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asOpcuaInstAttrNames[] =
+static constexpr AttrLookupTable_t asOpcuaInstAttrNames[] =
 {
 	{ ABP_OPCUA_IA_MODEL,					"Model",				BaseType::Numeric,		NotifEvent::None },
 	{ ABP_OPCUA_IA_APPLICATION_URI,			"Application URI",		BaseType::Character,	NotifEvent::None },
@@ -1198,7 +1199,7 @@ static const AttrLookupTable_t asOpcuaInstAttrNames[] =
 	{ ABP_OPCUA_IA_LIMITS,					"Limits",				BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asPnamInstAttrNames[] =
+static constexpr AttrLookupTable_t asPnamInstAttrNames[] =
 {
 	{ ABP_PNAM_IA_INFO_TYPE,		"Info Type",							BaseType::Numeric,		NotifEvent::None },
 	{ ABP_PNAM_IA_UNIQUE_ID,		"Unique ID",							BaseType::Numeric,		NotifEvent::None },
@@ -1216,7 +1217,7 @@ static const AttrLookupTable_t asPnamInstAttrNames[] =
 	{ ABP_PNAM_IA_IM_HW_REV,		"I&M Hardware Revision",				BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asPnioInstAttrNames[] =
+static constexpr AttrLookupTable_t asPnioInstAttrNames[] =
 {
 	{ ABP_PNIO_IA_DEVICE_ID,				"Device ID",						BaseType::Numeric,		NotifEvent::None },
 	{ ABP_PNIO_IA_VENDOR_ID,				"Vendor ID (I&M Manufacturer ID)",	BaseType::Numeric,		NotifEvent::None },
@@ -1249,7 +1250,7 @@ static const AttrLookupTable_t asPnioInstAttrNames[] =
 	{ ABP_PNIO_IA_S2_PRIMARY_AR_HANDLE,		"S2 Primary AR Handle",				BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asSafeInstAttrNames[] =
+static constexpr AttrLookupTable_t asSafeInstAttrNames[] =
 {
 	{ ABP_SAFE_IA_SAFETY_ENABLED,			"Safety Enabled",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_SAFE_IA_BAUD_RATE,				"Baud Rate",				BaseType::Numeric,	NotifEvent::None },
@@ -1258,14 +1259,14 @@ static const AttrLookupTable_t asSafeInstAttrNames[] =
 	{ ABP_SAFE_IA_FW_UPGRADE_IN_PROGRESS,	"FW Upgrade In Progress",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asSmtpObjAttrNames[] =
+static constexpr AttrLookupTable_t asSmtpObjAttrNames[] =
 {
 	{ ABP_SMTP_OA_MAX_INST,		"Maximum Number of Instances",	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_SMTP_OA_EMAILS_SENT,	"Emails Sent",					BaseType::Numeric,	NotifEvent::None },
 	{ ABP_SMTP_OA_EMAIL_FAILED,	"Emails Failed to Send",		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asSmtpInstAttrNames[] =
+static constexpr AttrLookupTable_t asSmtpInstAttrNames[] =
 {
 	{ ABP_SMTP_IA_FROM,		"From Address",		BaseType::Character,	NotifEvent::None },
 	{ ABP_SMTP_IA_TO,		"To Address",		BaseType::Character,	NotifEvent::None },
@@ -1273,12 +1274,12 @@ static const AttrLookupTable_t asSmtpInstAttrNames[] =
 	{ ABP_SMTP_IA_MESSAGE,	"Message Body",		BaseType::Character,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asSocObjAttrNames[] =
+static constexpr AttrLookupTable_t asSocObjAttrNames[] =
 {
 	{ ABP_SOC_OA_MAX_INST, "Maximum Number of Instances",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asSocInstAttrNames[] =
+static constexpr AttrLookupTable_t asSocInstAttrNames[] =
 {
 	{ ABP_SOC_IA_SOCK_TYPE,			"Socket Type",			BaseType::Numeric,	NotifEvent::None },
 	{ ABP_SOC_IA_LOCAL_PORT,		"Local Port",			BaseType::Numeric,	NotifEvent::None },
@@ -1296,7 +1297,7 @@ static const AttrLookupTable_t asSocInstAttrNames[] =
 	{ ABP_SOC_IA_TCP_CONNTIMEO,		"TCP Connect Timeout",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asSrc3InstAttrNames[] =
+static constexpr AttrLookupTable_t asSrc3InstAttrNames[] =
 {
 	{ ABP_SRC3_IA_COMPONENT_NAME,		"Component Name",					BaseType::Character,	NotifEvent::None },
 	{ ABP_SRC3_IA_VENDOR_CODE,			"Vendor Code",						BaseType::Numeric,		NotifEvent::None },
@@ -1307,7 +1308,7 @@ static const AttrLookupTable_t asSrc3InstAttrNames[] =
 	{ ABP_SRC3_IA_MAJOR_EVT_LATCHING,	"Major Diagnostic Event Latching",	BaseType::Numeric,		NotifEvent::None }
 };
 
-static const AttrLookupTable_t asSyncInstAttrNames[] =
+static constexpr AttrLookupTable_t asSyncInstAttrNames[] =
 {
 	{ ABP_SYNC_IA_CYCLE_TIME,			"Cycle Time",					BaseType::Numeric,	NotifEvent::None },
 	{ ABP_SYNC_IA_OUTPUT_VALID,			"Output Valid",					BaseType::Numeric,	NotifEvent::None },
@@ -1320,7 +1321,7 @@ static const AttrLookupTable_t asSyncInstAttrNames[] =
 	{ ABP_SYNC_IA_CONTROL_CYCLE_FACTOR,	"Control task cycle factor",	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const AttrLookupTable_t asTimeInstAttrNames[] =
+static constexpr AttrLookupTable_t asTimeInstAttrNames[] =
 {
 	{ ABP_TIME_IA_PROTOCOL,		"Protocol",		BaseType::Numeric,	NotifEvent::None },
 	{ ABP_TIME_IA_CURRENT_TIME,	"Current time",	BaseType::Numeric,	NotifEvent::None }
@@ -1328,7 +1329,7 @@ static const AttrLookupTable_t asTimeInstAttrNames[] =
 
 // Entries contained in this table shall be sorted by object number.
 // { Object, Num object names, Num instance names, Object names pointer, Instance names pointer } */
-AttributeNameTable_t asAttributeNameTables[] = {
+static constexpr AttributeNameTable_t asAttributeNameTables[] = {
 	{ ABP_OBJ_NUM_ANB,		0,									NUM_ENTRIES(asAnbInstAttrNames),	nullptr,			asAnbInstAttrNames },
 	{ ABP_OBJ_NUM_DI,		NUM_ENTRIES(asDiObjAttrNames),		NUM_ENTRIES(asDiInstAttrNames),		asDiObjAttrNames,	asDiInstAttrNames },
 	{ ABP_OBJ_NUM_NW,		0,									NUM_ENTRIES(asNwInstAttrNames),		nullptr,			asNwInstAttrNames },
@@ -1383,7 +1384,7 @@ AttributeNameTable_t asAttributeNameTables[] = {
 **
 *******************************************************************************/
 
-static const CmdLookupTable_t asCmdNames[] =
+static constexpr CmdLookupTable_t asCmdNames[] =
 {
 	{ ABP_CMD_GET_ATTR,			"Get_Attribute",			BaseType::Numeric,	BaseType::Numeric,		NotifEvent::None }, // NOTE: BaseType values here are not used by plugin
 	{ ABP_CMD_SET_ATTR,			"Set_Attribute",			BaseType::Numeric,	BaseType::Numeric,		NotifEvent::None }, // NOTE: BaseType values here are not used by plugin
@@ -1401,12 +1402,12 @@ static const CmdLookupTable_t asCmdNames[] =
 **
 *******************************************************************************/
 
-static const CmdLookupTable_t asAddCmdNames[] =
+static constexpr CmdLookupTable_t asAddCmdNames[] =
 {
 	{ ABP_ADD_CMD_ALARM_NOTIFICATION,	"Alarm_Notification",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::Alert }
 };
 
-static const CmdLookupTable_t asAppCmdNames[] =
+static constexpr CmdLookupTable_t asAppCmdNames[] =
 {
 	{ ABP_APP_CMD_RESET_REQUEST,		"Reset_Request",			BaseType::Numeric,	BaseType::Numeric,		NotifEvent::None },
 	{ ABP_APP_CMD_CHANGE_LANG_REQUEST,	"Change_Language_Request",	BaseType::Numeric,	BaseType::Numeric,		NotifEvent::None },
@@ -1414,7 +1415,7 @@ static const CmdLookupTable_t asAppCmdNames[] =
 	{ ABP_APP_CMD_GET_DATA_NOTIF,		"Get_Data_Notification",	BaseType::Numeric,	BaseType::Character,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asAppdCmdNames[] =
+static constexpr CmdLookupTable_t asAppdCmdNames[] =
 {
 	{ ABP_APPD_CMD_GET_INST_BY_ORDER,		"Get_Instance_Number_By_Order",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_APPD_GET_PROFILE_INST_NUMBERS,	"Get_Profile_Inst_Numbers",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
@@ -1424,13 +1425,13 @@ static const CmdLookupTable_t asAppdCmdNames[] =
 	{ ABP_APPD_GET_INSTANCE_NUMBERS,		"Get_Instance_Numbers",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asAsmCmdNames[] =
+static constexpr CmdLookupTable_t asAsmCmdNames[] =
 {
 	{ ABP_ASM_CMD_WRITE_ASSEMBLY_DATA,	"Write_Assembly_Data",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ASM_CMD_READ_ASSEMBLY_DATA,	"Read_Assembly_Data",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asBacCmdNames[] =
+static constexpr CmdLookupTable_t asBacCmdNames[] =
 {
 	{ ABP_BAC_CMD_GET_ADI_BY_BACNET_OBJ_INST,		"Get_ADI_By_BacNet_Obj_Inst",		BaseType::Numeric,		BaseType::Numeric,	NotifEvent::None },
 	{ ABP_BAC_CMD_GET_ADI_BY_BACNET_OBJ_INST_NAME,	"Get_ADI_By_BacNet_Obj_Inst_Name",	BaseType::Character,	BaseType::Numeric,	NotifEvent::None },
@@ -1438,36 +1439,36 @@ static const CmdLookupTable_t asBacCmdNames[] =
 	{ ABP_BAC_CMD_GET_BACNET_OBJ_INST_BY_ADI,		"Get_BacNet_Obj_Inst_By_ADI",		BaseType::Numeric,		BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asCclCmdNames[] =
+static constexpr CmdLookupTable_t asCclCmdNames[] =
 {
 	{ ABP_CCL_CMD_INITIAL_DATA_SETTING_NOTIFICATION,				"Initial_Data_Setting_Notification",				BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_CCL_CMD_INITIAL_DATA_PROCESSING_COMPLETED_NOTIFICATION,	"Initial_Data_Processing_Completed_Notification",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asCfnCmdNames[] =
+static constexpr CmdLookupTable_t asCfnCmdNames[] =
 {
 	{ ABP_CFN_CMD_BUF_SIZE_NOTIF,	"Buf_Size_Notif",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_CFN_CMD_SLMP_SERVER_REQ,	"SLMP_Server_Req",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asCntCmdNames[] =
+static constexpr CmdLookupTable_t asCntCmdNames[] =
 {
 	{ ABP_CNT_CMD_PROCESS_CIP_OBJ_REQUEST,	"Process_CIP_Obj_Request",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_CNT_CMD_SET_CONFIG_DATA,			"Set_Config_Data",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_CNT_CMD_GET_CONFIG_DATA,			"Get_Config_Data",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 };
 
-static const CmdLookupTable_t asCpnCmdNames[] =
+static constexpr CmdLookupTable_t asCpnCmdNames[] =
 {
 	{ ABP_CPN_CMD_PROCESS_CIP_OBJ_REQUEST,	"Process_CIP_Obj_Request",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asDevCmdNames[] =
+static constexpr CmdLookupTable_t asDevCmdNames[] =
 {
 	{ ABP_DEV_CMD_PROCESS_CIP_OBJ_REQUEST,	"Process_CIP_Obj_Request",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asDpv1CmdNames[] =
+static constexpr CmdLookupTable_t asDpv1CmdNames[] =
 {
 	{ ABP_DPV1_CMD_GET_IM_RECORD,	"Get_IM_Record",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_DPV1_CMD_SET_IM_RECORD,	"Set_IM_Record",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
@@ -1476,14 +1477,14 @@ static const CmdLookupTable_t asDpv1CmdNames[] =
 	{ ABP_DPV1_CMD_SET_RECORD,		"Set_Record",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asEcoCmdNames[] =
+static constexpr CmdLookupTable_t asEcoCmdNames[] =
 {
 	{ ABP_ECO_CMD_START_PAUSE,			"Start_Pause",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ECO_CMD_END_PAUSE,			"End_Pause",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_ECO_CMD_PREVIEW_PAUSE_TIME,	"Preview_Pause_Time",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asEctCmdNames[] =
+static constexpr CmdLookupTable_t asEctCmdNames[] =
 {
 	{ ABP_ECT_CMD_GET_OBJECT_DESC,		"Get_Object_Description",	BaseType::Numeric,	BaseType::Numeric,		NotifEvent::None },
 	{ ABP_ECT_CMD_GET_OBJECT_ACCESS,	"Get_Object_Access",		BaseType::Numeric,	BaseType::Numeric,		NotifEvent::None },
@@ -1491,7 +1492,7 @@ static const CmdLookupTable_t asEctCmdNames[] =
 	{ ABP_ECT_CMD_GET_ENUM_DATA,		"Get_Enum_Data",			BaseType::Numeric,	BaseType::Character,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asEipCmdNames[] =
+static constexpr CmdLookupTable_t asEipCmdNames[] =
 {
 	{ ABP_EIP_CMD_PROCESS_CIP_OBJ_REQUEST,		"Process_CIP_Obj_Request",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_EIP_CMD_SET_CONFIG_DATA,				"Set_Config_Data",				BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
@@ -1500,12 +1501,12 @@ static const CmdLookupTable_t asEipCmdNames[] =
 	{ ABP_EIP_CMD_PROCESS_CIP_OBJ_REQUEST_EXT,	"Process_CIP_Obj_Request_Ext",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asEmeCmdNames[] =
+static constexpr CmdLookupTable_t asEmeCmdNames[] =
 {
 	{ ABP_EME_CMD_GET_ATTRIBUTE_MEASUREMENT_LIST,	"Get_Attribute_Measurement_List",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asFsiCmdNames[] =
+static constexpr CmdLookupTable_t asFsiCmdNames[] =
 {
 	{ ABP_FSI_CMD_FILE_OPEN,			"File_Open",				BaseType::Character,	BaseType::Numeric,		NotifEvent::None },
 	{ ABP_FSI_CMD_FILE_CLOSE,			"File_Close",				BaseType::Numeric,		BaseType::Numeric,		NotifEvent::None },
@@ -1523,7 +1524,7 @@ static const CmdLookupTable_t asFsiCmdNames[] =
 	{ ABP_FSI_CMD_FORMAT_DISC,			"Format_Disc (deprecated)",	BaseType::Numeric,		BaseType::Numeric,		NotifEvent::Alert }
 };
 
-static const CmdLookupTable_t asFusmCmdNames[] =
+static constexpr CmdLookupTable_t asFusmCmdNames[] =
 {
 	{ ABP_FUSM_CMD_ERROR_CONFIRMATION,		"Error_Confirmation",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::Alert },
 	{ ABP_FUSM_CMD_SET_IO_CFG_STRING,		"Set_IO_Cfg_String",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
@@ -1531,22 +1532,22 @@ static const CmdLookupTable_t asFusmCmdNames[] =
 	{ ABP_FUSM_CMD_GET_SAFETY_INPUT_PDU,	"Get_Safety_Input_PDU",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asMddCmdNames[] =
+static constexpr CmdLookupTable_t asMddCmdNames[] =
 {
 	{ ABP_MDD_CMD_GET_LIST, "Get_List",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asModCmdNames[] =
+static constexpr CmdLookupTable_t asModCmdNames[] =
 {
 	{ ABP_MOD_CMD_PROCESS_MODBUS_MESSAGE,	"Process_Modbus_Message",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asMqttCmdNames[] =
+static constexpr CmdLookupTable_t asMqttCmdNames[] =
 {
 	{ ABP_MQTT_CMD_GET_PUBLISH_CONFIGURATION,	"Get_Publish_Configuration",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asNwCmdNames[] =
+static constexpr CmdLookupTable_t asNwCmdNames[] =
 {
 	{ ABP_NW_CMD_MAP_ADI_WRITE_AREA,		"Map_ADI_Write_Area",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NW_CMD_MAP_ADI_READ_AREA,			"Map_ADI_Read_Area",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
@@ -1554,25 +1555,25 @@ static const CmdLookupTable_t asNwCmdNames[] =
 	{ ABP_NW_CMD_MAP_ADI_READ_EXT_AREA,		"Map_ADI_Read_Ext_Area",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asNwCclCmdNames[] =
+static constexpr CmdLookupTable_t asNwCclCmdNames[] =
 {
 	{ ABP_NWCCL_CMD_MAP_ADI_SPEC_WRITE_AREA,	"Map_ADI_Spec_Write_Area",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWCCL_CMD_MAP_ADI_SPEC_READ_AREA,		"Map_ADI_Spec_Read_Area",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWCCL_CMD_CCL_CONF_TEST_MODE,			"CCL_Conf_Test_Mode",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asNwCfnCmdNames[] =
+static constexpr CmdLookupTable_t asNwCfnCmdNames[] =
 {
 	{ ABP_NWCFN_CMD_EXT_LOOPBACK,	"Ext_Loopback",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asNwDpv1CmdNames[] =
+static constexpr CmdLookupTable_t asNwDpv1CmdNames[] =
 {
 	{ ABP_NWDPV1_CMD_MAP_ADI_WRITE_AREA,	"Map_ADI_Write_Area",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWDPV1_CMD_MAP_ADI_READ_AREA,		"Map_ADI_Read_Area",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asNwPnioCmdNames[] =
+static constexpr CmdLookupTable_t asNwPnioCmdNames[] =
 {
 	{ ABP_NWPNIO_CMD_PLUG_MODULE,			"Plug_Module",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_NWPNIO_CMD_PLUG_SUB_MODULE,		"Plug_Submodule",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
@@ -1587,12 +1588,12 @@ static const CmdLookupTable_t asNwPnioCmdNames[] =
 	{ ABP_NWPNIO_CMD_IDENT_CHANGE_DONE,		"Ident_Change_Done",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asOpcuaCmdNames[] =
+static constexpr CmdLookupTable_t asOpcuaCmdNames[] =
 {
 	{ ABP_OPCUA_CMD_METHOD_CALL,	"Method_Call",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 };
 
-static const CmdLookupTable_t asPnioCmdNames[] =
+static constexpr CmdLookupTable_t asPnioCmdNames[] =
 {
 	{ ABP_PNIO_CMD_GET_RECORD,			"Get_Record",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
 	{ ABP_PNIO_CMD_SET_RECORD,			"Set_Record",			BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None },
@@ -1611,12 +1612,12 @@ static const CmdLookupTable_t asPnioCmdNames[] =
 	{ ABP_PNIO_CMD_PRM_BEGIN_IND,		"Prm_Begin_Ind",		BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-static const CmdLookupTable_t asSrc3CmdNames[] =
+static constexpr CmdLookupTable_t asSrc3CmdNames[] =
 {
 	{ ABP_SRC3_CMD_RESET_DIAGNOSTIC,	"Reset_Diagnostic",	BaseType::Numeric,	BaseType::Numeric,	NotifEvent::None }
 };
 
-CommandNameTable_t asCommandNameTables[] =
+static constexpr CommandNameTable_t asCommandNameTables[] =
 {
 	{ ABP_OBJ_NUM_ADD,		NUM_ENTRIES(asAddCmdNames),		asAddCmdNames },
 	{ ABP_OBJ_NUM_NW,		NUM_ENTRIES(asNwCmdNames),		asNwCmdNames },
@@ -1649,6 +1650,159 @@ CommandNameTable_t asCommandNameTables[] =
 	{ ABP_OBJ_NUM_SRC3,		NUM_ENTRIES(asSrc3CmdNames),	asSrc3CmdNames },
 };
 
+/*******************************************************************************
+**
+** Dense lookup indices
+**
+** Built at compile time from the object, attribute and command tables above,
+** so that a lookup is a single index instead of a scan of the tables. Each
+** index holds the position of the first table entry with that value plus one,
+** or NO_INDEX if there is none.
+**
+*******************************************************************************/
+
+#define NO_INDEX						0
+
+#define NUM_OBJECT_VALUES				256
+#define NUM_ATTRIBUTE_VALUES			256
+#define NUM_COMMAND_VALUES				( ABP_MSG_HEADER_CMD_BITS + 1 )
+
+#define NUM_ATTRIBUTE_NAME_TABLES		( sizeof(asAttributeNameTables) / sizeof(AttributeNameTable_t) )
+#define NUM_COMMAND_NAME_TABLES			( sizeof(asCommandNameTables) / sizeof(CommandNameTable_t) )
+
+typedef struct LookupIndices
+{
+	U8 abObject[NUM_OBJECT_VALUES];											// asObjectNames
+	U8 abAttributeTable[NUM_OBJECT_VALUES];									// asAttributeNameTables
+	U8 abCommandTable[NUM_OBJECT_VALUES];									// asCommandNameTables
+	U8 abCommonObjAttr[NUM_ATTRIBUTE_VALUES];								// asObjAttrNames
+	U8 abCommonCmd[NUM_COMMAND_VALUES];										// asCmdNames
+	U8 aabObjAttr[NUM_ATTRIBUTE_NAME_TABLES][NUM_ATTRIBUTE_VALUES];			// Object attributes of each object
+	U8 aabInstAttr[NUM_ATTRIBUTE_NAME_TABLES][NUM_ATTRIBUTE_VALUES];		// Instance attributes of each object
+	U8 aabObjCmd[NUM_COMMAND_NAME_TABLES][NUM_COMMAND_VALUES];				// Object specific commands of each object
+} LookupIndices_t;
+
+static_assert(NUM_ENTRIES(asObjectNames) <= 0xFF, "Object names do not fit an index");
+static_assert(NUM_ENTRIES(asObjAttrNames) <= 0xFF, "Object attribute names do not fit an index");
+static_assert(NUM_ENTRIES(asCmdNames) <= 0xFF, "Command names do not fit an index");
+static_assert(NUM_ATTRIBUTE_NAME_TABLES <= 0xFF, "Attribute name tables do not fit an index");
+static_assert(NUM_COMMAND_NAME_TABLES <= 0xFF, "Command name tables do not fit an index");
+
+template <typename T>
+static constexpr void BuildIndex(U8* index_ptr, U32 num_values, const T* table, U32 num_entries)
+{
+	// Backwards, so that the first of several entries with the same value is kept
+	for (U32 i = num_entries; i > 0; i--)
+	{
+		if (table[i - 1].value < num_values)
+		{
+			index_ptr[table[i - 1].value] = (U8)i;
+		}
+	}
+}
+
+static constexpr LookupIndices_t BuildLookupIndices()
+{
+	LookupIndices_t indices = {};
+
+	BuildIndex(indices.abObject, NUM_OBJECT_VALUES, asObjectNames, NUM_ENTRIES(asObjectNames));
+	BuildIndex(indices.abCommonObjAttr, NUM_ATTRIBUTE_VALUES, asObjAttrNames, NUM_ENTRIES(asObjAttrNames));
+	BuildIndex(indices.abCommonCmd, NUM_COMMAND_VALUES, asCmdNames, NUM_ENTRIES(asCmdNames));
+
+	for (U32 i = NUM_ATTRIBUTE_NAME_TABLES; i > 0; i--)
+	{
+		const AttributeNameTable_t& table = asAttributeNameTables[i - 1];
+
+		indices.abAttributeTable[table.object_num] = (U8)i;
+		BuildIndex(indices.aabObjAttr[i - 1], NUM_ATTRIBUTE_VALUES, table.obj_names, table.num_obj_names);
+		BuildIndex(indices.aabInstAttr[i - 1], NUM_ATTRIBUTE_VALUES, table.inst_names, table.num_inst_names);
+	}
+
+	for (U32 i = NUM_COMMAND_NAME_TABLES; i > 0; i--)
+	{
+		const CommandNameTable_t& table = asCommandNameTables[i - 1];
+
+		indices.abCommandTable[table.object_num] = (U8)i;
+		BuildIndex(indices.aabObjCmd[i - 1], NUM_COMMAND_VALUES, table.cmd_names, table.num_cmd_names);
+	}
+
+	return indices;
+}
+
+static constexpr LookupIndices_t sLookupIndices = BuildLookupIndices();
+
+/*
+** An index matches its table when every value it holds leads to an entry
+** with that value, and every entry in range is reached by its value at
+** that entry or an earlier one. This is what a scan of the table returns.
+*/
+template <typename T>
+static constexpr bool IndexMatchesTable(const U8* index, U32 num_values, const T* table, U32 num_entries)
+{
+	for (U32 i = 0; i < num_values; i++)
+	{
+		if ((index[i] != NO_INDEX) && ((index[i] > num_entries) || (table[index[i] - 1].value != i)))
+		{
+			return false;
+		}
+	}
+
+	for (U32 i = 0; i < num_entries; i++)
+	{
+		if ((table[i].value < num_values) &&
+			((index[table[i].value] == NO_INDEX) || (index[table[i].value] > i + 1)))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static constexpr bool LookupIndicesMatchTables()
+{
+	for (U32 i = 0; i < NUM_OBJECT_VALUES; i++)
+	{
+		U8 attrTable = sLookupIndices.abAttributeTable[i];
+		U8 cmdTable = sLookupIndices.abCommandTable[i];
+
+		if (((attrTable != NO_INDEX) && (asAttributeNameTables[attrTable - 1].object_num != i)) ||
+			((cmdTable != NO_INDEX) && (asCommandNameTables[cmdTable - 1].object_num != i)))
+		{
+			return false;
+		}
+	}
+
+	for (U32 i = 0; i < NUM_ATTRIBUTE_NAME_TABLES; i++)
+	{
+		const AttributeNameTable_t& table = asAttributeNameTables[i];
+
+		if ((sLookupIndices.abAttributeTable[table.object_num] > i + 1) ||
+			!IndexMatchesTable(sLookupIndices.aabObjAttr[i], NUM_ATTRIBUTE_VALUES, table.obj_names, table.num_obj_names) ||
+			!IndexMatchesTable(sLookupIndices.aabInstAttr[i], NUM_ATTRIBUTE_VALUES, table.inst_names, table.num_inst_names))
+		{
+			return false;
+		}
+	}
+
+	for (U32 i = 0; i < NUM_COMMAND_NAME_TABLES; i++)
+	{
+		const CommandNameTable_t& table = asCommandNameTables[i];
+
+		if ((sLookupIndices.abCommandTable[table.object_num] > i + 1) ||
+			!IndexMatchesTable(sLookupIndices.aabObjCmd[i], NUM_COMMAND_VALUES, table.cmd_names, table.num_cmd_names))
+		{
+			return false;
+		}
+	}
+
+	return IndexMatchesTable(sLookupIndices.abObject, NUM_OBJECT_VALUES, asObjectNames, NUM_ENTRIES(asObjectNames)) &&
+		IndexMatchesTable(sLookupIndices.abCommonObjAttr, NUM_ATTRIBUTE_VALUES, asObjAttrNames, NUM_ENTRIES(asObjAttrNames)) &&
+		IndexMatchesTable(sLookupIndices.abCommonCmd, NUM_COMMAND_VALUES, asCmdNames, NUM_ENTRIES(asCmdNames));
+}
+
+static_assert(LookupIndicesMatchTables(), "Lookup indices do not match the name tables");
+
 /*******************************************************************************
 **
 ** Common Error response lookup table
@@ -1894,12 +2048,12 @@ ErrorNameTable_t asErrorNameTables[] =
 **
 *******************************************************************************/
 
-static const LookupTable_t asNwExcptNames[] =
+static constexpr LookupTable_t asNwExcptNames[] =
 {
 	{ ABP_NW_EXCPT_INFO_NONE,	"No information",	NotifEvent::None }
 };
 
-static const LookupTable_t asNwBacExcptNames[] =
+static constexpr LookupTable_t asNwBacExcptNames[] =
 {
 	{ ABP_BAC_EXCPT_INFO_COULD_NOT_READ_OBJ_INST_AV,		"Could not read object instance AV",		NotifEvent::Alert },
 	{ ABP_BAC_EXCPT_INFO_COULD_NOT_READ_OBJ_INST_BV,		"Could not read object instance BV",		NotifEvent::Alert },
@@ -1908,23 +2062,23 @@ static const LookupTable_t asNwBacExcptNames[] =
 };
 
 /* Unused Lookup Tables
-static const LookupTable_t asNwCntExcptNames[] =
+static constexpr LookupTable_t asNwCntExcptNames[] =
 {
 	{ ABP_CNT_NW_EXCPT_INFO_INVALID_SY_INST,	"Invalid SY instance",	NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwCpnExcptNames[] =
+static constexpr LookupTable_t asNwCpnExcptNames[] =
 {
 	{ ABP_CPN_NW_EXCPT_INFO_INVALID_SY_INST,	"Invalid SY instance",	NotifEvent::Alert }
 };
 */
 
-static const LookupTable_t asNwDevExcptNames[] =
+static constexpr LookupTable_t asNwDevExcptNames[] =
 {
 	{ ABP_DEV_NW_EXCPT_INFO_INVALID_SY_INST,	"Invalid SY instance",	NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwDpv1ExcptNames[] =
+static constexpr LookupTable_t asNwDpv1ExcptNames[] =
 {
 	{ ABP_NW_EXCPT_DPV1_TOO_MUCH_DEFAULT_CFG_DATA,			"Too much default config data",					NotifEvent::Alert },
 	{ ABP_NW_EXCPT_DPV1_CFG_DATA_ATTR_TOO_BIG,				"Data attribute too big",						NotifEvent::Alert },
@@ -1941,7 +2095,7 @@ static const LookupTable_t asNwDpv1ExcptNames[] =
 	{ ABP_NW_EXCPT_DPV1_INVALID_MAP_EMPTY_SLOT,				"Invalid map empty slot",						NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwEctExcptNames[] =
+static constexpr LookupTable_t asNwEctExcptNames[] =
 {
 	{ ABP_ECT_NW_EXCPT_ILLEGAL_DATA_TYPE,								"Illegal data type",								NotifEvent::Alert },
 	{ ABP_ECT_NW_EXCPT_INSTANCE_BY_ORDER_ERROR,							"Instance by order error",							NotifEvent::Alert },
@@ -1954,7 +2108,7 @@ static const LookupTable_t asNwEctExcptNames[] =
 	{ ABP_ECT_NW_EXCPT_NO_MAC_ADDR,										"No MAC address",									NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwEipExcptNames[] =
+static constexpr LookupTable_t asNwEipExcptNames[] =
 {
 	{ ABP_EIP_NW_EXCPT_INFO_INVALID_SY_INST,		"Invalid SY Instance",			NotifEvent::Alert },
 	{ ABP_EIP_NW_EXCPT_INFO_INVALID_PROD_MAP_SIZE,	"Invalid producing map size",	NotifEvent::Alert },
@@ -1962,23 +2116,23 @@ static const LookupTable_t asNwEipExcptNames[] =
 	{ ABP_EIP_NW_EXCPT_INFO_MISSING_MAC_ADDRESS,	"Missing MAC address",			NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwEplExcptNames[] =
+static constexpr LookupTable_t asNwEplExcptNames[] =
 {
 	{ ABP_EPL_NW_EXCPT_GET_INST_NUMBERS_ERROR,		"Get instance numbers error",			NotifEvent::Alert },
 	{ ABP_EPL_NW_EXCPT_NO_MAC_ADDR,					"No MAC Address",						NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwModExcptNames[] =
+static constexpr LookupTable_t asNwModExcptNames[] =
 {
 	{ ABP_MOD_NW_EXCPT_MISSING_MAC_ADDRESS,	"Missing MAC address",	NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwCopExcptNames[] =
+static constexpr LookupTable_t asNwCopExcptNames[] =
 {
 	{ ABP_COP_NW_EXCPT_ILLEGAL_DATA_TYPE,	"Illegal Data Type",	NotifEvent::Alert }
 };
 
-static const LookupTable_t asNwPnioExcptNames[] =
+static constexpr LookupTable_t asNwPnioExcptNames[] =
 {
 	{ ABP_PNIO_NW_EXCPT_ILLEGAL_VALUE,			"Illegal value",			NotifEvent::Alert },
 	{ ABP_PNIO_NW_EXCPT_WRONG_DATA_SIZE,		"Wrong data size",			NotifEvent::Alert },
@@ -1997,7 +2151,7 @@ static const LookupTable_t asNwPnioExcptNames[] =
 **
 *******************************************************************************/
 
-static const LookupTable_t asAnbExcptNames[] =
+static constexpr LookupTable_t asAnbExcptNames[] =
 {
 	{ ABP_ANB_EXCPT_NONE,					"No exception",							NotifEvent::None },
 	{ ABP_ANB_EXCPT_APP_TO,					"Application timeout",					NotifEvent::Alert },
@@ -2022,7 +2176,7 @@ static const LookupTable_t asAnbExcptNames[] =
 **
 *******************************************************************************/
 
-static const LookupTable_t asFusmExcptNames[] =
+static constexpr LookupTable_t asFusmExcptNames[] =
 {
 	{ ABP_FUSM_EXCPT_INFO_NONE,					"None",									NotifEvent::None },
 	{ ABP_FUSM_EXCPT_INFO_BAUDRATE_NOT_SUPP,	"Baudrate not supported",				NotifEvent::Alert },
@@ -2048,7 +2202,7 @@ static const LookupTable_t asFusmExcptNames[] =
 	{ ABP_FUSM_EXCPT_INFO_SAFE_MOD_INIT_FAIL,	"Safety module initialzation failed",	NotifEvent::Alert }
 };
 
-ExceptionNameTable asExceptionNameTables[] =
+static constexpr ExceptionNameTable_t asExceptionNameTables[] =
 {
 	/* Negative reference IDs are associated with Anybus objects other than the Network object. */
 	{ -ABP_OBJ_NUM_FUSM,			1,	ABP_FUSM_IA_EXCPT_INFO,		NUM_ENTRIES(asFusmExcptNames),		asFusmExcptNames }, /* Special case for addressing FUSM Object exceptions. */
@@ -2080,12 +2234,132 @@ ExceptionNameTable asExceptionNameTables[] =
 	{ ABP_NW_TYPE_PIR_IIOT,			1,	ABP_NW_IA_EXCEPTION_INFO,	NUM_ENTRIES(asNwPnioExcptNames),	asNwPnioExcptNames }
 };
 
-static const CmdLookupTable_t* FindCmdEntryInTable(U8 cmd,
-	const CmdLookupTable_t* command_names, U8 num_commands);
+/*******************************************************************************
+**
+** Exception lookup indices
+**
+** The exception tables of each network type and of each other object are
+** chained in table order, since a reference may have tables for several
+** instances or attributes. The exception values are indexed like the names
+** above.
+**
+*******************************************************************************/
+
+#define NUM_NETWORK_TYPE_VALUES			256
+#define NUM_EXCEPTION_VALUES			256
 
-static const AttrLookupTable_t* FindAttrEntryInTable(U16 inst, U8 attr,
-	const AttrLookupTable_t* obj_names, U8 num_obj_names,
-	const AttrLookupTable_t* inst_names, U8 num_inst_names);
+#define NUM_EXCEPTION_NAME_TABLES		( sizeof(asExceptionNameTables) / sizeof(ExceptionNameTable_t) )
+
+typedef struct ExceptionIndices
+{
+	U8 abNetworkTable[NUM_NETWORK_TYPE_VALUES];							// First table of a network type
+	U8 abObjectTable[NUM_OBJECT_VALUES];								// First table of an object
+	U8 abNextTable[NUM_EXCEPTION_NAME_TABLES];							// Next table of the same network type or object
+	U8 abCommonNwExcpt[NUM_EXCEPTION_VALUES];							// asNwExcptNames
+	U8 aabExcpt[NUM_EXCEPTION_NAME_TABLES][NUM_EXCEPTION_VALUES];		// Exception names of each table
+} ExceptionIndices_t;
+
+static_assert(NUM_ENTRIES(asNwExcptNames) <= 0xFF, "Network exception names do not fit an index");
+static_assert(NUM_EXCEPTION_NAME_TABLES <= 0xFF, "Exception name tables do not fit an index");
+
+/*
+** A positive reference id is a network type, a negative one is an object
+** number in two's complement.
+*/
+static constexpr U8* GetFirstExceptionTablePtr(ExceptionIndices_t& indices, S16 ref_id)
+{
+	return (ref_id > 0) ? &indices.abNetworkTable[(U8)ref_id] :
+		(ref_id < 0) ? &indices.abObjectTable[(U8)(~ref_id + 1)] :
+		nullptr;
+}
+
+static constexpr ExceptionIndices_t BuildExceptionIndices()
+{
+	ExceptionIndices_t indices = {};
+
+	BuildIndex(indices.abCommonNwExcpt, NUM_EXCEPTION_VALUES, asNwExcptNames, NUM_ENTRIES(asNwExcptNames));
+
+	for (U32 i = NUM_EXCEPTION_NAME_TABLES; i > 0; i--)
+	{
+		const ExceptionNameTable_t& table = asExceptionNameTables[i - 1];
+		U8* firstTablePtr = GetFirstExceptionTablePtr(indices, table.ref_id);
+
+		if (firstTablePtr != nullptr)
+		{
+			indices.abNextTable[i - 1] = *firstTablePtr;
+			*firstTablePtr = (U8)i;
+		}
+
+		BuildIndex(indices.aabExcpt[i - 1], NUM_EXCEPTION_VALUES, table.excep_names, table.num_excep_names);
+	}
+
+	return indices;
+}
+
+static constexpr ExceptionIndices_t sExceptionIndices = BuildExceptionIndices();
+
+/*
+** Every chain must visit tables of its own reference in increasing order,
+** and the chains together must visit every table with a reference.
+*/
+static constexpr U32 CountExceptionTableChain(U8 first_table, S16 ref_id)
+{
+	U32 count = 0;
+	U8 previousTable = NO_INDEX;
+
+	for (U8 tableIndex = first_table; tableIndex != NO_INDEX; tableIndex = sExceptionIndices.abNextTable[tableIndex - 1])
+	{
+		if ((tableIndex <= previousTable) ||
+			(tableIndex > NUM_EXCEPTION_NAME_TABLES) ||
+			(asExceptionNameTables[tableIndex - 1].ref_id != ref_id))
+		{
+			return NUM_EXCEPTION_NAME_TABLES + 1;
+		}
+
+		previousTable = tableIndex;
+		count++;
+	}
+
+	return count;
+}
+
+static constexpr bool ExceptionIndicesMatchTables()
+{
+	U32 chainedTables = 0;
+	U32 referencedTables = 0;
+
+	for (S16 i = 1; i < 0x100; i++)
+	{
+		chainedTables += CountExceptionTableChain(sExceptionIndices.abNetworkTable[i], i);
+		chainedTables += CountExceptionTableChain(sExceptionIndices.abObjectTable[i], -i);
+	}
+
+	for (U32 i = 0; i < NUM_EXCEPTION_NAME_TABLES; i++)
+	{
+		const ExceptionNameTable_t& table = asExceptionNameTables[i];
+
+		if ((table.ref_id <= -0x100) || (table.ref_id >= 0x100) ||
+			!IndexMatchesTable(sExceptionIndices.aabExcpt[i], NUM_EXCEPTION_VALUES, table.excep_names, table.num_excep_names))
+		{
+			return false;
+		}
+
+		if (table.ref_id != 0)
+		{
+			referencedTables++;
+		}
+	}
+
+	return (chainedTables == referencedTables) &&
+		(sExceptionIndices.abNetworkTable[0] == NO_INDEX) &&
+		(sExceptionIndices.abObjectTable[0] == NO_INDEX) &&
+		IndexMatchesTable(sExceptionIndices.abCommonNwExcpt, NUM_EXCEPTION_VALUES, asNwExcptNames, NUM_ENTRIES(asNwExcptNames));
+}
+
+static_assert(ExceptionIndicesMatchTables(), "Exception indices do not match the exception tables");
+
+static const CmdLookupTable_t* FindCmdEntryInTable(U8 cmd, U8 table_index);
+static const AttrLookupTable_t* FindAttrEntryInTable(U16 inst, U8 attr, U8 table_index);
 
 static const CmdLookupTable_t* LookupCmdEntry(U8 obj, U8 cmd);
 static const AttrLookupTable_t* LookupAttrEntry(U8 obj, U16 inst, U8 attr);
@@ -2094,10 +2368,9 @@ static const AttrLookupTable_t* LookupAttrEntry(U8 obj, U16 inst, U8 attr);
 bool GetExceptionTableIndex(bool nw_object, U8 nw_type_idx, const MsgHeaderInfo_t* msg_header, U16* table_index)
 {
 	const U16 unspecifiedNetworkTypeTableIndex = 0xFFFF;
-	const U16 numEntries = sizeof(asExceptionNameTables) / sizeof(ExceptionNameTable_t);
 	const U8 exceptionAttrNum = 7;
 	U8 attribute = static_cast<U8>(msg_header->cmdExt & 0x00FF);
-	bool foundTableEntry = false;
+	U8 tableIndex;
 
 	if (nw_object && (nw_type_idx == 0))
 	{
@@ -2106,36 +2379,29 @@ bool GetExceptionTableIndex(bool nw_object, U8 nw_type_idx, const MsgHeaderInfo_
 		return (attribute == exceptionAttrNum);
 	}
 
-	// Attempt to find matching "exception names" table.
-	for (*table_index = 0; *table_index < numEntries; (*table_index)++)
+	// Attempt to find matching "exception names" table among those of the network type or object.
+	if (nw_object)
+	{
+		tableIndex = sExceptionIndices.abNetworkTable[abNetworkTypeValue[nw_type_idx]];
+	}
+	else
+	{
+		tableIndex = sExceptionIndices.abObjectTable[msg_header->obj];
+	}
+
+	for (; tableIndex != NO_INDEX; tableIndex = sExceptionIndices.abNextTable[tableIndex - 1])
 	{
-		if (nw_object && (asExceptionNameTables[*table_index].ref_id > 0))
+		if ((msg_header->inst == asExceptionNameTables[tableIndex - 1].inst) &&
+			(attribute == asExceptionNameTables[tableIndex - 1].attribute))
 		{
-			// ref_id represents a network type.
-			if ((abNetworkTypeValue[nw_type_idx] == asExceptionNameTables[*table_index].ref_id) &&
-				(msg_header->inst == asExceptionNameTables[*table_index].inst) &&
-				(attribute == asExceptionNameTables[*table_index].attribute))
-			{
-				foundTableEntry = true;
-				break;
-			}
-		}
-		else if (!nw_object && (asExceptionNameTables[*table_index].ref_id < 0))
-		{
-			// ref_id represents an object number (in 2's complement).
-			U8 objNum = (U8)(~asExceptionNameTables[*table_index].ref_id + 1);
-
-			if ((objNum == msg_header->obj) &&
-				(msg_header->inst == asExceptionNameTables[*table_index].inst) &&
-				(attribute == asExceptionNameTables[*table_index].attribute))
-			{
-				foundTableEntry = true;
-				break;
-			}
+			*table_index = tableIndex - 1;
+			return true;
 		}
 	}
 
-	return foundTableEntry;
+	*table_index = NUM_EXCEPTION_NAME_TABLES;
+
+	return false;
 }
 
 NotifEvent_t GetExceptionString(bool nw_object, U16 table_index, U8 val, char* str, U16 max_str_len, DisplayBase display_base)
@@ -2157,30 +2423,26 @@ NotifEvent_t GetExceptionString(bool nw_object, U16 table_index, U8 val, char* s
 		}
 
 		// Search for the "common" network object exception table.
-		for (exceptionEntry = 0; exceptionEntry < NUM_ENTRIES(asNwExcptNames); exceptionEntry++)
+		exceptionEntry = sExceptionIndices.abCommonNwExcpt[val];
+
+		if (exceptionEntry != NO_INDEX)
 		{
-			if (asNwExcptNames[exceptionEntry].value == val)
-			{
-				SNPRINTF(str, max_str_len, "%s", asNwExcptNames[exceptionEntry].name);
-				notification = asNwExcptNames[exceptionEntry].notification;
-				found = true;
-				break;
-			}
+			SNPRINTF(str, max_str_len, "%s", asNwExcptNames[exceptionEntry - 1].name);
+			notification = asNwExcptNames[exceptionEntry - 1].notification;
+			found = true;
 		}
 	}
 
 	if (!found)
 	{
 		// Attempt to find the exception value in the "exception names" object-specific/network-specific table.
-		for (exceptionEntry = 0; exceptionEntry < asExceptionNameTables[table_index].num_excep_names; exceptionEntry++)
+		exceptionEntry = sExceptionIndices.aabExcpt[table_index][val];
+
+		if (exceptionEntry != NO_INDEX)
 		{
-			if (asExceptionNameTables[table_index].excep_names[exceptionEntry].value == val)
-			{
-				SNPRINTF(str, max_str_len, "%s", asExceptionNameTables[table_index].excep_names[exceptionEntry].name);
-				notification = asExceptionNameTables[table_index].excep_names[exceptionEntry].notification;
-				found = true;
-				break;
-			}
+			SNPRINTF(str, max_str_len, "%s", asExceptionNameTables[table_index].excep_names[exceptionEntry - 1].name);
+			notification = asExceptionNameTables[table_index].excep_names[exceptionEntry - 1].notification;
+			found = true;
 		}
 	}
 
@@ -2204,7 +2466,7 @@ void GetNumberString(U64 number, DisplayBase display_base, U32 num_data_bits, ch
 		}
 	}
 
-	AnalyzerHelpers::GetNumberString(number, display_base, num_data_bits, result_string, result_string_max_length);
+	AbccTextBuilder(result_string, result_string_max_length).AppendNumber(number, display_base, num_data_bits);
 }
 
 NotifEvent_t GetSpiCtrlString(U8 val, char* str, U16 max_str_len, DisplayBase display_base)
@@ -2649,15 +2911,13 @@ NotifEvent_t GetNamedAttrString(
 NotifEvent_t GetObjectString(U8 val, char* str, U16 max_str_len, DisplayBase display_base)
 {
 	char numberStr[DISPLAY_NUMERIC_STRING_BUFFER_SIZE];
+	U8 entryIndex = sLookupIndices.abObject[val];
 
-	for (U8 i = 0; i < NUM_ENTRIES(asObjectNames); i++)
+	if (entryIndex != NO_INDEX)
 	{
-		if (asObjectNames[i].value == val)
-		{
-			SNPRINTF(str, max_str_len, "%s", asObjectNames[i].name);
+		SNPRINTF(str, max_str_len, "%s", asObjectNames[entryIndex - 1].name);
 
-			return asObjectNames[i].notification;
-		}
+		return asObjectNames[entryIndex - 1].notification;
 	}
 
 	GetNumberString(val, display_base, SIZE_IN_BITS(val), numberStr, sizeof(numberStr), BaseType::Numeric);
@@ -2805,92 +3065,51 @@ BaseType GetCmdBaseType(U8 obj, U8 cmd)
 	return type;
 }
 
-static const AttrLookupTable_t* FindAttrEntryInTable(
-	U16 inst, U8 attr,
-	const AttrLookupTable_t* obj_names, U8 num_obj_names,
-	const AttrLookupTable_t* inst_names, U8 num_inst_names)
+static const AttrLookupTable_t* FindAttrEntryInTable(U16 inst, U8 attr, U8 table_index)
 {
-	const AttrLookupTable_t* tablePtr = nullptr;
-	const AttrLookupTable_t* entryPtr = nullptr;
-	U8 numAttrs = 0;
+	const AttrLookupTable_t* tablePtr;
+	U8 entryIndex;
 
 	if (inst == ABP_INST_OBJ)
 	{
 		if (attr <= asObjAttrNames[NUM_ENTRIES(asObjAttrNames) - 1].value)
 		{
 			tablePtr = &asObjAttrNames[0];
-			numAttrs = NUM_ENTRIES(asObjAttrNames);
+			entryIndex = sLookupIndices.abCommonObjAttr[attr];
 		}
 		else
 		{
-			if (obj_names != nullptr)
-			{
-				tablePtr = obj_names;
-				numAttrs = num_obj_names;
-			}
+			tablePtr = asAttributeNameTables[table_index].obj_names;
+			entryIndex = sLookupIndices.aabObjAttr[table_index][attr];
 		}
 	}
 	else
 	{
-		if (num_inst_names != 0)
-		{
-			tablePtr = inst_names;
-			numAttrs = num_inst_names;
-		}
-	}
-
-	if (tablePtr != nullptr)
-	{
-		for (U8 i = 0; i < numAttrs; i++)
-		{
-			if (tablePtr[i].value == attr)
-			{
-				entryPtr = &tablePtr[i];
-				break;
-			}
-		}
+		tablePtr = asAttributeNameTables[table_index].inst_names;
+		entryIndex = sLookupIndices.aabInstAttr[table_index][attr];
 	}
 
-	return entryPtr;
+	return (entryIndex != NO_INDEX) ? &tablePtr[entryIndex - 1] : nullptr;
 }
 
 static const AttrLookupTable_t* LookupAttrEntry(U8 obj, U16 inst, U8 attr)
 {
 	const AttrLookupTable_t* entryPtr = nullptr;
+	U8 tableIndex = sLookupIndices.abAttributeTable[obj];
 
-	for (U8 i = 0; i < sizeof(asAttributeNameTables) / sizeof(AttributeNameTable_t); i++)
+	if (tableIndex != NO_INDEX)
 	{
-		if (asAttributeNameTables[i].object_num == obj)
-		{
-			entryPtr = FindAttrEntryInTable(
-				inst,
-				attr,
-				asAttributeNameTables[i].obj_names,
-				asAttributeNameTables[i].num_obj_names,
-				asAttributeNameTables[i].inst_names,
-				asAttributeNameTables[i].num_inst_names);
-
-			break;
-		}
+		entryPtr = FindAttrEntryInTable(inst, attr, tableIndex - 1);
 	}
 
 	return entryPtr;
 }
 
-static const CmdLookupTable_t* FindCmdEntryInTable(U8 cmd, const CmdLookupTable_t* command_names, U8 num_commands)
+static const CmdLookupTable_t* FindCmdEntryInTable(U8 cmd, U8 table_index)
 {
-	const CmdLookupTable_t* entryPtr = nullptr;
+	U8 entryIndex = sLookupIndices.aabObjCmd[table_index][cmd];
 
-	for (U8 i = 0; i < num_commands; i++)
-	{
-		if (command_names[i].value == cmd)
-		{
-			entryPtr = &command_names[i];
-			break;
-		}
-	}
-
-	return entryPtr;
+	return (entryIndex != NO_INDEX) ? &asCommandNameTables[table_index].cmd_names[entryIndex - 1] : nullptr;
 }
 
 static const CmdLookupTable_t* LookupCmdEntry(U8 obj, U8 cmd)
@@ -2901,28 +3120,20 @@ static const CmdLookupTable_t* LookupCmdEntry(U8 obj, U8 cmd)
 
 	if (IS_CMD_STANDARD(cmd))
 	{
-		for (U8 i = 0; i < NUM_ENTRIES(asCmdNames); i++)
+		U8 entryIndex = sLookupIndices.abCommonCmd[cmd];
+
+		if (entryIndex != NO_INDEX)
 		{
-			if (asCmdNames[i].value == cmd)
-			{
-				entryPtr = &asCmdNames[i];
-				break;
-			}
+			entryPtr = &asCmdNames[entryIndex - 1];
 		}
 	}
 	else if (IS_CMD_OBJECT_SPECIFIC(cmd))
 	{
-		for (U8 i = 0; i < sizeof(asCommandNameTables) / sizeof(CommandNameTable_t); i++)
-		{
-			if (asCommandNameTables[i].object_num == obj)
-			{
-				entryPtr = FindCmdEntryInTable(
-					cmd,
-					asCommandNameTables[i].cmd_names,
-					asCommandNameTables[i].num_cmd_names);
+		U8 tableIndex = sLookupIndices.abCommandTable[obj];
 
-				break;
-			}
+		if (tableIndex != NO_INDEX)
+		{
+			entryPtr = FindCmdEntryInTable(cmd, tableIndex - 1);
 		}
 	}
 
@@ -19,6 +19,7 @@
 #include "AbccSpiAnalyzer.h"
 #include "AbccSpiAnalyzerSettings.h"
 #include "AbccSpiAnalyzerLookup.h"
+#include "AbccTextBuilder.h"
 
 #include "abcc_td.h"
 #include "abcc_abp/abp.h"
@@ -42,6 +43,45 @@
 
 #define CSV_DELIMITER         mSettings->mExportDelimiter
 
+#define CRC_OK_STR            "OK"
+#define CRC_ERROR_STR         "CRC_ERROR"
+
+static const char* const acPacketTypeNames[] =
+{
+	"EMPTY",				/* PacketType::Empty */
+	"CMD",					/* PacketType::Command */
+	"RSP",					/* PacketType::Response */
+	"FRAGMENT",				/* PacketType::MessageFragment */
+	"ERR_RSP",				/* PacketType::ErrorResponse */
+	"PROTOCOL_ERROR",		/* PacketType::ProtocolError */
+	"PROTOCOL_EVENT",		/* PacketType::ProtocolEvent */
+	"CRC_ERROR",			/* PacketType::ChecksumError */
+	"MULTI_EVENT",			/* PacketType::MultiEvent */
+	"MULTI_EVENT_ERROR",	/* PacketType::MultiEventWithError */
+	"CANCEL"				/* PacketType::Cancel */
+};
+
+static_assert(sizeof(acPacketTypeNames) / sizeof(acPacketTypeNames[0]) == static_cast<U32>(PacketType::SizeOfEnum),
+	"acPacketTypeNames must have one entry per PacketType");
+
+static const char* const acTransactionStatusNames[] =
+{
+	"PENDING",				/* TransactionStatus::Pending */
+	"OK",					/* TransactionStatus::Complete */
+	"ERR_RSP",				/* TransactionStatus::ErrorResponse */
+	"NO_RSP",				/* TransactionStatus::NoResponse */
+	"UNEXPECTED_RSP"		/* TransactionStatus::UnexpectedResponse */
+};
+
+static_assert(sizeof(acTransactionStatusNames) / sizeof(acTransactionStatusNames[0]) == static_cast<U32>(TransactionStatus::SizeOfEnum),
+	"acTransactionStatusNames must have one entry per TransactionStatus");
+
+/* Text cache views, part of the key together with the frame and display base */
+#define TEXT_VIEW_MOSI_BUBBLE   0
+#define TEXT_VIEW_MISO_BUBBLE   1
+#define TEXT_VIEW_OTHER_BUBBLE  2
+#define TEXT_VIEW_TABULAR       3
+
 #ifdef _DEBUG
 /* Dummy macros, the old SDK does not support these */
 #define AddTabularText(...)
@@ -51,7 +91,8 @@
 SpiAnalyzerResults::SpiAnalyzerResults(SpiAnalyzer* analyzer, SpiAnalyzerSettings* settings)
 	: AnalyzerResults(),
 	  mSettings(settings),
-	  mAnalyzer(analyzer)
+	  mAnalyzer(analyzer),
+	  mRecordingText(false)
 {
 	memset(mMsgSizeStr, 0, sizeof(mMsgSizeStr));
 	memset(mMsgSrcStr, 0, sizeof(mMsgSrcStr));
@@ -69,13 +110,85 @@ SpiAnalyzerResults::~SpiAnalyzerResults()
 {
 }
 
+U32 SpiAnalyzerResults::GetSampleRate()
+{
+	return mAnalyzer->GetSampleRate();
+}
+
+U64 SpiAnalyzerResults::GetTriggerSample()
+{
+	return mAnalyzer->GetTriggerSample();
+}
+
+static const char* GetPacketTypeName(PacketType packet_type)
+{
+	return (packet_type < PacketType::SizeOfEnum) ? acPacketTypeNames[static_cast<U32>(packet_type)] : "";
+}
+
+/* Where the message field of a packet is in a fragmented message, empty if it is not fragmented */
+static const char* GetPacketFragmentName(U8 flags)
+{
+	if ((flags & (PACKET_MSG_FLAG | PACKET_FRAG_FLAG)) != (PACKET_MSG_FLAG | PACKET_FRAG_FLAG))
+	{
+		return "";
+	}
+
+	if (flags & PACKET_FIRST_FRAG_FLAG)
+	{
+		return FIRST_FRAG_STR;
+	}
+
+	return (flags & PACKET_LAST_FRAG_FLAG) ? LAST_FRAG_STR : FRAGMENT_STR;
+}
+
+static const char* GetPacketCrcName(U8 flags)
+{
+	if (!(flags & PACKET_CRC_FLAG))
+	{
+		return "";
+	}
+
+	return (flags & PACKET_CRC_ERROR_FLAG) ? CRC_ERROR_STR : CRC_OK_STR;
+}
+
+static const char* GetTransactionStatusName(TransactionStatus status)
+{
+	return (status < TransactionStatus::SizeOfEnum) ? acTransactionStatusNames[static_cast<U32>(status)] : "";
+}
+
+/* Appends a latency in samples as microseconds, with three decimals */
+static void AppendLatency(AbccTextBuilder& text, U64 latency, U32 sample_rate)
+{
+	U64 nanoseconds = (sample_rate > 0) ? (U64)((double)latency * 1e9 / sample_rate + 0.5) : 0;
+	U32 fraction = (U32)(nanoseconds % 1000);
+
+	text.AppendDecimal(nanoseconds / 1000).Append('.');
+	text.AppendRepeated('0', (fraction < 10) ? 2 : (fraction < 100) ? 1 : 0);
+	text.AppendDecimal(fraction);
+}
+
+/* Appends "tag: value", or "tag: [value]" when the value has no verbose text */
+static void AppendTagValue(AbccTextBuilder& text, const char* tag, const char* value, bool verbose)
+{
+	text.Append(tag).Append(": ", 2);
+
+	if (verbose)
+	{
+		text.Append(value);
+	}
+	else
+	{
+		text.Append('[').Append(value).Append(']');
+	}
+}
+
 void SpiAnalyzerResults::WriteBubbleText(const char* tag, const char* value, const char* verbose, NotifEvent_t notification, DisplayPriority disp_priority)
 {
 	const char alertStr[] = "!ALERT - ";
 	U16 strLenValue, strLenVerbose;
 	char str[FORMATTED_STRING_BUFFER_SIZE];
-	char pad[32] = "";
-	bool applyPad = false;
+	AbccTextBuilder text(str, sizeof(str));
+	size_t padLength = 0;
 
 	if (verbose && value)
 	{
@@ -91,26 +204,16 @@ void SpiAnalyzerResults::WriteBubbleText(const char* tag, const char* value, con
 		if (strLenVerbose <= strLenValue)
 		{
 			/* We must pad the level3 (bit states) text to maintain display priority */
-			applyPad = true;
-			memset(pad, ' ', (size_t)((strLenValue - strLenVerbose) >> 1) + 1);
+			padLength = (size_t)((strLenValue - strLenVerbose) >> 1) + 1;
 		}
 	}
 
 	if (tag)
 	{
-		if (notification == NotifEvent::Alert)
-		{
-			str[0] = '!';
-		}
-		else
-		{
-			str[0] = tag[0];
-		}
-
 		if ((notification == NotifEvent::Alert) || disp_priority == DisplayPriority::Tag)
 		{
-			str[1] = '\0';
-			AddResultString(str);
+			const char mark[2] = { (notification == NotifEvent::Alert) ? '!' : tag[0], '\0' };
+			AddBubbleString(mark);
 		}
 
 		if (disp_priority == DisplayPriority::Value)
@@ -119,61 +222,47 @@ void SpiAnalyzerResults::WriteBubbleText(const char* tag, const char* value, con
 			{
 				if (notification == NotifEvent::Alert)
 				{
-					AddResultString(alertStr, value);
+					AddBubbleString(alertStr, value);
 				}
 				else
 				{
-					AddResultString(value);
+					AddBubbleString(value);
 				}
-			}
 
-			if (verbose)
-			{
-				SNPRINTF(str, sizeof(str), "%s: %s", tag, value);
-			}
-			else
-			{
-				SNPRINTF(str, sizeof(str), "%s: [%s]", tag, value);
-			}
+				AppendTagValue(text, tag, value, (verbose != nullptr));
 
-			if (notification == NotifEvent::Alert)
-			{
-				AddResultString(alertStr, str);
-			}
-			else
-			{
-				AddResultString(str);
+				if (notification == NotifEvent::Alert)
+				{
+					AddBubbleString(alertStr, str);
+				}
+				else
+				{
+					AddBubbleString(str);
+				}
 			}
 		}
 		else
 		{
 			if (notification == NotifEvent::Alert)
 			{
-				AddResultString(alertStr, tag);
+				AddBubbleString(alertStr, tag);
 			}
 			else
 			{
-				AddResultString(tag);
+				AddBubbleString(tag);
 			}
 
 			if (value)
 			{
-				if (verbose)
-				{
-					SNPRINTF(str, sizeof(str), "%s: %s", tag, value);
-				}
-				else
-				{
-					SNPRINTF(str, sizeof(str), "%s: [%s]", tag, value);
-				}
+				AppendTagValue(text, tag, value, (verbose != nullptr));
 
 				if (notification == NotifEvent::Alert)
 				{
-					AddResultString(alertStr, str);
+					AddBubbleString(alertStr, str);
 				}
 				else
 				{
-					AddResultString(str);
+					AddBubbleString(str);
 				}
 			}
 		}
@@ -182,91 +271,253 @@ void SpiAnalyzerResults::WriteBubbleText(const char* tag, const char* value, con
 	{
 		if (value)
 		{
-			SNPRINTF(str, sizeof(str), "%s", value);
+			text.Append(value);
 
 			if (notification == NotifEvent::Alert)
 			{
-				AddResultString(alertStr, str);
+				AddBubbleString(alertStr, str);
 			}
 			else
 			{
-				AddResultString(str);
+				AddBubbleString(str);
 			}
 		}
 	}
 
 	if (verbose)
 	{
+		text.Clear();
+		text.AppendRepeated(' ', padLength);
+
 		if (tag)
 		{
-			if (applyPad)
-			{
-				SNPRINTF(str, sizeof(str), "%s%s: (%s)%s", pad, tag, verbose, pad);
-			}
-			else
-			{
-				SNPRINTF(str, sizeof(str), "%s: (%s)", tag, verbose);
-			}
+			text.Append(tag).Append(": ", 2);
 		}
-		else
+
+		text.Append('(').Append(verbose).Append(')').AppendRepeated(' ', padLength);
+		AddBubbleString(str);
+	}
+}
+
+void SpiAnalyzerResults::WriteTabularText(SpiChannel_t channel, const char* text, NotifEvent_t notification)
+{
+	/* Line prefixes by channel, without and with the alert mark */
+	static const TextPrefix_t asPrefixes[][2] =
+	{
+		{ TEXT_PREFIX(MOSI_TAG_STR), TEXT_PREFIX(MOSI_TAG_STR "!") },
+		{ TEXT_PREFIX(MISO_TAG_STR), TEXT_PREFIX(MISO_TAG_STR "!") },
+		{ TEXT_PREFIX(""), TEXT_PREFIX("!") }
+	};
+	char str[FORMATTED_STRING_BUFFER_SIZE];
+	AbccTextBuilder line(str, sizeof(str));
+	U32 prefixIndex = ((channel == SpiChannel::MOSI) || (channel == SpiChannel::MISO)) ? (U32)channel : 2;
+
+	line.Append(asPrefixes[prefixIndex][notification ? 1 : 0]).Append(text);
+	AddTabularLine(str);
+}
+
+void SpiAnalyzerResults::AddBubbleString(const char* str1, const char* str2)
+{
+	AddResultString(str1, str2);
+
+	if (mRecordingText)
+	{
+		mRecordedText.append(str1);
+
+		if (str2 != nullptr)
 		{
-			if (applyPad)
-			{
-				SNPRINTF(str, sizeof(str), "%s(%s)%s", pad, verbose, pad);
-			}
-			else
+			mRecordedText.append(str2);
+		}
+
+		mRecordedText.push_back('\0');
+	}
+}
+
+void SpiAnalyzerResults::AddTabularLine(const char* str1, const char* str2, const char* str3,
+	const char* str4, const char* str5, const char* str6)
+{
+	AddTabularText(str1, str2, str3, str4, str5, str6);
+
+	if (mRecordingText)
+	{
+		const char* strings[] = { str1, str2, str3, str4, str5, str6 };
+
+		for (const char* str : strings)
+		{
+			if (str != nullptr)
 			{
-				SNPRINTF(str, sizeof(str), "(%s)", verbose);
+				mRecordedText.append(str);
 			}
 		}
 
-		AddResultString(str);
+		mRecordedText.push_back('\0');
 	}
 }
 
-void SpiAnalyzerResults::WriteTabularText(SpiChannel_t channel, const char* text, NotifEvent_t notification)
+U64 SpiAnalyzerResults::GetTextCacheKey(U64 frame_index, U8 view, DisplayBase display_base)
 {
-	char str[FORMATTED_STRING_BUFFER_SIZE];
-	const char *prefix;
-	const char mosiPrefix[] = MOSI_TAG_STR;
-	const char misoPrefix[] = MISO_TAG_STR;
-	const char noPrefix[] = "";
+	return (frame_index << 8) | ((U64)view << 4) | ((U64)display_base & 0x0F);
+}
+
+void SpiAnalyzerResults::UpdateTextCacheSettings()
+{
+	mTextCache.SetGeneration(mSettings->mChangeID);
+	mTextCache.SetCapacity(mSettings->mTextCacheSize);
+}
 
-	if (channel == SpiChannel::MOSI)
+bool SpiAnalyzerResults::ReplayCachedText(U64 key, bool tabular)
+{
+	if (!mTextCache.Lookup(key, &mCachedText))
 	{
-		prefix = mosiPrefix;
+		return false;
 	}
-	else if (channel == SpiChannel::MISO)
+
+	for (size_t offset = 0; offset < mCachedText.size(); offset += strlen(&mCachedText[offset]) + 1)
 	{
-		prefix = misoPrefix;
+		if (tabular)
+		{
+			AddTabularText(&mCachedText[offset]);
+		}
+		else
+		{
+			AddResultString(&mCachedText[offset]);
+		}
 	}
-	else
+
+	return true;
+}
+
+bool SpiAnalyzerResults::IsFramePacketCommitted(U64 frame_index)
+{
+	// The text of a frame may refer to the other frames of its packet
+	return (GetPacketContainingFrameSequential(frame_index) != INVALID_RESULT_INDEX);
+}
+
+bool SpiAnalyzerResults::UpdatesTabularState(Frame& frame)
+{
+	// The message fields are aligned between the MOSI and MISO states
+	switch (frame.mType)
 	{
-		prefix = noPrefix;
+		case AbccMisoStates::MessageField_Size:
+		case AbccMisoStates::MessageField_SourceId:
+		case AbccMisoStates::MessageField_Object:
+		case AbccMisoStates::MessageField_Instance:
+		case AbccMisoStates::MessageField_Command:
+			return true;
+		default:
+			break;
 	}
 
-	if (notification)
+	if (IS_MOSI_FRAME(frame))
 	{
-		SNPRINTF(str, sizeof(str), "%s!%s", prefix, text);
+		return (frame.mType == AbccMosiStates::SpiControl);
 	}
-	else
+
+	return (frame.mType == AbccMisoStates::SpiStatus);
+}
+
+TextCacheStats_t SpiAnalyzerResults::GetTextCacheStats()
+{
+	TextCacheStats_t stats;
+
+	stats.lHits = mTextCache.GetHitCount();
+	stats.lMisses = mTextCache.GetMissCount();
+	stats.lEntries = mTextCache.GetCount();
+
+	return stats;
+}
+
+U64 SpiAnalyzerResults::StorePayload(const U8* data, U32 length)
+{
+	return mPayloadArena.Append(data, length);
+}
+
+AbccMessageTable& SpiAnalyzerResults::GetMessageTable()
+{
+	return mMessageTable;
+}
+
+AbccPacketDirectory& SpiAnalyzerResults::GetPacketDirectory()
+{
+	return mPacketDirectory;
+}
+
+AbccPacketSummaryTable& SpiAnalyzerResults::GetPacketSummaries()
+{
+	return mPacketSummaries;
+}
+
+AbccTransactionTable& SpiAnalyzerResults::GetTransactionTable()
+{
+	return mTransactions;
+}
+
+void SpiAnalyzerResults::GetProcessDataBlock(Frame& frame, U32 max_length, std::vector<U8>& bytes)
+{
+	U32 length = ((U64)max_length < frame.mData2) ? max_length : (U32)frame.mData2;
+
+	bytes.resize(length);
+	bytes.resize(mPayloadArena.Read(frame.mData1, bytes.data(), length));
+}
+
+/* Lists the bytes of a process data block, as many as fit in the buffer */
+void SpiAnalyzerResults::FormatProcessDataBlock(Frame& frame, DisplayBase display_base, char* buffer, size_t buffer_size)
+{
+	const TextPrefix_t ellipsis = TEXT_PREFIX(" ...");
+	char numberStr[DISPLAY_NUMERIC_STRING_BUFFER_SIZE];
+	std::vector<U8> bytes;
+	AbccTextBuilder text(buffer, buffer_size);
+
+	/* Every byte takes at least two characters */
+	GetProcessDataBlock(frame, (U32)(buffer_size / 2), bytes);
+
+	for (size_t i = 0; i < bytes.size(); i++)
 	{
-		SNPRINTF(str, sizeof(str), "%s%s", prefix, text);
+		GetNumberString(bytes[i], display_base, 8, numberStr, sizeof(numberStr), BaseType::Numeric);
+
+		size_t numberLength = strlen(numberStr);
+		size_t entryLength = numberLength + ((i > 0) ? 1 : 0);
+
+		if (text.GetLength() + entryLength + ellipsis.length + 1 > buffer_size)
+		{
+			text.Append(ellipsis);
+			return;
+		}
+
+		if (i > 0)
+		{
+			text.Append(' ');
+		}
+
+		text.Append(numberStr, numberLength);
+	}
+
+	if ((U64)bytes.size() < frame.mData2)
+	{
+		text.Append(ellipsis);
 	}
+}
+
+void SpiAnalyzerResults::WriteProcessDataBlockBubbleText(const char* tag, Frame& frame, DisplayBase display_base)
+{
+	char countStr[DISPLAY_NUMERIC_STRING_BUFFER_SIZE];
+	char bytesStr[FORMATTED_STRING_BUFFER_SIZE / 2];
 
-	AddTabularText(str);
+	AbccTextBuilder(countStr, sizeof(countStr)).AppendDecimal(frame.mData2).Append(" Bytes");
+	FormatProcessDataBlock(frame, display_base, bytesStr, sizeof(bytesStr));
+	WriteBubbleText(tag, countStr, bytesStr, NotifEvent::None, mSettings->mProcessDataPriority);
 }
 
 void SpiAnalyzerResults::FormatTabularTextBuffer(char* buffer, size_t buffer_size, const char* tag, const char* text, NotifEvent_t notification)
 {
+	AbccTextBuilder line(buffer, buffer_size);
+
 	if (notification == NotifEvent::Alert)
 	{
-		SNPRINTF(buffer, buffer_size, "!%s: %s", tag, text);
-	}
-	else
-	{
-		SNPRINTF(buffer, buffer_size, "%s: %s", tag, text);
+		line.Append('!');
 	}
+
+	line.Append(tag).Append(": ", 2).Append(text);
 }
 
 bool SpiAnalyzerResults::BuildCmdString(U8 command, U8 obj, DisplayBase display_base)
@@ -437,12 +688,12 @@ void SpiAnalyzerResults::GenerateMessageBubbleText(Frame &frame, DisplayBase dis
 
 			if (frame.HasFlag(SPI_PROTO_EVENT_FLAG))
 			{
-				SNPRINTF(verboseStr, sizeof(verboseStr), "%d Bytes, Exceeds Maximum Size of %d", (U16)frame.mData1, ABP_MAX_MSG_DATA_BYTES);
+				AbccTextBuilder(verboseStr, sizeof(verboseStr)).AppendDecimal((U16)frame.mData1).Append(" Bytes, Exceeds Maximum Size of ").AppendDecimal(ABP_MAX_MSG_DATA_BYTES);
 				notification = NotifEvent::Alert;
 			}
 			else
 			{
-				SNPRINTF(verboseStr, sizeof(verboseStr), "%d Bytes", (U16)frame.mData1);
+				AbccTextBuilder(verboseStr, sizeof(verboseStr)).AppendDecimal((U16)frame.mData1).Append(" Bytes");
 			}
 
 			WriteBubbleText(GET_MISO_FRAME_TAG(uState.eMiso), numberStr, verboseStr, notification);
@@ -536,12 +787,12 @@ void SpiAnalyzerResults::GenerateMessageBubbleText(Frame &frame, DisplayBase dis
 					if (cmdExt1 & ~validFlags)
 					{
 						notification = NotifEvent::Alert;
-						SNPRINTF(verboseStr, sizeof(verboseStr), "0x%02X | Segmentation Unknown (0x%02X)", cmdExt0, cmdExt1);
+						AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("0x").AppendHex(cmdExt0, 2).Append(" | Segmentation Unknown (0x").AppendHex(cmdExt1, 2).Append(')');
 					}
 					else if (cmdExt1 & ABP_MSG_CMDEXT1_SEG_ABORT)
 					{
 						notification = NotifEvent::Alert;
-						SNPRINTF(verboseStr, sizeof(verboseStr), "0x%02X | Segmentation Aborted", cmdExt0);
+						AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("0x").AppendHex(cmdExt0, 2).Append(" | Segmentation Aborted");
 					}
 					else if (segmentationMsg)
 					{
@@ -550,17 +801,17 @@ void SpiAnalyzerResults::GenerateMessageBubbleText(Frame &frame, DisplayBase dis
 						switch (cmdExt1)
 						{
 						case 0:
-							SNPRINTF(verboseStr, sizeof(verboseStr), "0x%02X | SEGMENT", cmdExt0);
+							AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("0x").AppendHex(cmdExt0, 2).Append(" | SEGMENT");
 							break;
 						case ABP_MSG_CMDEXT1_SEG_FIRST:
-							SNPRINTF(verboseStr, sizeof(verboseStr), "0x%02X | FIRST_SEGMENT", cmdExt0);
+							AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("0x").AppendHex(cmdExt0, 2).Append(" | FIRST_SEGMENT");
 							break;
 						case ABP_MSG_CMDEXT1_SEG_LAST:
-							SNPRINTF(verboseStr, sizeof(verboseStr), "0x%02X | LAST_SEGMENT", cmdExt0);
+							AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("0x").AppendHex(cmdExt0, 2).Append(" | LAST_SEGMENT");
 							break;
 						case (ABP_MSG_CMDEXT1_SEG_FIRST | ABP_MSG_CMDEXT1_SEG_LAST):
 						default:
-							SNPRINTF(verboseStr, sizeof(verboseStr), "0x%02X | FIRST_SEGMENT | LAST_SEGMENT", cmdExt0);
+							AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("0x").AppendHex(cmdExt0, 2).Append(" | FIRST_SEGMENT | LAST_SEGMENT");
 							break;
 						}
 					}
@@ -584,6 +835,9 @@ void SpiAnalyzerResults::GenerateMessageBubbleText(Frame &frame, DisplayBase dis
 		case AbccMisoStates::MessageField_Data:
 		{
 			MsgDataFrameData2_t* info = (MsgDataFrameData2_t*)&frame.mData2;
+			MsgHeaderInfo_t msgHeader = {};
+
+			mMessageTable.GetHeader(info->msgId, &msgHeader);
 
 			if (frame.HasFlag(SPI_PROTO_EVENT_FLAG))
 			{
@@ -607,31 +861,31 @@ void SpiAnalyzerResults::GenerateMessageBubbleText(Frame &frame, DisplayBase dis
 						nwTypeIdx = static_cast<U8>(mSettings->mNetworkType);
 					}
 
-					BuildErrorRsp(nwSpecificError, nwTypeIdx, info->msgHeader.obj, (U8)frame.mData1, display_base);
+					BuildErrorRsp(nwSpecificError, nwTypeIdx, msgHeader.obj, (U8)frame.mData1, display_base);
 				}
 			}
 			else
 			{
 				BaseType type;
 				bool exception = false;
-				bool nwObject = (info->msgHeader.obj == ABP_OBJ_NUM_NW);
-				bool attribute = IsAttributeCmd(info->msgHeader.cmd);
+				bool nwObject = (msgHeader.obj == ABP_OBJ_NUM_NW);
+				bool attribute = IsAttributeCmd(msgHeader.cmd);
 				bool firstAttributeByte = (attribute && (info->msgDataCnt == 0));
 
 				if (attribute)
 				{
-					type = GetAttrBaseType(info->msgHeader.obj, info->msgHeader.inst, (U8)info->msgHeader.cmdExt);
+					type = GetAttrBaseType(msgHeader.obj, msgHeader.inst, (U8)msgHeader.cmdExt);
 				}
 				else
 				{
-					type = GetCmdBaseType(info->msgHeader.obj, info->msgHeader.cmd);
+					type = GetCmdBaseType(msgHeader.obj, msgHeader.cmd);
 				}
 
 				if (IS_MISO_FRAME(frame) && firstAttributeByte)
 				{
 					U16 tableIndex;
 
-					if (GetExceptionTableIndex(nwObject, (U8)mSettings->mNetworkType, &info->msgHeader, &tableIndex))
+					if (GetExceptionTableIndex(nwObject, (U8)mSettings->mNetworkType, &msgHeader, &tableIndex))
 					{
 						notification = GetExceptionString(nwObject, tableIndex, (U8)frame.mData1, verboseStr, sizeof(verboseStr), display_base);
 						exception = true;
@@ -653,7 +907,7 @@ void SpiAnalyzerResults::GenerateMessageBubbleText(Frame &frame, DisplayBase dis
 				}
 				else
 				{
-					SNPRINTF(verboseStr, sizeof(verboseStr), " [%s] Byte #%d ", numberStr, info->msgDataCnt);
+					AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append(" [").Append(numberStr).Append("] Byte #").AppendDecimal(info->msgDataCnt).Append(' ');
 
 					if (mSettings->mMsgDataPriority == DisplayPriority::Value)
 					{
@@ -749,8 +1003,14 @@ void SpiAnalyzerResults::GenerateMisoBubbleText(Frame &frame, DisplayBase displa
 
 		case AbccMisoStates::ReadProcessData:
 		{
+			if (frame.HasFlag(SPI_PD_BLOCK_FLAG))
+			{
+				WriteProcessDataBlockBubbleText(GET_MISO_FRAME_TAG(uState.eMiso), frame, display_base);
+				break;
+			}
+
 			GetNumberString(frame.mData1, display_base, GET_MISO_FRAME_BITSIZE(uState.eMiso), numberStr, sizeof(numberStr), BaseType::Numeric);
-			SNPRINTF(verboseStr, sizeof(verboseStr), " [%s] Byte #%lld ", numberStr, frame.mData2);
+			AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append(" [").Append(numberStr).Append("] Byte #").AppendDecimal(frame.mData2).Append(' ');
 
 			if (mSettings->mProcessDataPriority == DisplayPriority::Value)
 			{
@@ -772,12 +1032,12 @@ void SpiAnalyzerResults::GenerateMisoBubbleText(Frame &frame, DisplayBase displa
 
 			if (frame.HasFlag(SPI_PROTO_EVENT_FLAG) && frame.HasFlag(DISPLAY_AS_ERROR_FLAG))
 			{
-				SNPRINTF(verboseStr, sizeof(verboseStr), "ERROR - Received 0x%08X != Calculated 0x%08X", (U32)(frame.mData1), (U32)(frame.mData2));
+				AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("ERROR - Received 0x").AppendHex((U32)frame.mData1, 8).Append(" != Calculated 0x").AppendHex((U32)frame.mData2, 8);
 				notification = NotifEvent::Alert;
 			}
 			else
 			{
-				SNPRINTF(verboseStr, sizeof(verboseStr), "Received 0x%08X == Calculated 0x%08X", (U32)(frame.mData1), (U32)(frame.mData2));
+				AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("Received 0x").AppendHex((U32)frame.mData1, 8).Append(" == Calculated 0x").AppendHex((U32)frame.mData2, 8);
 			}
 
 			WriteBubbleText(GET_MISO_FRAME_TAG(uState.eMiso), numberStr, verboseStr, notification);
@@ -826,13 +1086,13 @@ void SpiAnalyzerResults::GenerateMosiBubbleText(Frame &frame, DisplayBase displa
 
 		case AbccMosiStates::MessageLength:
 			GetNumberString(frame.mData1, display_base, GET_MOSI_FRAME_BITSIZE(uState.eMosi), numberStr, sizeof(numberStr), BaseType::Numeric);
-			SNPRINTF(verboseStr, sizeof(verboseStr), "%d Words", (U16)frame.mData1);
+			AbccTextBuilder(verboseStr, sizeof(verboseStr)).AppendDecimal((U16)frame.mData1).Append(" Words");
 			WriteBubbleText(GET_MOSI_FRAME_TAG(uState.eMosi), numberStr, verboseStr, notification);
 			break;
 
 		case AbccMosiStates::ProcessDataLength:
 			GetNumberString(frame.mData1, display_base, GET_MOSI_FRAME_BITSIZE(uState.eMosi), numberStr, sizeof(numberStr), BaseType::Numeric);
-			SNPRINTF(verboseStr, sizeof(verboseStr), "%d Words", (U16)frame.mData1);
+			AbccTextBuilder(verboseStr, sizeof(verboseStr)).AppendDecimal((U16)frame.mData1).Append(" Words");
 			WriteBubbleText(GET_MOSI_FRAME_TAG(uState.eMosi), numberStr, verboseStr, notification);
 			break;
 
@@ -864,8 +1124,14 @@ void SpiAnalyzerResults::GenerateMosiBubbleText(Frame &frame, DisplayBase displa
 
 		case AbccMosiStates::WriteProcessData:
 		{
+			if (frame.HasFlag(SPI_PD_BLOCK_FLAG))
+			{
+				WriteProcessDataBlockBubbleText(GET_MOSI_FRAME_TAG(uState.eMosi), frame, display_base);
+				break;
+			}
+
 			GetNumberString(frame.mData1, display_base, GET_MOSI_FRAME_BITSIZE(uState.eMosi), numberStr, sizeof(numberStr), BaseType::Numeric);
-			SNPRINTF(verboseStr, sizeof(verboseStr), " [%s] Byte #%lld ", numberStr, frame.mData2);
+			AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append(" [").Append(numberStr).Append("] Byte #").AppendDecimal(frame.mData2).Append(' ');
 
 			if (mSettings->mProcessDataPriority == DisplayPriority::Value)
 			{
@@ -887,12 +1153,12 @@ void SpiAnalyzerResults::GenerateMosiBubbleText(Frame &frame, DisplayBase displa
 
 			if (frame.HasFlag(SPI_PROTO_EVENT_FLAG) && frame.HasFlag(DISPLAY_AS_ERROR_FLAG))
 			{
-				SNPRINTF(verboseStr, sizeof(verboseStr), "ERROR - Received 0x%08X != Calculated 0x%08X", (U32)(frame.mData1 & 0xFFFFFFFF), (U32)(frame.mData2 & 0xFFFFFFFF));
+				AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("ERROR - Received 0x").AppendHex((U32)frame.mData1, 8).Append(" != Calculated 0x").AppendHex((U32)frame.mData2, 8);
 				notification = NotifEvent::Alert;
 			}
 			else
 			{
-				SNPRINTF(verboseStr, sizeof(verboseStr), "Received 0x%08X == Calculated 0x%08X", (U32)(frame.mData1 & 0xFFFFFFFF), (U32)(frame.mData2 & 0xFFFFFFFF));
+				AbccTextBuilder(verboseStr, sizeof(verboseStr)).Append("Received 0x").AppendHex((U32)frame.mData1, 8).Append(" == Calculated 0x").AppendHex((U32)frame.mData2, 8);
 			}
 
 			WriteBubbleText(GET_MOSI_FRAME_TAG(uState.eMosi), numberStr, verboseStr, notification);
@@ -924,11 +1190,46 @@ void SpiAnalyzerResults::GenerateMosiBubbleText(Frame &frame, DisplayBase displa
 
 void SpiAnalyzerResults::GenerateBubbleText(U64 frame_index, Channel &channel, DisplayBase display_base)
 {
+	U8 view;
+
+	if (channel == mSettings->mMosiChannel)
+	{
+		view = TEXT_VIEW_MOSI_BUBBLE;
+	}
+	else if (channel == mSettings->mMisoChannel)
+	{
+		view = TEXT_VIEW_MISO_BUBBLE;
+	}
+	else
+	{
+		view = TEXT_VIEW_OTHER_BUBBLE;
+	}
+
+	U64 key = GetTextCacheKey(frame_index, view, display_base);
+
 	ClearResultStrings();
+	UpdateTextCacheSettings();
+
+	if (ReplayCachedText(key, false))
+	{
+		return;
+	}
+
 	Frame frame = GetFrame(frame_index);
-	AbccSpiStatesUnion_t uState;
-	uState.eMosi = (AbccMosiStates::Enum)frame.mType;
 
+	mRecordedText.clear();
+	mRecordingText = true;
+	WriteFrameBubbleText(frame, channel, display_base);
+	mRecordingText = false;
+
+	if (IsFramePacketCommitted(frame_index))
+	{
+		mTextCache.Insert(key, mRecordedText);
+	}
+}
+
+void SpiAnalyzerResults::WriteFrameBubbleText(Frame& frame, Channel& channel, DisplayBase display_base)
+{
 	if (frame.HasFlag(SPI_ERROR_FLAG))
 	{
 		NotifEvent_t notification = NotifEvent::Alert;
@@ -974,9 +1275,10 @@ void SpiAnalyzerResults::ExportAllFramesToFile(const char* file, DisplayBase dis
 	std::stringstream ss;
 	void *f = AnalyzerHelpers::StartFile(file);
 
-	U64 triggerSample = mAnalyzer->GetTriggerSample();
-	U32 sampleRate = mAnalyzer->GetSampleRate();
+	U64 triggerSample = GetTriggerSample();
+	U32 sampleRate = GetSampleRate();
 	U64 numFrames = GetNumFrames();
+	std::vector<U8> pdBytes;
 
 	ss << "Channel" + CSV_DELIMITER +
 		  "Time [s]" + CSV_DELIMITER +
@@ -1009,7 +1311,10 @@ void SpiAnalyzerResults::ExportAllFramesToFile(const char* file, DisplayBase dis
 				ss << MISO_STR;
 			}
 
-			AnalyzerHelpers::GetNumberString(frame.mData1, display_base, GET_MOSI_FRAME_BITSIZE(frame.mType), frameDataStr, sizeof(frameDataStr));
+			if (!frame.HasFlag(SPI_PD_BLOCK_FLAG))
+			{
+				AnalyzerHelpers::GetNumberString(frame.mData1, display_base, GET_MOSI_FRAME_BITSIZE(frame.mType), frameDataStr, sizeof(frameDataStr));
+			}
 		}
 
 		ss << CSV_DELIMITER << timestampStr;
@@ -1051,7 +1356,21 @@ void SpiAnalyzerResults::ExportAllFramesToFile(const char* file, DisplayBase dis
 			}
 		}
 
-		ss << CSV_DELIMITER << frameDataStr << std::endl;
+		ss << CSV_DELIMITER << frameDataStr;
+
+		if (frame.HasFlag(SPI_PD_BLOCK_FLAG) && !frame.HasFlag(SPI_ERROR_FLAG))
+		{
+			/* All bytes of a process data block, space separated */
+			GetProcessDataBlock(frame, (U32)frame.mData2, pdBytes);
+
+			for (size_t byteIndex = 0; byteIndex < pdBytes.size(); byteIndex++)
+			{
+				AnalyzerHelpers::GetNumberString(pdBytes[byteIndex], display_base, 8, frameDataStr, sizeof(frameDataStr));
+				ss << ((byteIndex > 0) ? " " : "") << frameDataStr;
+			}
+		}
+
+		ss << std::endl;
 
 		AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), (U32)ss.str().length(), f);
 		ss.str(std::string());
@@ -1358,6 +1677,9 @@ void SpiAnalyzerResults::BufferCsvMessageMsgEntry(
 	case AbccMisoStates::MessageField:
 	{
 		MsgDataFrameData2_t* info = (MsgDataFrameData2_t*)&frame.mData2;
+		MsgHeaderInfo_t msgHeader = {};
+
+		mMessageTable.GetHeader(info->msgId, &msgHeader);
 
 		if (frame.HasFlag(SPI_PROTO_EVENT_FLAG))
 		{
@@ -1382,7 +1704,7 @@ void SpiAnalyzerResults::BufferCsvMessageMsgEntry(
 					nwTypeIdx = static_cast<U8>(mSettings->mNetworkType);
 				}
 
-				GetErrorRspString(nwSpecificError, nwTypeIdx, info->msgHeader.obj, (U8)frame.mData1, dataStr, sizeof(dataStr), display_base);
+				GetErrorRspString(nwSpecificError, nwTypeIdx, msgHeader.obj, (U8)frame.mData1, dataStr, sizeof(dataStr), display_base);
 
 				// Explicitly set display_base to ASCII to ensure proper escaping
 				// is performed when calling AppendCsvSafeString().
@@ -1393,24 +1715,24 @@ void SpiAnalyzerResults::BufferCsvMessageMsgEntry(
 		{
 			BaseType type;
 			bool exception = false;
-			bool attribute = IsAttributeCmd(info->msgHeader.cmd);
+			bool attribute = IsAttributeCmd(msgHeader.cmd);
 			bool firstAttributeByte = (attribute && (info->msgDataCnt == 0));
 
 			if (attribute)
 			{
-				type = GetAttrBaseType(info->msgHeader.obj, info->msgHeader.inst, (U8)info->msgHeader.cmdExt);
+				type = GetAttrBaseType(msgHeader.obj, msgHeader.inst, (U8)msgHeader.cmdExt);
 			}
 			else
 			{
-				type = GetCmdBaseType(info->msgHeader.obj, info->msgHeader.cmd);
+				type = GetCmdBaseType(msgHeader.obj, msgHeader.cmd);
 			}
 
 			if (IS_MISO_FRAME(frame) && firstAttributeByte)
 			{
-				bool nwObject = (info->msgHeader.obj == ABP_OBJ_NUM_NW);
+				bool nwObject = (msgHeader.obj == ABP_OBJ_NUM_NW);
 				U16 tableIndex;
 
-				if (GetExceptionTableIndex(nwObject, (U8)mSettings->mNetworkType, &info->msgHeader, &tableIndex))
+				if (GetExceptionTableIndex(nwObject, (U8)mSettings->mNetworkType, &msgHeader, &tableIndex))
 				{
 					GetExceptionString(nwObject, tableIndex, (U8)frame.mData1, dataStr, sizeof(dataStr), display_base);
 
@@ -1675,8 +1997,8 @@ void SpiAnalyzerResults::ExportMessageDataToFile(const char *file, DisplayBase d
 	bool misoPreviousFragState = false;
 	void* f = AnalyzerHelpers::StartFile(file);
 
-	U64 triggerSample = mAnalyzer->GetTriggerSample();
-	U32 sampleRate = mAnalyzer->GetSampleRate();
+	U64 triggerSample = GetTriggerSample();
+	U32 sampleRate = GetSampleRate();
 	U64 numFrames = GetNumFrames();
 	U64 i = 0;
 
@@ -1833,11 +2155,12 @@ void SpiAnalyzerResults::ExportProcessDataToFile(const char* file, DisplayBase d
 	std::stringstream ssMosiTail;
 	std::stringstream ssMisoTail;
 	std::stringstream ssSharedBody;
+	std::vector<U8> pdBytes;
 	void* f = AnalyzerHelpers::StartFile(file);
 	bool addCsvHeader = true;
 
-	U64 triggerSample = mAnalyzer->GetTriggerSample();
-	U32 sampleRate = mAnalyzer->GetSampleRate();
+	U64 triggerSample = GetTriggerSample();
+	U32 sampleRate = GetSampleRate();
 	U64 numFrames = GetNumFrames();
 	U64 i = 0;
 
@@ -1921,6 +2244,19 @@ void SpiAnalyzerResults::ExportProcessDataToFile(const char* file, DisplayBase d
 					}
 					case AbccMosiStates::WriteProcessData:
 					{
+						if (frame.HasFlag(SPI_PD_BLOCK_FLAG))
+						{
+							GetProcessDataBlock(frame, (U32)frame.mData2, pdBytes);
+
+							for (U8 pdByte : pdBytes)
+							{
+								GetNumberString(pdByte, display_base, GET_MOSI_FRAME_BITSIZE(frame.mType), dataStr, sizeof(dataStr), BaseType::Numeric);
+								ssMosiTail << CSV_DELIMITER << dataStr;
+							}
+
+							break;
+						}
+
 						GetNumberString(frame.mData1, display_base, GET_MOSI_FRAME_BITSIZE(frame.mType), dataStr, sizeof(dataStr), BaseType::Numeric);
 						ssMosiTail << CSV_DELIMITER << dataStr;
 						break;
@@ -1976,6 +2312,19 @@ void SpiAnalyzerResults::ExportProcessDataToFile(const char* file, DisplayBase d
 					}
 					case AbccMisoStates::ReadProcessData:
 					{
+						if (frame.HasFlag(SPI_PD_BLOCK_FLAG))
+						{
+							GetProcessDataBlock(frame, (U32)frame.mData2, pdBytes);
+
+							for (U8 pdByte : pdBytes)
+							{
+								GetNumberString(pdByte, display_base, GET_MISO_FRAME_BITSIZE(frame.mType), dataStr, sizeof(dataStr), BaseType::Numeric);
+								ssMisoTail << CSV_DELIMITER << dataStr;
+							}
+
+							break;
+						}
+
 						GetNumberString(frame.mData1, display_base, GET_MISO_FRAME_BITSIZE(frame.mType), dataStr, sizeof(dataStr), BaseType::Numeric);
 						ssMisoTail << CSV_DELIMITER << dataStr;
 						break;
@@ -2053,6 +2402,264 @@ void SpiAnalyzerResults::ExportProcessDataToFile(const char* file, DisplayBase d
 	AnalyzerHelpers::EndFile(f);
 }
 
+/*
+** One line per packet, written from the packet summary table alone
+*/
+void SpiAnalyzerResults::ExportPacketsToFile(const char* file, DisplayBase display_base)
+{
+	const PacketChannelSummary_t* apsChannels[NUM_DATA_CHANNELS];
+	std::stringstream ss;
+	void* f = AnalyzerHelpers::StartFile(file);
+
+	U64 triggerSample = GetTriggerSample();
+	U32 sampleRate = GetSampleRate();
+	U64 numPackets = mPacketSummaries.GetPacketCount();
+
+	ss << "Packet ID" + CSV_DELIMITER +
+		  "Start Time [s]" + CSV_DELIMITER +
+		  "End Time [s]" + CSV_DELIMITER +
+		  "MOSI Type" + CSV_DELIMITER +
+		  "MOSI Object" + CSV_DELIMITER +
+		  "MOSI Instance" + CSV_DELIMITER +
+		  "MOSI Command" + CSV_DELIMITER +
+		  "MOSI Fragment" + CSV_DELIMITER +
+		  "MOSI CRC" + CSV_DELIMITER +
+		  "MISO Type" + CSV_DELIMITER +
+		  "MISO Object" + CSV_DELIMITER +
+		  "MISO Instance" + CSV_DELIMITER +
+		  "MISO Command" + CSV_DELIMITER +
+		  "MISO Fragment" + CSV_DELIMITER +
+		  "MISO CRC" + CSV_DELIMITER +
+		  "Anybus State" + CSV_DELIMITER +
+		  "Application State"
+	   << std::endl;
+
+	AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), (U32)ss.str().length(), f);
+	ss.str(std::string());
+
+	for (U64 i = 0; i < numPackets; i++)
+	{
+		PacketSummary_t summary;
+		char timeStr[DISPLAY_NUMERIC_STRING_BUFFER_SIZE];
+		char dataStr[FORMATTED_STRING_BUFFER_SIZE];
+
+		if (!mPacketSummaries.Get(i, &summary))
+		{
+			break;
+		}
+
+		apsChannels[SpiChannel::MOSI] = &summary.sMosi;
+		apsChannels[SpiChannel::MISO] = &summary.sMiso;
+
+		ss << i;
+		AnalyzerHelpers::GetTimeString(summary.lFirstSample, triggerSample, sampleRate, timeStr, sizeof(timeStr));
+		ss << CSV_DELIMITER << timeStr;
+		AnalyzerHelpers::GetTimeString(summary.lLastSample, triggerSample, sampleRate, timeStr, sizeof(timeStr));
+		ss << CSV_DELIMITER << timeStr;
+
+		for (U32 channel = SpiChannel::MOSI; channel <= SpiChannel::MISO; channel++)
+		{
+			const PacketChannelSummary_t& channelSummary = *apsChannels[channel];
+
+			ss << CSV_DELIMITER << GetPacketTypeName(channelSummary.ePacketType);
+
+			if (channelSummary.bFlags & PACKET_MSG_FLAG)
+			{
+				GetObjectString(channelSummary.sMsgHeader.obj, dataStr, sizeof(dataStr), display_base);
+				ss << CSV_DELIMITER << dataStr;
+				GetNumberString(channelSummary.sMsgHeader.inst, display_base, SIZE_IN_BITS(channelSummary.sMsgHeader.inst), dataStr, sizeof(dataStr), BaseType::Numeric);
+				ss << CSV_DELIMITER << dataStr;
+				GetCmdString(channelSummary.sMsgHeader.cmd, channelSummary.sMsgHeader.obj, dataStr, sizeof(dataStr), display_base);
+				ss << CSV_DELIMITER << dataStr;
+			}
+			else
+			{
+				ss << CSV_DELIMITER + CSV_DELIMITER + CSV_DELIMITER;
+			}
+
+			ss << CSV_DELIMITER << GetPacketFragmentName(channelSummary.bFlags);
+			ss << CSV_DELIMITER << GetPacketCrcName(channelSummary.bFlags);
+		}
+
+		ss << CSV_DELIMITER;
+
+		if (summary.sMiso.bFlags & PACKET_STATUS_FLAG)
+		{
+			GetAbccStatusString(summary.sMiso.bStatus, dataStr, sizeof(dataStr), display_base);
+			ss << dataStr;
+		}
+
+		ss << CSV_DELIMITER;
+
+		if (summary.sMosi.bFlags & PACKET_STATUS_FLAG)
+		{
+			GetApplStsString(summary.sMosi.bStatus, dataStr, sizeof(dataStr), display_base);
+			ss << dataStr;
+		}
+
+		ss << std::endl;
+
+		AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), (U32)ss.str().length(), f);
+		ss.str(std::string());
+
+		if (UpdateExportProgressAndCheckForCancel(i, numPackets) == true)
+		{
+			AnalyzerHelpers::EndFile(f);
+			return;
+		}
+	}
+
+	UpdateExportProgressAndCheckForCancel(numPackets, numPackets);
+	AnalyzerHelpers::EndFile(f);
+}
+
+/*
+** One line per transaction, in the order the commands were completed. A
+** response that no command was waiting for has a line of its own.
+*/
+void SpiAnalyzerResults::ExportTransactionsToFile(const char* file, DisplayBase display_base)
+{
+	std::stringstream ss;
+	void* f = AnalyzerHelpers::StartFile(file);
+
+	U64 triggerSample = GetTriggerSample();
+	U32 sampleRate = GetSampleRate();
+	U64 numTransactions = mTransactions.GetTransactionCount();
+
+	ss << "Transaction ID" + CSV_DELIMITER +
+		  "Status" + CSV_DELIMITER +
+		  "Command Channel" + CSV_DELIMITER +
+		  "Source ID" + CSV_DELIMITER +
+		  "Object" + CSV_DELIMITER +
+		  "Instance" + CSV_DELIMITER +
+		  "Command" + CSV_DELIMITER +
+		  "Command Start [s]" + CSV_DELIMITER +
+		  "Command End [s]" + CSV_DELIMITER +
+		  "Response Start [s]" + CSV_DELIMITER +
+		  "Response End [s]" + CSV_DELIMITER +
+		  "Latency [us]"
+	   << std::endl;
+
+	AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), (U32)ss.str().length(), f);
+	ss.str(std::string());
+
+	for (U64 i = 0; i < numTransactions; i++)
+	{
+		AbccTransaction_t transaction;
+		U64 latency;
+		char timeStr[DISPLAY_NUMERIC_STRING_BUFFER_SIZE];
+		char dataStr[FORMATTED_STRING_BUFFER_SIZE];
+		S64 alSamples[4];
+
+		if (!mTransactions.Get(i, &transaction))
+		{
+			break;
+		}
+
+		ss << i << CSV_DELIMITER << GetTransactionStatusName(transaction.eStatus);
+		ss << CSV_DELIMITER << ((transaction.eCommandChannel == SpiChannel::MOSI) ? MOSI_STR : MISO_STR);
+		GetNumberString(transaction.bSourceId, display_base, SIZE_IN_BITS(transaction.bSourceId), dataStr, sizeof(dataStr), BaseType::Numeric);
+		ss << CSV_DELIMITER << dataStr;
+		GetObjectString(transaction.sHeader.obj, dataStr, sizeof(dataStr), display_base);
+		ss << CSV_DELIMITER << dataStr;
+		GetNumberString(transaction.sHeader.inst, display_base, SIZE_IN_BITS(transaction.sHeader.inst), dataStr, sizeof(dataStr), BaseType::Numeric);
+		ss << CSV_DELIMITER << dataStr;
+		GetCmdString(transaction.sHeader.cmd, transaction.sHeader.obj, dataStr, sizeof(dataStr), display_base);
+		ss << CSV_DELIMITER << dataStr;
+
+		alSamples[0] = transaction.lCommandFirstSample;
+		alSamples[1] = transaction.lCommandLastSample;
+		alSamples[2] = transaction.lResponseFirstSample;
+		alSamples[3] = transaction.lResponseLastSample;
+
+		for (U32 j = 0; j < 4; j++)
+		{
+			ss << CSV_DELIMITER;
+
+			if (alSamples[j] != TRANSACTION_SAMPLE_NONE)
+			{
+				AnalyzerHelpers::GetTimeString(alSamples[j], triggerSample, sampleRate, timeStr, sizeof(timeStr));
+				ss << timeStr;
+			}
+		}
+
+		ss << CSV_DELIMITER;
+
+		if (AbccTransactionTable::GetLatency(transaction, &latency))
+		{
+			AbccTextBuilder text(dataStr, sizeof(dataStr));
+
+			AppendLatency(text, latency, sampleRate);
+			ss << text.GetString();
+		}
+
+		ss << std::endl;
+
+		AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), (U32)ss.str().length(), f);
+		ss.str(std::string());
+
+		if (UpdateExportProgressAndCheckForCancel(i, numTransactions) == true)
+		{
+			AnalyzerHelpers::EndFile(f);
+			return;
+		}
+	}
+
+	UpdateExportProgressAndCheckForCancel(numTransactions, numTransactions);
+	AnalyzerHelpers::EndFile(f);
+}
+
+/*
+** One line per object and command that received a response, from the
+** transaction table's latency histograms
+*/
+void SpiAnalyzerResults::ExportResponseLatencyToFile(const char* file, DisplayBase display_base)
+{
+	std::vector<TransactionLatencyStats_t> stats;
+	std::stringstream ss;
+	void* f = AnalyzerHelpers::StartFile(file);
+
+	U32 sampleRate = GetSampleRate();
+
+	mTransactions.GetLatencyStats(&stats);
+
+	ss << "Object" + CSV_DELIMITER +
+		  "Command" + CSV_DELIMITER +
+		  "Responses" + CSV_DELIMITER +
+		  "p50 [us]" + CSV_DELIMITER +
+		  "p99 [us]" + CSV_DELIMITER +
+		  "Max [us]"
+	   << std::endl;
+
+	for (size_t i = 0; i < stats.size(); i++)
+	{
+		char dataStr[FORMATTED_STRING_BUFFER_SIZE];
+		char latencyStr[FORMATTED_STRING_BUFFER_SIZE];
+		AbccTextBuilder text(latencyStr, sizeof(latencyStr));
+
+		GetObjectString(stats[i].bObject, dataStr, sizeof(dataStr), display_base);
+		ss << dataStr;
+		GetCmdString(stats[i].bCommand, stats[i].bObject, dataStr, sizeof(dataStr), display_base);
+		ss << CSV_DELIMITER << dataStr;
+		ss << CSV_DELIMITER << stats[i].lCount;
+
+		AppendLatency(text, stats[i].lP50, sampleRate);
+		ss << CSV_DELIMITER << text.GetString();
+		text.Clear();
+		AppendLatency(text, stats[i].lP99, sampleRate);
+		ss << CSV_DELIMITER << text.GetString();
+		text.Clear();
+		AppendLatency(text, stats[i].lMax, sampleRate);
+		ss << CSV_DELIMITER << text.GetString();
+
+		ss << std::endl;
+	}
+
+	AnalyzerHelpers::AppendToFile((U8*)ss.str().c_str(), (U32)ss.str().length(), f);
+	UpdateExportProgressAndCheckForCancel(1, 1);
+	AnalyzerHelpers::EndFile(f);
+}
+
 void SpiAnalyzerResults::GenerateExportFile(const char* file, DisplayBase display_base, U32 export_type_user_id)
 {
 	switch (static_cast<ExportType>(export_type_user_id))
@@ -2069,6 +2676,18 @@ void SpiAnalyzerResults::GenerateExportFile(const char* file, DisplayBase displa
 		/* Export 'valid' process data */
 		ExportProcessDataToFile(file, display_base);
 		break;
+	case ExportType::Packets:
+		/* Export the packet summaries */
+		ExportPacketsToFile(file, display_base);
+		break;
+	case ExportType::Transactions:
+		/* Export the commands paired with their responses */
+		ExportTransactionsToFile(file, display_base);
+		break;
+	case ExportType::ResponseLatency:
+		/* Export the response latency per object and command */
+		ExportResponseLatencyToFile(file, display_base);
+		break;
 	default:
 		break;
 	}
@@ -2080,23 +2699,34 @@ U64 SpiAnalyzerResults::GetFrameIdOfAbccFieldContainedInPacket(U64 packet_index,
 	U64 firstFrameIndex;
 	U64 lastFrameIndex;
 
-	if (packet_index != INVALID_RESULT_INDEX)
+	if ((packet_index == INVALID_RESULT_INDEX) ||
+		((channel != SpiChannel::MOSI) && (channel != SpiChannel::MISO)))
+	{
+		return INVALID_RESULT_INDEX;
+	}
+
+	if (mPacketDirectory.Find(packet_index, (channel == SpiChannel::MOSI), type, &frameIndex))
+	{
+		return frameIndex;
+	}
+
+	// Packets not yet in the directory, and fields it could not record, are searched for
+	GetFramesContainedInPacket(packet_index, &firstFrameIndex, &lastFrameIndex);
+
+	if ((firstFrameIndex != INVALID_RESULT_INDEX) && (lastFrameIndex != INVALID_RESULT_INDEX))
 	{
-		GetFramesContainedInPacket(packet_index, &firstFrameIndex, &lastFrameIndex);
-		if ((firstFrameIndex != INVALID_RESULT_INDEX) && (lastFrameIndex != INVALID_RESULT_INDEX))
+		for (U64 i = firstFrameIndex; i <= lastFrameIndex; i++)
 		{
-			for (frameIndex = firstFrameIndex; frameIndex <= lastFrameIndex; frameIndex++)
+			Frame frame = GetFrame(i);
+
+			if ((frame.mType == type) && ((channel == SpiChannel::MOSI) == IS_MOSI_FRAME(frame)))
 			{
-				Frame frame = GetFrame(frameIndex);
-				if (((channel == SpiChannel::MOSI) && IS_MOSI_FRAME(frame) && (frame.mType == type)) ||
-					((channel == SpiChannel::MISO) && IS_MISO_FRAME(frame) && (frame.mType == type)))
-				{
-					break;
-				}
+				return i;
 			}
 		}
 	}
-	return frameIndex;
+
+	return INVALID_RESULT_INDEX;
 }
 
 void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame &frame, DisplayBase display_base)
@@ -2119,14 +2749,14 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 			}
 			else
 			{
+				AbccTextBuilder text(mMsgSizeStr[channel], sizeof(mMsgSizeStr[channel]));
+
 				if (sizeError)
 				{
-					SNPRINTF(mMsgSizeStr[channel], sizeof(mMsgSizeStr[channel]), "!Size: %u Bytes", (U16)frame.mData1);
-				}
-				else
-				{
-					SNPRINTF(mMsgSizeStr[channel], sizeof(mMsgSizeStr[channel]), "Size: %u Bytes", (U16)frame.mData1);
+					text.Append('!');
 				}
+
+				text.Append("Size: ").AppendDecimal((U16)frame.mData1).Append(" Bytes");
 			}
 
 			break;
@@ -2134,28 +2764,31 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 
 		case AbccMisoStates::MessageField_SourceId:
 		{
-			SNPRINTF(mMsgSrcStr[channel], sizeof(mMsgSrcStr[channel]), "Source ID: %d (0x%02X)", (U8)frame.mData1, (U8)frame.mData1);
+			AbccTextBuilder(mMsgSrcStr[channel], sizeof(mMsgSrcStr[channel]))
+				.Append("Source ID: ").AppendDecimal((U8)frame.mData1).Append(" (0x").AppendHex((U8)frame.mData1, 2).Append(')');
 			break;
 		}
 
 		case AbccMisoStates::MessageField_Object:
 		{
+			AbccTextBuilder text(mMsgObjStr[channel], sizeof(mMsgObjStr[channel]));
+
 			if (mSettings->mMessageIndexingVerbosityLevel == MessageIndexing::Detailed)
 			{
-				NotifEvent_t notification = GetObjectString((U8)frame.mData1, str, sizeof(str), display_base);
+				// The name is looked up straight into the line, the alert mark
+				// in front of it is dropped again when it is not needed
+				text.Append("!Object: ");
+				NotifEvent_t notification = GetObjectString((U8)frame.mData1, text.GetTail(), (U16)text.GetTailSize(), display_base);
+				text.CommitTail();
 
-				if (notification == NotifEvent::Alert)
-				{
-					SNPRINTF(mMsgObjStr[channel], sizeof(mMsgObjStr[channel]), "!Object: %s", str);
-				}
-				else
+				if (notification != NotifEvent::Alert)
 				{
-					SNPRINTF(mMsgObjStr[channel], sizeof(mMsgObjStr[channel]), "Object: %s", str);
+					text.RemovePrefix(1);
 				}
 			}
 			else if (mSettings->mMessageIndexingVerbosityLevel == MessageIndexing::Compact)
 			{
-				SNPRINTF(mMsgObjStr[channel], sizeof(mMsgObjStr[channel]), "Obj {%02X:", (U8)frame.mData1);
+				text.Append("Obj {").AppendHex((U8)frame.mData1, 2).Append(':');
 			}
 
 			break;
@@ -2163,29 +2796,33 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 
 		case AbccMisoStates::MessageField_Instance:
 		{
+			AbccTextBuilder text(mMsgInstStr[channel], sizeof(mMsgInstStr[channel]));
+
 			if (mSettings->mMessageIndexingVerbosityLevel == MessageIndexing::Detailed)
 			{
 				bool found = false;
 				NotifEvent_t notification = NotifEvent::None;
-				found = GetInstString((U8)mSettings->mNetworkType, (U8)frame.mData2, (U16)frame.mData1, str, sizeof(str), &notification, display_base);
 
-				if (!found)
-				{
-					SNPRINTF(str, sizeof(str), "%d (0x%04X)", (U16)frame.mData1, (U16)frame.mData1);
-				}
+				text.Append("!Instance: ");
+				found = GetInstString((U8)mSettings->mNetworkType, (U8)frame.mData2, (U16)frame.mData1, text.GetTail(), (U16)text.GetTailSize(), &notification, display_base);
 
-				if (notification)
+				if (found)
 				{
-					SNPRINTF(mMsgInstStr[channel], sizeof(mMsgInstStr[channel]), "!Instance: %s", str);
+					text.CommitTail();
 				}
 				else
 				{
-					SNPRINTF(mMsgInstStr[channel], sizeof(mMsgInstStr[channel]), "Instance: %s", str);
+					text.AppendDecimal((U16)frame.mData1).Append(" (0x").AppendHex((U16)frame.mData1, 4).Append(')');
+				}
+
+				if (!notification)
+				{
+					text.RemovePrefix(1);
 				}
 			}
 			else if (mSettings->mMessageIndexingVerbosityLevel == MessageIndexing::Compact)
 			{
-				SNPRINTF(mMsgInstStr[channel], sizeof(mMsgInstStr[channel]), "%04Xh}", (U16)frame.mData1);
+				text.AppendHex((U16)frame.mData1, 4).Append("h}");
 			}
 
 			break;
@@ -2195,43 +2832,39 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 		{
 			mMsgErrorRspFlag[channel] = ((frame.mData1 & ABP_MSG_HEADER_E_BIT) != 0);
 
+			AbccTextBuilder text(mMsgCmdStr[channel], sizeof(mMsgCmdStr[channel]));
+
 			if (mSettings->mMessageIndexingVerbosityLevel == MessageIndexing::Detailed)
 			{
-				NotifEvent_t notification = GetCmdString((U8)frame.mData1, (U8)frame.mData2, str, sizeof(str), display_base);
-
-				if ((mMsgErrorRspFlag[channel] == true) || (notification == NotifEvent::Alert))
+				if ((U8)frame.mData1 & ABP_MSG_HEADER_C_BIT)
 				{
-					if ((U8)frame.mData1 & ABP_MSG_HEADER_C_BIT)
-					{
-						SNPRINTF(mMsgCmdStr[channel], sizeof(mMsgCmdStr[channel]), "!Command: %s", str);
-					}
-					else
-					{
-						SNPRINTF(mMsgCmdStr[channel], sizeof(mMsgCmdStr[channel]), "!Response: %s", str);
-					}
+					text.Append("!Command: ");
 				}
 				else
 				{
-					if ((U8)frame.mData1 & ABP_MSG_HEADER_C_BIT)
-					{
-						SNPRINTF(mMsgCmdStr[channel], sizeof(mMsgCmdStr[channel]), "Command: %s", str);
-					}
-					else
-					{
-						SNPRINTF(mMsgCmdStr[channel], sizeof(mMsgCmdStr[channel]), "Response: %s", str);
-					}
+					text.Append("!Response: ");
+				}
+
+				NotifEvent_t notification = GetCmdString((U8)frame.mData1, (U8)frame.mData2, text.GetTail(), (U16)text.GetTailSize(), display_base);
+				text.CommitTail();
+
+				if ((mMsgErrorRspFlag[channel] == false) && (notification != NotifEvent::Alert))
+				{
+					text.RemovePrefix(1);
 				}
 			}
 			else if (mSettings->mMessageIndexingVerbosityLevel == MessageIndexing::Compact)
 			{
 				if ((U8)frame.mData1 & ABP_MSG_HEADER_C_BIT)
 				{
-					SNPRINTF(mMsgCmdStr[channel], sizeof(mMsgCmdStr[channel]), ", Cmd {%02X:", (U8)(frame.mData1 & ABP_MSG_HEADER_CMD_BITS));
+					text.Append(", Cmd {");
 				}
 				else
 				{
-					SNPRINTF(mMsgCmdStr[channel], sizeof(mMsgCmdStr[channel]), ", Rsp {%02X:", (U8)(frame.mData1 & ABP_MSG_HEADER_CMD_BITS));
+					text.Append(", Rsp {");
 				}
+
+				text.AppendHex((U8)(frame.mData1 & ABP_MSG_HEADER_CMD_BITS), 2).Append(':');
 			}
 
 			break;
@@ -2250,7 +2883,7 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 					const char mosiMsgBanner[] = "-----MOSI MESSAGE-----";
 					const char* msgBanner = (channel == SpiChannel::MISO) ? misoMsgBanner : mosiMsgBanner;
 
-					AddTabularText(msgBanner);
+					AddTabularLine(msgBanner);
 				}
 
 				if (mSettings->mMessageSrcIdIndexing)
@@ -2262,30 +2895,33 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 				{
 					NotifEvent_t notification = NotifEvent::None;
 					MsgHeaderInfo_t* psMsgHdr = reinterpret_cast<MsgHeaderInfo_t*>(&frame.mData2);
+					AbccTextBuilder text(mMsgExtStr[channel], sizeof(mMsgExtStr[channel]));
 					bool found = false;
 
+					text.Append("!Extension: ");
+
 					if (IsIndexedAttributeCmd(psMsgHdr->cmd))
 					{
-						found = GetAttrString(psMsgHdr->obj, psMsgHdr->inst, cmdExt, str, sizeof(str), AttributeAccessMode::Indexed, &notification, display_base);
+						found = GetAttrString(psMsgHdr->obj, psMsgHdr->inst, cmdExt, text.GetTail(), (U16)text.GetTailSize(), AttributeAccessMode::Indexed, &notification, display_base);
 					}
 					else if (IsNonIndexedAttributeCmd(psMsgHdr->cmd))
 					{
-						found = GetAttrString(psMsgHdr->obj, psMsgHdr->inst, cmdExt, str, sizeof(str), AttributeAccessMode::Normal, &notification, display_base);
+						found = GetAttrString(psMsgHdr->obj, psMsgHdr->inst, cmdExt, text.GetTail(), (U16)text.GetTailSize(), AttributeAccessMode::Normal, &notification, display_base);
 					}
 
-					if (!found)
+					if (found)
 					{
-						/* For consistency with Source ID and Instance, only use hex format */
-						SNPRINTF(str, sizeof(str), "%d (0x%04X)", cmdExt, cmdExt);
+						text.CommitTail();
 					}
-
-					if (notification == NotifEvent::Alert)
+					else
 					{
-						SNPRINTF(mMsgExtStr[channel], sizeof(mMsgExtStr[channel]), "!Extension: %s", str);
+						/* For consistency with Source ID and Instance, only use hex format */
+						text.AppendDecimal(cmdExt).Append(" (0x").AppendHex(cmdExt, 4).Append(')');
 					}
-					else
+
+					if (notification != NotifEvent::Alert)
 					{
-						SNPRINTF(mMsgExtStr[channel], sizeof(mMsgExtStr[channel]), "Extension: %s", str);
+						text.RemovePrefix(1);
 					}
 
 					WriteTabularText(channel, mMsgSizeStr[channel], NotifEvent::None);
@@ -2319,12 +2955,12 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 						if (cmdExt1 & ~validFlags)
 						{
 							notification = NotifEvent::Alert;
-							SNPRINTF(str, sizeof(str), "Segmentation Unknown (0x%02X).", cmdExt1);
+							AbccTextBuilder(str, sizeof(str)).Append("Segmentation Unknown (0x").AppendHex(cmdExt1, 2).Append(").");
 						}
 						else if (cmdExt1 & ABP_MSG_CMDEXT1_SEG_ABORT)
 						{
 							notification = NotifEvent::Alert;
-							SNPRINTF(str, sizeof(str), "%s", "Segmentation Aborted.");
+							AbccTextBuilder(str, sizeof(str)).Append("Segmentation Aborted.");
 						}
 						else if (segmentationMsg)
 						{
@@ -2333,13 +2969,13 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 							switch (cmdExt1)
 							{
 							case 0:
-								SNPRINTF(str, sizeof(str), "%s", "Segment; More Follow.");
+								AbccTextBuilder(str, sizeof(str)).Append("Segment; More Follow.");
 								break;
 							case ABP_MSG_CMDEXT1_SEG_FIRST:
-								SNPRINTF(str, sizeof(str), "%s", "First Segment; More Follow.");
+								AbccTextBuilder(str, sizeof(str)).Append("First Segment; More Follow.");
 								break;
 							case ABP_MSG_CMDEXT1_SEG_LAST:
-								SNPRINTF(str, sizeof(str), "%s", "Last Segment.");
+								AbccTextBuilder(str, sizeof(str)).Append("Last Segment.");
 								break;
 							case (ABP_MSG_CMDEXT1_SEG_FIRST | ABP_MSG_CMDEXT1_SEG_LAST):
 							default:
@@ -2369,11 +3005,11 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 					const char mosiTag[] = MOSI_TAG_STR;
 					const char* tag = (channel == SpiChannel::MISO) ? misoTag : mosiTag;
 
-					SNPRINTF(mMsgExtStr[channel], sizeof(mMsgExtStr[channel]), "%04Xh}", cmdExt);
+					AbccTextBuilder(mMsgExtStr[channel], sizeof(mMsgExtStr[channel])).AppendHex(cmdExt, 4).Append("h}");
 
 					if (mMsgErrorRspFlag[channel])
 					{
-						AddTabularText(tag, "!",
+						AddTabularLine(tag, "!",
 							mMsgObjStr[channel],
 							mMsgInstStr[channel],
 							mMsgCmdStr[channel],
@@ -2383,7 +3019,7 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 					{
 						if (frame.HasFlag(SPI_MSG_FIRST_FRAG_FLAG))
 						{
-							AddTabularText(tag,
+							AddTabularLine(tag,
 								mMsgObjStr[channel],
 								mMsgInstStr[channel],
 								mMsgCmdStr[channel],
@@ -2392,7 +3028,7 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 						}
 						else
 						{
-							AddTabularText(tag,
+							AddTabularLine(tag,
 								mMsgObjStr[channel],
 								mMsgInstStr[channel],
 								mMsgCmdStr[channel],
@@ -2411,6 +3047,9 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 		{
 			NotifEvent_t notification = NotifEvent::None;
 			MsgDataFrameData2_t* info = (MsgDataFrameData2_t*)&frame.mData2;
+			MsgHeaderInfo_t msgHeader = {};
+
+			mMessageTable.GetHeader(info->msgId, &msgHeader);
 
 			if (frame.HasFlag(SPI_PROTO_EVENT_FLAG))
 			{
@@ -2425,7 +3064,7 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 				if (info->msgDataCnt == 0)
 				{
 					notification = GetErrorRspString((U8)frame.mData1, str, sizeof(str), display_base);
-					SNPRINTF(errorStr, sizeof(errorStr), "Error Code: %s", str);
+					AbccTextBuilder(errorStr, sizeof(errorStr)).Append("Error Code: ").Append(str);
 					WriteTabularText(channel, errorStr, notification);
 				}
 				else if (info->msgDataCnt <= nwSpecErrCodeOffset)
@@ -2438,15 +3077,15 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 						nwTypeIdx = static_cast<U8>(mSettings->mNetworkType);
 					}
 
-					notification = GetErrorRspString(nwSpecificError, nwTypeIdx, info->msgHeader.obj, (U8)frame.mData1, str, sizeof(str), display_base);
+					notification = GetErrorRspString(nwSpecificError, nwTypeIdx, msgHeader.obj, (U8)frame.mData1, str, sizeof(str), display_base);
 
 					if (nwSpecificError)
 					{
-						SNPRINTF(errorStr, sizeof(errorStr), "Network Error: %s", str);
+						AbccTextBuilder(errorStr, sizeof(errorStr)).Append("Network Error: ").Append(str);
 					}
 					else
 					{
-						SNPRINTF(errorStr, sizeof(errorStr), "Object Error: %s", str);
+						AbccTextBuilder(errorStr, sizeof(errorStr)).Append("Object Error: ").Append(str);
 					}
 
 					WriteTabularText(channel, errorStr, notification);
@@ -2454,16 +3093,16 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 			}
 			else if (channel == SpiChannel::MISO)
 			{
-				bool nwObject = (info->msgHeader.obj == ABP_OBJ_NUM_NW);
+				bool nwObject = (msgHeader.obj == ABP_OBJ_NUM_NW);
 				bool exception = false;
-				bool attribute = IsAttributeCmd(info->msgHeader.cmd);
+				bool attribute = IsAttributeCmd(msgHeader.cmd);
 				bool firstAttributeByte = (attribute && (info->msgDataCnt == 0));
 
 				if (firstAttributeByte)
 				{
 					U16 tableIndex;
 
-					if (GetExceptionTableIndex(nwObject, (U8)mSettings->mNetworkType, &info->msgHeader, &tableIndex))
+					if (GetExceptionTableIndex(nwObject, (U8)mSettings->mNetworkType, &msgHeader, &tableIndex))
 					{
 						notification = GetExceptionString(nwObject, tableIndex, (U8)frame.mData1, str, sizeof(str), display_base);
 						exception = true;
@@ -2476,12 +3115,12 @@ void SpiAnalyzerResults::GenerateMessageTabularText(SpiChannel_t channel, Frame
 
 					if (nwObject)
 					{
-						SNPRINTF(excepStr, sizeof(excepStr), "Exception Info: %s", str);
+						AbccTextBuilder(excepStr, sizeof(excepStr)).Append("Exception Info: ").Append(str);
 						WriteTabularText(channel, excepStr, notification);
 					}
 					else
 					{
-						SNPRINTF(excepStr, sizeof(excepStr), "Exception Code: %s", str);
+						AbccTextBuilder(excepStr, sizeof(excepStr)).Append("Exception Code: ").Append(str);
 						WriteTabularText(channel, excepStr, notification);
 					}
 				}
@@ -2513,7 +3152,7 @@ void SpiAnalyzerResults::GenerateMosiTabularText(U64 frame_index, Frame &frame,
 
 				if (addEntry)
 				{
-					SNPRINTF(str, sizeof(str), "Application Status: %s", appStsStr);
+					AbccTextBuilder(str, sizeof(str)).Append("Application Status: ").Append(appStsStr);
 					WriteTabularText(SpiChannel::NotSpecified, str, notification);
 				}
 			}
@@ -2575,6 +3214,20 @@ void SpiAnalyzerResults::GenerateMosiTabularText(U64 frame_index, Frame &frame,
 			break;
 		}
 
+		case AbccMosiStates::WriteProcessData:
+		{
+			if (frame.HasFlag(SPI_PD_BLOCK_FLAG))
+			{
+				char bytesStr[FORMATTED_STRING_BUFFER_SIZE / 2];
+
+				FormatProcessDataBlock(frame, display_base, bytesStr, sizeof(bytesStr));
+				FormatTabularTextBuffer(str, sizeof(str), GET_MOSI_FRAME_TAG(frame.mType), bytesStr, NotifEvent::None);
+				WriteTabularText(SpiChannel::MOSI, str, NotifEvent::None);
+			}
+
+			break;
+		}
+
 		case AbccMosiStates::Crc32:
 		{
 			bool crcError = frame.HasFlag(SPI_PROTO_EVENT_FLAG);
@@ -2628,10 +3281,10 @@ void SpiAnalyzerResults::GenerateMisoTabularText(U64 frame_index, Frame &frame,
 			{
 				U64 packetId = GetPacketContainingFrame(frame_index);
 				U32 delta = ((NetworkTimeInfo_t*)&frame.mData2)->deltaTime;
-				SNPRINTF(str, sizeof(str), "0x%08X (Delta: 0x%08X)", (U32)frame.mData1, delta);
-				AddTabularText("Time: ", str);
-				SNPRINTF(str, sizeof(str), "Packet: 0x%016llX", packetId);
-				AddTabularText(str);
+				AbccTextBuilder(str, sizeof(str)).Append("0x").AppendHex((U32)frame.mData1, 8).Append(" (Delta: 0x").AppendHex(delta, 8).Append(')');
+				AddTabularLine("Time: ", str);
+				AbccTextBuilder(str, sizeof(str)).Append("Packet: 0x").AppendHex(packetId, 16);
+				AddTabularLine(str);
 			}
 
 			break;
@@ -2646,7 +3299,7 @@ void SpiAnalyzerResults::GenerateMisoTabularText(U64 frame_index, Frame &frame,
 
 			if (addEntry)
 			{
-				SNPRINTF(str, sizeof(str), "Anybus Status: (%s)", anbSts);
+				AbccTextBuilder(str, sizeof(str)).Append("Anybus Status: (").Append(anbSts).Append(')');
 				WriteTabularText(SpiChannel::MISO, str, notification);
 			}
 
@@ -2704,6 +3357,20 @@ void SpiAnalyzerResults::GenerateMisoTabularText(U64 frame_index, Frame &frame,
 			break;
 		}
 
+		case AbccMisoStates::ReadProcessData:
+		{
+			if (frame.HasFlag(SPI_PD_BLOCK_FLAG))
+			{
+				char bytesStr[FORMATTED_STRING_BUFFER_SIZE / 2];
+
+				FormatProcessDataBlock(frame, display_base, bytesStr, sizeof(bytesStr));
+				FormatTabularTextBuffer(str, sizeof(str), GET_MISO_FRAME_TAG(frame.mType), bytesStr, NotifEvent::None);
+				WriteTabularText(SpiChannel::MISO, str, NotifEvent::None);
+			}
+
+			break;
+		}
+
 		case AbccMisoStates::Crc32:
 		{
 			bool crcError = frame.HasFlag(SPI_PROTO_EVENT_FLAG);
@@ -2724,9 +3391,33 @@ void SpiAnalyzerResults::GenerateMisoTabularText(U64 frame_index, Frame &frame,
 
 void SpiAnalyzerResults::GenerateFrameTabularText(U64 frame_index, DisplayBase display_base)
 {
+	U64 key = GetTextCacheKey(frame_index, TEXT_VIEW_TABULAR, display_base);
+
 	ClearTabularText();
+	UpdateTextCacheSettings();
+
+	if (ReplayCachedText(key, true))
+	{
+		return;
+	}
+
 	Frame frame = GetFrame(frame_index);
 
+	mRecordedText.clear();
+	mRecordingText = true;
+	WriteFrameTabularText(frame_index, frame, display_base);
+	mRecordingText = false;
+
+	// Frames that leave message or SPI state for the following rows are
+	// rendered every time, so that the state stays up to date.
+	if (!UpdatesTabularState(frame) && IsFramePacketCommitted(frame_index))
+	{
+		mTextCache.Insert(key, mRecordedText);
+	}
+}
+
+void SpiAnalyzerResults::WriteFrameTabularText(U64 frame_index, Frame& frame, DisplayBase display_base)
+{
 	if (mSettings->mErrorIndexing)
 	{
 		if (frame.HasFlag(SPI_ERROR_FLAG))
@@ -2765,14 +3456,140 @@ void SpiAnalyzerResults::GenerateFrameTabularText(U64 frame_index, DisplayBase d
 	}
 }
 
-void SpiAnalyzerResults::GeneratePacketTabularText(U64 /*packet_id*/, DisplayBase /*display_base*/) //unreferenced vars commented out to remove warnings.
+/* Appends the packet type of a channel and, if verbose, the header of its message */
+void SpiAnalyzerResults::WritePacketChannelText(AbccTextBuilder& text, const PacketChannelSummary_t& channel, bool verbose, DisplayBase display_base)
 {
+	char str[FORMATTED_STRING_BUFFER_SIZE];
+
+	text.Append(GetPacketTypeName(channel.ePacketType));
+
+	if (!verbose)
+	{
+		return;
+	}
+
+	if (channel.bFlags & PACKET_MSG_FLAG)
+	{
+		GetObjectString(channel.sMsgHeader.obj, str, sizeof(str), display_base);
+		text.Append(' ').Append(str).Append(", Inst ", 7);
+		text.AppendNumber(channel.sMsgHeader.inst, display_base, SIZE_IN_BITS(channel.sMsgHeader.inst));
+		GetCmdString(channel.sMsgHeader.cmd, channel.sMsgHeader.obj, str, sizeof(str), display_base);
+		text.Append(", ", 2).Append(str);
+
+		if (channel.bFlags & PACKET_FRAG_FLAG)
+		{
+			text.Append(" (", 2).Append(GetPacketFragmentName(channel.bFlags)).Append(')');
+		}
+	}
+
+	// Unless the packet type already says so
+	if ((channel.bFlags & PACKET_CRC_ERROR_FLAG) && (channel.ePacketType != PacketType::ChecksumError))
+	{
+		text.Append(' ').Append(CRC_ERROR_STR);
+	}
+}
+
+/*
+** Rendered from the packet summary table, the packet's frames are not read
+*/
+void SpiAnalyzerResults::GeneratePacketTabularText(U64 packet_id, DisplayBase display_base)
+{
+	char str[FORMATTED_STRING_BUFFER_SIZE];
+	char statusStr[FORMATTED_STRING_BUFFER_SIZE];
+	AbccTextBuilder text(str, sizeof(str));
+	PacketSummary_t summary;
+
 	ClearResultStrings();
-	AddResultString("not supported");
+
+	if (!mPacketSummaries.Get(packet_id, &summary))
+	{
+		return;
+	}
+
+	text.Append(TEXT_PREFIX(MOSI_STR ": "));
+	WritePacketChannelText(text, summary.sMosi, false, display_base);
+	text.Append(TEXT_PREFIX(", " MISO_STR ": "));
+	WritePacketChannelText(text, summary.sMiso, false, display_base);
+	AddResultString(text.GetString());
+
+	text.Clear();
+	text.Append(TEXT_PREFIX(MOSI_STR ": "));
+	WritePacketChannelText(text, summary.sMosi, true, display_base);
+	text.Append(TEXT_PREFIX("; " MISO_STR ": "));
+	WritePacketChannelText(text, summary.sMiso, true, display_base);
+
+	if (summary.sMiso.bFlags & PACKET_STATUS_FLAG)
+	{
+		GetAbccStatusString(summary.sMiso.bStatus, statusStr, sizeof(statusStr), display_base);
+		text.Append(TEXT_PREFIX("; ANB: ")).Append(statusStr);
+	}
+
+	if (summary.sMosi.bFlags & PACKET_STATUS_FLAG)
+	{
+		GetApplStsString(summary.sMosi.bStatus, statusStr, sizeof(statusStr), display_base);
+		text.Append(TEXT_PREFIX("; APP: ")).Append(statusStr);
+	}
+
+	AddResultString(text.GetString());
 }
 
-void SpiAnalyzerResults::GenerateTransactionTabularText(U64 /*transaction_id*/, DisplayBase /*display_base*/) //unreferenced vars commented out to remove warnings.
+/* Appends "MOSI CMD, Src 1: Obj, Inst N, Cmd" for the channel that sent the command */
+void SpiAnalyzerResults::WriteTransactionHeaderText(AbccTextBuilder& text, const AbccTransaction_t& transaction, DisplayBase display_base)
 {
+	char str[FORMATTED_STRING_BUFFER_SIZE];
+
+	text.Append((transaction.eCommandChannel == SpiChannel::MOSI) ? MOSI_STR : MISO_STR);
+	text.Append(TEXT_PREFIX(" CMD, Src "));
+	text.AppendNumber(transaction.bSourceId, display_base, SIZE_IN_BITS(transaction.bSourceId));
+	GetObjectString(transaction.sHeader.obj, str, sizeof(str), display_base);
+	text.Append(": ", 2).Append(str).Append(", Inst ", 7);
+	text.AppendNumber(transaction.sHeader.inst, display_base, SIZE_IN_BITS(transaction.sHeader.inst));
+	GetCmdString(transaction.sHeader.cmd, transaction.sHeader.obj, str, sizeof(str), display_base);
+	text.Append(", ", 2).Append(str);
+}
+
+/*
+** transaction_id is the index in the transaction table. Rendered from the
+** table, the messages are not read.
+*/
+void SpiAnalyzerResults::GenerateTransactionTabularText(U64 transaction_id, DisplayBase display_base)
+{
+	char str[FORMATTED_STRING_BUFFER_SIZE];
+	AbccTextBuilder text(str, sizeof(str));
+	AbccTransaction_t transaction;
+	U64 latency;
+	bool hasLatency;
+
 	ClearResultStrings();
-	AddResultString("not supported");
+
+	if (!mTransactions.Get(transaction_id, &transaction))
+	{
+		return;
+	}
+
+	hasLatency = AbccTransactionTable::GetLatency(transaction, &latency);
+
+	text.Append(GetTransactionStatusName(transaction.eStatus));
+
+	if (hasLatency)
+	{
+		text.Append(' ');
+		AppendLatency(text, latency, GetSampleRate());
+		text.Append(TEXT_PREFIX(" us"));
+	}
+
+	AddResultString(text.GetString());
+
+	text.Clear();
+	WriteTransactionHeaderText(text, transaction, display_base);
+	text.Append(TEXT_PREFIX("; ")).Append(GetTransactionStatusName(transaction.eStatus));
+
+	if (hasLatency)
+	{
+		text.Append(TEXT_PREFIX(", latency "));
+		AppendLatency(text, latency, GetSampleRate());
+		text.Append(TEXT_PREFIX(" us"));
+	}
+
+	AddResultString(text.GetString());
 }
@@ -14,6 +14,12 @@
 
 #include "AnalyzerResults.h"
 #include "AbccSpiAnalyzerTypes.h"
+#include "AbccPayloadArena.h"
+#include "AbccMessageTable.h"
+#include "AbccPacketDirectory.h"
+#include "AbccPacketSummaryTable.h"
+#include "AbccTransactionTable.h"
+#include "AbccTextCache.h"
 
 #ifndef FORMATTED_STRING_BUFFER_SIZE
 #define FORMATTED_STRING_BUFFER_SIZE 256
@@ -32,7 +38,15 @@ enum class ErrorEvent : U32
 	SizeOfEnum
 };
 
+typedef struct TextCacheStats
+{
+	U64 lHits;
+	U64 lMisses;
+	U64 lEntries;
+} TextCacheStats_t;
+
 class SpiAnalyzer;
+class AbccTextBuilder;
 class SpiAnalyzerSettings;
 
 class SpiAnalyzerResults : public AnalyzerResults
@@ -51,6 +65,24 @@ public:
 
 	virtual U64 GetFrameIdOfAbccFieldContainedInPacket(U64 packet_index, SpiChannel_t channel, U8 type);
 
+	/* Stores the bytes of a frame flagged with SPI_PD_BLOCK_FLAG, returns their offset */
+	U64 StorePayload(const U8* data, U32 length);
+
+	/* Messages referred to by the message data frames */
+	AbccMessageTable& GetMessageTable();
+
+	/* Frame of each field type in the committed packets */
+	AbccPacketDirectory& GetPacketDirectory();
+
+	/* Summary of each committed packet, as handed over by the decoder */
+	AbccPacketSummaryTable& GetPacketSummaries();
+
+	/* Commands paired with their responses, and the response latencies */
+	AbccTransactionTable& GetTransactionTable();
+
+	/* Bubble and tabular text served from the text cache, and rendered */
+	TextCacheStats_t GetTextCacheStats();
+
 protected: /* Enums, Types, and Classes */
 
 	typedef union AbccSpiStatesUnion
@@ -73,10 +105,42 @@ protected:  /* Members */
 	bool mMsgValidFlag[NUM_DATA_CHANNELS];
 	bool mMsgErrorRspFlag[NUM_DATA_CHANNELS];
 
+	AbccPayloadArena mPayloadArena;
+	AbccMessageTable mMessageTable;
+	AbccPacketDirectory mPacketDirectory;
+	AbccPacketSummaryTable mPacketSummaries;
+	AbccTransactionTable mTransactions;
+
+	// Text of the frame being rendered, in the text cache's format
+	AbccTextCache mTextCache;
+	std::string mRecordedText;
+	std::string mCachedText;
+	bool mRecordingText;
+
 protected: /* Methods */
 
+	/* Timebase of the capture, used when exporting to file */
+	virtual U32 GetSampleRate();
+	virtual U64 GetTriggerSample();
+
+	void AddBubbleString(const char* str1, const char* str2 = nullptr);
+	void AddTabularLine(const char* str1, const char* str2 = nullptr, const char* str3 = nullptr,
+		const char* str4 = nullptr, const char* str5 = nullptr, const char* str6 = nullptr);
+
+	U64 GetTextCacheKey(U64 frame_index, U8 view, DisplayBase display_base);
+	void UpdateTextCacheSettings();
+	bool ReplayCachedText(U64 key, bool tabular);
+	bool IsFramePacketCommitted(U64 frame_index);
+	bool UpdatesTabularState(Frame& frame);
+
+	void WriteFrameBubbleText(Frame& frame, Channel& channel, DisplayBase display_base);
+	void WriteFrameTabularText(U64 frame_index, Frame& frame, DisplayBase display_base);
+
 	void WriteBubbleText(const char* tag, const char* value, const char* verbose, NotifEvent_t notification, DisplayPriority disp_priority = DisplayPriority::Tag);
 	void WriteTabularText(SpiChannel_t channel, const char* text, NotifEvent_t notification);
+	void WriteProcessDataBlockBubbleText(const char* tag, Frame& frame, DisplayBase display_base);
+	void FormatProcessDataBlock(Frame& frame, DisplayBase display_base, char* buffer, size_t buffer_size);
+	void GetProcessDataBlock(Frame& frame, U32 max_length, std::vector<U8>& bytes);
 	void FormatTabularTextBuffer(char* buffer, size_t buffer_size, const char* tag, const char* text, NotifEvent_t notification);
 
 	void BuildSpiCtrlString(U8 spi_control, DisplayBase display_base);
@@ -95,6 +159,12 @@ protected: /* Methods */
 	void ExportAllFramesToFile(const char* file, DisplayBase display_base);
 	void ExportMessageDataToFile(const char* file, DisplayBase display_base);
 	void ExportProcessDataToFile(const char* file, DisplayBase display_base);
+	void ExportPacketsToFile(const char* file, DisplayBase display_base);
+	void ExportTransactionsToFile(const char* file, DisplayBase display_base);
+	void ExportResponseLatencyToFile(const char* file, DisplayBase display_base);
+
+	void WritePacketChannelText(AbccTextBuilder& text, const PacketChannelSummary_t& channel, bool verbose, DisplayBase display_base);
+	void WriteTransactionHeaderText(AbccTextBuilder& text, const AbccTransaction_t& transaction, DisplayBase display_base);
 
 	void BufferCsvMessageMsgEntry(
 		Frame& frame,
@@ -27,7 +27,7 @@
 ** incompatibility is introduced, increment this counter. This should be
 ** maintained at the commit level to improve reliability of custom builds
 ** at any point in the commit history. */
-#define SETTINGS_REVISION_STRING "REVISION_00000012"
+#define SETTINGS_REVISION_STRING "REVISION_00000016"
 
 #define ANALYZER_NAME "AbccSpiAnalyzer"
 
@@ -90,7 +90,8 @@ SpiAnalyzerSettings::SpiAnalyzerSettings()
 	mAnybusStatusIndexing(true),
 	mApplStatusIndexing(true),
 	mAdvSettingsPath(""),
-	mChangeID(0)
+	mChangeID(0),
+	mDecodeChangeID(0)
 {
 	SetDefaultAdvancedSettings();
 
@@ -248,12 +249,20 @@ SpiAnalyzerSettings::SpiAnalyzerSettings()
 	AddExportExtension(static_cast<U32>(ExportType::ProcessData), "Process Data", "csv");
 	AddExportOption(static_cast<U32>(ExportType::MessageData), "Export Message Data");
 	AddExportExtension(static_cast<U32>(ExportType::MessageData), "Message Data", "csv");
+	AddExportOption(static_cast<U32>(ExportType::Packets), "Export Packet Summary");
+	AddExportExtension(static_cast<U32>(ExportType::Packets), "Packet Summary", "csv");
+	AddExportOption(static_cast<U32>(ExportType::Transactions), "Export Transactions");
+	AddExportExtension(static_cast<U32>(ExportType::Transactions), "Transactions", "csv");
+	AddExportOption(static_cast<U32>(ExportType::ResponseLatency), "Export Response Latency");
+	AddExportExtension(static_cast<U32>(ExportType::ResponseLatency), "Response Latency", "csv");
 
 	ClearChannels();
 	AddChannel(mMosiChannel, MOSI_CHANNEL_NAME, false);
 	AddChannel(mMisoChannel, MISO_CHANNEL_NAME, false);
 	AddChannel(mClockChannel, SCLK_CHANNEL_NAME, false);
 	AddChannel(mEnableChannel, NSS_CHANNEL_NAME, false);
+
+	mDecodeSettingsKey = GetDecodeSettingsKey();
 }
 
 SpiAnalyzerSettings::~SpiAnalyzerSettings()
@@ -267,6 +276,11 @@ void SpiAnalyzerSettings::SetDefaultAdvancedSettings()
 	mExportDelimiter.assign(",");
 	mClockingAlertLimit = -1;
 	mExpandBitFrames = true;
+	m3WireIdleGapNs = MIN_IDLE_GAP_TIME_NS;
+	m3WireClockIdleNs = MAX_CLOCK_IDLE_HI_TIME_NS;
+	mMarkerDensity = MarkerDensity::AllBits;
+	mCoalesceProcessData = false;
+	mTextCacheSize = DEFAULT_TEXT_CACHE_SIZE;
 	mSimulateLogFilePath = "";
 	mSimulateLogFileDefaultState = ABP_ANB_STATE_SETUP;
 	mSimulateClockIdleHigh = -1;
@@ -511,6 +525,59 @@ bool SpiAnalyzerSettings::ParseAdvancedSettingsFile()
 						{
 							mExpandBitFrames = (nodeValue.compare("1") == 0);
 						}
+						else if (nodeName.compare("3-wire-idle-gap-ns") == 0)
+						{
+							// Zero, negative and invalid values keep the default
+							long parsedValue = strtol(nodeValue.c_str(), nullptr, 0);
+
+							if (parsedValue > 0)
+							{
+								m3WireIdleGapNs = static_cast<U32>(parsedValue);
+							}
+						}
+						else if (nodeName.compare("3-wire-clock-idle-ns") == 0)
+						{
+							// Zero, negative and invalid values keep the default
+							long parsedValue = strtol(nodeValue.c_str(), nullptr, 0);
+
+							if (parsedValue > 0)
+							{
+								m3WireClockIdleNs = static_cast<U32>(parsedValue);
+							}
+						}
+						else if (nodeName.compare("bit-markers") == 0)
+						{
+							if (nodeValue.compare("first-bit") == 0)
+							{
+								mMarkerDensity = MarkerDensity::FirstBit;
+							}
+							else if (nodeValue.compare("none") == 0)
+							{
+								mMarkerDensity = MarkerDensity::None;
+							}
+							else if (nodeValue.compare("errors-only") == 0)
+							{
+								mMarkerDensity = MarkerDensity::ErrorsOnly;
+							}
+							else
+							{
+								mMarkerDensity = MarkerDensity::AllBits;
+							}
+						}
+						else if (nodeName.compare("coalesce-process-data") == 0)
+						{
+							mCoalesceProcessData = (nodeValue.compare("1") == 0);
+						}
+						else if (nodeName.compare("text-cache-size") == 0)
+						{
+							// Zero disables the cache, negative and invalid values keep the default
+							long parsedValue = strtol(nodeValue.c_str(), nullptr, 0);
+
+							if ((parsedValue >= 0) && !nodeValue.empty())
+							{
+								mTextCacheSize = static_cast<U32>(parsedValue);
+							}
+						}
 						else if (nodeName.compare("simulation") == 0)
 						{
 							// Attempt to get applicable settings for simulation from child nodes.
@@ -642,6 +709,11 @@ void SpiAnalyzerSettings::LoadSettings(const char* settings)
 		textArchive >> mExportDelimiter;
 		textArchive >> mClockingAlertLimit;
 		textArchive >> mExpandBitFrames;
+		textArchive >> m3WireIdleGapNs;
+		textArchive >> m3WireClockIdleNs;
+		textArchive >> mMarkerDensity;
+		textArchive >> mCoalesceProcessData;
+		textArchive >> mTextCacheSize;
 		textArchive >> &mAdvSettingsPath;
 	}
 
@@ -679,6 +751,11 @@ const char* SpiAnalyzerSettings::SaveSettings()
 	textArchive << mExportDelimiter.c_str();
 	textArchive << mClockingAlertLimit;
 	textArchive << mExpandBitFrames;
+	textArchive << m3WireIdleGapNs;
+	textArchive << m3WireClockIdleNs;
+	textArchive << mMarkerDensity;
+	textArchive << mCoalesceProcessData;
+	textArchive << mTextCacheSize;
 	textArchive << mAdvSettingsPath;
 
 	SaveSettingChangeID();
@@ -707,6 +784,50 @@ void SpiAnalyzerSettings::UpdateInterfacesFromSettings()
 
 U8 SpiAnalyzerSettings::SaveSettingChangeID()
 {
+	std::string decodeSettingsKey = GetDecodeSettingsKey();
+
+	if (decodeSettingsKey != mDecodeSettingsKey)
+	{
+		mDecodeSettingsKey = decodeSettingsKey;
+		mDecodeChangeID++;
+	}
+
 	mChangeID++;
 	return mChangeID;
 }
+
+/*
+** Serializes the settings that affect the decoded frames: the channels, the
+** acquisition and decoder options, and the simulation options since they
+** change what is decoded in simulation mode. The network type, the indexing
+** and priority options and the export delimiter are left out, they are
+** only read when the results are rendered or exported.
+*/
+std::string SpiAnalyzerSettings::GetDecodeSettingsKey()
+{
+	SimpleArchive textArchive;
+
+	textArchive << mMosiChannel;
+	textArchive << mMisoChannel;
+	textArchive << mClockChannel;
+	textArchive << mEnableChannel;
+	textArchive << m3WireOn4Channels;
+	textArchive << m4WireOn3Channels;
+	textArchive << mClockingAlertLimit;
+	textArchive << mExpandBitFrames;
+	textArchive << m3WireIdleGapNs;
+	textArchive << m3WireClockIdleNs;
+	textArchive << mMarkerDensity;
+	textArchive << mCoalesceProcessData;
+	textArchive << mSimulateLogFilePath.c_str();
+	textArchive << mSimulateLogFileDefaultState;
+	textArchive << mSimulateClockIdleHigh;
+	textArchive << mSimulateClockFrequency;
+	textArchive << mSimulatePacketGapNs;
+	textArchive << mSimulateByteGapNs;
+	textArchive << mSimulateChipSelectNs;
+	textArchive << mSimulateMsgDataLength;
+	textArchive << mSimulateWordMode;
+
+	return std::string(textArchive.GetString());
+}
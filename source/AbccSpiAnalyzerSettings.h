@@ -41,6 +41,9 @@ enum class ExportType : U32
 	Frames,
 	ProcessData,
 	MessageData,
+	Packets,
+	Transactions,
+	ResponseLatency,
 	SizeOfEnum
 };
 
@@ -94,6 +97,9 @@ public:
 
 	void UpdateInterfacesFromSettings();
 
+	/* The settings that affect the decoded frames, serialized */
+	std::string GetDecodeSettingsKey();
+
 public: /* Members */
 
 	Channel mMosiChannel;
@@ -102,7 +108,12 @@ public: /* Members */
 	Channel mEnableChannel;
 
 	U32 mNetworkType;
+
+	// mChangeID is advanced each time the settings are saved, mDecodeChangeID
+	// only when a setting that affects the decoded frames has changed. The
+	// other settings only change how the frames are rendered.
 	U8 mChangeID;
+	U8 mDecodeChangeID;
 
 	DisplayPriority mMsgDataPriority;
 	DisplayPriority mProcessDataPriority;
@@ -121,6 +132,11 @@ public: /* Members */
 	std::string mExportDelimiter;
 	S32 mClockingAlertLimit;
 	bool mExpandBitFrames;
+	U32 m3WireIdleGapNs;
+	U32 m3WireClockIdleNs;
+	MarkerDensity mMarkerDensity;
+	bool mCoalesceProcessData;
+	U32 mTextCacheSize;
 
 	std::string mSimulateLogFilePath;
 	U32 mSimulateLogFileDefaultState;
@@ -157,6 +173,10 @@ protected: /* Methods */
 
 	void SetSettingError( const std::string& setting_name, const std::string& error_text );
 	U8 SaveSettingChangeID();
+
+protected: /* Members */
+
+	std::string mDecodeSettingsKey;
 };
 
 #endif /* ABCC_SPI_ANALYZER_SETTINGS_H */
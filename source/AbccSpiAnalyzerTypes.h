@@ -10,7 +10,7 @@
 
 #ifndef ABCC_SPI_ANALYZER_TYPES_H
 #define ABCC_SPI_ANALYZER_TYPES_H
-#include "Analyzer.h"
+#include "LogicPublicTypes.h"
 
 /* Indicates a SPI settings error (e.g. CPOL, CPHA, EN Active Hi/Lo) */
 #define SPI_ERROR_FLAG						( 1 << 0 )
@@ -24,6 +24,10 @@
 /* Indicates that message fragmentation is in progress */
 #define SPI_MSG_FRAG_FLAG					( 1 << 3 )
 
+/* Process data frame holding a whole block of bytes. mData1 is the offset of
+** the bytes in the payload arena and mData2 is the number of bytes. */
+#define SPI_PD_BLOCK_FLAG					( 1 << 4 )
+
 /* Event flag to indicate any critical events that are part of the ABCC SPI protocol
 ** This flag is field-specific.
 ** This flag is relevant for the following fields:
@@ -36,6 +40,29 @@
 **   - CRC32: signals a checksum error */
 #define SPI_PROTO_EVENT_FLAG				( 1 << 5 )
 
+/* Display flags, identical to the definitions in the SDK's AnalyzerResults.h.
+** Repeated here so that the decoder needs only the SDK's basic types. */
+#ifndef DISPLAY_AS_ERROR_FLAG
+#define DISPLAY_AS_ERROR_FLAG ( 1 << 7 )
+#endif
+#ifndef DISPLAY_AS_WARNING_FLAG
+#define DISPLAY_AS_WARNING_FLAG ( 1 << 6 )
+#endif
+
+/* Default 3-wire idle limits (in nanoseconds). The ABCC requires an idle gap
+** of at least 10us between packets and treats the clock idling high for 5us
+** or more during a packet as an end of transfer. Both can be overridden in the
+** advanced settings file. */
+#define MIN_IDLE_GAP_TIME_NS				10000
+#define MAX_CLOCK_IDLE_HI_TIME_NS			5000
+
+/* Default number of rendered frame texts kept by the results, can be
+** overridden in the advanced settings file. */
+#define DEFAULT_TEXT_CACHE_SIZE				16384
+
+/* The ABCC's minimum idle gap in seconds, as used by the simulation */
+#define MIN_IDLE_GAP_TIME					10.0e-6f
+
 #define GET_MSG_FRAME_TAG(x)				(asMsgStates[static_cast<U32>(x)].tag)
 #define GET_MOSI_FRAME_TAG(x)				(asMosiStates[x].tag)
 #define GET_MISO_FRAME_TAG(x)				(asMisoStates[x].tag)
@@ -55,6 +82,17 @@ enum class DisplayPriority : U32
 	SizeOfEnum
 };
 
+/* Which of the per-bit sample markers (MOSI/MISO value and SCLK arrow) are
+** placed on the channels. Error markers are placed in all cases. */
+enum class MarkerDensity : U32
+{
+	AllBits,	// Every sampled bit
+	FirstBit,	// The first bit of each decoded frame
+	None,		// No per-bit markers, packet markers on the enable line are kept
+	ErrorsOnly,	// Nothing but error markers
+	SizeOfEnum
+};
+
 typedef enum NotifEvent {
 	None,
 	Alert
@@ -191,10 +229,14 @@ typedef struct NetworkTimeInfo
 	bool wrPdValid;
 } NetworkTimeInfo_t;
 
+/* Id of a message data frame that does not belong to a message in the table */
+#define ABCC_MSG_ID_NONE					0xFFFFFFFF
+
 typedef struct MsgDataFrameData2
 {
 	U16 msgDataCnt;
-	MsgHeaderInfo_t msgHeader;
+	U16 reserved;
+	U32 msgId;		/* Message table entry holding the message header */
 } MsgDataFrameData2_t;
 
 #endif /* ABCC_SPI_ANALYZER_TYPES_H */
@@ -0,0 +1,2228 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiDecoder.cpp
+**    Summary: Headless ABCC SPI protocol decoder. Runs the MOSI/MISO state
+**             machines on acquired byte pairs and reports the decoded
+**             frames, packets, and markers to an abstract sink.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <cstring>
+
+#include "AbccSpiDecoder.h"
+#include "AbccCrc.h"
+
+#include "abcc_td.h"
+#include "abcc_abp/abp.h"
+
+AbccSpiDecoder::AbccSpiDecoder(AbccSpiDecoderBus* bus, AbccSpiDecoderSink* sink)
+	: mBus(bus),
+	mSink(sink),
+	mConfig(),
+	mMosiVars(),
+	mMisoVars(),
+	mPreviousMosiVars(),
+	mPreviousMisoVars(),
+	mMosiReady(true),
+	mMisoReady(true),
+	mMosiPdBlock(),
+	mMisoPdBlock()
+{
+}
+
+AbccSpiDecoder::~AbccSpiDecoder()
+{
+}
+
+void AbccSpiDecoder::Setup(const DecoderConfig_t& config)
+{
+	mConfig = config;
+}
+
+void AbccSpiDecoder::Reset()
+{
+	mMosiVars.eState              = AbccMosiStates::Idle;
+	mMisoVars.eState              = AbccMisoStates::Idle;
+	mMisoVars.bLastAnbSts         = 0xFF;
+	mMosiVars.bLastApplSts        = 0xFF;
+	mMosiVars.bLastToggleState    = 0xFF;
+	mMosiVars.dwMsgLen            = 0;
+	mMosiVars.dwMsgLenCnt         = 0;
+	mMosiVars.dwPdLen             = 0;
+	mMisoVars.dwMsgLen            = 0;
+	mMisoVars.dwMsgLenCnt         = 0;
+	mMisoVars.dwPdLen             = 0;
+
+	mMisoVars.fNewMsg             = false;
+	mMisoVars.fErrorRsp           = true;
+	mMisoVars.fFragmentation      = false;
+	mMisoVars.fFirstFrag          = false;
+	mMisoVars.fLastFrag           = false;
+	mMisoVars.fNewRdPd            = false;
+	mMosiVars.fNewMsg             = false;
+	mMosiVars.fErrorRsp           = true;
+	mMosiVars.fFragmentation      = false;
+	mMosiVars.fFirstFrag          = false;
+	mMosiVars.fLastFrag           = false;
+	mMosiVars.fWrPdValid          = false;
+
+	mMisoVars.fReadyForNewPacket  = false;
+	mMosiVars.fReadyForNewPacket  = false;
+
+	memset(&mMisoVars.sMsgHeader, 0, sizeof(mMisoVars.sMsgHeader));
+	mMisoVars.dwMsgId = ABCC_MSG_ID_NONE;
+	mMisoVars.dwPdCnt = 0;
+	mMisoVars.wMdCnt = 0;
+	mMisoVars.wMdSize = 0;
+
+	memset(&mMosiVars.sMsgHeader, 0, sizeof(mMosiVars.sMsgHeader));
+	mMosiVars.dwMsgId = ABCC_MSG_ID_NONE;
+	mMosiVars.dwPdCnt = 0;
+	mMosiVars.wMdCnt = 0;
+	mMosiVars.wMdSize = 0;
+
+	mMisoVars.dwLastTimestamp = 0;
+
+	mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Size;
+	mMisoVars.dwByteCnt    = 0;
+	mMisoVars.lFrameData   = 0;
+
+	mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Size;
+	mMosiVars.dwByteCnt    = 0;
+	mMosiVars.lFrameData   = 0;
+
+	mMosiVars.bFrameSizeCnt = 0;
+	mMisoVars.bFrameSizeCnt = 0;
+
+	mMisoPacketBytes.clear();
+	mMosiPacketBytes.clear();
+
+	mMisoPdBlock.dwLength = 0;
+	mMosiPdBlock.dwLength = 0;
+
+	mMisoMsgFields.fPresent = false;
+	mMisoMsgFields.fChecksumError = false;
+	mMisoMsgFields.bToggle = 0xFF;
+	mMisoMsgFields.fAdded = false;
+	mMisoMsgFields.fRetransmission = false;
+	mMosiMsgFields.fPresent = false;
+	mMosiMsgFields.fChecksumError = false;
+	mMosiMsgFields.bToggle = 0xFF;
+	mMosiMsgFields.fAdded = false;
+	mMosiMsgFields.fRetransmission = false;
+
+	ResetPacketSummary();
+
+	RunAbccMosiMsgSubStateMachine(StateOperation::Reset, nullptr, nullptr);
+	RunAbccMisoMsgSubStateMachine(StateOperation::Reset, nullptr, nullptr);
+
+	mMosiReady = true;
+	mMisoReady = true;
+}
+
+void AbccSpiDecoder::GetState(DecoderState_t* state_ptr) const
+{
+	state_ptr->sMosiVars = mMosiVars;
+	state_ptr->sMisoVars = mMisoVars;
+	state_ptr->sPreviousMosiVars = mPreviousMosiVars;
+	state_ptr->sPreviousMisoVars = mPreviousMisoVars;
+	state_ptr->fMosiReady = mMosiReady;
+	state_ptr->fMisoReady = mMisoReady;
+	state_ptr->abMosiPacketBytes = mMosiPacketBytes;
+	state_ptr->abMisoPacketBytes = mMisoPacketBytes;
+	state_ptr->sMosiPdBlock = mMosiPdBlock;
+	state_ptr->sMisoPdBlock = mMisoPdBlock;
+	state_ptr->sMosiMsgFields = mMosiMsgFields;
+	state_ptr->sMisoMsgFields = mMisoMsgFields;
+	state_ptr->sPacketSummary = mPacketSummary;
+}
+
+void AbccSpiDecoder::SetState(const DecoderState_t& state)
+{
+	mMosiVars = state.sMosiVars;
+	mMisoVars = state.sMisoVars;
+	mPreviousMosiVars = state.sPreviousMosiVars;
+	mPreviousMisoVars = state.sPreviousMisoVars;
+	mMosiReady = state.fMosiReady;
+	mMisoReady = state.fMisoReady;
+	mMosiPacketBytes = state.abMosiPacketBytes;
+	mMisoPacketBytes = state.abMisoPacketBytes;
+	mMosiPdBlock = state.sMosiPdBlock;
+	mMisoPdBlock = state.sMisoPdBlock;
+	mMosiMsgFields = state.sMosiMsgFields;
+	mMisoMsgFields = state.sMisoMsgFields;
+	mPacketSummary = state.sPacketSummary;
+}
+
+static bool IsSameMsgHeader(const MsgHeaderInfo_t& header_a, const MsgHeaderInfo_t& header_b)
+{
+	return (header_a.cmd == header_b.cmd) && (header_a.obj == header_b.obj) &&
+		(header_a.inst == header_b.inst) && (header_a.cmdExt == header_b.cmdExt);
+}
+
+static bool IsSameMsgId(U32 id_a, U32 id_b)
+{
+	return ((id_a == ABCC_MSG_ID_NONE) == (id_b == ABCC_MSG_ID_NONE));
+}
+
+static bool IsSameMosiVars(const AbccSpiDecoder::MosiVars_t& vars_a, const AbccSpiDecoder::MosiVars_t& vars_b)
+{
+	return (vars_a.lFrameData == vars_b.lFrameData) &&
+		(vars_a.ePacketType == vars_b.ePacketType) &&
+		(vars_a.eState == vars_b.eState) &&
+		(vars_a.eMsgSubState == vars_b.eMsgSubState) &&
+		IsSameMsgHeader(vars_a.sMsgHeader, vars_b.sMsgHeader) &&
+		IsSameMsgId(vars_a.dwMsgId, vars_b.dwMsgId) &&
+		(vars_a.dwPdLen == vars_b.dwPdLen) &&
+		(vars_a.dwPdCnt == vars_b.dwPdCnt) &&
+		(vars_a.dwMsgLen == vars_b.dwMsgLen) &&
+		(vars_a.dwMsgLenCnt == vars_b.dwMsgLenCnt) &&
+		(vars_a.dwByteCnt == vars_b.dwByteCnt) &&
+		(vars_a.bFrameSizeCnt == vars_b.bFrameSizeCnt) &&
+		(vars_a.wMdCnt == vars_b.wMdCnt) &&
+		(vars_a.wMdSize == vars_b.wMdSize) &&
+		(vars_a.bLastToggleState == vars_b.bLastToggleState) &&
+		(vars_a.bLastApplSts == vars_b.bLastApplSts) &&
+		(vars_a.fNewMsg == vars_b.fNewMsg) &&
+		(vars_a.fErrorRsp == vars_b.fErrorRsp) &&
+		(vars_a.fFragmentation == vars_b.fFragmentation) &&
+		(vars_a.fFirstFrag == vars_b.fFirstFrag) &&
+		(vars_a.fLastFrag == vars_b.fLastFrag) &&
+		(vars_a.fWrPdValid == vars_b.fWrPdValid) &&
+		(vars_a.fReadyForNewPacket == vars_b.fReadyForNewPacket);
+}
+
+static bool IsSameMisoVars(const AbccSpiDecoder::MisoVars_t& vars_a, const AbccSpiDecoder::MisoVars_t& vars_b)
+{
+	return (vars_a.lFrameData == vars_b.lFrameData) &&
+		(vars_a.ePacketType == vars_b.ePacketType) &&
+		(vars_a.eState == vars_b.eState) &&
+		(vars_a.eMsgSubState == vars_b.eMsgSubState) &&
+		IsSameMsgHeader(vars_a.sMsgHeader, vars_b.sMsgHeader) &&
+		IsSameMsgId(vars_a.dwMsgId, vars_b.dwMsgId) &&
+		(vars_a.dwLastTimestamp == vars_b.dwLastTimestamp) &&
+		(vars_a.dwPdLen == vars_b.dwPdLen) &&
+		(vars_a.dwPdCnt == vars_b.dwPdCnt) &&
+		(vars_a.dwMsgLen == vars_b.dwMsgLen) &&
+		(vars_a.dwMsgLenCnt == vars_b.dwMsgLenCnt) &&
+		(vars_a.dwByteCnt == vars_b.dwByteCnt) &&
+		(vars_a.bFrameSizeCnt == vars_b.bFrameSizeCnt) &&
+		(vars_a.wMdCnt == vars_b.wMdCnt) &&
+		(vars_a.wMdSize == vars_b.wMdSize) &&
+		(vars_a.bLastAnbSts == vars_b.bLastAnbSts) &&
+		(vars_a.fNewMsg == vars_b.fNewMsg) &&
+		(vars_a.fErrorRsp == vars_b.fErrorRsp) &&
+		(vars_a.fFragmentation == vars_b.fFragmentation) &&
+		(vars_a.fFirstFrag == vars_b.fFirstFrag) &&
+		(vars_a.fLastFrag == vars_b.fLastFrag) &&
+		(vars_a.fNewRdPd == vars_b.fNewRdPd) &&
+		(vars_a.fReadyForNewPacket == vars_b.fReadyForNewPacket);
+}
+
+// Only the variables that RestorePreviousStateVars() puts back
+template <typename Vars>
+static bool IsSameRestoredVars(const Vars& vars_a, const Vars& vars_b)
+{
+	return (vars_a.wMdCnt == vars_b.wMdCnt) &&
+		(vars_a.fFirstFrag == vars_b.fFirstFrag) &&
+		(vars_a.fLastFrag == vars_b.fLastFrag) &&
+		(vars_a.fFragmentation == vars_b.fFragmentation) &&
+		(vars_a.eMsgSubState == vars_b.eMsgSubState);
+}
+
+static bool IsSamePdBlock(const AbccSpiDecoder::ProcessDataBlock_t& block_a, const AbccSpiDecoder::ProcessDataBlock_t& block_b)
+{
+	if ((block_a.dwLength == 0) || (block_b.dwLength == 0))
+	{
+		return (block_a.dwLength == block_b.dwLength);
+	}
+
+	return (block_a.nFirstByte == block_b.nFirstByte) &&
+		(block_a.dwLength == block_b.dwLength) &&
+		(block_a.bFlags == block_b.bFlags);
+}
+
+static bool IsSameMsgFields(const AbccSpiDecoder::PacketMessageFields_t& fields_a, const AbccSpiDecoder::PacketMessageFields_t& fields_b)
+{
+	if (fields_a.fPresent != fields_b.fPresent)
+	{
+		return false;
+	}
+
+	if (fields_a.fPresent &&
+		((fields_a.nFirstByte != fields_b.nFirstByte) ||
+		 (fields_a.fChecksumOk != fields_b.fChecksumOk) ||
+		 (fields_a.fLastFragment != fields_b.fLastFragment)))
+	{
+		return false;
+	}
+
+	return (fields_a.fChecksumError == fields_b.fChecksumError) &&
+		(fields_a.bToggle == fields_b.bToggle) &&
+		(fields_a.fAdded == fields_b.fAdded) &&
+		(fields_a.fRetransmission == fields_b.fRetransmission);
+}
+
+static bool IsSamePacketSummary(const PacketSummary_t& summary_a, const PacketSummary_t& summary_b)
+{
+	return ((summary_a.lFirstSample == PACKET_SAMPLE_NONE) == (summary_b.lFirstSample == PACKET_SAMPLE_NONE)) &&
+		(summary_a.sMosi.bStatus == summary_b.sMosi.bStatus) &&
+		(summary_a.sMosi.bFlags == summary_b.sMosi.bFlags) &&
+		(summary_a.sMiso.bStatus == summary_b.sMiso.bStatus) &&
+		(summary_a.sMiso.bFlags == summary_b.sMiso.bFlags);
+}
+
+bool AbccSpiDecoder::IsSameState(const DecoderState_t& state_a, const DecoderState_t& state_b)
+{
+	return IsSameMosiVars(state_a.sMosiVars, state_b.sMosiVars) &&
+		IsSameMisoVars(state_a.sMisoVars, state_b.sMisoVars) &&
+		IsSameRestoredVars(state_a.sPreviousMosiVars, state_b.sPreviousMosiVars) &&
+		IsSameRestoredVars(state_a.sPreviousMisoVars, state_b.sPreviousMisoVars) &&
+		(state_a.fMosiReady == state_b.fMosiReady) &&
+		(state_a.fMisoReady == state_b.fMisoReady) &&
+		(state_a.abMosiPacketBytes == state_b.abMosiPacketBytes) &&
+		(state_a.abMisoPacketBytes == state_b.abMisoPacketBytes) &&
+		IsSamePdBlock(state_a.sMosiPdBlock, state_b.sMosiPdBlock) &&
+		IsSamePdBlock(state_a.sMisoPdBlock, state_b.sMisoPdBlock) &&
+		IsSameMsgFields(state_a.sMosiMsgFields, state_b.sMosiMsgFields) &&
+		IsSameMsgFields(state_a.sMisoMsgFields, state_b.sMisoMsgFields) &&
+		IsSamePacketSummary(state_a.sPacketSummary, state_b.sPacketSummary);
+}
+
+void AbccSpiDecoder::ProcessBytePair(AcquisitionStatus acquisition_status, U64 mosi_data, U64 miso_data, S64 first_sample)
+{
+	StateOperation mosiOperation;
+	StateOperation misoOperation;
+
+	if (acquisition_status == AcquisitionStatus::OK)
+	{
+		mosiOperation = StateOperation::Run;
+		misoOperation = StateOperation::Run;
+	}
+	else
+	{
+		mosiOperation = StateOperation::Reset;
+		misoOperation = StateOperation::Reset;
+	}
+
+	if (mMosiReady)
+	{
+		mosiOperation = StateOperation::Reset;
+	}
+
+	if (mMisoReady)
+	{
+		misoOperation = StateOperation::Reset;
+	}
+
+	mMosiReady = RunAbccMosiStateMachine(mosiOperation, acquisition_status, mosi_data, first_sample);
+	mMisoReady = RunAbccMisoStateMachine(misoOperation, acquisition_status, miso_data, first_sample);
+
+	if (!mMosiReady && !mMisoReady)
+	{
+		if (mBus->IsIdleConditionDetected())
+		{
+			mMosiVars.eState = AbccMosiStates::SpiControl;
+			mMisoVars.eState = AbccMisoStates::Reserved1;
+			//mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Size;
+			//mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Size;
+			AddProcessDataBlockFrame(SpiChannel::MISO);
+			AddProcessDataBlockFrame(SpiChannel::MOSI);
+			mMisoPacketBytes.clear();
+			mMosiPacketBytes.clear();
+			mMisoMsgFields.fPresent = false;
+			mMosiMsgFields.fPresent = false;
+			mMisoVars.lFrameData = 0;
+			mMosiVars.lFrameData = 0;
+			mMisoVars.dwByteCnt = 0;
+			mMosiVars.dwByteCnt = 0;
+			acquisition_status = AcquisitionStatus::Error;
+		}
+	}
+
+	if (acquisition_status == AcquisitionStatus::Error)
+	{
+		// Signal error, do not commit packet
+		SetMosiPacketType(PacketType::Cancel);
+		SignalReadyForNewPacket(SpiChannel::MOSI);
+	}
+
+	// The acquisition places the first-bit markers of each frame
+	mBus->SetNextByteStartsFrame(DoesNextByteStartFrame(SpiChannel::MOSI), DoesNextByteStartFrame(SpiChannel::MISO));
+
+	mSink->CommitResults();
+}
+
+static bool IsErrorPacketType(PacketType packet_type)
+{
+	switch (packet_type)
+	{
+	case PacketType::ProtocolError:
+	case PacketType::ChecksumError:
+	case PacketType::ErrorResponse:
+	case PacketType::MultiEventWithError:
+	case PacketType::Cancel:
+		return true;
+	default:
+		return false;
+	}
+}
+
+DecoderMarker AbccSpiDecoder::GetPacketMarkerType()
+{
+	DecoderMarker eMarkerType;
+
+	// Determine marker type based on packet types:
+	// Dot - Message Fragment
+	// Start - Message Command
+	// Stop - Message Response
+	// Square - Multiple Events (no errors)
+	// ErrorDot - Error Response
+	// ErrorX - Checksum Error
+	// ErrorSquare - Protocol Error or Multiple Events with at least one error
+	if ((mMosiVars.ePacketType != PacketType::Empty) && (mMisoVars.ePacketType != PacketType::Empty))
+	{
+		// Multiple events (at least one on each channel, or multiple events on one channel)
+		if (IsErrorPacketType(mMosiVars.ePacketType) ||
+			IsErrorPacketType(mMisoVars.ePacketType))
+		{
+			eMarkerType = DecoderMarker::ErrorSquare;
+		}
+		else
+		{
+			eMarkerType = DecoderMarker::Square;
+		}
+	}
+	else
+	{
+		// Only one channel contains an event(s)
+		if ((mMosiVars.ePacketType == PacketType::MultiEventWithError) ||
+			(mMisoVars.ePacketType == PacketType::MultiEventWithError))
+		{
+			eMarkerType = DecoderMarker::ErrorSquare;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::ProtocolError) ||
+				 (mMisoVars.ePacketType == PacketType::ProtocolError))
+		{
+			eMarkerType = DecoderMarker::ErrorSquare;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::ProtocolEvent) ||
+				 (mMisoVars.ePacketType == PacketType::ProtocolEvent))
+		{
+			eMarkerType = DecoderMarker::X;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::ChecksumError) ||
+				 (mMisoVars.ePacketType == PacketType::ChecksumError))
+		{
+			eMarkerType = DecoderMarker::ErrorX;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::ErrorResponse) ||
+				 (mMisoVars.ePacketType == PacketType::ErrorResponse))
+		{
+			eMarkerType = DecoderMarker::ErrorDot;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::MultiEvent) ||
+				 (mMisoVars.ePacketType == PacketType::MultiEvent))
+		{
+			eMarkerType = DecoderMarker::Square;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::Response) ||
+				 (mMisoVars.ePacketType == PacketType::Response))
+		{
+			eMarkerType = DecoderMarker::Stop;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::Command) ||
+				 (mMisoVars.ePacketType == PacketType::Command))
+		{
+			eMarkerType = DecoderMarker::Start;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::MessageFragment) ||
+				 (mMisoVars.ePacketType == PacketType::MessageFragment))
+		{
+			eMarkerType = DecoderMarker::Dot;
+		}
+		else if ((mMosiVars.ePacketType == PacketType::Empty) ||
+				 (mMisoVars.ePacketType == PacketType::Empty))
+		{
+			eMarkerType = DecoderMarker::One;
+		}
+		else
+		{
+			eMarkerType = DecoderMarker::UpArrow;
+		}
+	}
+
+	return eMarkerType;
+}
+
+void AbccSpiDecoder::SignalReadyForNewPacket(SpiChannel_t channel)
+{
+	bool startNewPacket = false;
+
+	if (channel == SpiChannel::MOSI)
+	{
+		mMosiVars.fReadyForNewPacket = true;
+	}
+	else
+	{
+		mMisoVars.fReadyForNewPacket = true;
+	}
+
+	if (mMosiVars.ePacketType == PacketType::Cancel)
+	{
+		startNewPacket = true;
+		mSink->CancelPacketAndStartNewPacket();
+
+		if (mBus->HasEnableChannel())
+		{
+			AddMarker(mBus->GetCurrentSample(), DecoderMarker::ErrorX, DecoderChannel::Enable);
+		}
+	}
+	else if (mMisoVars.fReadyForNewPacket && mMosiVars.fReadyForNewPacket)
+	{
+		bool packetCommitted;
+
+		// The packet types and message headers are final once both channels are done
+		mPacketSummary.sMosi.ePacketType = mMosiVars.ePacketType;
+		mPacketSummary.sMiso.ePacketType = mMisoVars.ePacketType;
+		mPacketSummary.sMosi.sMsgHeader = mMosiVars.sMsgHeader;
+		mPacketSummary.sMiso.sMsgHeader = mMisoVars.sMsgHeader;
+
+		packetCommitted = mSink->CommitPacketAndStartNewPacket(mPacketSummary);
+		startNewPacket = true;
+
+		if (!packetCommitted)
+		{
+			if (mBus->HasEnableChannel())
+			{
+				AddMarker(mBus->GetCurrentSample(), DecoderMarker::Zero, DecoderChannel::Enable);
+			}
+		}
+		else
+		{
+			if (mBus->HasEnableChannel())
+			{
+				DecoderMarker eMarkerType = GetPacketMarkerType();
+
+				if (eMarkerType != DecoderMarker::One)
+				{
+					AddMarker(mBus->GetCurrentSample(), eMarkerType, DecoderChannel::Enable);
+				}
+			}
+		}
+
+		// Commands are paired with their responses by the sink's transaction
+		// table, as their messages are completed
+		mSink->CommitResults();
+	}
+
+	if (startNewPacket)
+	{
+		if (mMosiVars.ePacketType != PacketType::Cancel)
+		{
+			// Check if any additional clocks appear on SCLK before enable goes inactive
+			mBus->CheckForIdleAfterPacket();
+		}
+
+		mMosiVars.fReadyForNewPacket = false;
+		mMisoVars.fReadyForNewPacket = false;
+		mMosiVars.ePacketType = PacketType::Empty;
+		mMisoVars.ePacketType = PacketType::Empty;
+
+		ResetPacketSummary();
+	}
+}
+
+/*
+** Passes a frame on to the sink and adds what it tells about the packet to
+** the packet summary.
+*/
+void AbccSpiDecoder::AddFrame(const DecoderFrame_t& frame)
+{
+	bool mosi = frame.HasFlag(SPI_MOSI_FLAG);
+	PacketChannelSummary_t& summary = mosi ? mPacketSummary.sMosi : mPacketSummary.sMiso;
+
+	if ((mPacketSummary.lFirstSample == PACKET_SAMPLE_NONE) ||
+		(frame.mStartingSampleInclusive < mPacketSummary.lFirstSample))
+	{
+		mPacketSummary.lFirstSample = frame.mStartingSampleInclusive;
+	}
+
+	if (frame.mEndingSampleInclusive > mPacketSummary.lLastSample)
+	{
+		mPacketSummary.lLastSample = frame.mEndingSampleInclusive;
+	}
+
+	if (frame.HasFlag(DISPLAY_AS_ERROR_FLAG))
+	{
+		summary.bFlags |= PACKET_ERROR_FLAG;
+	}
+
+	if (frame.HasFlag(SPI_MSG_FRAG_FLAG))
+	{
+		summary.bFlags |= PACKET_FRAG_FLAG;
+	}
+
+	if (frame.HasFlag(SPI_MSG_FIRST_FRAG_FLAG))
+	{
+		summary.bFlags |= PACKET_FIRST_FRAG_FLAG;
+	}
+
+	if (!frame.HasFlag(SPI_ERROR_FLAG))
+	{
+		U8 control = (U8)frame.mData1;
+
+		if (mosi)
+		{
+			switch (frame.mType)
+			{
+			case AbccMosiStates::SpiControl:
+				if (control & ABP_SPI_CTRL_M)
+				{
+					summary.bFlags |= PACKET_MSG_FLAG;
+
+					if (control & ABP_SPI_CTRL_LAST_FRAG)
+					{
+						summary.bFlags |= PACKET_LAST_FRAG_FLAG;
+					}
+				}
+				break;
+			case AbccMosiStates::ApplicationStatus:
+				summary.bStatus = (U8)frame.mData1;
+				summary.bFlags |= PACKET_STATUS_FLAG;
+				break;
+			case AbccMosiStates::Crc32:
+				summary.bFlags |= ((U32)frame.mData1 == (U32)frame.mData2) ? PACKET_CRC_FLAG : (PACKET_CRC_FLAG | PACKET_CRC_ERROR_FLAG);
+				break;
+			default:
+				break;
+			}
+		}
+		else
+		{
+			switch (frame.mType)
+			{
+			case AbccMisoStates::SpiStatus:
+				if (control & ABP_SPI_STATUS_M)
+				{
+					summary.bFlags |= PACKET_MSG_FLAG;
+
+					if (control & ABP_SPI_STATUS_LAST_FRAG)
+					{
+						summary.bFlags |= PACKET_LAST_FRAG_FLAG;
+					}
+				}
+				break;
+			case AbccMisoStates::AnybusStatus:
+				summary.bStatus = (U8)frame.mData1;
+				summary.bFlags |= PACKET_STATUS_FLAG;
+				break;
+			case AbccMisoStates::Crc32:
+				summary.bFlags |= ((U32)frame.mData1 == (U32)frame.mData2) ? PACKET_CRC_FLAG : (PACKET_CRC_FLAG | PACKET_CRC_ERROR_FLAG);
+				break;
+			default:
+				break;
+			}
+		}
+	}
+
+	mSink->AddFrame(frame);
+}
+
+void AbccSpiDecoder::AddMarker(U64 sample, DecoderMarker marker, DecoderChannel channel)
+{
+	if (mConfig.fErrorMarkersOnly && !IsErrorMarker(marker))
+	{
+		return;
+	}
+
+	mSink->AddMarker(sample, marker, channel);
+}
+
+bool AbccSpiDecoder::DoesNextByteStartFrame(SpiChannel_t channel) const
+{
+	bool ready = (channel == SpiChannel::MOSI) ? mMosiReady : mMisoReady;
+	U32 byteCount = (channel == SpiChannel::MOSI) ? mMosiVars.dwByteCnt : mMisoVars.dwByteCnt;
+	bool processData = (channel == SpiChannel::MOSI) ?
+		((mMosiVars.eState == AbccMosiStates::WriteProcessData) && (mMosiVars.dwPdCnt > 0)) :
+		((mMisoVars.eState == AbccMisoStates::ReadProcessData) && (mMisoVars.dwPdCnt > 0));
+
+	if (ready)
+	{
+		// The next byte starts a new packet
+		return true;
+	}
+
+	// A coalesced process data block is one frame
+	return (byteCount == 0) && !(mConfig.fCoalesceProcessData && processData);
+}
+
+void AbccSpiDecoder::ResetPacketSummary()
+{
+	PacketChannelSummary_t* channels[] = { &mPacketSummary.sMosi, &mPacketSummary.sMiso };
+
+	mPacketSummary.lFirstSample = PACKET_SAMPLE_NONE;
+	mPacketSummary.lLastSample = PACKET_SAMPLE_NONE;
+
+	for (PacketChannelSummary_t* c : channels)
+	{
+		c->ePacketType = PacketType::Empty;
+		memset(&c->sMsgHeader, 0, sizeof(c->sMsgHeader));
+		c->bStatus = 0;
+		c->bFlags = 0;
+	}
+}
+
+void AbccSpiDecoder::AddFragFrame(SpiChannel_t channel, U64 first_sample, U64 last_sample)
+{
+	DecoderFrame_t errorFrame;
+
+	// Keep the process data received before the packet was cut short
+	AddProcessDataBlockFrame(channel);
+
+	errorFrame.mStartingSampleInclusive = first_sample;
+	errorFrame.mEndingSampleInclusive = last_sample;
+	errorFrame.mData1 = 0;
+	errorFrame.mType = AbccSpiError::Fragmentation;
+	errorFrame.mFlags = (SPI_ERROR_FLAG | DISPLAY_AS_ERROR_FLAG);
+
+	if (channel == SpiChannel::MOSI)
+	{
+		errorFrame.mFlags |= SPI_MOSI_FLAG;
+
+		// Only apply marker from MOSI, this prevents multiple markers at the same spot
+		// in such instances draw distance is reduced significantly.
+		if (mBus->HasEnableChannel())
+		{
+			AddMarker(last_sample, DecoderMarker::ErrorSquare, DecoderChannel::Enable);
+		}
+		else
+		{
+			U64 markerSample = first_sample + (last_sample - first_sample) / 2;
+			AddMarker(markerSample, DecoderMarker::ErrorSquare, DecoderChannel::Clock);
+		}
+	}
+
+	AddFrame(errorFrame);
+
+	SignalReadyForNewPacket(channel);
+	RestorePreviousStateVars();
+}
+
+void AbccSpiDecoder::AddProcessDataByte(SpiChannel_t channel, const DecoderFrame_t& byte_frame, bool last_byte)
+{
+	ProcessDataBlock_t& block = (channel == SpiChannel::MOSI) ? mMosiPdBlock : mMisoPdBlock;
+	const std::vector<U8>& packetBytes = (channel == SpiChannel::MOSI) ? mMosiPacketBytes : mMisoPacketBytes;
+
+	if (block.dwLength == 0)
+	{
+		// The byte was the last one added to the packet bytes
+		block.lFirstSample = byte_frame.mStartingSampleInclusive;
+		block.nFirstByte = packetBytes.size() - 1;
+	}
+
+	block.lLastSample = byte_frame.mEndingSampleInclusive;
+	block.bFlags = byte_frame.mFlags;
+	block.dwLength++;
+
+	if (last_byte)
+	{
+		AddProcessDataBlockFrame(channel);
+	}
+}
+
+void AbccSpiDecoder::AddProcessDataBlockFrame(SpiChannel_t channel)
+{
+	ProcessDataBlock_t& block = (channel == SpiChannel::MOSI) ? mMosiPdBlock : mMisoPdBlock;
+	const std::vector<U8>& packetBytes = (channel == SpiChannel::MOSI) ? mMosiPacketBytes : mMisoPacketBytes;
+	DecoderFrame_t resultFrame;
+
+	if ((block.dwLength == 0) || (block.nFirstByte + block.dwLength > packetBytes.size()))
+	{
+		block.dwLength = 0;
+		return;
+	}
+
+	resultFrame.mStartingSampleInclusive = block.lFirstSample;
+	resultFrame.mEndingSampleInclusive = block.lLastSample;
+	resultFrame.mData1 = mSink->StorePayload(&packetBytes[block.nFirstByte], block.dwLength);
+	resultFrame.mData2 = block.dwLength;
+	resultFrame.mFlags = block.bFlags | SPI_PD_BLOCK_FLAG;
+
+	if (channel == SpiChannel::MOSI)
+	{
+		resultFrame.mType = (U8)AbccMosiStates::WriteProcessData;
+	}
+	else
+	{
+		resultFrame.mType = (U8)AbccMisoStates::ReadProcessData;
+	}
+
+	AddFrame(resultFrame);
+	block.dwLength = 0;
+}
+
+void AbccSpiDecoder::AddMessageFieldFrame(SpiChannel_t channel, const DecoderFrame_t& field_frame)
+{
+	PacketMessageFields_t& fields = (channel == SpiChannel::MOSI) ? mMosiMsgFields : mMisoMsgFields;
+
+	if (!fields.fPresent)
+	{
+		fields.lFirstSample = field_frame.mStartingSampleInclusive;
+		fields.fPresent = true;
+		fields.fChecksumOk = false;
+		fields.fLastFragment = false;
+	}
+
+	fields.lLastSample = field_frame.mEndingSampleInclusive;
+}
+
+void AbccSpiDecoder::AddMessageFragment(SpiChannel_t channel)
+{
+	PacketMessageFields_t& fields = (channel == SpiChannel::MOSI) ? mMosiMsgFields : mMisoMsgFields;
+	const std::vector<U8>& packetBytes = (channel == SpiChannel::MOSI) ? mMosiPacketBytes : mMisoPacketBytes;
+	U32 messageId = (channel == SpiChannel::MOSI) ? mMosiVars.dwMsgId : mMisoVars.dwMsgId;
+	U32 messageLength = (channel == SpiChannel::MOSI) ? mMosiVars.dwMsgLen : mMisoVars.dwMsgLen;
+
+	if (fields.fPresent && !fields.fChecksumOk)
+	{
+		// Only the channel's own checksum failed
+		fields.fChecksumError = true;
+	}
+	else if (fields.fPresent && (messageId != ABCC_MSG_ID_NONE) &&
+			 (fields.nFirstByte + messageLength <= packetBytes.size()))
+	{
+		MessageFragmentInfo_t fragment;
+
+		fragment.lFirstSample = fields.lFirstSample;
+		fragment.lLastSample = fields.lLastSample;
+		fragment.pbData = &packetBytes[fields.nFirstByte];
+		fragment.dwLength = messageLength;
+		fragment.fLastFragment = fields.fLastFragment;
+		fragment.fRetransmission = fields.fRetransmission;
+		fragment.fChecksumError = fields.fChecksumError;
+
+		mSink->AddMessageFragment(messageId, fragment);
+		fields.fChecksumError = false;
+		fields.fAdded = true;
+	}
+
+	fields.fPresent = false;
+}
+
+void AbccSpiDecoder::DiscardMessageFragment(SpiChannel_t channel)
+{
+	PacketMessageFields_t& fields = (channel == SpiChannel::MOSI) ? mMosiMsgFields : mMisoMsgFields;
+
+	if (fields.fPresent)
+	{
+		fields.fChecksumError = true;
+		fields.fPresent = false;
+	}
+}
+
+/*
+** A packet sent with the same SPI_CTL toggle bit as the packet before it is
+** a retransmission, and both channels repeat their message fields. Only a
+** fragment that was added needs to be replaced.
+*/
+void AbccSpiDecoder::StartMessageFragments(U8 toggle)
+{
+	PacketMessageFields_t* fields[] = { &mMosiMsgFields, &mMisoMsgFields };
+
+	for (PacketMessageFields_t* f : fields)
+	{
+		f->fRetransmission = (f->fAdded && (f->bToggle == toggle));
+		f->fAdded = false;
+		f->bToggle = toggle;
+	}
+}
+
+void AbccSpiDecoder::ProcessMisoFrame(AbccMisoStates::Enum state, U64 frame_data, S64 frames_first_sample)
+{
+	DecoderFrame_t resultFrame;
+
+	resultFrame.mFlags = 0x00;
+	resultFrame.mType = (U8)state;
+	resultFrame.mStartingSampleInclusive = frames_first_sample;
+	resultFrame.mEndingSampleInclusive = (S64)mBus->GetClockSampleNumber();
+	resultFrame.mData1 = frame_data;
+
+
+	if (state == AbccMisoStates::MessageField_Object)
+	{
+		mMisoVars.sMsgHeader.obj = (U8)frame_data;
+		mMisoVars.wMdCnt = 0;
+	}
+	else if (state == AbccMisoStates::MessageField_Instance)
+	{
+		mMisoVars.sMsgHeader.inst = (U16)frame_data;
+
+		// Store the object code in frame data to handle object specific data
+		resultFrame.mData2 = mMisoVars.sMsgHeader.obj;
+	}
+	else if (state == AbccMisoStates::MessageField_Command)
+	{
+		mMisoVars.sMsgHeader.cmd = (U8)frame_data;
+
+		// Store the object code in frame data to handle object specific data
+		resultFrame.mData2 = mMisoVars.sMsgHeader.obj;
+
+		if ((frame_data & ABP_MSG_HEADER_E_BIT) == ABP_MSG_HEADER_E_BIT)
+		{
+			mMisoVars.fErrorRsp = true;
+		}
+		else
+		{
+			mMisoVars.fErrorRsp = false;
+		}
+	}
+	else if (state == AbccMisoStates::MessageField_CommandExtension)
+	{
+		// To better analyze the data in bubbletext
+		// store the object code, instance, and command
+		memcpy(&resultFrame.mData2, &mMisoVars.sMsgHeader, sizeof(mMisoVars.sMsgHeader));
+		mMisoVars.sMsgHeader.cmdExt = (U16)frame_data;
+		mSink->SetMessageHeader(mMisoVars.dwMsgId, mMisoVars.sMsgHeader);
+	}
+	else if (state == AbccMisoStates::MessageField_Size)
+	{
+		// A new message starts, its data frames refer to its table entry
+		mMisoVars.dwMsgId = mSink->OpenMessage(SpiChannel::MISO, mMisoMsgFields.fRetransmission);
+
+		if ((U16)frame_data > ABP_MAX_MSG_DATA_BYTES)
+		{
+			// Max message data size exceeded
+			resultFrame.mFlags |= (SPI_PROTO_EVENT_FLAG | DISPLAY_AS_ERROR_FLAG);
+			mMisoVars.wMdSize = 0;
+			mMisoVars.fFirstFrag = false;
+			mMisoVars.fLastFrag = false;
+			mMisoVars.fFragmentation = false;
+		}
+		else
+		{
+			mMisoVars.wMdSize = (U16)frame_data;
+		}
+	}
+	else if (state == AbccMisoStates::MessageField_Data)
+	{
+		MsgDataFrameData2_t* psFrameData2 = (MsgDataFrameData2_t*)&resultFrame.mData2;
+
+		if (mMisoVars.fErrorRsp)
+		{
+			resultFrame.mFlags |= SPI_PROTO_EVENT_FLAG;
+			// Check if data is 0xFF, if so delay de-assertion of fErrorRsp
+			// so that the object specific error response can be detected
+			if ((((U8)frame_data != (U8)0xFF) && (mMisoVars.wMdCnt == 0)) ||
+				(mMisoVars.wMdCnt > 1))
+			{
+				mMisoVars.fErrorRsp = false;
+			}
+		}
+
+		// Refer to the message's table entry so that the display of the
+		// data can be adapted based on the message header.
+		psFrameData2->msgId = mMisoVars.dwMsgId;
+
+		// Add a byte counter that can be displayed
+		// in the results for easy tracking of specific values
+		psFrameData2->msgDataCnt = mMisoVars.wMdCnt;
+		mMisoVars.wMdCnt++;
+
+		// Check if the message data counter has reached the end of valid data
+		if (mMisoVars.wMdCnt > mMisoVars.wMdSize)
+		{
+			// Override frame type
+			resultFrame.mType = (U8)AbccMisoStates::MessageField_DataNotValid;
+		}
+	}
+	else if (state == AbccMisoStates::MessageField_DataNotValid)
+	{
+		MsgDataFrameData2_t* psFrameData2 = (MsgDataFrameData2_t*)&resultFrame.mData2;
+
+		// The message field holds no new message
+		psFrameData2->msgId = ABCC_MSG_ID_NONE;
+	}
+	else if (state == AbccMisoStates::AnybusStatus)
+	{
+		if (mMisoVars.bLastAnbSts != (U8)frame_data)
+		{
+			// Anybus status change event
+			mMisoVars.bLastAnbSts = (U8)frame_data;
+			resultFrame.mFlags |= SPI_PROTO_EVENT_FLAG;
+			SetMisoPacketType(PacketType::ProtocolEvent);
+		}
+	}
+	else if (state == AbccMisoStates::NetworkTime)
+	{
+		NetworkTimeInfo_t* networkTimeInfo = reinterpret_cast<NetworkTimeInfo_t*>(&resultFrame.mData2);
+		// Compute delta from last timestamp and save it
+		networkTimeInfo->deltaTime = (U32)resultFrame.mData1 - mMisoVars.dwLastTimestamp;
+		networkTimeInfo->newRdPd = mMisoVars.fNewRdPd;
+		networkTimeInfo->wrPdValid = mMosiVars.fWrPdValid;
+		mMisoVars.fNewRdPd = false;
+		mMosiVars.fWrPdValid = false;
+		mMisoVars.dwLastTimestamp = (U32)resultFrame.mData1;
+	}
+	else if (state == AbccMisoStates::SpiStatus)
+	{
+		if ((U8)(frame_data & ABP_SPI_STATUS_WRMSG_FULL))
+		{
+			// Write message buffer is full, possible overrun
+			resultFrame.mFlags |= (SPI_PROTO_EVENT_FLAG | DISPLAY_AS_WARNING_FLAG);
+			SetMisoPacketType(PacketType::ProtocolEvent);
+		}
+	}
+	else if (state == AbccMisoStates::Crc32)
+	{
+		// Checksum the packet in one go and save the computed CRC32 to the
+		// unused frame data
+		resultFrame.mData2 = ComputePacketCrc32(mMisoPacketBytes);
+
+		if (resultFrame.mData2 != resultFrame.mData1)
+		{
+			// CRC Error
+			resultFrame.mFlags |= (SPI_PROTO_EVENT_FLAG | DISPLAY_AS_ERROR_FLAG);
+		}
+
+		mMisoMsgFields.fChecksumOk = (resultFrame.mData2 == resultFrame.mData1);
+		mMisoMsgFields.fLastFragment = mMisoVars.fLastFrag;
+	}
+
+	if (mMisoVars.fNewMsg &&
+		(((state >= AbccMisoStates::MessageField_Size) && (state <= AbccMisoStates::MessageField_Data)) ||
+		 (state == AbccMisoStates::MessageField_DataNotValid)))
+	{
+		AddMessageFieldFrame(SpiChannel::MISO, resultFrame);
+	}
+
+	// Add a byte counter that can be displayed
+	// in the results for easy tracking of specific values
+	if (state == AbccMisoStates::ReadProcessData)
+	{
+		resultFrame.mData2 = (U64)mMisoVars.dwPdCnt;
+		mMisoVars.dwPdCnt++;
+	}
+	else
+	{
+		mMisoVars.dwPdCnt = 0;
+	}
+
+	// Handle indication of the SPI message fragmentation protocol
+	if (mMisoVars.fFragmentation)
+	{
+		resultFrame.mFlags |= (SPI_MSG_FRAG_FLAG);
+
+		if (mMisoVars.fFirstFrag)
+		{
+			resultFrame.mFlags |= (SPI_MSG_FIRST_FRAG_FLAG);
+		}
+
+		if (state == AbccMisoStates::Crc32)
+		{
+			mMisoVars.fFirstFrag = false;
+
+			if (mMisoVars.fLastFrag)
+			{
+				mMisoVars.fLastFrag = false;
+				mMisoVars.fFragmentation = false;
+			}
+		}
+	}
+
+	if (state == AbccMisoStates::Crc32)
+	{
+		if (resultFrame.HasFlag(DISPLAY_AS_ERROR_FLAG))
+		{
+			SetMisoPacketType(PacketType::ChecksumError);
+			RestorePreviousStateVars();
+
+			// The message fields are retransmitted
+			DiscardMessageFragment(SpiChannel::MISO);
+			DiscardMessageFragment(SpiChannel::MOSI);
+		}
+		else
+		{
+			// Backup state variables for both MOSI and MISO
+			memcpy(&mPreviousMisoVars, &mMisoVars, sizeof(MisoVars_t));
+			memcpy(&mPreviousMosiVars, &mMosiVars, sizeof(MosiVars_t));
+
+			AddMessageFragment(SpiChannel::MISO);
+			AddMessageFragment(SpiChannel::MOSI);
+		}
+
+		if (mMisoVars.fNewMsg)
+		{
+			if (resultFrame.HasFlag(SPI_MSG_FRAG_FLAG) &&
+				!resultFrame.HasFlag(SPI_MSG_FIRST_FRAG_FLAG))
+			{
+				SetMisoPacketType(PacketType::MessageFragment);
+			}
+			else
+			{
+				if (mMisoVars.sMsgHeader.cmd & ABP_MSG_HEADER_C_BIT)
+				{
+					SetMisoPacketType(PacketType::Command);
+				}
+				else if (mMisoVars.sMsgHeader.cmd & ABP_MSG_HEADER_E_BIT)
+				{
+					SetMisoPacketType(PacketType::ErrorResponse);
+				}
+				else
+				{
+					SetMisoPacketType(PacketType::Response);
+				}
+			}
+		}
+	}
+	else if (resultFrame.HasFlag(DISPLAY_AS_ERROR_FLAG))
+	{
+		SetMisoPacketType(PacketType::ProtocolError);
+	}
+
+	if (mConfig.fCoalesceProcessData && (state == AbccMisoStates::ReadProcessData))
+	{
+		// The block is added as one frame once its last byte is received
+		AddProcessDataByte(SpiChannel::MISO, resultFrame, (mMisoVars.eState != AbccMisoStates::ReadProcessData));
+		return;
+	}
+
+	// Commit the processed frame
+	AddFrame(resultFrame);
+	mSink->CommitResults();
+
+	if (state == AbccMisoStates::Crc32)
+	{
+		SignalReadyForNewPacket(SpiChannel::MISO);
+	}
+}
+
+void AbccSpiDecoder::ProcessMosiFrame(AbccMosiStates::Enum state, U64 frame_data, S64 frames_first_sample)
+{
+	DecoderFrame_t resultFrame;
+
+	resultFrame.mFlags = SPI_MOSI_FLAG;
+	resultFrame.mType = (U8)state;
+	resultFrame.mStartingSampleInclusive = frames_first_sample;
+	resultFrame.mEndingSampleInclusive = (S64)mBus->GetClockSampleNumber();
+	resultFrame.mData1 = frame_data;
+
+
+	if (state == AbccMosiStates::MessageField_Object)
+	{
+		mMosiVars.sMsgHeader.obj = (U8)frame_data;
+		mMosiVars.wMdCnt = 0;
+	}
+	else if (state == AbccMosiStates::MessageField_Instance)
+	{
+		mMosiVars.sMsgHeader.inst = (U16)frame_data;
+
+		// Store the object code in frame data to handle object specific data
+		resultFrame.mData2 = mMosiVars.sMsgHeader.obj;
+	}
+	else if (state == AbccMosiStates::MessageField_Command)
+	{
+		mMosiVars.sMsgHeader.cmd = (U8)frame_data;
+
+		// Store the object code in frame data to handle object specific data
+		resultFrame.mData2 = mMosiVars.sMsgHeader.obj;
+
+		if ((frame_data & ABP_MSG_HEADER_E_BIT) == ABP_MSG_HEADER_E_BIT)
+		{
+			mMosiVars.fErrorRsp = true;
+		}
+		else
+		{
+			mMosiVars.fErrorRsp = false;
+		}
+	}
+	else if (state == AbccMosiStates::MessageField_CommandExtension)
+	{
+		// To better analyze the data in bubbletext
+		// store the object code, instance, and command
+		memcpy(&resultFrame.mData2, &mMosiVars.sMsgHeader, sizeof(mMosiVars.sMsgHeader));
+		mMosiVars.sMsgHeader.cmdExt = (U16)frame_data;
+		mSink->SetMessageHeader(mMosiVars.dwMsgId, mMosiVars.sMsgHeader);
+	}
+	else if (state == AbccMosiStates::MessageField_Size)
+	{
+		// A new message starts, its data frames refer to its table entry
+		mMosiVars.dwMsgId = mSink->OpenMessage(SpiChannel::MOSI, mMosiMsgFields.fRetransmission);
+
+		if ((U16)frame_data > ABP_MAX_MSG_DATA_BYTES)
+		{
+			// Max message data size exceeded
+			resultFrame.mFlags |= (SPI_PROTO_EVENT_FLAG | DISPLAY_AS_ERROR_FLAG);
+			mMosiVars.wMdSize = 0;
+			mMosiVars.fFirstFrag = false;
+			mMosiVars.fLastFrag = false;
+			mMosiVars.fFragmentation = false;
+		}
+		else
+		{
+			mMosiVars.wMdSize = (U16)frame_data;
+		}
+	}
+	else if (state == AbccMosiStates::MessageField_Data)
+	{
+		MsgDataFrameData2_t* psFrameData2 = (MsgDataFrameData2_t*)&resultFrame.mData2;
+
+		if (mMosiVars.fErrorRsp)
+		{
+			resultFrame.mFlags |= SPI_PROTO_EVENT_FLAG;
+
+			// Check if data is 0xFF, if so delay de-assertion of fErrorRsp
+			// so that the object specific error response can be detected
+			if ((((U8)frame_data != (U8)0xFF) && (mMosiVars.wMdCnt == 0)) ||
+				(mMosiVars.wMdCnt > 1))
+			{
+				mMosiVars.fErrorRsp = false;
+			}
+		}
+
+		// Refer to the message's table entry so that the display of the
+		// data can be adapted based on the message header.
+		psFrameData2->msgId = mMosiVars.dwMsgId;
+
+		// Add a byte counter that can be displayed
+		// in the results for easy tracking of specific values
+		psFrameData2->msgDataCnt = mMosiVars.wMdCnt;
+		mMosiVars.wMdCnt++;
+
+		// Check if the message data counter has reached the end of valid data
+		if (mMosiVars.wMdCnt > mMosiVars.wMdSize)
+		{
+			// Override frame type
+			resultFrame.mType = (U8)AbccMosiStates::MessageField_DataNotValid;
+		}
+	}
+	else if (state == AbccMosiStates::MessageField_DataNotValid)
+	{
+		MsgDataFrameData2_t* psFrameData2 = (MsgDataFrameData2_t*)&resultFrame.mData2;
+
+		// The message field holds no new message
+		psFrameData2->msgId = ABCC_MSG_ID_NONE;
+	}
+	else if (state == AbccMosiStates::ApplicationStatus)
+	{
+		if (mMosiVars.bLastApplSts != (U8)frame_data)
+		{
+			// Application status change event
+			mMosiVars.bLastApplSts = (U8)frame_data;
+			resultFrame.mFlags |= SPI_PROTO_EVENT_FLAG;
+			SetMosiPacketType(PacketType::ProtocolEvent);
+		}
+	}
+	else if (state == AbccMosiStates::SpiControl)
+	{
+		StartMessageFragments((U8)(frame_data & ABP_SPI_CTRL_T));
+
+		if (mMosiVars.bLastToggleState == (U8)(frame_data & ABP_SPI_CTRL_T))
+		{
+			// Retransmit event
+			resultFrame.mFlags |= SPI_PROTO_EVENT_FLAG;
+			SetMosiPacketType(PacketType::ProtocolEvent);
+		}
+		else
+		{
+			mMosiVars.bLastToggleState = (U8)(frame_data & ABP_SPI_CTRL_T);
+		}
+	}
+	else if (state == AbccMosiStates::Crc32)
+	{
+		// Checksum the packet in one go and save the computed CRC32 to the
+		// unused frame data
+		resultFrame.mData2 = ComputePacketCrc32(mMosiPacketBytes);
+
+		if (resultFrame.mData2 != resultFrame.mData1)
+		{
+			// CRC Error
+			resultFrame.mFlags |= (SPI_PROTO_EVENT_FLAG | DISPLAY_AS_ERROR_FLAG);
+		}
+
+		mMosiMsgFields.fChecksumOk = (resultFrame.mData2 == resultFrame.mData1);
+		mMosiMsgFields.fLastFragment = mMosiVars.fLastFrag;
+	}
+
+	if (mMosiVars.fNewMsg &&
+		(((state >= AbccMosiStates::MessageField_Size) && (state <= AbccMosiStates::MessageField_Data)) ||
+		 (state == AbccMosiStates::MessageField_DataNotValid)))
+	{
+		AddMessageFieldFrame(SpiChannel::MOSI, resultFrame);
+	}
+
+	// Add a byte counter that can be displayed
+	// in the results for easy tracking of specific values
+	if (state == AbccMosiStates::WriteProcessData)
+	{
+		resultFrame.mData2 = (U64)mMosiVars.dwPdCnt;
+		mMosiVars.dwPdCnt++;
+	}
+	else
+	{
+		mMosiVars.dwPdCnt = 0;
+	}
+
+	// Handle indication of the SPI message fragmentation protocol
+	if (mMosiVars.fFragmentation)
+	{
+		resultFrame.mFlags |= (SPI_MSG_FRAG_FLAG);
+
+		if (mMosiVars.fFirstFrag)
+		{
+			resultFrame.mFlags |= SPI_MSG_FIRST_FRAG_FLAG;
+		}
+		if (state == AbccMosiStates::Pad)
+		{
+			mMosiVars.fFirstFrag = false;
+
+			if (mMosiVars.fLastFrag)
+			{
+				mMosiVars.fLastFrag = false;
+				mMosiVars.fFragmentation = false;
+			}
+		}
+	}
+
+	if (resultFrame.HasFlag(DISPLAY_AS_ERROR_FLAG))
+	{
+		if (state == AbccMosiStates::Crc32)
+		{
+			SetMosiPacketType(PacketType::ChecksumError);
+		}
+		else
+		{
+			SetMosiPacketType(PacketType::ProtocolError);
+		}
+	}
+
+	if (state == AbccMosiStates::Pad)
+	{
+		if (mMosiVars.fNewMsg)
+		{
+			if (resultFrame.HasFlag(SPI_MSG_FRAG_FLAG) &&
+				!resultFrame.HasFlag(SPI_MSG_FIRST_FRAG_FLAG))
+			{
+				SetMosiPacketType(PacketType::MessageFragment);
+			}
+			else
+			{
+				if (mMosiVars.sMsgHeader.cmd & ABP_MSG_HEADER_C_BIT)
+				{
+					SetMosiPacketType(PacketType::Command);
+				}
+				else if (mMosiVars.sMsgHeader.cmd & ABP_MSG_HEADER_E_BIT)
+				{
+					SetMosiPacketType(PacketType::ErrorResponse);
+				}
+				else
+				{
+					SetMosiPacketType(PacketType::Response);
+				}
+			}
+		}
+	}
+
+	if (mConfig.fCoalesceProcessData && (state == AbccMosiStates::WriteProcessData))
+	{
+		// The block is added as one frame once its last byte is received
+		AddProcessDataByte(SpiChannel::MOSI, resultFrame, (mMosiVars.eState != AbccMosiStates::WriteProcessData));
+		return;
+	}
+
+	// Commit the processed frame
+	AddFrame(resultFrame);
+	mSink->CommitResults();
+
+	if (state == AbccMosiStates::Pad)
+	{
+		SignalReadyForNewPacket(SpiChannel::MOSI);
+	}
+}
+
+void AbccSpiDecoder::SetMosiPacketType(PacketType packet_type)
+{
+	switch (packet_type)
+	{
+	case PacketType::Empty:
+	case PacketType::Cancel:
+		mMosiVars.ePacketType = packet_type;
+		break;
+	case PacketType::ProtocolError:
+	case PacketType::ChecksumError:
+	case PacketType::ErrorResponse:
+		if (mMosiVars.ePacketType == PacketType::Empty)
+		{
+			mMosiVars.ePacketType = packet_type;
+		}
+		else if (mMosiVars.ePacketType != packet_type)
+		{
+			mMosiVars.ePacketType = PacketType::MultiEventWithError;
+		}
+		break;
+	case PacketType::Response:
+	case PacketType::Command:
+	case PacketType::MessageFragment:
+	case PacketType::ProtocolEvent:
+		if (mMosiVars.ePacketType == PacketType::Empty)
+		{
+			mMosiVars.ePacketType = packet_type;
+		}
+		else if (IsErrorPacketType(mMosiVars.ePacketType))
+		{
+			mMosiVars.ePacketType = PacketType::MultiEventWithError;
+		}
+		else if (mMosiVars.ePacketType != packet_type)
+		{
+			mMosiVars.ePacketType = PacketType::MultiEvent;
+		}
+		break;
+	default:
+	case PacketType::MultiEvent:
+	case PacketType::MultiEventWithError:
+		break;
+	}
+}
+
+void AbccSpiDecoder::SetMisoPacketType(PacketType packet_type)
+{
+	switch (packet_type)
+	{
+	case PacketType::Empty:
+	case PacketType::Cancel:
+		mMisoVars.ePacketType = packet_type;
+		break;
+	case PacketType::ProtocolError:
+	case PacketType::ChecksumError:
+	case PacketType::ErrorResponse:
+		if (mMisoVars.ePacketType == PacketType::Empty)
+		{
+			mMisoVars.ePacketType = packet_type;
+		}
+		else if (mMisoVars.ePacketType != packet_type)
+		{
+			mMisoVars.ePacketType = PacketType::MultiEventWithError;
+		}
+		break;
+	case PacketType::Response:
+	case PacketType::Command:
+	case PacketType::MessageFragment:
+	case PacketType::ProtocolEvent:
+		if (mMisoVars.ePacketType == PacketType::Empty)
+		{
+			mMisoVars.ePacketType = packet_type;
+		}
+		else if (IsErrorPacketType(mMisoVars.ePacketType))
+		{
+			mMisoVars.ePacketType = PacketType::MultiEventWithError;
+		}
+		else if (mMisoVars.ePacketType != packet_type)
+		{
+			mMisoVars.ePacketType = PacketType::MultiEvent;
+		}
+		break;
+	default:
+	case PacketType::MultiEvent:
+	case PacketType::MultiEventWithError:
+		break;
+	}
+}
+
+bool AbccSpiDecoder::RunAbccMisoStateMachine(StateOperation operation, AcquisitionStatus acquisition_status, U64 miso_data, S64 first_sample)
+{
+	AbccMisoStates::Enum eMsgSubState = AbccMisoStates::MessageField_Size;
+	AbccMisoStates::Enum eMisoState_Current = AbccMisoStates::Idle;
+	bool addFrame = false;
+
+	eMisoState_Current = mMisoVars.eState;
+
+	// If an error is signaled we jump into IDLE and wait to be reset.
+	// A reset should be logically signaled when CS# is brought HIGH.
+	// This would essentially indicate the begining of a new transaction.
+	if ((operation != StateOperation::Reset) && ((acquisition_status == AcquisitionStatus::Error) || !mBus->IsEnableActive()))
+	{
+		mMisoVars.eState = AbccMisoStates::Idle;
+
+		if (mMisoVars.dwByteCnt == 0)
+		{
+			mMisoVars.lFramesFirstSample = first_sample;
+		}
+
+		if (mBus->HasEnableChannel())
+		{
+			AddFragFrame(SpiChannel::MISO, mMisoVars.lFramesFirstSample, mBus->GetSampleOfNextEnableEdge());
+		}
+		else
+		{
+			// 3-wire mode fragments exist only when idle gaps are detected too soon.
+			AddFragFrame(SpiChannel::MISO, mMisoVars.lFramesFirstSample, mBus->GetSampleOfNextClockEdge());
+		}
+
+		mSink->CommitResults();
+		return true;
+	}
+
+	if (mMisoVars.eState == AbccMisoStates::Idle)
+	{
+		AddProcessDataBlockFrame(SpiChannel::MISO);
+		mMisoPacketBytes.clear();
+		mMisoMsgFields.fPresent = false;
+		mMisoVars.lFrameData = 0;
+		mMisoVars.dwByteCnt = 0;
+
+		if (operation == StateOperation::Reset)
+		{
+			mMisoVars.eState = AbccMisoStates::Reserved1;
+			eMisoState_Current = mMisoVars.eState;
+		}
+	}
+
+	if (mMisoVars.dwByteCnt == 0)
+	{
+		mMisoVars.lFramesFirstSample = first_sample;
+	}
+
+	mMisoVars.lFrameData |= (miso_data << (8 * mMisoVars.dwByteCnt));
+	mMisoVars.dwByteCnt++;
+
+	if (mMisoVars.eState != AbccMisoStates::Crc32)
+	{
+		mMisoPacketBytes.push_back((U8)miso_data);
+	}
+
+	switch (mMisoVars.eState)
+	{
+	case AbccMisoStates::Idle:
+		// We wait here until a reset is signaled
+		break;
+	case AbccMisoStates::Reserved1:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			addFrame = true;
+			mMisoVars.eState = AbccMisoStates::Reserved2;
+		}
+		break;
+	case AbccMisoStates::Reserved2:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			addFrame = true;
+			mMisoVars.eState = AbccMisoStates::LedStatus;
+		}
+		break;
+	case AbccMisoStates::LedStatus:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			addFrame = true;
+			mMisoVars.eState = AbccMisoStates::AnybusStatus;
+		}
+		break;
+	case AbccMisoStates::AnybusStatus:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			addFrame = true;
+			mMisoVars.eState = AbccMisoStates::SpiStatus;
+		}
+		break;
+	case AbccMisoStates::SpiStatus:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			mMisoVars.fNewRdPd = ((mMisoVars.lFrameData & ABP_SPI_STATUS_NEW_PD) == ABP_SPI_STATUS_NEW_PD);
+
+			if ((mMisoVars.lFrameData & (ABP_SPI_STATUS_LAST_FRAG | ABP_SPI_STATUS_M)) == ABP_SPI_STATUS_M)
+			{
+				// New message but not the last
+				mMisoVars.fNewMsg = true;
+
+				if (!mMisoVars.fFragmentation)
+				{
+					// Message fragmentation starts
+					mMisoVars.fFragmentation = true;
+					mMisoVars.fFirstFrag = true;
+					mMisoVars.fLastFrag = false;
+				}
+			}
+			else if ((mMisoVars.lFrameData & (ABP_SPI_STATUS_LAST_FRAG | ABP_SPI_STATUS_M)) == (ABP_SPI_STATUS_LAST_FRAG | ABP_SPI_STATUS_M))
+			{
+				// New message and last
+				mMisoVars.fNewMsg = true;
+
+				// Message fragmentation ends
+				mMisoVars.fLastFrag = true;
+				mMisoVars.fFirstFrag = !mMisoVars.fFragmentation;
+			}
+			else
+			{
+				// No new message
+				mMisoVars.fNewMsg = false;
+				mMisoVars.eMsgSubState = AbccMisoStates::MessageField_DataNotValid;
+				mMisoVars.wMdCnt = 0;
+				mMisoVars.wMdSize = 0;
+			}
+
+			addFrame = true;
+			mMisoVars.eState = AbccMisoStates::NetworkTime;
+		}
+		break;
+	case AbccMisoStates::NetworkTime:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			addFrame = true;
+
+			if (mMisoVars.dwMsgLenCnt != 0)
+			{
+				mMisoVars.eState = AbccMisoStates::MessageField;
+				mMisoMsgFields.nFirstByte = mMisoPacketBytes.size();
+
+				if (mMisoVars.fNewMsg && mMisoVars.fFirstFrag)
+				{
+					RunAbccMisoMsgSubStateMachine(StateOperation::Reset, nullptr, nullptr);
+				}
+			}
+			else if (mMisoVars.dwPdLen != 0)
+			{
+				mMisoVars.eState = AbccMisoStates::ReadProcessData;
+			}
+			else
+			{
+				mMisoVars.eState = AbccMisoStates::Crc32;
+			}
+		}
+		break;
+	case AbccMisoStates::MessageField:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			if (!RunAbccMisoMsgSubStateMachine(StateOperation::Run, &addFrame, &eMsgSubState))
+			{
+				// Error, transition to idle and wait for reset
+				mMisoVars.eState = AbccMisoStates::Idle;
+			}
+
+			if (mMisoVars.dwMsgLenCnt == 1)
+			{
+				if (mMisoVars.dwPdLen != 0)
+				{
+					mMisoVars.eState = AbccMisoStates::ReadProcessData;
+				}
+				else
+				{
+					mMisoVars.eState = AbccMisoStates::Crc32;
+				}
+			}
+
+			mMisoVars.dwMsgLenCnt--;
+		}
+		break;
+	case AbccMisoStates::ReadProcessData:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			if (mMisoVars.dwPdLen == 1)
+			{
+				mMisoVars.eState = AbccMisoStates::Crc32;
+			}
+
+			addFrame = true;
+			mMisoVars.dwPdLen--;
+		}
+		break;
+	case AbccMisoStates::Crc32:
+		if (mMisoVars.dwByteCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eState))
+		{
+			addFrame = true;
+			mMisoVars.eState = AbccMisoStates::Idle;
+		}
+		break;
+	case AbccMisoStates::MessageField_Size:
+	case AbccMisoStates::MessageField_Reserved1:
+	case AbccMisoStates::MessageField_SourceId:
+	case AbccMisoStates::MessageField_Object:
+	case AbccMisoStates::MessageField_Instance:
+	case AbccMisoStates::MessageField_Command:
+	case AbccMisoStates::MessageField_Reserved2:
+	case AbccMisoStates::MessageField_CommandExtension:
+	case AbccMisoStates::MessageField_Data:
+	default:
+		mMisoVars.eState = AbccMisoStates::Idle;
+		break;
+	}
+
+	if (mBus->WouldAdvancingTheClockToggleEnable())
+	{
+		if (mMisoVars.eState != AbccMisoStates::Idle)
+		{
+			// We have a fragmented message
+			if (mBus->HasEnableChannel())
+			{
+				AddFragFrame(SpiChannel::MISO, mMisoVars.lFramesFirstSample, mBus->GetSampleOfNextEnableEdge());
+			}
+			else
+			{
+				AddFragFrame(SpiChannel::MISO, mMisoVars.lFramesFirstSample, mBus->GetClockSampleNumber());
+			}
+
+			mMisoVars.eState = AbccMisoStates::Idle;
+			mMisoVars.lFrameData = 0;
+			mMisoVars.dwByteCnt = 0;
+			return true;
+		}
+	}
+
+	if (addFrame)
+	{
+		if (eMisoState_Current == AbccMisoStates::MessageField)
+		{
+			ProcessMisoFrame(eMsgSubState, mMisoVars.lFrameData, mMisoVars.lFramesFirstSample);
+		}
+		else
+		{
+			ProcessMisoFrame(eMisoState_Current, mMisoVars.lFrameData, mMisoVars.lFramesFirstSample);
+
+			if ((eMisoState_Current == AbccMisoStates::Crc32) && (mMisoVars.fLastFrag && (mMisoVars.dwMsgLenCnt == 0)))
+			{
+				RunAbccMisoMsgSubStateMachine(StateOperation::Reset, nullptr, nullptr);
+			}
+		}
+
+		// Reset the state variables
+		mMisoVars.lFrameData = 0;
+		mMisoVars.dwByteCnt = 0;
+	}
+
+	if (mBus->WouldAdvancingTheClockToggleEnable())
+	{
+		mMisoVars.eState = AbccMisoStates::Idle;
+		mMisoVars.lFrameData = 0;
+		mMisoVars.dwByteCnt = 0;
+	}
+
+	return (mMisoVars.eState == AbccMisoStates::Idle);
+}
+
+bool AbccSpiDecoder::RunAbccMosiStateMachine(StateOperation operation, AcquisitionStatus acquisition_status, U64 mosi_data, S64 first_sample)
+{
+	AbccMosiStates::Enum eMsgSubState = AbccMosiStates::MessageField_Size;
+	AbccMosiStates::Enum eMosiState_Current;
+	bool addFrame = false;
+
+	eMosiState_Current = mMosiVars.eState;
+
+	// If an error is signaled we jump into IDLE and wait to be reset.
+	// A reset should be logically signaled when CS# is brought HIGH.
+	// This would essentially indicate the begining of a new transaction.
+	if ((operation != StateOperation::Reset) && ((acquisition_status == AcquisitionStatus::Error) || !mBus->IsEnableActive()))
+	{
+		if (mMosiVars.dwByteCnt == 0)
+		{
+			mMosiVars.lFramesFirstSample = first_sample;
+		}
+
+		mMosiVars.eState = AbccMosiStates::Idle;
+
+		if (mBus->HasEnableChannel())
+		{
+			AddFragFrame(SpiChannel::MOSI, mMosiVars.lFramesFirstSample, mBus->GetSampleOfNextEnableEdge());
+		}
+		else
+		{
+			// 3-wire mode fragments exist only when idle gaps are detected too soon.
+			AddFragFrame(SpiChannel::MOSI, mMosiVars.lFramesFirstSample, mBus->GetSampleOfNextClockEdge());
+		}
+
+		mSink->CommitResults();
+		return true;
+	}
+
+	if (mMosiVars.eState == AbccMosiStates::Idle)
+	{
+		AddProcessDataBlockFrame(SpiChannel::MOSI);
+		mMosiPacketBytes.clear();
+		mMosiMsgFields.fPresent = false;
+		mMosiVars.lFrameData = 0;
+		mMosiVars.dwByteCnt = 0;
+
+		if (operation == StateOperation::Reset)
+		{
+			mMosiVars.eState = AbccMosiStates::SpiControl;
+			eMosiState_Current = mMosiVars.eState;
+		}
+	}
+
+	if (mMosiVars.dwByteCnt == 0)
+	{
+		mMosiVars.lFramesFirstSample = first_sample;
+	}
+
+	mMosiVars.lFrameData |= (mosi_data << (8 * mMosiVars.dwByteCnt));
+	mMosiVars.dwByteCnt++;
+
+	if (mMosiVars.eState != AbccMosiStates::Crc32)
+	{
+		mMosiPacketBytes.push_back((U8)mosi_data);
+	}
+
+	switch (mMosiVars.eState)
+	{
+	case AbccMosiStates::Idle:
+		// We wait here until a reset is signaled
+		break;
+	case AbccMosiStates::SpiControl:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			mMosiVars.fWrPdValid = ((mMosiVars.lFrameData & ABP_SPI_CTRL_WRPD_VALID) == ABP_SPI_CTRL_WRPD_VALID);
+
+			if ((mMosiVars.lFrameData & (ABP_SPI_CTRL_LAST_FRAG | ABP_SPI_CTRL_M)) == ABP_SPI_CTRL_M)
+			{
+				// New message but not the last
+				mMosiVars.fNewMsg = true;
+
+				if (!mMosiVars.fFragmentation)
+				{
+					// Message fragmentation starts
+					mMosiVars.fFragmentation = true;
+					mMosiVars.fFirstFrag = true;
+					mMosiVars.fLastFrag = false;
+				}
+			}
+			else if ((mMosiVars.lFrameData & (ABP_SPI_CTRL_LAST_FRAG | ABP_SPI_CTRL_M)) == (ABP_SPI_CTRL_LAST_FRAG | ABP_SPI_CTRL_M))
+			{
+				// New message and last
+				mMosiVars.fNewMsg = true;
+
+				// Message fragmentation ends
+				mMosiVars.fLastFrag = true;
+				mMosiVars.fFirstFrag = !mMosiVars.fFragmentation;
+			}
+			else
+			{
+				// No new message
+				mMosiVars.fNewMsg = false;
+				mMosiVars.eMsgSubState = AbccMosiStates::MessageField_DataNotValid;
+				mMosiVars.wMdCnt = 0;
+				mMosiVars.wMdSize = 0;
+			}
+
+			addFrame = true;
+			mMosiVars.eState = AbccMosiStates::Reserved1;
+		}
+		break;
+	case AbccMosiStates::Reserved1:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			addFrame = true;
+			mMosiVars.eState = AbccMosiStates::MessageLength;
+		}
+		break;
+	case AbccMosiStates::MessageLength:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			addFrame = true;
+			mMosiVars.dwMsgLen = (U32)mMosiVars.lFrameData * 2;
+			mMosiVars.dwMsgLenCnt = mMosiVars.dwMsgLen;
+			mMisoVars.dwMsgLen = mMosiVars.dwMsgLen;
+			mMisoVars.dwMsgLenCnt = mMosiVars.dwMsgLen;
+			mMosiVars.eState = AbccMosiStates::ProcessDataLength;
+		}
+		break;
+	case AbccMosiStates::ProcessDataLength:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			addFrame = true;
+			mMosiVars.dwPdLen = (U32)mMosiVars.lFrameData * 2;
+			mMisoVars.dwPdLen = mMosiVars.dwPdLen;
+			mMosiVars.eState = AbccMosiStates::ApplicationStatus;
+		}
+		break;
+	case AbccMosiStates::ApplicationStatus:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			addFrame = true;
+			mMosiVars.eState = AbccMosiStates::InterruptMask;
+		}
+		break;
+	case AbccMosiStates::InterruptMask:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			addFrame = true;
+
+			if (mMosiVars.dwMsgLenCnt != 0)
+			{
+				mMosiVars.eState = AbccMosiStates::MessageField;
+				mMosiMsgFields.nFirstByte = mMosiPacketBytes.size();
+
+				if (mMosiVars.fNewMsg && mMosiVars.fFirstFrag)
+				{
+					RunAbccMosiMsgSubStateMachine(StateOperation::Reset, nullptr, nullptr);
+				}
+			}
+			else if (mMosiVars.dwPdLen != 0)
+			{
+				mMosiVars.eState = AbccMosiStates::WriteProcessData;
+			}
+			else
+			{
+				mMosiVars.eState = AbccMosiStates::Crc32;
+			}
+		}
+		break;
+	case AbccMosiStates::MessageField:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			if (!RunAbccMosiMsgSubStateMachine(StateOperation::Run, &addFrame, &eMsgSubState))
+			{
+				// Error, transition to idle and wait for reset
+				mMosiVars.eState = AbccMosiStates::Idle;
+			}
+
+			if (mMosiVars.dwMsgLenCnt == 1)
+			{
+				if (mMosiVars.dwPdLen != 0)
+				{
+					mMosiVars.eState = AbccMosiStates::WriteProcessData;
+				}
+				else
+				{
+					mMosiVars.eState = AbccMosiStates::Crc32;
+				}
+			}
+
+			mMosiVars.dwMsgLenCnt--;
+		}
+		break;
+	case AbccMosiStates::WriteProcessData:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			if (mMosiVars.dwPdLen == 1)
+			{
+				mMosiVars.eState = AbccMosiStates::Crc32;
+			}
+
+			addFrame = true;
+			mMosiVars.dwPdLen--;
+		}
+		break;
+	case AbccMosiStates::Crc32:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			addFrame = true;
+			mMosiVars.eState = AbccMosiStates::Pad;
+		}
+		break;
+	case AbccMosiStates::Pad:
+		if (mMosiVars.dwByteCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eState))
+		{
+			addFrame = true;
+			mMosiVars.eState = AbccMosiStates::Idle;
+		}
+		break;
+	case AbccMosiStates::MessageField_Size:
+	case AbccMosiStates::MessageField_Reserved1:
+	case AbccMosiStates::MessageField_SourceId:
+	case AbccMosiStates::MessageField_Object:
+	case AbccMosiStates::MessageField_Instance:
+	case AbccMosiStates::MessageField_Command:
+	case AbccMosiStates::MessageField_Reserved2:
+	case AbccMosiStates::MessageField_CommandExtension:
+	case AbccMosiStates::MessageField_Data:
+	default:
+		mMosiVars.eState = AbccMosiStates::Idle;
+		break;
+	}
+
+	if (mBus->WouldAdvancingTheClockToggleEnable())
+	{
+		if (mMosiVars.eState != AbccMosiStates::Idle)
+		{
+			// We have a fragmented message
+			if (mBus->HasEnableChannel())
+			{
+				AddFragFrame(SpiChannel::MOSI, mMosiVars.lFramesFirstSample, mBus->GetSampleOfNextEnableEdge());
+			}
+			else
+			{
+				AddFragFrame(SpiChannel::MOSI, mMosiVars.lFramesFirstSample, mBus->GetSampleOfNextClockEdge());
+			}
+
+			mMosiVars.eState = AbccMosiStates::Idle;
+			mMosiVars.lFrameData = 0;
+			mMosiVars.dwByteCnt = 0;
+			return true;
+		}
+	}
+
+	if (addFrame)
+	{
+		if (eMosiState_Current == AbccMosiStates::MessageField)
+		{
+			ProcessMosiFrame(eMsgSubState, mMosiVars.lFrameData, mMosiVars.lFramesFirstSample);
+		}
+		else
+		{
+			ProcessMosiFrame(eMosiState_Current, mMosiVars.lFrameData, mMosiVars.lFramesFirstSample);
+
+			if ((eMosiState_Current == AbccMosiStates::Crc32) && (mMosiVars.fLastFrag && (mMosiVars.dwMsgLenCnt == 0)))
+			{
+				RunAbccMosiMsgSubStateMachine(StateOperation::Reset, nullptr, nullptr);
+			}
+		}
+
+		// Reset the state variables
+		mMosiVars.lFrameData = 0;
+		mMosiVars.dwByteCnt = 0;
+	}
+
+	if (mBus->WouldAdvancingTheClockToggleEnable())
+	{
+		mMosiVars.eState = AbccMosiStates::Idle;
+		mMosiVars.lFrameData = 0;
+		mMosiVars.dwByteCnt = 0;
+	}
+
+	return (mMosiVars.eState == AbccMosiStates::Idle);
+}
+
+bool AbccSpiDecoder::RunAbccMisoMsgSubStateMachine(StateOperation operation, bool* add_frame_ptr, AbccMisoStates::Enum* substate_ptr)
+{
+	if (operation == StateOperation::Reset)
+	{
+		// Perform checks here that we were in the last state and that the
+		// number of bytes seen in this state matched the header's msg len specifier
+		// In such cases a "framing error" should be signaled
+		mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Size;
+		mMisoVars.bFrameSizeCnt = 0;
+		return true;
+	}
+
+	if ((add_frame_ptr == nullptr) || (substate_ptr == nullptr))
+	{
+		return false;
+	}
+
+	*substate_ptr = mMisoVars.eMsgSubState;
+	mMisoVars.bFrameSizeCnt++;
+
+	switch (mMisoVars.eMsgSubState)
+	{
+	case AbccMisoStates::MessageField_Size:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Reserved1;
+		}
+		break;
+	case AbccMisoStates::MessageField_Reserved1:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_SourceId;
+		}
+		break;
+	case AbccMisoStates::MessageField_SourceId:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Object;
+		}
+		break;
+	case AbccMisoStates::MessageField_Object:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Instance;
+		}
+		break;
+	case AbccMisoStates::MessageField_Instance:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Command;
+		}
+		break;
+	case AbccMisoStates::MessageField_Command:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Reserved2;
+		}
+		break;
+	case AbccMisoStates::MessageField_Reserved2:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_CommandExtension;
+		}
+		break;
+	case AbccMisoStates::MessageField_CommandExtension:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Data;
+		}
+		break;
+	case AbccMisoStates::MessageField_Data:
+	case AbccMisoStates::MessageField_DataNotValid:
+		if (mMisoVars.bFrameSizeCnt >= GET_MISO_FRAME_SIZE(mMisoVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+		}
+		break;
+	case AbccMisoStates::Idle:
+	case AbccMisoStates::Reserved1:
+	case AbccMisoStates::Reserved2:
+	case AbccMisoStates::LedStatus:
+	case AbccMisoStates::AnybusStatus:
+	case AbccMisoStates::SpiStatus:
+	case AbccMisoStates::NetworkTime:
+	case AbccMisoStates::MessageField:
+	case AbccMisoStates::ReadProcessData:
+	case AbccMisoStates::Crc32:
+	default:
+		mMisoVars.eMsgSubState = AbccMisoStates::MessageField_Data;
+		return false;
+	}
+
+	if (*add_frame_ptr == true)
+	{
+		mMisoVars.bFrameSizeCnt = 0;
+	}
+
+	return true;
+}
+
+bool AbccSpiDecoder::RunAbccMosiMsgSubStateMachine(StateOperation operation, bool* add_frame_ptr, AbccMosiStates::Enum* substate_ptr)
+{
+	if (operation == StateOperation::Reset)
+	{
+		// Perform checks here that we were in the last state and that the
+		// number of bytes seen in this state matched the header's msg len specifier
+		// In such cases a "framing error" should be signaled
+		mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Size;
+		mMosiVars.bFrameSizeCnt = 0;
+		return true;
+	}
+
+	if ((add_frame_ptr == nullptr) || (substate_ptr == nullptr))
+	{
+		return false;
+	}
+
+	*substate_ptr = mMosiVars.eMsgSubState;
+	mMosiVars.bFrameSizeCnt++;
+
+	switch (mMosiVars.eMsgSubState)
+	{
+	case AbccMosiStates::MessageField_Size:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Reserved1;
+		}
+		break;
+	case AbccMosiStates::MessageField_Reserved1:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_SourceId;
+		}
+		break;
+	case AbccMosiStates::MessageField_SourceId:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Object;
+		}
+		break;
+	case AbccMosiStates::MessageField_Object:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Instance;
+		}
+		break;
+	case AbccMosiStates::MessageField_Instance:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Command;
+		}
+		break;
+	case AbccMosiStates::MessageField_Command:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Reserved2;
+		}
+		break;
+	case AbccMosiStates::MessageField_Reserved2:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_CommandExtension;
+		}
+		break;
+	case AbccMosiStates::MessageField_CommandExtension:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+			mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Data;
+		}
+		break;
+	case AbccMosiStates::MessageField_Data:
+	case AbccMosiStates::MessageField_DataNotValid:
+		if (mMosiVars.bFrameSizeCnt >= GET_MOSI_FRAME_SIZE(mMosiVars.eMsgSubState))
+		{
+			*add_frame_ptr = true;
+		}
+		break;
+	case AbccMosiStates::Pad:
+	case AbccMosiStates::Crc32:
+	case AbccMosiStates::WriteProcessData:
+	case AbccMosiStates::MessageField:
+	case AbccMosiStates::InterruptMask:
+	case AbccMosiStates::ApplicationStatus:
+	case AbccMosiStates::ProcessDataLength:
+	case AbccMosiStates::MessageLength:
+	case AbccMosiStates::Reserved1:
+	case AbccMosiStates::SpiControl:
+	case AbccMosiStates::Idle:
+	default:
+		mMosiVars.eMsgSubState = AbccMosiStates::MessageField_Data;
+		return false;
+	}
+
+	if (*add_frame_ptr == true)
+	{
+		mMosiVars.bFrameSizeCnt = 0;
+	}
+
+	return true;
+}
+
+void AbccSpiDecoder::RestorePreviousStateVars()
+{
+	// In the event of an error packet that would otherwise result in a
+	// 'retransmit' event, this routine must be called to put the revelant
+	// state variable back to the last known 'good state'
+	mMisoVars.wMdCnt = mPreviousMisoVars.wMdCnt;
+	mMisoVars.fFirstFrag = mPreviousMisoVars.fFirstFrag;
+	mMisoVars.fLastFrag = mPreviousMisoVars.fLastFrag;
+	mMisoVars.fFragmentation = mPreviousMisoVars.fFragmentation;
+	mMisoVars.eMsgSubState = mPreviousMisoVars.eMsgSubState;
+
+	mMosiVars.wMdCnt = mPreviousMosiVars.wMdCnt;
+	mMosiVars.fFirstFrag = mPreviousMosiVars.fFirstFrag;
+	mMosiVars.fLastFrag = mPreviousMosiVars.fLastFrag;
+	mMosiVars.fFragmentation = mPreviousMosiVars.fFragmentation;
+	mMosiVars.eMsgSubState = mPreviousMosiVars.eMsgSubState;
+}
+
+U32 AbccSpiDecoder::ComputePacketCrc32(const std::vector<U8>& packet_bytes)
+{
+	AbccCrc oChecksum;
+
+	oChecksum.Init();
+	oChecksum.Update(packet_bytes.data(), (U32)packet_bytes.size());
+
+	return oChecksum.Crc32();
+}
@@ -0,0 +1,432 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiDecoder.h
+**    Summary: Headless ABCC SPI protocol decoder. Runs the MOSI/MISO state
+**             machines on acquired byte pairs and reports the decoded
+**             frames, packets, and markers to an abstract sink. Depends
+**             only on the basic types of the Saleae Analyzer SDK.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_SPI_DECODER_H
+#define ABCC_SPI_DECODER_H
+
+#include <cstddef>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "AbccSpiAnalyzerTypes.h"
+
+// Enum for indicating when to reset a statemachine
+enum class StateOperation : U32
+{
+	Run,
+	Reset,
+	SizeOfEnum
+};
+
+// Enum for indicating whether or not the analyzer succeeded in acquiring an SPI byte
+enum class AcquisitionStatus : U32
+{
+	OK,
+	Reset,
+	Error,
+	SizeOfEnum
+};
+
+enum class PacketType : U32
+{
+	Empty,
+	Command,
+	Response,
+	MessageFragment,
+	ErrorResponse,
+	ProtocolError,
+	ProtocolEvent,
+	ChecksumError,
+	MultiEvent,
+	MultiEventWithError,
+	Cancel,
+	SizeOfEnum
+};
+
+// Marker types placed by the decoder (mirrors AnalyzerResults::MarkerType)
+enum class DecoderMarker : U32
+{
+	Dot,
+	ErrorDot,
+	Square,
+	ErrorSquare,
+	UpArrow,
+	X,
+	ErrorX,
+	Start,
+	Stop,
+	One,
+	Zero,
+	SizeOfEnum
+};
+
+inline bool IsErrorMarker(DecoderMarker marker)
+{
+	return (marker == DecoderMarker::ErrorDot) ||
+		(marker == DecoderMarker::ErrorSquare) ||
+		(marker == DecoderMarker::ErrorX);
+}
+
+// The SPI signal a decoder marker is placed on
+enum class DecoderChannel : U32
+{
+	Mosi,
+	Miso,
+	Clock,
+	Enable,
+	SizeOfEnum
+};
+
+extern const AbccMosiInfo_t asMosiStates[];
+extern const AbccMisoInfo_t asMisoStates[];
+extern const AbccMsgInfo_t asMsgStates[];
+
+/*
+** A decoded frame, field-compatible with the SDK's Frame class.
+*/
+typedef struct DecoderFrame
+{
+	S64 mStartingSampleInclusive = 0;
+	S64 mEndingSampleInclusive = 0;
+	U64 mData1 = 0;
+	U64 mData2 = 0;
+	U8 mType = 0;
+	U8 mFlags = 0;
+
+	bool HasFlag(U8 flag) const
+	{
+		return ((mFlags & flag) != 0);
+	}
+} DecoderFrame_t;
+
+/*
+** The message field of a packet that passed its checksum test, i.e. one
+** fragment of a message. The bytes are only valid during the call.
+*/
+typedef struct MessageFragmentInfo
+{
+	S64 lFirstSample;
+	S64 lLastSample;
+	const U8* pbData;		// Header (first fragment only), data, and padding
+	U32 dwLength;
+	bool fLastFragment;
+	bool fRetransmission;	// Repeats the fragment added last, which it replaces
+	bool fChecksumError;	// A packet since the previous fragment failed its CRC32 check
+} MessageFragmentInfo_t;
+
+/* Flags of one channel of a packet summary */
+#define PACKET_MSG_FLAG					( 1 << 0 )	/* Carries a message field */
+#define PACKET_FRAG_FLAG				( 1 << 1 )	/* The message field is a fragment of a longer message */
+#define PACKET_FIRST_FRAG_FLAG			( 1 << 2 )
+#define PACKET_LAST_FRAG_FLAG			( 1 << 3 )
+#define PACKET_STATUS_FLAG				( 1 << 4 )	/* The anybus or application status was received */
+#define PACKET_CRC_FLAG					( 1 << 5 )	/* The CRC32 field was received */
+#define PACKET_CRC_ERROR_FLAG			( 1 << 6 )
+#define PACKET_ERROR_FLAG				( 1 << 7 )	/* A frame is displayed as an error */
+
+/* Sample of a packet summary that has no frames yet */
+#define PACKET_SAMPLE_NONE				(-1)
+
+typedef struct PacketChannelSummary
+{
+	PacketType ePacketType;
+	MsgHeaderInfo_t sMsgHeader;		// Of the message the field belongs to, if PACKET_MSG_FLAG
+	U8 bStatus;						// Anybus status on MISO, application status on MOSI
+	U8 bFlags;
+} PacketChannelSummary_t;
+
+/*
+** What a packet held, handed to the sink when the packet is committed. The
+** samples span the frames the decoder added to the packet.
+*/
+typedef struct PacketSummary
+{
+	S64 lFirstSample;
+	S64 lLastSample;
+	PacketChannelSummary_t sMosi;
+	PacketChannelSummary_t sMiso;
+} PacketSummary_t;
+
+/*
+** Receives the output of the decoder.
+*/
+class AbccSpiDecoderSink
+{
+public:
+	virtual ~AbccSpiDecoderSink() {}
+
+	virtual void AddFrame(const DecoderFrame_t& frame) = 0;
+	virtual void AddMarker(U64 sample, DecoderMarker marker, DecoderChannel channel) = 0;
+
+	// Stores bytes that a frame refers to by the returned offset
+	virtual U64 StorePayload(const U8* data, U32 length) = 0;
+
+	// Adds a message to the sink's message table when its first field is
+	// decoded, returns the id that the message's data frames refer to. A
+	// retransmission of the packet that started the last message reuses it.
+	virtual U32 OpenMessage(SpiChannel_t channel, bool retransmission) = 0;
+
+	// Stores the decoded header that the message's data frames are rendered with
+	virtual void SetMessageHeader(U32 message_id, const MsgHeaderInfo_t& header) = 0;
+
+	virtual void AddMessageFragment(U32 message_id, const MessageFragmentInfo_t& fragment) = 0;
+
+	// Returns false if the packet contained no frames and was therefore not committed
+	virtual bool CommitPacketAndStartNewPacket(const PacketSummary_t& summary) = 0;
+	virtual void CancelPacketAndStartNewPacket() = 0;
+	virtual void CommitResults() = 0;
+};
+
+/*
+** Provides the decoder with the state of the SPI signals at the current
+** acquisition position. These are queried lazily while the state machines
+** run, since the answers may depend on data beyond the current byte.
+*/
+class AbccSpiDecoderBus
+{
+public:
+	virtual ~AbccSpiDecoderBus() {}
+
+	virtual bool HasEnableChannel() = 0;
+	virtual bool IsEnableActive() = 0;
+	virtual bool WouldAdvancingTheClockToggleEnable() = 0;
+
+	// True when an idle condition (3-wire mode) ends the transfer in progress
+	virtual bool IsIdleConditionDetected() = 0;
+
+	virtual U64 GetCurrentSample() = 0;
+	virtual U64 GetClockSampleNumber() = 0;
+	virtual U64 GetSampleOfNextClockEdge() = 0;
+	virtual U64 GetSampleOfNextEnableEdge() = 0;
+
+	// Called after a packet is committed, before the next packet starts
+	virtual void CheckForIdleAfterPacket() = 0;
+
+	// Called after each byte pair, true for a channel whose next byte
+	// starts a frame
+	virtual void SetNextByteStartsFrame(bool mosi, bool miso) = 0;
+};
+
+/*
+** The subset of the analyzer settings that influences decoding
+*/
+typedef struct DecoderConfig
+{
+	bool fCoalesceProcessData;	// One frame per process data block, bytes in the sink's payload store
+	bool fErrorMarkersOnly;		// Markers other than error markers are not placed
+} DecoderConfig_t;
+
+class AbccSpiDecoder
+{
+public:
+
+	AbccSpiDecoder(AbccSpiDecoderBus* bus, AbccSpiDecoderSink* sink);
+	~AbccSpiDecoder();
+
+	void Setup(const DecoderConfig_t& config);
+
+	// Prepares the state machines for a new pass over a capture
+	void Reset();
+
+	// Runs the MOSI and MISO state machines on one acquired byte pair
+	void ProcessBytePair(AcquisitionStatus acquisition_status, U64 mosi_data, U64 miso_data, S64 first_sample);
+
+public: /* Enums, Classes, Types */
+
+	typedef struct MosiVars
+	{
+		S64 lFramesFirstSample;
+		U64 lFrameData;
+		PacketType ePacketType;
+		AbccMosiStates::Enum eState;
+		AbccMosiStates::Enum eMsgSubState;
+		MsgHeaderInfo_t sMsgHeader;
+		U32 dwMsgId;
+		U32 dwPdLen;
+		U32 dwPdCnt;
+		U32 dwMsgLen;
+		U32 dwMsgLenCnt;
+		U32 dwByteCnt;
+		U8 bFrameSizeCnt;
+		U16 wMdCnt;
+		U16 wMdSize;
+		U8 bLastToggleState;
+		U8 bLastApplSts;
+		bool fNewMsg;
+		bool fErrorRsp;
+		bool fFragmentation;
+		bool fFirstFrag;
+		bool fLastFrag;
+		bool fWrPdValid;
+		bool fReadyForNewPacket;
+	} MosiVars_t;
+
+	typedef struct MisoVars
+	{
+		S64 lFramesFirstSample;
+		U64 lFrameData;
+		PacketType ePacketType;
+		AbccMisoStates::Enum eState;
+		AbccMisoStates::Enum eMsgSubState;
+		MsgHeaderInfo_t sMsgHeader;
+		U32 dwMsgId;
+		U32 dwLastTimestamp;
+		U32 dwPdLen;
+		U32 dwPdCnt;
+		U32 dwMsgLen;
+		U32 dwMsgLenCnt;
+		U32 dwByteCnt;
+		U8 bFrameSizeCnt;
+		U16 wMdCnt;
+		U16 wMdSize;
+		U8 bLastAnbSts;
+		bool fNewMsg;
+		bool fErrorRsp;
+		bool fFragmentation;
+		bool fFirstFrag;
+		bool fLastFrag;
+		bool fNewRdPd;
+		bool fReadyForNewPacket;
+	} MisoVars_t;
+
+	// Process data bytes collected for a coalesced frame
+	typedef struct ProcessDataBlock
+	{
+		S64 lFirstSample;
+		S64 lLastSample;
+		size_t nFirstByte;	// Index into the packet bytes
+		U32 dwLength;
+		U8 bFlags;
+	} ProcessDataBlock_t;
+
+	// Message field of the current packet. It is added to the sink's message
+	// table when the MISO checksum passes, the same point at which the state
+	// variables are backed up. A packet that is rolled back or cut short is
+	// never added.
+	typedef struct PacketMessageFields
+	{
+		S64 lFirstSample;
+		S64 lLastSample;
+		size_t nFirstByte;		// Index of the message field in the packet bytes
+		bool fPresent;			// The packet carries a message fragment
+		bool fChecksumOk;		// The channel's own CRC32 field matched
+		bool fLastFragment;
+		bool fChecksumError;	// A transmission of the next fragment failed its CRC32 check
+		U8 bToggle;				// SPI_CTL toggle bit of the current packet
+		bool fAdded;			// The previous packet's fragment was added
+		bool fRetransmission;	// The current packet repeats that fragment
+	} PacketMessageFields_t;
+
+	// Everything the decoder carries from one byte pair to the next
+	typedef struct DecoderState
+	{
+		MosiVars_t sMosiVars;
+		MisoVars_t sMisoVars;
+		MosiVars_t sPreviousMosiVars;
+		MisoVars_t sPreviousMisoVars;
+		bool fMosiReady;
+		bool fMisoReady;
+		std::vector<U8> abMosiPacketBytes;
+		std::vector<U8> abMisoPacketBytes;
+		ProcessDataBlock_t sMosiPdBlock;
+		ProcessDataBlock_t sMisoPdBlock;
+		PacketMessageFields_t sMosiMsgFields;
+		PacketMessageFields_t sMisoMsgFields;
+		PacketSummary_t sPacketSummary;
+	} DecoderState_t;
+
+public:
+
+	/*
+	** Decoding continues from a state set with SetState() exactly as it did
+	** from where the state was taken, provided that the acquisition is at the
+	** same position. The message ids in the state refer to the sink that the
+	** decoder reported to when the state was taken.
+	*/
+	void GetState(DecoderState_t* state_ptr) const;
+	void SetState(const DecoderState_t& state);
+
+	/*
+	** True if decoding continues the same way from both states. Sample
+	** numbers are not compared, and message ids only as far as whether a
+	** message is referred to.
+	*/
+	static bool IsSameState(const DecoderState_t& state_a, const DecoderState_t& state_b);
+
+protected: // Members
+
+	AbccSpiDecoderBus* mBus;
+	AbccSpiDecoderSink* mSink;
+	DecoderConfig_t mConfig;
+
+	MosiVars_t mMosiVars;
+	MisoVars_t mMisoVars;
+
+	// Backup variables to recover from error cases
+	// that require knowledge of the last valid state
+	MosiVars_t mPreviousMosiVars;
+	MisoVars_t mPreviousMisoVars;
+
+	// Set when the respective state machine is idle and waiting for a new packet
+	bool mMosiReady;
+	bool mMisoReady;
+
+	// Raw bytes of the current packet, up to the CRC32 field. They are kept
+	// outside of the state variables since those are backed up with memcpy.
+	std::vector<U8> mMosiPacketBytes;
+	std::vector<U8> mMisoPacketBytes;
+
+	ProcessDataBlock_t mMosiPdBlock;
+	ProcessDataBlock_t mMisoPdBlock;
+
+	PacketMessageFields_t mMosiMsgFields;
+	PacketMessageFields_t mMisoMsgFields;
+
+	// Built up from the frames of the current packet
+	PacketSummary_t mPacketSummary;
+
+protected: // Methods
+
+	void AddFrame(const DecoderFrame_t& frame);
+	void AddMarker(U64 sample, DecoderMarker marker, DecoderChannel channel);
+	void ResetPacketSummary();
+	bool DoesNextByteStartFrame(SpiChannel_t channel) const;
+
+	void AddFragFrame(SpiChannel_t channel, U64 first_sample, U64 last_sample);
+	void AddProcessDataByte(SpiChannel_t channel, const DecoderFrame_t& byte_frame, bool last_byte);
+	void AddProcessDataBlockFrame(SpiChannel_t channel);
+	void AddMessageFieldFrame(SpiChannel_t channel, const DecoderFrame_t& field_frame);
+	void AddMessageFragment(SpiChannel_t channel);
+	void DiscardMessageFragment(SpiChannel_t channel);
+	void StartMessageFragments(U8 toggle);
+	void SignalReadyForNewPacket(SpiChannel_t channel);
+
+	void SetMosiPacketType(PacketType packet_type);
+	void SetMisoPacketType(PacketType packet_type);
+	DecoderMarker GetPacketMarkerType();
+
+	void ProcessMosiFrame(AbccMosiStates::Enum state, U64 frame_data, S64 frames_first_sample);
+	void ProcessMisoFrame(AbccMisoStates::Enum state, U64 frame_data, S64 frames_first_sample);
+
+	bool RunAbccMosiStateMachine(StateOperation operation, AcquisitionStatus acquisition_status, U64 mosi_data, S64 first_sample);
+	bool RunAbccMisoStateMachine(StateOperation operation, AcquisitionStatus acquisition_status, U64 miso_data, S64 first_sample);
+
+	bool RunAbccMisoMsgSubStateMachine(StateOperation operation, bool* add_frame_ptr, AbccMisoStates::Enum* substate_ptr);
+	bool RunAbccMosiMsgSubStateMachine(StateOperation operation, bool* add_frame_ptr, AbccMosiStates::Enum* substate_ptr);
+
+	void RestorePreviousStateVars();
+
+	U32 ComputePacketCrc32(const std::vector<U8>& packet_bytes);
+};
+
+#endif /* ABCC_SPI_DECODER_H */
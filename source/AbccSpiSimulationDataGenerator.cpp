@@ -98,12 +98,19 @@ SpiSimulationDataGenerator::SpiSimulationDataGenerator()
 	memset(&mMosiMsgData, 0, sizeof(mMosiMsgData));
 
 	mAbortTransfer = false;
+	mFixedRandomSeed = false;
 }
 
 SpiSimulationDataGenerator::~SpiSimulationDataGenerator()
 {
 }
 
+void SpiSimulationDataGenerator::SetRandomSeed(U32 seed)
+{
+	mSeedGenerator.seed(seed);
+	mFixedRandomSeed = true;
+}
+
 void SpiSimulationDataGenerator::Initialize(U32 simulation_sample_rate, SpiAnalyzerSettings* settings)
 {
 	mSimulationSampleRateHz = simulation_sample_rate;
@@ -478,7 +485,7 @@ bool SpiSimulationDataGenerator::CreateSpiTransaction()
 	ClockIdleMode currentClockIdleMode;
 
 	std::random_device rd;
-	std::mt19937 prng(rd());
+	std::mt19937 prng(mFixedRandomSeed ? mSeedGenerator() : rd());
 	std::uniform_int_distribution<> fragmentSize(1, mNumBytesInSpiPacket - 1);
 
 	bool mosiCrcError;
@@ -11,6 +11,7 @@
 #ifndef ABCC_SPI_SIMULATION_DATA_GENERATOR_H
 #define ABCC_SPI_SIMULATION_DATA_GENERATOR_H
 
+#include <random>
 #include <AnalyzerHelpers.h>
 #include "abcc_td.h"
 #include "abcc_abp/abp.h"
@@ -31,6 +32,10 @@ public:
 	void Initialize(U32 simulation_sample_rate, SpiAnalyzerSettings* settings);
 	U32 GenerateSimulationData(U64 newest_sample_requested, U32 sample_rate, SimulationChannelDescriptor** simulation_channels);
 
+	/* Makes the random SPI events repeatable, e.g. for benchmarking.
+	** By default every transaction is seeded from std::random_device. */
+	void SetRandomSeed(U32 seed);
+
 protected: /* Enums, Types, and Classes */
 
 	enum class MessageType : U8
@@ -96,6 +101,10 @@ protected: /* Members */
 	/* Dummy value used as the payload for various random SPI events. */
 	U64 mIncrementingValue;
 
+	/* Seeds each transaction's random events when mFixedRandomSeed is set */
+	std::mt19937 mSeedGenerator;
+	bool mFixedRandomSeed;
+
 	bool m3WireMode;
 	bool mLogFileSimulation;
 	bool mAbortTransfer;
@@ -0,0 +1,133 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccTextBuilder.cpp
+**    Summary: Appends strings and numbers to a fixed size character buffer
+**             without heap allocation or format string parsing. Used to
+**             render the bubble and tabular text.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "AbccTextBuilder.h"
+#include "AnalyzerHelpers.h"
+
+/* Enough for the 20 decimal or 16 hexadecimal digits of a U64 */
+#define MAX_NUMBER_DIGITS			20
+
+static const char acDecimalPairs[] =
+	"00010203040506070809"
+	"10111213141516171819"
+	"20212223242526272829"
+	"30313233343536373839"
+	"40414243444546474849"
+	"50515253545556575859"
+	"60616263646566676869"
+	"70717273747576777879"
+	"80818283848586878889"
+	"90919293949596979899";
+
+static const char acHexDigits[] = "0123456789ABCDEF";
+
+AbccTextBuilder& AbccTextBuilder::AppendRepeated(char c, size_t count)
+{
+	if (count > mCapacity - mLength)
+	{
+		count = mCapacity - mLength;
+	}
+
+	memset(&mBuffer[mLength], c, count);
+	mLength += count;
+	mBuffer[mLength] = '\0';
+
+	return *this;
+}
+
+AbccTextBuilder& AbccTextBuilder::AppendDecimal(U64 value)
+{
+	char digits[MAX_NUMBER_DIGITS];
+	char* first = &digits[MAX_NUMBER_DIGITS];
+
+	// Two digits at a time, from the least significant end
+	while (value >= 100)
+	{
+		U32 pair = (U32)(value % 100) * 2;
+
+		value /= 100;
+		*--first = acDecimalPairs[pair + 1];
+		*--first = acDecimalPairs[pair];
+	}
+
+	if (value >= 10)
+	{
+		*--first = acDecimalPairs[value * 2 + 1];
+		*--first = acDecimalPairs[value * 2];
+	}
+	else
+	{
+		*--first = (char)('0' + value);
+	}
+
+	return Append(first, (size_t)(&digits[MAX_NUMBER_DIGITS] - first));
+}
+
+AbccTextBuilder& AbccTextBuilder::AppendHex(U64 value, U32 min_digits)
+{
+	char digits[MAX_NUMBER_DIGITS];
+	char* first = &digits[MAX_NUMBER_DIGITS];
+	U32 count = 0;
+
+	do
+	{
+		*--first = acHexDigits[value & 0x0F];
+		value >>= 4;
+		count++;
+	} while (value != 0);
+
+	if (min_digits > count)
+	{
+		AppendRepeated('0', min_digits - count);
+	}
+
+	return Append(first, count);
+}
+
+AbccTextBuilder& AbccTextBuilder::AppendNumber(U64 number, DisplayBase display_base, U32 num_data_bits)
+{
+	switch (display_base)
+	{
+	case Decimal:
+	case Hexadecimal:
+	{
+		U32 hexDigits = (num_data_bits + 3) / 4;
+
+		if ((num_data_bits > 0) && (num_data_bits < 64))
+		{
+			number &= ((1ull << num_data_bits) - 1);
+		}
+
+		if (display_base == Decimal)
+		{
+			return AppendDecimal(number);
+		}
+
+		return Append("0x", 2).AppendHex(number, (hexDigits > 0) ? hexDigits : 1);
+	}
+	default:
+		AnalyzerHelpers::GetNumberString(number, display_base, num_data_bits, GetTail(), (U32)GetTailSize());
+		CommitTail();
+		return *this;
+	}
+}
+
+void AbccTextBuilder::RemovePrefix(size_t count)
+{
+	if (count > mLength)
+	{
+		count = mLength;
+	}
+
+	memmove(mBuffer, &mBuffer[count], mLength - count + 1);
+	mLength -= count;
+}
@@ -0,0 +1,136 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccTextBuilder.h
+**    Summary: Appends strings and numbers to a fixed size character buffer
+**             without heap allocation or format string parsing. Used to
+**             render the bubble and tabular text.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_TEXT_BUILDER_H
+#define ABCC_TEXT_BUILDER_H
+
+#include <cstddef>
+#include <cstring>
+
+#include "LogicPublicTypes.h"
+
+/* A string literal together with its length, known at compile time */
+typedef struct TextPrefix
+{
+	const char* str;
+	size_t length;
+} TextPrefix_t;
+
+#define TEXT_PREFIX(literal)		{ literal, sizeof(literal) - 1 }
+
+/*
+** Writes into a buffer owned by the caller, which always holds a terminated
+** string. Text that does not fit is cut off, like snprintf() into the same
+** buffer would.
+*/
+class AbccTextBuilder
+{
+public:
+
+	AbccTextBuilder(char* buffer, size_t buffer_size)
+		: mBuffer(buffer),
+		mCapacity(buffer_size - 1),
+		mLength(0)
+	{
+		mBuffer[0] = '\0';
+	}
+
+	inline AbccTextBuilder& Append(const char* str, size_t length)
+	{
+		if (length > mCapacity - mLength)
+		{
+			length = mCapacity - mLength;
+		}
+
+		memcpy(&mBuffer[mLength], str, length);
+		mLength += length;
+		mBuffer[mLength] = '\0';
+
+		return *this;
+	}
+
+	inline AbccTextBuilder& Append(const char* str)
+	{
+		return Append(str, strlen(str));
+	}
+
+	inline AbccTextBuilder& Append(const TextPrefix_t& prefix)
+	{
+		return Append(prefix.str, prefix.length);
+	}
+
+	inline AbccTextBuilder& Append(char c)
+	{
+		return AppendRepeated(c, 1);
+	}
+
+	AbccTextBuilder& AppendRepeated(char c, size_t count);
+
+	/* Like "%llu" */
+	AbccTextBuilder& AppendDecimal(U64 value);
+
+	/* Like "%0*llX", upper case and zero padded to min_digits */
+	AbccTextBuilder& AppendHex(U64 value, U32 min_digits);
+
+	/*
+	** The same text as AnalyzerHelpers::GetNumberString(). Hexadecimal and
+	** decimal are formatted here, other bases by the SDK.
+	*/
+	AbccTextBuilder& AppendNumber(U64 number, DisplayBase display_base, U32 num_data_bits);
+
+	/*
+	** For functions that write a terminated string into a buffer: the
+	** remaining space is handed out with GetTail() and GetTailSize(), and
+	** the string written there is taken over by CommitTail().
+	*/
+	inline char* GetTail()
+	{
+		return &mBuffer[mLength];
+	}
+
+	inline size_t GetTailSize() const
+	{
+		return mCapacity - mLength + 1;
+	}
+
+	inline void CommitTail()
+	{
+		mLength += strlen(&mBuffer[mLength]);
+	}
+
+	/* Drops the first count characters */
+	void RemovePrefix(size_t count);
+
+	inline const char* GetString() const
+	{
+		return mBuffer;
+	}
+
+	inline size_t GetLength() const
+	{
+		return mLength;
+	}
+
+	inline void Clear()
+	{
+		mLength = 0;
+		mBuffer[0] = '\0';
+	}
+
+protected:
+
+	char* mBuffer;
+	size_t mCapacity;		// Characters, not counting the terminator
+	size_t mLength;
+};
+
+#endif /* ABCC_TEXT_BUILDER_H */
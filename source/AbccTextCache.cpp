@@ -0,0 +1,137 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccTextCache.cpp
+**    Summary: Bounded least-recently-used cache of the bubble and tabular
+**             text generated for frames, so that frames Logic asks for
+**             again while scrolling or zooming are not rendered again.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "AbccTextCache.h"
+
+AbccTextCache::AbccTextCache()
+	: mCapacity(0),
+	mGeneration(0),
+	mHitCount(0),
+	mMissCount(0)
+{
+}
+
+AbccTextCache::~AbccTextCache()
+{
+}
+
+void AbccTextCache::SetCapacity(U32 capacity)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mCapacity = capacity;
+
+	if (mEntries.size() > mCapacity)
+	{
+		Evict(mEntries.size() - mCapacity);
+	}
+}
+
+U32 AbccTextCache::GetCapacity() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mCapacity;
+}
+
+void AbccTextCache::SetGeneration(U32 generation)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (generation != mGeneration)
+	{
+		mGeneration = generation;
+		mEntries.clear();
+		mIndex.clear();
+	}
+}
+
+bool AbccTextCache::Lookup(U64 key, std::string* text_ptr)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mIndex.find(key);
+
+	if (it == mIndex.end())
+	{
+		mMissCount++;
+		return false;
+	}
+
+	mEntries.splice(mEntries.begin(), mEntries, it->second);
+	text_ptr->assign(it->second->text);
+	mHitCount++;
+
+	return true;
+}
+
+void AbccTextCache::Insert(U64 key, const std::string& text)
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	auto it = mIndex.find(key);
+
+	if (mCapacity == 0)
+	{
+		return;
+	}
+
+	if (it != mIndex.end())
+	{
+		mEntries.splice(mEntries.begin(), mEntries, it->second);
+		it->second->text = text;
+		return;
+	}
+
+	if (mEntries.size() >= mCapacity)
+	{
+		Evict(mEntries.size() - mCapacity + 1);
+	}
+
+	mEntries.push_front({ key, text });
+	mIndex[key] = mEntries.begin();
+}
+
+U64 AbccTextCache::GetHitCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mHitCount;
+}
+
+U64 AbccTextCache::GetMissCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mMissCount;
+}
+
+size_t AbccTextCache::GetCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+	return mEntries.size();
+}
+
+void AbccTextCache::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mEntries.clear();
+	mIndex.clear();
+	mHitCount = 0;
+	mMissCount = 0;
+}
+
+void AbccTextCache::Evict(size_t count)
+{
+	// The least recently used entries are at the back
+	for (size_t i = 0; (i < count) && !mEntries.empty(); i++)
+	{
+		mIndex.erase(mEntries.back().lKey);
+		mEntries.pop_back();
+	}
+}
@@ -0,0 +1,79 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccTextCache.h
+**    Summary: Bounded least-recently-used cache of the bubble and tabular
+**             text generated for frames, so that frames Logic asks for
+**             again while scrolling or zooming are not rendered again.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_TEXT_CACHE_H
+#define ABCC_TEXT_CACHE_H
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include "LogicPublicTypes.h"
+
+/*
+** The text of an entry is the result strings or tabular lines in the order
+** they were added, each followed by a '\0'. All entries are dropped when
+** the settings generation changes, since most settings change the text.
+*/
+class AbccTextCache
+{
+public:
+
+	AbccTextCache();
+	~AbccTextCache();
+
+	/* Maximum number of entries, zero disables the cache */
+	void SetCapacity(U32 capacity);
+	U32 GetCapacity() const;
+
+	void SetGeneration(U32 generation);
+
+	/*
+	** Copies the text of key into text_ptr and makes the entry the most
+	** recently used one. Returns false, and counts a miss, if there is none.
+	*/
+	bool Lookup(U64 key, std::string* text_ptr);
+
+	/* Adds or replaces an entry, evicting the least recently used ones */
+	void Insert(U64 key, const std::string& text);
+
+	U64 GetHitCount() const;
+	U64 GetMissCount() const;
+	size_t GetCount() const;
+
+	void Clear();
+
+protected:
+
+	typedef struct TextCacheEntry
+	{
+		U64 lKey;
+		std::string text;
+	} TextCacheEntry_t;
+
+	typedef std::list<TextCacheEntry_t> EntryList_t;
+
+	EntryList_t mEntries;		// Most recently used first
+	std::unordered_map<U64, EntryList_t::iterator> mIndex;
+	U32 mCapacity;
+	U32 mGeneration;
+	U64 mHitCount;
+	U64 mMissCount;
+	mutable std::mutex mMutex;
+
+protected:
+
+	void Evict(size_t count);
+};
+
+#endif /* ABCC_TEXT_CACHE_H */
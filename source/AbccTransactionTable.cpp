@@ -0,0 +1,291 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccTransactionTable.cpp
+**    Summary: Pairs each command message with its response by source ID and
+**             object/instance/command, and keeps response latency histograms
+**             per object and command.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "AbccTransactionTable.h"
+
+#define LATENCY_SUB_BUCKETS			(1 << LATENCY_SUB_BUCKET_BITS)
+
+AbccTransactionTable::AbccTransactionTable()
+{
+	Clear();
+}
+
+AbccTransactionTable::~AbccTransactionTable()
+{
+}
+
+U32 AbccTransactionTable::AddMessage(const AbccMessageTable& messages, U32 message_id)
+{
+	AbccMessageView_t view;
+	MsgHeaderInfo_t header;
+
+	// The message table is read before this table is locked
+	if (!messages.GetView(message_id, &view) || !messages.GetHeader(message_id, &header))
+	{
+		return TRANSACTION_ID_NONE;
+	}
+
+	std::lock_guard<std::mutex> lock(mMutex);
+	SpiChannel_t channel = view.eChannel;
+
+	if ((channel >= SpiChannel::NotSpecified) || (message_id < maNextMessageId[channel]))
+	{
+		return TRANSACTION_ID_NONE;
+	}
+
+	maNextMessageId[channel] = message_id + 1;
+
+	if (!(header.cmd & ABP_MSG_HEADER_C_BIT))
+	{
+		return AddResponse(message_id, view, header);
+	}
+
+	AbccTransaction_t transaction;
+	U32& pending = maPending[channel][view.psHeader->bSourceId];
+
+	if (pending != TRANSACTION_ID_NONE)
+	{
+		// The requester has given up on the response
+		mTransactions[pending].eStatus = TransactionStatus::NoResponse;
+	}
+
+	transaction.lCommandFirstSample = view.lFirstSample;
+	transaction.lCommandLastSample = view.lLastSample;
+	transaction.lResponseFirstSample = TRANSACTION_SAMPLE_NONE;
+	transaction.lResponseLastSample = TRANSACTION_SAMPLE_NONE;
+	transaction.dwCommandId = message_id;
+	transaction.dwResponseId = ABCC_MSG_ID_NONE;
+	transaction.sHeader = header;
+	transaction.eCommandChannel = channel;
+	transaction.bSourceId = view.psHeader->bSourceId;
+	transaction.eStatus = TransactionStatus::Pending;
+
+	pending = (U32)mTransactions.size();
+	mTransactions.push_back(transaction);
+
+	return pending;
+}
+
+U32 AbccTransactionTable::AddResponse(U32 message_id, const AbccMessageView_t& view, const MsgHeaderInfo_t& header)
+{
+	SpiChannel_t commandChannel = (view.eChannel == SpiChannel::MOSI) ? SpiChannel::MISO : SpiChannel::MOSI;
+	U32& pending = maPending[commandChannel][view.psHeader->bSourceId];
+
+	if (pending != TRANSACTION_ID_NONE)
+	{
+		AbccTransaction_t& transaction = mTransactions[pending];
+
+		if ((transaction.sHeader.obj == header.obj) &&
+			(transaction.sHeader.inst == header.inst) &&
+			((transaction.sHeader.cmd & ABP_MSG_HEADER_CMD_BITS) == (header.cmd & ABP_MSG_HEADER_CMD_BITS)))
+		{
+			U32 transactionId = pending;
+
+			transaction.lResponseFirstSample = view.lFirstSample;
+			transaction.lResponseLastSample = view.lLastSample;
+			transaction.dwResponseId = message_id;
+			transaction.eStatus = (header.cmd & ABP_MSG_HEADER_E_BIT) ? TransactionStatus::ErrorResponse : TransactionStatus::Complete;
+
+			pending = TRANSACTION_ID_NONE;
+			AddLatency(transaction);
+			return transactionId;
+		}
+	}
+
+	// Either no command is waiting for the source ID or its header does not
+	// match; a command that is waiting keeps waiting.
+	AbccTransaction_t transaction;
+
+	transaction.lCommandFirstSample = TRANSACTION_SAMPLE_NONE;
+	transaction.lCommandLastSample = TRANSACTION_SAMPLE_NONE;
+	transaction.lResponseFirstSample = view.lFirstSample;
+	transaction.lResponseLastSample = view.lLastSample;
+	transaction.dwCommandId = ABCC_MSG_ID_NONE;
+	transaction.dwResponseId = message_id;
+	transaction.sHeader = header;
+	transaction.eCommandChannel = commandChannel;
+	transaction.bSourceId = view.psHeader->bSourceId;
+	transaction.eStatus = TransactionStatus::UnexpectedResponse;
+
+	mTransactions.push_back(transaction);
+
+	return (U32)(mTransactions.size() - 1);
+}
+
+void AbccTransactionTable::AddLatency(const AbccTransaction_t& transaction)
+{
+	U16 key = (U16)((transaction.sHeader.obj << 8) | (transaction.sHeader.cmd & ABP_MSG_HEADER_CMD_BITS));
+	U64 latency;
+
+	if (!GetLatency(transaction, &latency))
+	{
+		return;
+	}
+
+	LatencyHistogram_t& histogram = mLatencies[key];
+
+	if (histogram.adwBuckets.empty())
+	{
+		histogram.lCount = 0;
+		histogram.lMax = 0;
+		histogram.adwBuckets.resize(NUM_LATENCY_BUCKETS, 0);
+	}
+
+	histogram.adwBuckets[GetLatencyBucket(latency)]++;
+	histogram.lCount++;
+
+	if (latency > histogram.lMax)
+	{
+		histogram.lMax = latency;
+	}
+}
+
+bool AbccTransactionTable::GetLatency(const AbccTransaction_t& transaction, U64* latency_ptr)
+{
+	if ((transaction.eStatus != TransactionStatus::Complete) &&
+		(transaction.eStatus != TransactionStatus::ErrorResponse))
+	{
+		return false;
+	}
+
+	*latency_ptr = 0;
+
+	if (transaction.lResponseFirstSample > transaction.lCommandLastSample)
+	{
+		*latency_ptr = (U64)(transaction.lResponseFirstSample - transaction.lCommandLastSample);
+	}
+
+	return true;
+}
+
+U32 AbccTransactionTable::GetLatencyBucket(U64 latency)
+{
+	U32 shift = 0;
+
+	if (latency < LATENCY_EXACT_BUCKETS)
+	{
+		return (U32)latency;
+	}
+
+	// Keep the LATENCY_SUB_BUCKET_BITS bits below the most significant one
+	while ((latency >> shift) >= LATENCY_EXACT_BUCKETS)
+	{
+		shift++;
+	}
+
+	return (shift << LATENCY_SUB_BUCKET_BITS) + (U32)(latency >> shift);
+}
+
+/* Largest latency that falls in a bucket */
+U64 AbccTransactionTable::GetLatencyBucketLimit(U32 bucket)
+{
+	if (bucket < LATENCY_EXACT_BUCKETS)
+	{
+		return bucket;
+	}
+
+	U32 shift = (bucket >> LATENCY_SUB_BUCKET_BITS) - 1;
+	U64 mantissa = (bucket & (LATENCY_SUB_BUCKETS - 1)) + LATENCY_SUB_BUCKETS;
+
+	if (shift + LATENCY_SUB_BUCKET_BITS + 1 >= 64)
+	{
+		return ~0ull;
+	}
+
+	return ((mantissa + 1) << shift) - 1;
+}
+
+U64 AbccTransactionTable::GetLatencyPercentile(const LatencyHistogram_t& histogram, U32 percent)
+{
+	// Rank of the percentile among the latencies, rounded up
+	U64 rank = (histogram.lCount * percent + 99) / 100;
+	U64 count = 0;
+
+	if (rank == 0)
+	{
+		rank = 1;
+	}
+
+	for (U32 bucket = 0; bucket < histogram.adwBuckets.size(); bucket++)
+	{
+		count += histogram.adwBuckets[bucket];
+
+		if (count >= rank)
+		{
+			U64 limit = GetLatencyBucketLimit(bucket);
+
+			return (limit < histogram.lMax) ? limit : histogram.lMax;
+		}
+	}
+
+	return histogram.lMax;
+}
+
+bool AbccTransactionTable::Get(U64 transaction_id, AbccTransaction_t* transaction_ptr) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	if (transaction_id >= mTransactions.size())
+	{
+		return false;
+	}
+
+	*transaction_ptr = mTransactions[(size_t)transaction_id];
+
+	return true;
+}
+
+U64 AbccTransactionTable::GetTransactionCount() const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	return mTransactions.size();
+}
+
+void AbccTransactionTable::GetLatencyStats(std::vector<TransactionLatencyStats_t>* stats_ptr) const
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	stats_ptr->clear();
+
+	for (std::map<U16, LatencyHistogram_t>::const_iterator it = mLatencies.begin(); it != mLatencies.end(); ++it)
+	{
+		TransactionLatencyStats_t stats;
+
+		stats.bObject = (U8)(it->first >> 8);
+		stats.bCommand = (U8)it->first;
+		stats.lCount = it->second.lCount;
+		stats.lP50 = GetLatencyPercentile(it->second, 50);
+		stats.lP99 = GetLatencyPercentile(it->second, 99);
+		stats.lMax = it->second.lMax;
+
+		stats_ptr->push_back(stats);
+	}
+}
+
+void AbccTransactionTable::Clear()
+{
+	std::lock_guard<std::mutex> lock(mMutex);
+
+	mTransactions.clear();
+	mLatencies.clear();
+
+	for (U32 channel = 0; channel < SpiChannel::NotSpecified; channel++)
+	{
+		for (U32 sourceId = 0; sourceId < 256; sourceId++)
+		{
+			maPending[channel][sourceId] = TRANSACTION_ID_NONE;
+		}
+
+		maNextMessageId[channel] = 0;
+	}
+}
@@ -0,0 +1,147 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccTransactionTable.h
+**    Summary: Pairs each command message with its response by source ID and
+**             object/instance/command, and keeps response latency histograms
+**             per object and command.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_TRANSACTION_TABLE_H
+#define ABCC_TRANSACTION_TABLE_H
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "AbccSpiAnalyzerTypes.h"
+#include "AbccMessageTable.h"
+
+/* Sample of a transaction without a command or response message */
+#define TRANSACTION_SAMPLE_NONE				-1
+
+#define TRANSACTION_ID_NONE					0xFFFFFFFF
+
+/*
+** Latency histogram buckets. Latencies below LATENCY_EXACT_BUCKETS samples
+** have a bucket each, longer ones share 2^LATENCY_SUB_BUCKET_BITS buckets per
+** power of two.
+*/
+#define LATENCY_SUB_BUCKET_BITS				5
+#define LATENCY_EXACT_BUCKETS				(2 << LATENCY_SUB_BUCKET_BITS)
+#define NUM_LATENCY_BUCKETS					((64 - LATENCY_SUB_BUCKET_BITS + 1) << LATENCY_SUB_BUCKET_BITS)
+
+enum class TransactionStatus : U32
+{
+	Pending,			// No response yet
+	Complete,
+	ErrorResponse,		// Completed by a response with the E bit set
+	NoResponse,			// The source ID was used by a new command before a response arrived
+	UnexpectedResponse,	// No command is waiting for the response's source ID and header
+	SizeOfEnum
+};
+
+typedef struct AbccTransaction
+{
+	S64 lCommandFirstSample;
+	S64 lCommandLastSample;
+	S64 lResponseFirstSample;
+	S64 lResponseLastSample;
+	U32 dwCommandId;				// Message table ids, ABCC_MSG_ID_NONE if there is no such message
+	U32 dwResponseId;
+	MsgHeaderInfo_t sHeader;		// Of the command, or of the response if there is no command
+	SpiChannel_t eCommandChannel;	// MOSI for commands from the application, MISO for those from the ABCC
+	U8 bSourceId;
+	TransactionStatus eStatus;
+} AbccTransaction_t;
+
+/*
+** Response latencies of one object and command, in samples. The latency of a
+** transaction runs from the last sample of the command to the first sample
+** of the response, so the transfer time of a fragmented response is not
+** included. The percentiles are the upper bound of the histogram bucket
+** they fall in, which is within about 3% of the exact value, and never more
+** than the maximum.
+*/
+typedef struct TransactionLatencyStats
+{
+	U8 bObject;
+	U8 bCommand;					// Without the C and E bits
+	U64 lCount;
+	U64 lP50;
+	U64 lP99;
+	U64 lMax;
+} TransactionLatencyStats_t;
+
+/*
+** Messages are handed over as they are completed on each channel, which is
+** in the order they were sent. A command is paired with the next response on
+** the other channel that has its source ID, object, instance and command.
+** The table is filled by the analyzer's worker thread and read while the
+** results are rendered; all access is serialized.
+*/
+class AbccTransactionTable
+{
+public:
+
+	AbccTransactionTable();
+	~AbccTransactionTable();
+
+	/*
+	** Adds a message that was completed in the message table. A message that
+	** was added before, as when the packet holding its last fragment is
+	** retransmitted, is ignored. Returns the id of the transaction the
+	** message was added to, or TRANSACTION_ID_NONE if it was ignored.
+	*/
+	U32 AddMessage(const AbccMessageTable& messages, U32 message_id);
+
+	/* Returns false if there is no such transaction */
+	bool Get(U64 transaction_id, AbccTransaction_t* transaction_ptr) const;
+
+	U64 GetTransactionCount() const;
+
+	/* One entry per object and command with a response, ordered by object and command */
+	void GetLatencyStats(std::vector<TransactionLatencyStats_t>* stats_ptr) const;
+
+	/* Returns false unless the transaction was completed by a response */
+	static bool GetLatency(const AbccTransaction_t& transaction, U64* latency_ptr);
+
+	void Clear();
+
+protected:
+
+	typedef struct LatencyHistogram
+	{
+		U64 lCount;
+		U64 lMax;
+		std::vector<U32> adwBuckets;
+	} LatencyHistogram_t;
+
+	static U32 GetLatencyBucket(U64 latency);
+	static U64 GetLatencyBucketLimit(U32 bucket);
+	static U64 GetLatencyPercentile(const LatencyHistogram_t& histogram, U32 percent);
+
+	U32 AddResponse(U32 message_id, const AbccMessageView_t& view, const MsgHeaderInfo_t& header);
+	void AddLatency(const AbccTransaction_t& transaction);
+
+protected:
+
+	std::vector<AbccTransaction_t> mTransactions;
+
+	// Transaction waiting for a response, per command channel and source ID
+	U32 maPending[SpiChannel::NotSpecified][256];
+
+	// Messages below these ids were added already, per channel
+	U32 maNextMessageId[SpiChannel::NotSpecified];
+
+	// Keyed by object and command, in that order
+	std::map<U16, LatencyHistogram_t> mLatencies;
+
+	mutable std::mutex mMutex;
+};
+
+#endif /* ABCC_TRANSACTION_TABLE_H */
@@ -0,0 +1,1686 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiBenchmark.cpp
+**    Summary: abcc-spi-bench, decode throughput benchmark. Generates fixed
+**             synthetic captures with SpiSimulationDataGenerator, runs
+**             SpiAnalyzer over them on the stand-in SDK and reports time,
+**             throughput, memory and allocations. Optionally compares the
+**             results against a stored baseline, or checks that the
+**             specialized acquisition kernels decode the captures the same
+**             way as the generic loop and that ranges of them resumed from
+**             decoder checkpoints decode the same as the whole capture.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <fstream>
+#include <map>
+#include <new>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
+#include "StandinHost.h"
+#include "../AbccSpiAnalyzer.h"
+#include "../AbccSpiAnalyzerSettings.h"
+#include "../AbccSpiAnalyzerResults.h"
+#include "../AbccCrc.h"
+#include "../AbccTextBuilder.h"
+#include "AnalyzerHelpers.h"
+#include "../cli/AbccSpiChunkedDecoder.h"
+#include "../cli/AbccSpiResultsCache.h"
+
+#define BENCH_NAME "abcc-spi-bench"
+
+#define DEFAULT_NUM_SAMPLES			20000000ull
+#define DEFAULT_SAMPLE_RATE			50000000
+#define DEFAULT_ITERATIONS			3
+#define DEFAULT_THRESHOLD_PERCENT	10.0
+#define RANDOM_SEED					0x41424343
+
+/* Frames shown at once when rendering, each window is rendered twice */
+#define RENDER_WINDOW_FRAMES		1000
+
+/* Strings formatted per case and iteration of the formatting benchmark */
+#define FORMAT_OPERATIONS			2000000
+
+/* Buffers of every length up to this are checksummed by --verify */
+#define CRC_VERIFY_MAX_LENGTH		3000
+
+/*------------------------------------------------------------------------
+** Allocation tracking. Every allocation carries a small header holding its
+** size so that the live and peak heap usage can be tracked as well.
+**------------------------------------------------------------------------
+*/
+
+static std::atomic<U64> sAllocationCount(0);
+static std::atomic<U64> sLiveHeapBytes(0);
+static std::atomic<U64> sPeakHeapBytes(0);
+
+static const size_t ALLOCATION_HEADER_SIZE = alignof(std::max_align_t);
+
+static void* TrackedAlloc(size_t size)
+{
+	U8* ptr = (U8*)malloc(size + ALLOCATION_HEADER_SIZE);
+
+	if (ptr == nullptr)
+	{
+		throw std::bad_alloc();
+	}
+
+	*(size_t*)ptr = size;
+	sAllocationCount++;
+
+	U64 live = (sLiveHeapBytes += size);
+	U64 peak = sPeakHeapBytes;
+
+	while ((live > peak) && !sPeakHeapBytes.compare_exchange_weak(peak, live))
+	{
+	}
+
+	return ptr + ALLOCATION_HEADER_SIZE;
+}
+
+static void TrackedFree(void* ptr)
+{
+	if (ptr != nullptr)
+	{
+		U8* base = (U8*)ptr - ALLOCATION_HEADER_SIZE;
+		sLiveHeapBytes -= *(size_t*)base;
+		free(base);
+	}
+}
+
+void* operator new(size_t size) { return TrackedAlloc(size); }
+void* operator new[](size_t size) { return TrackedAlloc(size); }
+void operator delete(void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { TrackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { TrackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { TrackedFree(ptr); }
+
+static U64 GetPeakRssBytes()
+{
+#ifdef _WIN32
+	return 0;
+#else
+	struct rusage usage;
+
+	getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+	return (U64)usage.ru_maxrss;
+#else
+	return (U64)usage.ru_maxrss * 1024;
+#endif
+#endif
+}
+
+/*------------------------------------------------------------------------
+** Scenarios
+**------------------------------------------------------------------------
+*/
+
+typedef struct Scenario
+{
+	const char* name;
+	const char* description;
+	bool f3Wire;
+	bool f3WireOn4Channels;			/* Enable channel present but ignored */
+	bool f4WireOn3Channels;			/* 4-wire capture decoded without its enable channel */
+	S32 lClockIdleHigh;			/* -1: auto, 0: low, 1: high */
+	S32 lMsgDataLength;			/* SpiMessageDataLength advanced setting */
+	U32 dwCorruptionsPerMillion;	/* Data line glitches per million clock edges */
+} Scenario_t;
+
+static const Scenario_t asScenarios[] =
+{
+	{ "4wire",        "4-wire, mixed clock polarity",                false, false, false, -1,  8,     0 },
+	{ "3wire",        "3-wire",                                      true,  false, false, -1,  8,     0 },
+	{ "3wire-on-4",   "3-wire, enable channel ignored",              false, true,  false, -1,  8,     0 },
+	{ "4wire-on-3",   "4-wire, no enable channel",                   false, false, true,  -1,  8,     0 },
+	{ "clk-idle-low", "4-wire, clock idles low (CPOL0/CPHA0)",        false, false, false,  0,  8,     0 },
+	{ "clk-idle-hi",  "4-wire, clock idles high (CPOL1/CPHA1)",       false, false, false,  1,  8,     0 },
+	{ "fragmented",   "4-wire, 2-byte message field (fragmentation)", false, false, false, -1,  1,     0 },
+	{ "crc-storm",    "4-wire, data glitches causing CRC errors",     false, false, false, -1,  8, 20000 },
+};
+
+typedef struct BenchResult
+{
+	double rNsPerByte;
+	double rSamplesPerSec;
+	double rFramesPerSec;
+	double rPacketsPerSec;
+	double rAllocsPerPacket;
+	U64 lBytes;
+	U64 lFrames;
+	U64 lPackets;
+	U64 lPeakHeapBytes;
+	U64 lPeakRssBytes;
+	double rColdRenderNsPerFrame;
+	double rWarmRenderNsPerFrame;
+	U64 lTextCacheHits;
+	U64 lTextCacheMisses;
+	double rPacketRenderNsPerPacket;
+} BenchResult_t;
+
+/*
+** Exposes the simulation generator and results of the analyzer.
+*/
+class BenchAnalyzer : public SpiAnalyzer
+{
+public:
+
+	SpiAnalyzerSettings* GetSettings()
+	{
+		return mSettings.get();
+	}
+
+	SpiAnalyzerResults* GetResults()
+	{
+		return mResults.get();
+	}
+
+	void SetRandomSeed(U32 seed)
+	{
+		mSimulationDataGenerator.SetRandomSeed(seed);
+	}
+
+	void SetGenericAcquisition(bool generic)
+	{
+		mGenericAcquisition = generic;
+	}
+};
+
+static Channel sMosiChannel(0, 0);
+static Channel sMisoChannel(0, 1);
+static Channel sClockChannel(0, 2);
+static Channel sEnableChannel(0, 3);
+
+static void ConfigureAnalyzer(BenchAnalyzer* analyzer, const Scenario_t& scenario)
+{
+	SpiAnalyzerSettings* settings = analyzer->GetSettings();
+
+	settings->mMosiChannel = sMosiChannel;
+	settings->mMisoChannel = sMisoChannel;
+	settings->mClockChannel = sClockChannel;
+	settings->mEnableChannel = (scenario.f3Wire || scenario.f4WireOn3Channels) ? UNDEFINED_CHANNEL : sEnableChannel;
+	settings->m3WireOn4Channels = scenario.f3WireOn4Channels;
+	settings->m4WireOn3Channels = scenario.f4WireOn3Channels;
+	settings->mSimulateClockIdleHigh = scenario.lClockIdleHigh;
+	settings->mSimulateMsgDataLength = scenario.lMsgDataLength;
+	settings->UpdateInterfacesFromSettings();
+}
+
+static U64 NextRandom(U64* state_ptr)
+{
+	*state_ptr = *state_ptr * 6364136223846793005ull + 1442695040888963407ull;
+	return *state_ptr >> 33;
+}
+
+/*
+** Inserts a one-sample glitch at a clock edge on MOSI or MISO, so that
+** the byte sampled at that edge is corrupted.
+*/
+static void CorruptCapture(StandinCapture* capture, U32 corruptions_per_million)
+{
+	const std::vector<U64>& clockEdges = capture->GetTransitions(sClockChannel);
+	std::vector<U64> mosi = capture->GetTransitions(sMosiChannel);
+	std::vector<U64> miso = capture->GetTransitions(sMisoChannel);
+	U64 numCorruptions = (U64)clockEdges.size() * corruptions_per_million / 1000000;
+	U64 randomState = RANDOM_SEED;
+
+	for (U64 i = 0; (i < numCorruptions) && (clockEdges.size() > 2); i++)
+	{
+		U64 edge = clockEdges[1 + NextRandom(&randomState) % (clockEdges.size() - 2)];
+		std::vector<U64>& data = (NextRandom(&randomState) & 1) ? mosi : miso;
+
+		data.push_back(edge - 1);
+		data.push_back(edge + 1);
+	}
+
+	for (std::vector<U64>* data : { &mosi, &miso })
+	{
+		std::vector<U64> merged;
+
+		// Coinciding transitions cancel each other
+		std::sort(data->begin(), data->end());
+		for (U64 transition : *data)
+		{
+			if (!merged.empty() && (merged.back() == transition))
+			{
+				merged.pop_back();
+			}
+			else
+			{
+				merged.push_back(transition);
+			}
+		}
+
+		data->swap(merged);
+	}
+
+	capture->AddChannel(sMosiChannel, capture->GetInitialBitState(sMosiChannel), mosi);
+	capture->AddChannel(sMisoChannel, capture->GetInitialBitState(sMisoChannel), miso);
+}
+
+/*
+** Renders the bubbles of both data channels and the tabular text of every
+** frame, a window at a time the way the UI scrolls over a capture. Each
+** window is rendered once cold and then again, which the text cache serves.
+** The packet tabular text of every packet is timed as well.
+*/
+static void RenderFrames(SpiAnalyzerResults* results, BenchResult_t* result_ptr)
+{
+	U64 numFrames = results->GetNumFrames();
+	double coldSeconds = 0.0;
+	double warmSeconds = 0.0;
+
+	for (U64 first = 0; first < numFrames; first += RENDER_WINDOW_FRAMES)
+	{
+		U64 last = std::min<U64>(first + RENDER_WINDOW_FRAMES, numFrames);
+
+		for (U32 pass = 0; pass < 2; pass++)
+		{
+			auto start = std::chrono::steady_clock::now();
+
+			for (U64 i = first; i < last; i++)
+			{
+				results->GenerateBubbleText(i, sMosiChannel, Hexadecimal);
+				results->GenerateBubbleText(i, sMisoChannel, Hexadecimal);
+				results->GenerateFrameTabularText(i, Hexadecimal);
+			}
+
+			auto stop = std::chrono::steady_clock::now();
+			double seconds = std::chrono::duration<double>(stop - start).count();
+
+			if (pass == 0)
+			{
+				coldSeconds += seconds;
+			}
+			else
+			{
+				warmSeconds += seconds;
+			}
+		}
+	}
+
+	U64 numPackets = results->GetNumPackets();
+	auto packetStart = std::chrono::steady_clock::now();
+
+	for (U64 i = 0; i < numPackets; i++)
+	{
+		results->GeneratePacketTabularText(i, Hexadecimal);
+	}
+
+	auto packetStop = std::chrono::steady_clock::now();
+	double packetSeconds = std::chrono::duration<double>(packetStop - packetStart).count();
+
+	TextCacheStats_t stats = results->GetTextCacheStats();
+
+	result_ptr->rColdRenderNsPerFrame = coldSeconds * 1e9 / std::max<U64>(numFrames, 1);
+	result_ptr->rWarmRenderNsPerFrame = warmSeconds * 1e9 / std::max<U64>(numFrames, 1);
+	result_ptr->lTextCacheHits = stats.lHits;
+	result_ptr->lTextCacheMisses = stats.lMisses;
+	result_ptr->rPacketRenderNsPerPacket = packetSeconds * 1e9 / std::max<U64>(numPackets, 1);
+}
+
+static void GenerateCapture(const Scenario_t& scenario, U32 sample_rate, U64 num_samples, StandinCapture* capture)
+{
+	// The simulator needs the enable channel to produce 4-wire traffic
+	Scenario_t simulated = scenario;
+
+	simulated.f4WireOn3Channels = false;
+
+	{
+		BenchAnalyzer simulator;
+
+		ConfigureAnalyzer(&simulator, simulated);
+		simulator.SetRandomSeed(RANDOM_SEED);
+		StandinHost::Simulate(&simulator, sample_rate, num_samples, capture);
+	}
+
+	if (scenario.dwCorruptionsPerMillion > 0)
+	{
+		CorruptCapture(capture, scenario.dwCorruptionsPerMillion);
+	}
+}
+
+static void RunScenario(const Scenario_t& scenario, U32 sample_rate, U64 num_samples, U32 iterations, bool render, BenchResult_t* result_ptr)
+{
+	StandinCapture capture;
+	double bestSeconds = 0.0;
+
+	GenerateCapture(scenario, sample_rate, num_samples, &capture);
+
+	// Every SPI byte takes 8 clock cycles of two edges each
+	result_ptr->lBytes = capture.GetTransitions(sClockChannel).size() / 16;
+
+	for (U32 i = 0; i < iterations; i++)
+	{
+		BenchAnalyzer analyzer;
+		U64 allocationsBefore;
+
+		ConfigureAnalyzer(&analyzer, scenario);
+
+		StandinHost host(&analyzer, &capture);
+
+		sPeakHeapBytes = sLiveHeapBytes.load();
+		allocationsBefore = sAllocationCount;
+
+		auto start = std::chrono::steady_clock::now();
+		host.Run();
+		auto stop = std::chrono::steady_clock::now();
+
+		double seconds = std::chrono::duration<double>(stop - start).count();
+		U64 allocations = sAllocationCount - allocationsBefore;
+
+		if ((i == 0) || (seconds < bestSeconds))
+		{
+			bestSeconds = seconds;
+		}
+
+		result_ptr->lFrames = analyzer.GetResults()->GetNumFrames();
+		result_ptr->lPackets = analyzer.GetResults()->GetNumPackets();
+		result_ptr->lPeakHeapBytes = sPeakHeapBytes;
+		result_ptr->rAllocsPerPacket = (double)allocations / std::max<U64>(result_ptr->lPackets, 1);
+
+		if (render && (i == iterations - 1))
+		{
+			RenderFrames(analyzer.GetResults(), result_ptr);
+		}
+	}
+
+	result_ptr->lPeakRssBytes = GetPeakRssBytes();
+	result_ptr->rNsPerByte = bestSeconds * 1e9 / std::max<U64>(result_ptr->lBytes, 1);
+	result_ptr->rSamplesPerSec = num_samples / bestSeconds;
+	result_ptr->rFramesPerSec = result_ptr->lFrames / bestSeconds;
+	result_ptr->rPacketsPerSec = result_ptr->lPackets / bestSeconds;
+}
+
+/*------------------------------------------------------------------------
+** Acquisition verification. Each capture is decoded with the acquisition
+** kernels specialized per wiring mode and clock polarity, and again with the
+** generic loop they replace. The frames, packets and markers must be the
+** same.
+**------------------------------------------------------------------------
+*/
+
+static bool IsSameFrame(const Frame& expected, const Frame& actual)
+{
+	return (expected.mStartingSampleInclusive == actual.mStartingSampleInclusive) &&
+		(expected.mEndingSampleInclusive == actual.mEndingSampleInclusive) &&
+		(expected.mData1 == actual.mData1) &&
+		(expected.mData2 == actual.mData2) &&
+		(expected.mType == actual.mType) &&
+		(expected.mFlags == actual.mFlags);
+}
+
+static bool CompareResults(const char* scenario_name, SpiAnalyzerResults* expected, SpiAnalyzerResults* actual, U64* markers_ptr)
+{
+	Channel* channels[] = { &sMosiChannel, &sMisoChannel, &sClockChannel, &sEnableChannel };
+	U64 numFrames = expected->GetNumFrames();
+
+	if ((actual->GetNumFrames() != numFrames) || (actual->GetNumPackets() != expected->GetNumPackets()))
+	{
+		fprintf(stderr, BENCH_NAME ": %s: %llu frames in %llu packets, the generic loop gives %llu in %llu\n",
+			scenario_name,
+			(unsigned long long)actual->GetNumFrames(), (unsigned long long)actual->GetNumPackets(),
+			(unsigned long long)numFrames, (unsigned long long)expected->GetNumPackets());
+		return false;
+	}
+
+	for (U64 i = 0; i < numFrames; i++)
+	{
+		if (!IsSameFrame(expected->GetFrame(i), actual->GetFrame(i)))
+		{
+			fprintf(stderr, BENCH_NAME ": %s: frame %llu differs from the generic loop\n",
+				scenario_name, (unsigned long long)i);
+			return false;
+		}
+	}
+
+	for (U64 i = 0; i < expected->GetNumPackets(); i++)
+	{
+		if (expected->GetTransactionContainingPacket(i) != actual->GetTransactionContainingPacket(i))
+		{
+			fprintf(stderr, BENCH_NAME ": %s: packet %llu is in another transaction than with the generic loop\n",
+				scenario_name, (unsigned long long)i);
+			return false;
+		}
+	}
+
+	*markers_ptr = 0;
+
+	for (Channel* channel : channels)
+	{
+		U64 numMarkers = expected->GetNumMarkers(*channel);
+
+		if (actual->GetNumMarkers(*channel) != numMarkers)
+		{
+			fprintf(stderr, BENCH_NAME ": %s: %llu markers on channel %u, the generic loop gives %llu\n",
+				scenario_name, (unsigned long long)actual->GetNumMarkers(*channel),
+				(unsigned)channel->mChannelIndex, (unsigned long long)numMarkers);
+			return false;
+		}
+
+		for (U64 i = 0; i < numMarkers; i++)
+		{
+			AnalyzerResults::MarkerType expectedType;
+			AnalyzerResults::MarkerType actualType;
+			U64 expectedSample;
+			U64 actualSample;
+
+			expected->GetMarker(*channel, i, &expectedType, &expectedSample);
+			actual->GetMarker(*channel, i, &actualType, &actualSample);
+
+			if ((expectedType != actualType) || (expectedSample != actualSample))
+			{
+				fprintf(stderr, BENCH_NAME ": %s: marker %llu on channel %u differs from the generic loop\n",
+					scenario_name, (unsigned long long)i, (unsigned)channel->mChannelIndex);
+				return false;
+			}
+		}
+
+		*markers_ptr += numMarkers;
+	}
+
+	return true;
+}
+
+/*
+** Checks the CRC32 kernels, updates split at random points and
+** AbccCrc::Combine() against the nibble-wise ABCC40 definition, for buffers
+** of every length up to CRC_VERIFY_MAX_LENGTH.
+*/
+static bool VerifyCrc32()
+{
+	std::vector<U8> data(CRC_VERIFY_MAX_LENGTH);
+	U64 randomState = RANDOM_SEED;
+
+	for (U8& value : data)
+	{
+		value = (U8)NextRandom(&randomState);
+	}
+
+	for (U32 length = 0; length <= CRC_VERIFY_MAX_LENGTH; length++)
+	{
+		U32 expected = AbccCrc::Crc32With(Crc32Implementation::Nibble, data.data(), length);
+		U32 split = (length > 0) ? (U32)(NextRandom(&randomState) % (length + 1)) : 0;
+		AbccCrc crc;
+		AbccCrc splitCrc;
+
+		crc.Init();
+		crc.Update(data.data(), length);
+
+		splitCrc.Init();
+		splitCrc.Update(data.data(), split);
+		splitCrc.Update(data.data() + split, length - split);
+
+		U32 combined = AbccCrc::Combine(AbccCrc::Crc32With(Crc32Implementation::Nibble, data.data(), split),
+			AbccCrc::Crc32With(Crc32Implementation::Nibble, data.data() + split, length - split), length - split);
+
+		const char* failed =
+			(AbccCrc::Crc32With(Crc32Implementation::SliceBy8, data.data(), length) != expected) ? "slice-by-8" :
+			(AbccCrc::Crc32With(Crc32Implementation::Selected, data.data(), length) != expected) ? AbccCrc::KernelName() :
+			(crc.Crc32() != expected) ? "Update()" :
+			(splitCrc.Crc32() != expected) ? "split Update()" :
+			(combined != expected) ? "Combine()" :
+			nullptr;
+
+		if (failed != nullptr)
+		{
+			fprintf(stderr, BENCH_NAME ": CRC32 of %u bytes by %s differs from the nibble definition\n", length, failed);
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool VerifyScenario(const Scenario_t& scenario, U32 sample_rate, U64 num_samples)
+{
+	StandinCapture capture;
+	BenchAnalyzer reference;
+	BenchAnalyzer analyzer;
+	U64 numMarkers = 0;
+	bool matched;
+
+	GenerateCapture(scenario, sample_rate, num_samples, &capture);
+
+	ConfigureAnalyzer(&reference, scenario);
+	ConfigureAnalyzer(&analyzer, scenario);
+	reference.SetGenericAcquisition(true);
+
+	StandinHost referenceHost(&reference, &capture);
+	StandinHost host(&analyzer, &capture);
+
+	referenceHost.Run();
+	host.Run();
+
+	matched = CompareResults(scenario.name, reference.GetResults(), analyzer.GetResults(), &numMarkers);
+
+	printf("%-14s %12llu %12llu %12llu  %s\n",
+		scenario.name,
+		(unsigned long long)reference.GetResults()->GetNumFrames(),
+		(unsigned long long)reference.GetResults()->GetNumPackets(),
+		(unsigned long long)numMarkers,
+		matched ? "identical" : "DIFFERENT");
+
+	return matched;
+}
+
+/*------------------------------------------------------------------------
+** Marker density verification. Each capture is decoded with every bit
+** marker density. The frames and error markers must be the same as with all
+** bits. First-bit markers must fall on the first sample of the frames of
+** their channel, and the enable line must keep its packet markers unless
+** only errors are marked.
+**------------------------------------------------------------------------
+*/
+
+typedef std::vector<std::pair<U64, AnalyzerResults::MarkerType>> MarkerList_t;
+
+typedef struct DensityCheck
+{
+	MarkerDensity eDensity;
+	const char* name;			/* As in the bit-markers advanced setting */
+} DensityCheck_t;
+
+/* Compared against the markers placed for all bits */
+static const DensityCheck_t asDensityChecks[] =
+{
+	{ MarkerDensity::FirstBit,   "first-bit" },
+	{ MarkerDensity::None,       "none" },
+	{ MarkerDensity::ErrorsOnly, "errors-only" },
+};
+
+#define NUM_DENSITY_CHECKS				( sizeof(asDensityChecks) / sizeof(DensityCheck_t) )
+
+static bool IsErrorMarkerType(AnalyzerResults::MarkerType marker_type)
+{
+	return (marker_type == AnalyzerResults::ErrorDot) ||
+		(marker_type == AnalyzerResults::ErrorSquare) ||
+		(marker_type == AnalyzerResults::ErrorX);
+}
+
+static void GetMarkers(SpiAnalyzerResults* results, Channel& channel, bool errors, MarkerList_t* markers_ptr)
+{
+	markers_ptr->clear();
+
+	for (U64 i = 0; i < results->GetNumMarkers(channel); i++)
+	{
+		AnalyzerResults::MarkerType markerType;
+		U64 sample;
+
+		results->GetMarker(channel, i, &markerType, &sample);
+
+		if (IsErrorMarkerType(markerType) == errors)
+		{
+			markers_ptr->push_back(std::make_pair(sample, markerType));
+		}
+	}
+}
+
+/*
+** First-bit markers must be placed on the first sample of each frame of their
+** data channel, and not within a frame. A marker outside of every frame is
+** the start of a frame that was cut short before it was decoded.
+*/
+static bool AreFirstBitMarkersPlaced(SpiAnalyzerResults* results, bool mosi, std::vector<U64> samples)
+{
+	std::vector<std::pair<S64, S64>> frames;
+	S64 coveredUntil = -1;
+	size_t next = 0;
+
+	for (U64 i = 0; i < results->GetNumFrames(); i++)
+	{
+		Frame frame = results->GetFrame(i);
+
+		// Clocking errors are not decoded from a byte
+		if ((frame.mType != AbccSpiError::EndOfTransfer) && (frame.HasFlag(SPI_MOSI_FLAG) == mosi))
+		{
+			frames.push_back(std::make_pair(frame.mStartingSampleInclusive, frame.mEndingSampleInclusive));
+		}
+	}
+
+	std::sort(frames.begin(), frames.end());
+	std::sort(samples.begin(), samples.end());
+
+	for (const std::pair<S64, S64>& frame : frames)
+	{
+		if (!std::binary_search(samples.begin(), samples.end(), (U64)frame.first))
+		{
+			return false;
+		}
+	}
+
+	for (U64 sample : samples)
+	{
+		while ((next < frames.size()) && (frames[next].first < (S64)sample))
+		{
+			coveredUntil = std::max(coveredUntil, frames[next].second);
+			next++;
+		}
+
+		bool startsFrame = (next < frames.size()) && (frames[next].first == (S64)sample);
+
+		if (!startsFrame && (coveredUntil >= (S64)sample))
+		{
+			return false;
+		}
+	}
+
+	return true;
+}
+
+static bool CheckMarkerDensity(MarkerDensity density, SpiAnalyzerResults* all_bits, SpiAnalyzerResults* results, const char** failure_ptr)
+{
+	Channel* channels[] = { &sMosiChannel, &sMisoChannel, &sClockChannel, &sEnableChannel };
+	MarkerList_t expected;
+	MarkerList_t actual;
+
+	if (results->GetNumFrames() != all_bits->GetNumFrames())
+	{
+		*failure_ptr = "number of frames";
+		return false;
+	}
+
+	for (U64 i = 0; i < results->GetNumFrames(); i++)
+	{
+		if (!IsSameFrame(all_bits->GetFrame(i), results->GetFrame(i)))
+		{
+			*failure_ptr = "frames";
+			return false;
+		}
+	}
+
+	for (Channel* channel : channels)
+	{
+		GetMarkers(all_bits, *channel, true, &expected);
+		GetMarkers(results, *channel, true, &actual);
+
+		if (actual != expected)
+		{
+			*failure_ptr = "error markers";
+			return false;
+		}
+
+		GetMarkers(results, *channel, false, &actual);
+
+		if (channel == &sEnableChannel)
+		{
+			GetMarkers(all_bits, *channel, false, &expected);
+
+			if ((density == MarkerDensity::ErrorsOnly) ? !actual.empty() : (actual != expected))
+			{
+				*failure_ptr = "enable markers";
+				return false;
+			}
+		}
+		else if (density != MarkerDensity::FirstBit)
+		{
+			if (!actual.empty())
+			{
+				*failure_ptr = "bit markers";
+				return false;
+			}
+		}
+		else if (channel == &sClockChannel)
+		{
+			// Arrows only where either data channel has a first-bit marker;
+			// a byte that was cut short has no arrow
+			std::vector<U64> samples;
+
+			for (Channel* dataChannel : { &sMosiChannel, &sMisoChannel })
+			{
+				GetMarkers(results, *dataChannel, false, &expected);
+
+				for (const std::pair<U64, AnalyzerResults::MarkerType>& marker : expected)
+				{
+					samples.push_back(marker.first);
+				}
+			}
+
+			std::sort(samples.begin(), samples.end());
+
+			for (const std::pair<U64, AnalyzerResults::MarkerType>& marker : actual)
+			{
+				if ((marker.second != AnalyzerResults::UpArrow) ||
+					!std::binary_search(samples.begin(), samples.end(), marker.first))
+				{
+					*failure_ptr = "clock arrows";
+					return false;
+				}
+			}
+		}
+		else
+		{
+			std::vector<U64> samples;
+
+			for (const std::pair<U64, AnalyzerResults::MarkerType>& marker : actual)
+			{
+				samples.push_back(marker.first);
+			}
+
+			if (!AreFirstBitMarkersPlaced(results, channel == &sMosiChannel, samples))
+			{
+				*failure_ptr = "first-bit markers";
+				return false;
+			}
+		}
+	}
+
+	return true;
+}
+
+static U64 GetTotalMarkers(SpiAnalyzerResults* results)
+{
+	Channel* channels[] = { &sMosiChannel, &sMisoChannel, &sClockChannel, &sEnableChannel };
+	U64 numMarkers = 0;
+
+	for (Channel* channel : channels)
+	{
+		numMarkers += results->GetNumMarkers(*channel);
+	}
+
+	return numMarkers;
+}
+
+static bool VerifyMarkerDensities(const Scenario_t& scenario, U32 sample_rate, U64 num_samples)
+{
+	StandinCapture capture;
+	BenchAnalyzer allBits;
+	U64 numMarkers[NUM_DENSITY_CHECKS];
+	const char* failure = nullptr;
+
+	GenerateCapture(scenario, sample_rate, num_samples, &capture);
+
+	ConfigureAnalyzer(&allBits, scenario);
+	allBits.GetSettings()->mMarkerDensity = MarkerDensity::AllBits;
+	StandinHost(&allBits, &capture).Run();
+
+	for (size_t i = 0; i < NUM_DENSITY_CHECKS; i++)
+	{
+		BenchAnalyzer analyzer;
+
+		ConfigureAnalyzer(&analyzer, scenario);
+		analyzer.GetSettings()->mMarkerDensity = asDensityChecks[i].eDensity;
+		StandinHost(&analyzer, &capture).Run();
+
+		numMarkers[i] = GetTotalMarkers(analyzer.GetResults());
+
+		if ((failure == nullptr) && !CheckMarkerDensity(asDensityChecks[i].eDensity, allBits.GetResults(), analyzer.GetResults(), &failure))
+		{
+			fprintf(stderr, BENCH_NAME ": %s: wrong %s with bit markers set to %s\n",
+				scenario.name, failure, asDensityChecks[i].name);
+		}
+	}
+
+	printf("%-14s %12llu %12llu %12llu %12llu  %s\n",
+		scenario.name,
+		(unsigned long long)GetTotalMarkers(allBits.GetResults()),
+		(unsigned long long)numMarkers[0],
+		(unsigned long long)numMarkers[1],
+		(unsigned long long)numMarkers[2],
+		(failure == nullptr) ? "as expected" : "WRONG");
+
+	return (failure == nullptr);
+}
+
+/*------------------------------------------------------------------------
+** Range decode verification. Each capture is decoded in full by the
+** command-line decoder, which takes decoder checkpoints, and must give the
+** same frames and packets as the analyzer. Ranges of it are then decoded
+** again from the checkpoints, once from those read back from the results
+** cache and once from those of a chunked decode, and must give the same
+** frames and packets as the same part of the full decode.
+**------------------------------------------------------------------------
+*/
+
+/* Packets between the checkpoints of the full decode */
+#define RANGE_CHECKPOINT_INTERVAL		16
+
+/* Threads of the chunked decode, which takes a checkpoint at every chunk */
+#define RANGE_CHUNKS					4
+
+/* Ranges decoded per capture and set of checkpoints */
+#define NUM_RANGES						8
+
+/*
+** Matches the message ids of two decodes, which need not be the same. Each
+** id of the range must always stand for the same id of the full decode. A
+** message opened before the range is ABCC_MSG_ID_NONE in it, and may
+** therefore not be one the range opened itself.
+*/
+class MessageIdMatcher
+{
+public:
+
+	bool Match(U32 expected, U32 actual)
+	{
+		if (actual == ABCC_MSG_ID_NONE)
+		{
+			mUnopened.insert(expected);
+			return true;
+		}
+
+		return (mIds.emplace(actual, expected).first->second == expected);
+	}
+
+	bool IsConsistent() const
+	{
+		for (const std::pair<const U32, U32>& id : mIds)
+		{
+			if (mUnopened.count(id.second) != 0)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+protected:
+
+	std::map<U32, U32> mIds;
+	std::set<U32> mUnopened;
+};
+
+static DecoderFrame_t GetDecoderFrame(const Frame& frame)
+{
+	DecoderFrame_t decoderFrame;
+
+	decoderFrame.mStartingSampleInclusive = frame.mStartingSampleInclusive;
+	decoderFrame.mEndingSampleInclusive = frame.mEndingSampleInclusive;
+	decoderFrame.mData1 = frame.mData1;
+	decoderFrame.mData2 = frame.mData2;
+	decoderFrame.mType = frame.mType;
+	decoderFrame.mFlags = frame.mFlags;
+
+	return decoderFrame;
+}
+
+static bool IsSameDecodedFrame(const DecoderFrame_t& expected, const DecoderFrame_t& actual, MessageIdMatcher* ids_ptr)
+{
+	if ((expected.mStartingSampleInclusive != actual.mStartingSampleInclusive) ||
+		(expected.mEndingSampleInclusive != actual.mEndingSampleInclusive) ||
+		(expected.mType != actual.mType) ||
+		(expected.mFlags != actual.mFlags))
+	{
+		return false;
+	}
+
+	if (expected.HasFlag(SPI_PD_BLOCK_FLAG))
+	{
+		// The data is an offset into the payloads of each sink
+		return true;
+	}
+
+	if (IsMessageDataFrame(expected))
+	{
+		MsgDataFrameData2_t expectedData2;
+		MsgDataFrameData2_t actualData2;
+
+		memcpy(&expectedData2, &expected.mData2, sizeof(expectedData2));
+		memcpy(&actualData2, &actual.mData2, sizeof(actualData2));
+
+		return (expected.mData1 == actual.mData1) &&
+			(expectedData2.msgDataCnt == actualData2.msgDataCnt) &&
+			ids_ptr->Match(expectedData2.msgId, actualData2.msgId);
+	}
+
+	return (expected.mData1 == actual.mData1) && (expected.mData2 == actual.mData2);
+}
+
+static bool IsSameChannelSummary(const PacketChannelSummary_t& expected, const PacketChannelSummary_t& actual)
+{
+	return (expected.ePacketType == actual.ePacketType) &&
+		(expected.sMsgHeader.cmd == actual.sMsgHeader.cmd) &&
+		(expected.sMsgHeader.obj == actual.sMsgHeader.obj) &&
+		(expected.sMsgHeader.inst == actual.sMsgHeader.inst) &&
+		(expected.sMsgHeader.cmdExt == actual.sMsgHeader.cmdExt) &&
+		(expected.bStatus == actual.bStatus) &&
+		(expected.bFlags == actual.bFlags);
+}
+
+static bool IsSamePacketSummary(const PacketSummary_t& expected, const PacketSummary_t& actual)
+{
+	return (expected.lFirstSample == actual.lFirstSample) &&
+		(expected.lLastSample == actual.lLastSample) &&
+		IsSameChannelSummary(expected.sMosi, actual.sMosi) &&
+		IsSameChannelSummary(expected.sMiso, actual.sMiso);
+}
+
+/*
+** Compares the full decode of the command-line decoder with the analyzer's
+** results.
+*/
+static bool CompareFullDecode(SpiAnalyzerResults* expected, const DecoderRecordingView_t& actual, const char** failure_ptr)
+{
+	MessageIdMatcher ids;
+
+	if ((actual.nFrameCount != expected->GetNumFrames()) || (actual.nPacketSummaryCount != expected->GetNumPackets()))
+	{
+		*failure_ptr = "frame or packet count";
+		return false;
+	}
+
+	for (U64 i = 0; i < actual.nFrameCount; i++)
+	{
+		if (!IsSameDecodedFrame(GetDecoderFrame(expected->GetFrame(i)), actual.psFrames[i], &ids))
+		{
+			*failure_ptr = "frames";
+			return false;
+		}
+	}
+
+	for (U64 i = 0; i < actual.nPacketSummaryCount; i++)
+	{
+		PacketSummary_t summary;
+
+		if (!expected->GetPacketSummaries().Get(i, &summary) || !IsSamePacketSummary(summary, actual.psPacketSummaries[i]))
+		{
+			*failure_ptr = "packets";
+			return false;
+		}
+	}
+
+	if (!ids.IsConsistent())
+	{
+		*failure_ptr = "message ids";
+		return false;
+	}
+
+	return true;
+}
+
+/*
+** Compares a range decode with the part of the full decode that starts with
+** the same frame and packet.
+*/
+static bool CompareRangeDecode(const DecoderRecordingView_t& full, const DecoderRecordingView_t& range, const char** failure_ptr)
+{
+	MessageIdMatcher ids;
+	size_t firstFrame = 0;
+	size_t firstPacket = 0;
+
+	if (range.nFrameCount == 0)
+	{
+		*failure_ptr = "empty range";
+		return false;
+	}
+
+	while ((firstFrame < full.nFrameCount) &&
+		   (full.psFrames[firstFrame].mStartingSampleInclusive < range.psFrames[0].mStartingSampleInclusive))
+	{
+		firstFrame++;
+	}
+
+	// Without packets, e.g. without an enable line, the range is the rest of the capture
+	while ((range.nPacketSummaryCount > 0) && (firstPacket < full.nPacketSummaryCount) &&
+		   (full.psPacketSummaries[firstPacket].lFirstSample < range.psPacketSummaries[0].lFirstSample))
+	{
+		firstPacket++;
+	}
+
+	if ((range.nFrameCount > full.nFrameCount - firstFrame) ||
+		(range.nPacketSummaryCount > full.nPacketSummaryCount - firstPacket))
+	{
+		*failure_ptr = "frame or packet count";
+		return false;
+	}
+
+	for (size_t i = 0; i < range.nFrameCount; i++)
+	{
+		if (!IsSameDecodedFrame(full.psFrames[firstFrame + i], range.psFrames[i], &ids))
+		{
+			*failure_ptr = "frames";
+			return false;
+		}
+	}
+
+	for (size_t i = 0; i < range.nPacketSummaryCount; i++)
+	{
+		if (!IsSamePacketSummary(full.psPacketSummaries[firstPacket + i], range.psPacketSummaries[i]))
+		{
+			*failure_ptr = "packets";
+			return false;
+		}
+	}
+
+	if (!ids.IsConsistent())
+	{
+		*failure_ptr = "message ids";
+		return false;
+	}
+
+	return true;
+}
+
+static void GetCaptureChannel(const StandinCapture& capture, const Channel& channel, CaptureChannel_t* channel_ptr)
+{
+	channel_ptr->eInitialState = capture.GetInitialBitState(channel);
+	channel_ptr->alTransitions = capture.GetTransitions(channel);
+}
+
+/*
+** Stores the checkpoints in a results cache in a temporary directory and
+** reads them back, the way the command-line decoder resumes from them.
+*/
+static bool GetCachedCheckpoints(const AbccSpiDecoderRecorder& recorder, const std::vector<DecoderCheckpoint_t>& checkpoints,
+	std::vector<DecoderCheckpoint_t>* checkpoints_ptr)
+{
+	char directory[] = "/tmp/" BENCH_NAME "-XXXXXX";
+	CachedCaptureInfo_t captureInfo = { 0, 4 };
+	bool loaded;
+
+	if (mkdtemp(directory) == nullptr)
+	{
+		return false;
+	}
+
+	AbccSpiResultsCache cache(directory);
+
+	loaded = cache.Store(RANDOM_SEED, captureInfo, recorder, checkpoints) &&
+		cache.Load(RANDOM_SEED, nullptr, &captureInfo, checkpoints_ptr);
+
+	remove(cache.GetPath(RANDOM_SEED).c_str());
+	rmdir(directory);
+
+	return loaded;
+}
+
+static bool VerifyRangeDecodes(const Scenario_t& scenario, U32 sample_rate, U64 num_samples)
+{
+	StandinCapture capture;
+	BenchAnalyzer analyzer;
+	CaptureChannel_t asChannels[4];
+	CaptureChannels_t channels;
+	AcquisitionConfig_t config;
+	DecoderConfig_t decoderConfig;
+	AbccSpiDecoderRecorder fullRecorder;
+	AbccSpiDecoderRecorder chunkedRecorder;
+	DecoderRecordingView_t full;
+	std::vector<DecoderCheckpoint_t> checkpoints;
+	std::vector<DecoderCheckpoint_t> checkpointSets[2];
+	U32 resumed = 0;
+	const char* failure = nullptr;
+
+	GenerateCapture(scenario, sample_rate, num_samples, &capture);
+
+	ConfigureAnalyzer(&analyzer, scenario);
+	StandinHost(&analyzer, &capture).Run();
+
+	SpiAnalyzerSettings* settings = analyzer.GetSettings();
+
+	GetCaptureChannel(capture, sMosiChannel, &asChannels[0]);
+	GetCaptureChannel(capture, sMisoChannel, &asChannels[1]);
+	GetCaptureChannel(capture, sClockChannel, &asChannels[2]);
+	channels.psMosi = &asChannels[0];
+	channels.psMiso = &asChannels[1];
+	channels.psClock = &asChannels[2];
+	channels.psEnable = nullptr;
+
+	if (settings->mEnableChannel != UNDEFINED_CHANNEL)
+	{
+		GetCaptureChannel(capture, sEnableChannel, &asChannels[3]);
+		channels.psEnable = &asChannels[3];
+	}
+
+	// As set up by SpiAnalyzer
+	config.dwSampleRate = sample_rate;
+	config.lClockingAlertLimit = settings->mClockingAlertLimit;
+	config.f3WireOn4Channels = settings->m3WireOn4Channels;
+	config.f4WireOn3Channels = settings->m4WireOn3Channels;
+	config.fExpandBitFrames = settings->mExpandBitFrames;
+	config.fTransactionAcquisition = true;
+	config.dwIdleGapNs = settings->m3WireIdleGapNs;
+	config.dwClockIdleNs = settings->m3WireClockIdleNs;
+	config.eMarkerDensity = settings->mMarkerDensity;
+	config.fGenericAcquisition = false;
+
+	decoderConfig.fCoalesceProcessData = settings->mCoalesceProcessData;
+	decoderConfig.fErrorMarkersOnly = (settings->mMarkerDensity == MarkerDensity::ErrorsOnly);
+
+	AbccSpiChunkedDecoder decoder(channels, capture.mNumSamples);
+
+	decoder.Setup(config, decoderConfig);
+	decoder.DecodeWithCheckpoints(&fullRecorder, RANGE_CHECKPOINT_INTERVAL, &checkpoints);
+	decoder.Decode(&chunkedRecorder, RANGE_CHUNKS, &checkpointSets[1]);
+	fullRecorder.GetView(&full);
+
+	if (CompareFullDecode(analyzer.GetResults(), full, &failure) &&
+		!GetCachedCheckpoints(fullRecorder, checkpoints, &checkpointSets[0]))
+	{
+		failure = "cached checkpoints";
+	}
+
+	for (size_t set = 0; (set < 2) && (failure == nullptr); set++)
+	{
+		for (U32 i = 0; (i < NUM_RANGES) && (failure == nullptr); i++)
+		{
+			AbccSpiDecoderRecorder rangeRecorder;
+			DecoderRecordingView_t range;
+			U64 firstSample = num_samples * (2 * i + 1) / (2 * NUM_RANGES);
+			U64 lastSample = firstSample + num_samples / (4 * NUM_RANGES);
+
+			if (decoder.DecodeRange(&rangeRecorder, checkpointSets[set], firstSample, lastSample) > 0)
+			{
+				resumed++;
+			}
+
+			rangeRecorder.GetView(&range);
+			CompareRangeDecode(full, range, &failure);
+		}
+	}
+
+	printf("%-14s %12llu %12llu %12llu %12u  %s\n",
+		scenario.name,
+		(unsigned long long)full.nFrameCount,
+		(unsigned long long)checkpointSets[0].size(),
+		(unsigned long long)checkpointSets[1].size(),
+		resumed,
+		(failure == nullptr) ? "identical" : failure);
+
+	if (failure != nullptr)
+	{
+		fprintf(stderr, BENCH_NAME ": %s: the range decodes differ in their %s\n", scenario.name, failure);
+	}
+
+	return (failure == nullptr);
+}
+
+/*------------------------------------------------------------------------
+** Formatting microbenchmarks. Each case formats the same text with
+** snprintf() or the SDK, as the results did before, and with
+** AbccTextBuilder. The two must produce the same text.
+**------------------------------------------------------------------------
+*/
+
+typedef void (*FormatFunction)(char* buffer, size_t buffer_size, U32 value);
+
+typedef struct FormatCase
+{
+	const char* name;
+	FormatFunction pnPrintf;
+	FormatFunction pnBuilder;
+} FormatCase_t;
+
+static void FormatHexPrintf(char* buffer, size_t buffer_size, U32 value)
+{
+	AnalyzerHelpers::GetNumberString(value & 0xFF, Hexadecimal, 8, buffer, (U32)buffer_size);
+}
+
+static void FormatHexBuilder(char* buffer, size_t buffer_size, U32 value)
+{
+	AbccTextBuilder(buffer, buffer_size).AppendNumber(value & 0xFF, Hexadecimal, 8);
+}
+
+static void FormatDecimalPrintf(char* buffer, size_t buffer_size, U32 value)
+{
+	AnalyzerHelpers::GetNumberString(value & 0xFFFF, Decimal, 16, buffer, (U32)buffer_size);
+}
+
+static void FormatDecimalBuilder(char* buffer, size_t buffer_size, U32 value)
+{
+	AbccTextBuilder(buffer, buffer_size).AppendNumber(value & 0xFFFF, Decimal, 16);
+}
+
+static void FormatDataBytePrintf(char* buffer, size_t buffer_size, U32 value)
+{
+	char numberStr[DISPLAY_NUMERIC_STRING_BUFFER_SIZE];
+
+	AnalyzerHelpers::GetNumberString(value & 0xFF, Hexadecimal, 8, numberStr, sizeof(numberStr));
+	SNPRINTF(buffer, buffer_size, " [%s] Byte #%d ", numberStr, (U16)(value >> 8));
+}
+
+static void FormatDataByteBuilder(char* buffer, size_t buffer_size, U32 value)
+{
+	char numberStr[DISPLAY_NUMERIC_STRING_BUFFER_SIZE];
+
+	AbccTextBuilder(numberStr, sizeof(numberStr)).AppendNumber(value & 0xFF, Hexadecimal, 8);
+	AbccTextBuilder(buffer, buffer_size).Append(" [").Append(numberStr).Append("] Byte #").AppendDecimal((U16)(value >> 8)).Append(' ');
+}
+
+static void FormatSourceIdPrintf(char* buffer, size_t buffer_size, U32 value)
+{
+	SNPRINTF(buffer, buffer_size, "Source ID: %d (0x%02X)", (U8)value, (U8)value);
+}
+
+static void FormatSourceIdBuilder(char* buffer, size_t buffer_size, U32 value)
+{
+	AbccTextBuilder(buffer, buffer_size).Append("Source ID: ").AppendDecimal((U8)value).Append(" (0x").AppendHex((U8)value, 2).Append(')');
+}
+
+static void FormatTabularLinePrintf(char* buffer, size_t buffer_size, U32 value)
+{
+	SNPRINTF(buffer, buffer_size, "%s%s", (value & 1) ? "MISO-!" : "MOSI-", "Object: Anybus Object (0x01)");
+}
+
+static void FormatTabularLineBuilder(char* buffer, size_t buffer_size, U32 value)
+{
+	static const TextPrefix_t asPrefixes[] = { TEXT_PREFIX("MOSI-"), TEXT_PREFIX("MISO-!") };
+
+	AbccTextBuilder(buffer, buffer_size).Append(asPrefixes[value & 1]).Append("Object: Anybus Object (0x01)");
+}
+
+static void FormatCrcPrintf(char* buffer, size_t buffer_size, U32 value)
+{
+	SNPRINTF(buffer, buffer_size, "Received 0x%08X == Calculated 0x%08X", value, value * 2654435761u);
+}
+
+static void FormatCrcBuilder(char* buffer, size_t buffer_size, U32 value)
+{
+	AbccTextBuilder(buffer, buffer_size).Append("Received 0x").AppendHex(value, 8).Append(" == Calculated 0x").AppendHex(value * 2654435761u, 8);
+}
+
+static const FormatCase_t asFormatCases[] =
+{
+	{ "hex-byte",     FormatHexPrintf,          FormatHexBuilder },
+	{ "decimal",      FormatDecimalPrintf,      FormatDecimalBuilder },
+	{ "data-byte",    FormatDataBytePrintf,     FormatDataByteBuilder },
+	{ "source-id",    FormatSourceIdPrintf,     FormatSourceIdBuilder },
+	{ "tabular-line", FormatTabularLinePrintf,  FormatTabularLineBuilder },
+	{ "crc",          FormatCrcPrintf,          FormatCrcBuilder },
+};
+
+/* Returns the fastest ns per string and the allocations per string */
+static double TimeFormatFunction(FormatFunction function, U32 iterations, double* allocs_per_op_ptr)
+{
+	char buffer[FORMATTED_STRING_BUFFER_SIZE];
+	double bestSeconds = 0.0;
+	U64 checksum = 0;
+	U64 allocationsBefore = sAllocationCount;
+
+	for (U32 i = 0; i < iterations; i++)
+	{
+		auto start = std::chrono::steady_clock::now();
+
+		for (U32 value = 0; value < FORMAT_OPERATIONS; value++)
+		{
+			function(buffer, sizeof(buffer), value * 7919);
+			checksum += (U8)buffer[0];
+		}
+
+		auto stop = std::chrono::steady_clock::now();
+		double seconds = std::chrono::duration<double>(stop - start).count();
+
+		if ((i == 0) || (seconds < bestSeconds))
+		{
+			bestSeconds = seconds;
+		}
+	}
+
+	// Keeps the formatting from being optimized away
+	if (checksum == 0)
+	{
+		printf(" ");
+	}
+
+	*allocs_per_op_ptr = (double)(sAllocationCount - allocationsBefore) / ((double)FORMAT_OPERATIONS * iterations);
+
+	return bestSeconds * 1e9 / FORMAT_OPERATIONS;
+}
+
+static bool RunFormatBenchmarks(U32 iterations)
+{
+	char expected[FORMATTED_STRING_BUFFER_SIZE];
+	char actual[FORMATTED_STRING_BUFFER_SIZE];
+	bool matched = true;
+
+	printf("%-14s %12s %12s %14s %14s %8s\n",
+		"case", "printf ns", "builder ns", "printf allocs", "builder allocs", "speedup");
+
+	for (const FormatCase_t& formatCase : asFormatCases)
+	{
+		double printfAllocs;
+		double builderAllocs;
+
+		for (U32 value = 0; value < 0x20000; value++)
+		{
+			formatCase.pnPrintf(expected, sizeof(expected), value * 7919);
+			formatCase.pnBuilder(actual, sizeof(actual), value * 7919);
+
+			if (strcmp(expected, actual) != 0)
+			{
+				fprintf(stderr, BENCH_NAME ": %s differs: \"%s\" != \"%s\"\n", formatCase.name, actual, expected);
+				matched = false;
+				break;
+			}
+		}
+
+		double printfNs = TimeFormatFunction(formatCase.pnPrintf, iterations, &printfAllocs);
+		double builderNs = TimeFormatFunction(formatCase.pnBuilder, iterations, &builderAllocs);
+
+		printf("%-14s %12.1f %12.1f %14.2f %14.2f %7.1fx\n",
+			formatCase.name, printfNs, builderNs, printfAllocs, builderAllocs, printfNs / builderNs);
+	}
+
+	return matched;
+}
+
+/*------------------------------------------------------------------------
+** Baseline handling. The baseline is a CSV file of "scenario,ns_per_byte".
+**------------------------------------------------------------------------
+*/
+
+static bool LoadBaseline(const std::string& file_path, std::map<std::string, double>& baseline)
+{
+	std::ifstream filestream(file_path);
+	std::string line;
+
+	if (!filestream)
+	{
+		return false;
+	}
+
+	while (std::getline(filestream, line))
+	{
+		size_t comma = line.find(',');
+
+		if ((line.empty()) || (line[0] == '#') || (comma == std::string::npos))
+		{
+			continue;
+		}
+
+		baseline[line.substr(0, comma)] = atof(line.c_str() + comma + 1);
+	}
+
+	return true;
+}
+
+static bool SaveBaseline(const std::string& file_path, const std::vector<const Scenario_t*>& scenarios, const std::vector<BenchResult_t>& results)
+{
+	FILE* file = fopen(file_path.c_str(), "w");
+
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	fprintf(file, "# " BENCH_NAME " baseline: scenario,ns_per_byte\n");
+
+	for (size_t i = 0; i < scenarios.size(); i++)
+	{
+		fprintf(file, "%s,%.3f\n", scenarios[i]->name, results[i].rNsPerByte);
+	}
+
+	fclose(file);
+	return true;
+}
+
+static void PrintUsage()
+{
+	printf(
+		"Usage: " BENCH_NAME " [options]\n"
+		"\n"
+		"Options:\n"
+		"  --scenario <name>       Run only this scenario, may be repeated\n"
+		"  --samples <n>           Samples per capture (default %llu)\n"
+		"  --sample-rate <hz>      Capture sample rate (default %u)\n"
+		"  --iterations <n>        Runs per scenario, the fastest is reported (default %u)\n"
+		"  --baseline <file>       Compare ns/byte against this baseline\n"
+		"  --threshold <percent>   Allowed slowdown versus the baseline (default %.0f)\n"
+		"  --save-baseline <file>  Store the measured ns/byte as a new baseline\n"
+		"  --render                Also time the bubble and tabular text of every frame\n"
+		"                          and the tabular text of every packet\n"
+		"  --format                Only run the string formatting microbenchmarks\n"
+		"  --verify                Only check the CRC32 kernels against the nibble-wise\n"
+		"                          definition, that the specialized acquisition kernels\n"
+		"                          decode every scenario the same as the generic loop,\n"
+		"                          the markers placed with each bit marker density, and\n"
+		"                          that ranges resumed from decoder checkpoints decode\n"
+		"                          the same as the whole capture\n"
+		"  --list                  List the scenarios\n"
+		"  --help                  Show this text\n",
+		DEFAULT_NUM_SAMPLES, DEFAULT_SAMPLE_RATE, DEFAULT_ITERATIONS, DEFAULT_THRESHOLD_PERCENT);
+}
+
+int main(int argc, char* argv[])
+{
+	std::vector<const Scenario_t*> scenarios;
+	std::vector<BenchResult_t> results;
+	std::map<std::string, double> baseline;
+	std::string baselinePath;
+	std::string saveBaselinePath;
+	U64 numSamples = DEFAULT_NUM_SAMPLES;
+	U32 sampleRate = DEFAULT_SAMPLE_RATE;
+	U32 iterations = DEFAULT_ITERATIONS;
+	double thresholdPercent = DEFAULT_THRESHOLD_PERCENT;
+	bool regression = false;
+	bool render = false;
+	bool formatOnly = false;
+	bool verifyOnly = false;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* param = (i + 1 < argc) ? argv[i + 1] : "";
+
+		if ((strcmp(arg, "--help") == 0) || (strcmp(arg, "-h") == 0))
+		{
+			PrintUsage();
+			return EXIT_SUCCESS;
+		}
+		else if (strcmp(arg, "--list") == 0)
+		{
+			for (const Scenario_t& scenario : asScenarios)
+			{
+				printf("%-14s %s\n", scenario.name, scenario.description);
+			}
+			return EXIT_SUCCESS;
+		}
+		else if (strcmp(arg, "--render") == 0)
+		{
+			render = true;
+			continue;
+		}
+		else if (strcmp(arg, "--format") == 0)
+		{
+			formatOnly = true;
+			continue;
+		}
+		else if (strcmp(arg, "--verify") == 0)
+		{
+			verifyOnly = true;
+			continue;
+		}
+		else if (strcmp(arg, "--scenario") == 0)
+		{
+			const Scenario_t* found = nullptr;
+
+			for (const Scenario_t& scenario : asScenarios)
+			{
+				if (strcmp(scenario.name, param) == 0)
+				{
+					found = &scenario;
+				}
+			}
+
+			if (found == nullptr)
+			{
+				fprintf(stderr, BENCH_NAME ": unknown scenario '%s'\n", param);
+				return EXIT_FAILURE;
+			}
+
+			scenarios.push_back(found);
+		}
+		else if (strcmp(arg, "--samples") == 0)
+		{
+			numSamples = strtoull(param, nullptr, 10);
+		}
+		else if (strcmp(arg, "--sample-rate") == 0)
+		{
+			sampleRate = (U32)strtoul(param, nullptr, 10);
+		}
+		else if (strcmp(arg, "--iterations") == 0)
+		{
+			iterations = (U32)strtoul(param, nullptr, 10);
+		}
+		else if (strcmp(arg, "--threshold") == 0)
+		{
+			thresholdPercent = atof(param);
+		}
+		else if (strcmp(arg, "--baseline") == 0)
+		{
+			baselinePath = param;
+		}
+		else if (strcmp(arg, "--save-baseline") == 0)
+		{
+			saveBaselinePath = param;
+		}
+		else
+		{
+			fprintf(stderr, BENCH_NAME ": unknown option %s\n", arg);
+			return EXIT_FAILURE;
+		}
+
+		i++;
+	}
+
+	if ((numSamples == 0) || (sampleRate == 0) || (iterations == 0))
+	{
+		fprintf(stderr, BENCH_NAME ": --samples, --sample-rate and --iterations must be non-zero\n");
+		return EXIT_FAILURE;
+	}
+
+	if (formatOnly)
+	{
+		return RunFormatBenchmarks(iterations) ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	if (!baselinePath.empty() && !LoadBaseline(baselinePath, baseline))
+	{
+		fprintf(stderr, BENCH_NAME ": could not read baseline %s\n", baselinePath.c_str());
+		return EXIT_FAILURE;
+	}
+
+	if (scenarios.empty())
+	{
+		for (const Scenario_t& scenario : asScenarios)
+		{
+			scenarios.push_back(&scenario);
+		}
+	}
+
+	if (verifyOnly)
+	{
+		bool matched = VerifyCrc32();
+
+		printf("CRC32 kernel: %s, slice-by-8, Update() and Combine() %s the nibble definition\n\n",
+			AbccCrc::KernelName(), matched ? "match" : "DO NOT MATCH");
+		printf("%-14s %12s %12s %12s  %s\n", "scenario", "frames", "packets", "markers", "result");
+
+		for (const Scenario_t* scenario : scenarios)
+		{
+			matched = VerifyScenario(*scenario, sampleRate, numSamples) && matched;
+		}
+
+		printf("\nMarkers per bit marker density:\n");
+		printf("%-14s %12s %12s %12s %12s  %s\n", "scenario", "all", "first-bit", "none", "errors-only", "result");
+
+		for (const Scenario_t* scenario : scenarios)
+		{
+			matched = VerifyMarkerDensities(*scenario, sampleRate, numSamples) && matched;
+		}
+
+		printf("\nRanges resumed from decoder checkpoints:\n");
+		printf("%-14s %12s %12s %12s %12s  %s\n", "scenario", "frames", "cached", "chunked", "resumed", "result");
+
+		for (const Scenario_t* scenario : scenarios)
+		{
+			matched = VerifyRangeDecodes(*scenario, sampleRate, numSamples) && matched;
+		}
+
+		return matched ? EXIT_SUCCESS : EXIT_FAILURE;
+	}
+
+	printf("CRC32 kernel: %s\n\n", AbccCrc::KernelName());
+	printf("%-14s %10s %10s %12s %12s %12s %10s %10s %10s  %s\n",
+		"scenario", "bytes", "ns/byte", "Msamples/s", "frames/s", "packets/s",
+		"allocs/pkt", "heap MB", "RSS MB", "baseline");
+
+	for (const Scenario_t* scenario : scenarios)
+	{
+		BenchResult_t result;
+		std::string verdict = "-";
+
+		RunScenario(*scenario, sampleRate, numSamples, iterations, render, &result);
+		results.push_back(result);
+
+		auto it = baseline.find(scenario->name);
+
+		if (it != baseline.end())
+		{
+			double change = (result.rNsPerByte / it->second - 1.0) * 100.0;
+			char text[64];
+
+			snprintf(text, sizeof(text), "%+.1f%%", change);
+			verdict = text;
+
+			if (change > thresholdPercent)
+			{
+				verdict += " REGRESSION";
+				regression = true;
+			}
+		}
+
+		printf("%-14s %10llu %10.2f %12.2f %12.0f %12.0f %10.2f %10.1f %10.1f  %s\n",
+			scenario->name,
+			(unsigned long long)result.lBytes,
+			result.rNsPerByte,
+			result.rSamplesPerSec / 1e6,
+			result.rFramesPerSec,
+			result.rPacketsPerSec,
+			result.rAllocsPerPacket,
+			result.lPeakHeapBytes / (1024.0 * 1024.0),
+			result.lPeakRssBytes / (1024.0 * 1024.0),
+			verdict.c_str());
+	}
+
+	if (render)
+	{
+		printf("\n%-14s %12s %12s %12s %12s %12s\n",
+			"scenario", "cold ns/frm", "warm ns/frm", "cache hits", "cache misses", "ns/packet");
+
+		for (size_t i = 0; i < scenarios.size(); i++)
+		{
+			printf("%-14s %12.1f %12.1f %12llu %12llu %12.1f\n",
+				scenarios[i]->name,
+				results[i].rColdRenderNsPerFrame,
+				results[i].rWarmRenderNsPerFrame,
+				(unsigned long long)results[i].lTextCacheHits,
+				(unsigned long long)results[i].lTextCacheMisses,
+				results[i].rPacketRenderNsPerPacket);
+		}
+	}
+
+	if (!saveBaselinePath.empty() && !SaveBaseline(saveBaselinePath, scenarios, results))
+	{
+		fprintf(stderr, BENCH_NAME ": could not write baseline %s\n", saveBaselinePath.c_str());
+		return EXIT_FAILURE;
+	}
+
+	if (regression)
+	{
+		fprintf(stderr, BENCH_NAME ": throughput regressed by more than %.1f%% against %s\n",
+			thresholdPercent, baselinePath.c_str());
+		return EXIT_FAILURE;
+	}
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,347 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiCapture.cpp
+**    Summary: Offline digital capture loaded from a CSV file exported by
+**             Saleae Logic, and sequential access to its channels in the
+**             same manner as the SDK's AnalyzerChannelData.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+
+#include "AbccSpiCapture.h"
+#include "../AbccSpiAnalyzerHelpers.h"
+
+/*******************************************************************************
+**
+** CaptureChannelData
+**
+*******************************************************************************/
+
+CaptureChannelData::CaptureChannelData(const CaptureChannel_t* channel, U64 end_sample)
+	: mChannel(channel),
+	mEndSample(end_sample),
+	mSampleNumber(0),
+	mNextTransition(0)
+{
+}
+
+CaptureChannelData::CaptureChannelData(const CaptureChannel_t* channel, U64 start_sample, U64 end_sample)
+	: mChannel(channel),
+	mEndSample(end_sample),
+	mSampleNumber(start_sample),
+	mNextTransition(0)
+{
+	const std::vector<U64>& transitions = mChannel->alTransitions;
+
+	if (start_sample > 0)
+	{
+		mNextTransition = std::upper_bound(transitions.begin(), transitions.end(), start_sample) - transitions.begin();
+	}
+}
+
+U64 CaptureChannelData::GetSampleNumber()
+{
+	return mSampleNumber;
+}
+
+BitState CaptureChannelData::GetBitState()
+{
+	if ((mNextTransition & 1) == 0)
+	{
+		return mChannel->eInitialState;
+	}
+
+	return (mChannel->eInitialState == BIT_HIGH) ? BIT_LOW : BIT_HIGH;
+}
+
+U32 CaptureChannelData::AdvanceToAbsPosition(U64 sample_number)
+{
+	const std::vector<U64>& transitions = mChannel->alTransitions;
+	U32 transitionCount = 0;
+
+	if (sample_number <= mSampleNumber)
+	{
+		return 0;
+	}
+
+	if (sample_number >= mEndSample)
+	{
+		throw CaptureEndOfData();
+	}
+
+	while ((mNextTransition < transitions.size()) && (transitions[mNextTransition] <= sample_number))
+	{
+		mNextTransition++;
+		transitionCount++;
+	}
+
+	mSampleNumber = sample_number;
+	return transitionCount;
+}
+
+void CaptureChannelData::AdvanceToNextEdge()
+{
+	AdvanceToAbsPosition(GetSampleOfNextEdge());
+}
+
+U64 CaptureChannelData::GetSampleOfNextEdge()
+{
+	if (mNextTransition >= mChannel->alTransitions.size())
+	{
+		throw CaptureEndOfData();
+	}
+
+	return mChannel->alTransitions[mNextTransition];
+}
+
+bool CaptureChannelData::WouldAdvancingToAbsPositionCauseTransition(U64 sample_number)
+{
+	if ((mNextTransition < mChannel->alTransitions.size()) && (mChannel->alTransitions[mNextTransition] <= sample_number))
+	{
+		return true;
+	}
+
+	if (sample_number >= mEndSample)
+	{
+		throw CaptureEndOfData();
+	}
+
+	return false;
+}
+
+bool CaptureChannelData::DoMoreTransitionsExistInCurrentData()
+{
+	return (mNextTransition < mChannel->alTransitions.size());
+}
+
+/*******************************************************************************
+**
+** AbccSpiCapture
+**
+*******************************************************************************/
+
+static void SplitCsvLine(const std::string& line, std::vector<std::string>& fields)
+{
+	std::stringstream ss(line);
+	std::string field;
+
+	fields.clear();
+
+	while (std::getline(ss, field, ','))
+	{
+		TrimString(field);
+		fields.push_back(field);
+	}
+}
+
+static bool ParseNumber(const std::string& field, double* value_ptr)
+{
+	char* endPtr;
+
+	if (field.empty())
+	{
+		return false;
+	}
+
+	*value_ptr = strtod(field.c_str(), &endPtr);
+	return (*endPtr == '\0');
+}
+
+AbccSpiCapture::AbccSpiCapture()
+	: mSampleRate(0),
+	mTriggerSample(0),
+	mEndSample(0)
+{
+}
+
+AbccSpiCapture::~AbccSpiCapture()
+{
+}
+
+bool AbccSpiCapture::LoadCsv(const std::string& file_path, U32 sample_rate, std::string& error_text)
+{
+	std::ifstream filestream(file_path);
+	std::vector<std::string> fields;
+	std::vector<BitState> lastStates;
+	std::string line;
+	double origin = 0.0;
+	double time;
+	double value;
+	U64 lineNumber = 0;
+	U64 lastSample = 0;
+	bool firstRow = true;
+
+	mChannels.clear();
+	mSampleRate = sample_rate;
+	mTriggerSample = 0;
+	mEndSample = 0;
+
+	if (!filestream)
+	{
+		error_text = "File not found or could not be opened.";
+		return false;
+	}
+
+	if (sample_rate == 0)
+	{
+		error_text = "Sample rate must be specified.";
+		return false;
+	}
+
+	while (std::getline(filestream, line))
+	{
+		lineNumber++;
+
+		// Tolerate CRLF line endings and a UTF-8 BOM
+		if (!line.empty() && (line.back() == '\r'))
+		{
+			line.pop_back();
+		}
+		if ((lineNumber == 1) && (line.compare(0, 3, "\xEF\xBB\xBF") == 0))
+		{
+			line.erase(0, 3);
+		}
+
+		SplitCsvLine(line, fields);
+
+		if (fields.empty() || ((fields.size() == 1) && fields[0].empty()))
+		{
+			continue;
+		}
+
+		if (mChannels.empty())
+		{
+			if (fields.size() < 2)
+			{
+				error_text = "Line " + std::to_string(lineNumber) + ": expected a time column followed by at least one channel.";
+				return false;
+			}
+
+			mChannels.resize(fields.size() - 1);
+			lastStates.resize(fields.size() - 1);
+
+			if (!ParseNumber(fields[0], &time))
+			{
+				// Header row, take the channel names from it
+				for (size_t i = 1; i < fields.size(); i++)
+				{
+					mChannels[i - 1].name = fields[i];
+				}
+
+				continue;
+			}
+
+			for (size_t i = 1; i < fields.size(); i++)
+			{
+				mChannels[i - 1].name = "Channel " + std::to_string(i - 1);
+			}
+		}
+
+		if ((fields.size() != mChannels.size() + 1) || !ParseNumber(fields[0], &time))
+		{
+			error_text = "Line " + std::to_string(lineNumber) + ": malformed row.";
+			return false;
+		}
+
+		if (firstRow)
+		{
+			// Sample 0 is the first row, or the trigger point if the capture
+			// starts after it. The trigger is at time 0.
+			origin = (time < 0.0) ? time : 0.0;
+			mTriggerSample = (U64)llround(-origin * sample_rate);
+		}
+
+		U64 sample = (U64)llround((time - origin) * sample_rate);
+
+		if (!firstRow && (sample < lastSample))
+		{
+			error_text = "Line " + std::to_string(lineNumber) + ": time stamps are not in ascending order.";
+			return false;
+		}
+
+		for (size_t i = 0; i < mChannels.size(); i++)
+		{
+			BitState state;
+
+			if (!ParseNumber(fields[i + 1], &value) || ((value != 0.0) && (value != 1.0)))
+			{
+				error_text = "Line " + std::to_string(lineNumber) + ": channel values must be 0 or 1.";
+				return false;
+			}
+
+			state = (value != 0.0) ? BIT_HIGH : BIT_LOW;
+
+			if (firstRow)
+			{
+				mChannels[i].eInitialState = state;
+			}
+			else if (state != lastStates[i])
+			{
+				std::vector<U64>& transitions = mChannels[i].alTransitions;
+
+				if (sample == 0)
+				{
+					// Still at the first sample, adjust the initial state
+					mChannels[i].eInitialState = state;
+				}
+				else if (!transitions.empty() && (transitions.back() == sample))
+				{
+					// Pulse shorter than one sample period, drop it
+					transitions.pop_back();
+				}
+				else
+				{
+					transitions.push_back(sample);
+				}
+			}
+
+			lastStates[i] = state;
+		}
+
+		lastSample = sample;
+		firstRow = false;
+	}
+
+	if (firstRow)
+	{
+		error_text = "File contains no samples.";
+		return false;
+	}
+
+	mEndSample = lastSample + 1;
+
+	return true;
+}
+
+U32 AbccSpiCapture::GetNumChannels() const
+{
+	return (U32)mChannels.size();
+}
+
+const CaptureChannel_t* AbccSpiCapture::GetChannel(U32 index) const
+{
+	return &mChannels.at(index);
+}
+
+U32 AbccSpiCapture::GetSampleRate() const
+{
+	return mSampleRate;
+}
+
+U64 AbccSpiCapture::GetTriggerSample() const
+{
+	return mTriggerSample;
+}
+
+U64 AbccSpiCapture::GetEndSample() const
+{
+	return mEndSample;
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiCapture.h
+**    Summary: Offline digital capture loaded from a CSV file exported by
+**             Saleae Logic, and sequential access to its channels in the
+**             same manner as the SDK's AnalyzerChannelData.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_SPI_CAPTURE_H
+#define ABCC_SPI_CAPTURE_H
+
+#include <string>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+
+/*
+** Thrown when the acquisition asks for data past the end of the capture.
+*/
+class CaptureEndOfData
+{
+};
+
+typedef struct CaptureChannel
+{
+	std::string name;
+	BitState eInitialState;
+	std::vector<U64> alTransitions;
+} CaptureChannel_t;
+
+/* The channels of a capture assigned to the SPI signals */
+typedef struct CaptureChannels
+{
+	const CaptureChannel_t* psMosi;
+	const CaptureChannel_t* psMiso;
+	const CaptureChannel_t* psClock;
+	const CaptureChannel_t* psEnable;	// nullptr without an enable line
+} CaptureChannels_t;
+
+/*
+** Walks the transitions of one capture channel. The method names and
+** semantics follow AnalyzerChannelData so that AbccSpiAcquisition can be
+** instantiated on it.
+*/
+class CaptureChannelData
+{
+public:
+
+	CaptureChannelData(const CaptureChannel_t* channel, U64 end_sample);
+
+	// Starts as if advanced to start_sample
+	CaptureChannelData(const CaptureChannel_t* channel, U64 start_sample, U64 end_sample);
+
+	U64 GetSampleNumber();
+	BitState GetBitState();
+
+	U32 AdvanceToAbsPosition(U64 sample_number);
+	void AdvanceToNextEdge();
+
+	U64 GetSampleOfNextEdge();
+	bool WouldAdvancingToAbsPositionCauseTransition(U64 sample_number);
+	bool DoMoreTransitionsExistInCurrentData();
+
+protected:
+
+	const CaptureChannel_t* mChannel;
+	U64 mEndSample;
+	U64 mSampleNumber;
+	size_t mNextTransition;
+};
+
+class AbccSpiCapture
+{
+public:
+
+	AbccSpiCapture();
+	~AbccSpiCapture();
+
+	/*
+	** Loads a "Time [s],<channel>,<channel>,..." CSV export. Each row holds
+	** the state of all channels from that time onwards. Times are converted
+	** to sample numbers using sample_rate.
+	*/
+	bool LoadCsv(const std::string& file_path, U32 sample_rate, std::string& error_text);
+
+	U32 GetNumChannels() const;
+	const CaptureChannel_t* GetChannel(U32 index) const;
+
+	U32 GetSampleRate() const;
+	U64 GetTriggerSample() const;
+	U64 GetEndSample() const;
+
+protected:
+
+	std::vector<CaptureChannel_t> mChannels;
+	U32 mSampleRate;
+	U64 mTriggerSample;
+	U64 mEndSample;
+};
+
+#endif /* ABCC_SPI_CAPTURE_H */
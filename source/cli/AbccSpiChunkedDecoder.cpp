@@ -0,0 +1,768 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiChunkedDecoder.cpp
+**    Summary: Decodes a capture in chunks on several threads. The capture is
+**             split where the bus is idle between two packets, the chunks
+**             are decoded in parallel, and a sequential stitch pass passes
+**             their output on in capture order. The decoder state at such
+**             splits can be kept as checkpoints, from which a range of the
+**             capture is decoded later without decoding what comes before.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "AbccSpiChunkedDecoder.h"
+
+/* Packets at the start of a chunk for which the decoder state is kept. If
+** the stitch pass has not caught up with the chunk's own decoding within
+** them, it decodes the whole chunk. */
+#define MAX_CHUNK_CHECKPOINTS				256
+
+typedef AbccSpiAcquisition<CaptureChannelData> CaptureAcquisition;
+
+// The decoder state after a packet near the start of a chunk
+typedef struct ChunkCheckpoint
+{
+	U64 lClockSample;		// Acquisition position after the packet
+	U64 lCurrentSample;
+	size_t nCallCount;		// Recorded calls up to the position
+	AbccSpiDecoder::DecoderState_t sState;
+} ChunkCheckpoint_t;
+
+/*
+** Passes the output of the chunks on to the final sink in capture order,
+** either directly from the stitch pass's decoder or replayed from a chunk's
+** recording. Each chunk's acquisition counts its clocking errors on its own,
+** so the clocking alert limit is applied here for the whole capture.
+*/
+class ChunkMerger : public AbccSpiCountingSink
+{
+public:
+
+	ChunkMerger(AbccSpiDecoderSink* sink, S32 clocking_alert_limit)
+		: mSink(sink),
+		mClockingAlertLimit(clocking_alert_limit),
+		mClockingErrorCount(0),
+		mSkipMarker(false)
+	{
+	}
+
+	S32 GetClockingErrorCount() const
+	{
+		return mClockingErrorCount;
+	}
+
+	// Continues the count of a decode that is resumed from a checkpoint
+	void SetClockingErrorCount(S32 count)
+	{
+		mClockingErrorCount = count;
+	}
+
+	virtual void AddFrame(const DecoderFrame_t& frame)
+	{
+		mSkipMarker = false;
+
+		if ((frame.mType == AbccSpiError::EndOfTransfer) && (mClockingAlertLimit >= 0))
+		{
+			if (mClockingErrorCount >= mClockingAlertLimit)
+			{
+				// The acquisition adds a marker along with the frame
+				mSkipMarker = true;
+				return;
+			}
+
+			mClockingErrorCount++;
+		}
+
+		mSink->AddFrame(frame);
+	}
+
+	virtual void AddMarker(U64 sample, DecoderMarker marker, DecoderChannel channel)
+	{
+		if (mSkipMarker)
+		{
+			mSkipMarker = false;
+			return;
+		}
+
+		mSink->AddMarker(sample, marker, channel);
+	}
+
+	virtual U64 StorePayload(const U8* data, U32 length)
+	{
+		return mSink->StorePayload(data, length);
+	}
+
+	virtual U32 OpenMessage(SpiChannel_t channel, bool retransmission)
+	{
+		return mSink->OpenMessage(channel, retransmission);
+	}
+
+	virtual void SetMessageHeader(U32 message_id, const MsgHeaderInfo_t& header)
+	{
+		mSink->SetMessageHeader(message_id, header);
+	}
+
+	virtual void AddMessageFragment(U32 message_id, const MessageFragmentInfo_t& fragment)
+	{
+		mSink->AddMessageFragment(message_id, fragment);
+	}
+
+	virtual bool CommitPacketAndStartNewPacket(const PacketSummary_t& summary)
+	{
+		mPacketCount++;
+		return mSink->CommitPacketAndStartNewPacket(summary);
+	}
+
+	virtual void CancelPacketAndStartNewPacket()
+	{
+		mPacketCount++;
+		mSink->CancelPacketAndStartNewPacket();
+	}
+
+	virtual void CommitResults()
+	{
+		mSink->CommitResults();
+	}
+
+protected:
+
+	AbccSpiDecoderSink* mSink;
+	S32 mClockingAlertLimit;
+	S32 mClockingErrorCount;
+	bool mSkipMarker;
+};
+
+/*
+** The capture's channels positioned at the start of a chunk, and an
+** acquisition on them.
+*/
+class ChunkAcquisition
+{
+public:
+
+	ChunkAcquisition(const CaptureChannels_t& channels, U64 start_sample, U64 end_sample, AbccSpiDecoderSink* sink, const AcquisitionConfig_t& config)
+		: mMosi(channels.psMosi, start_sample, end_sample),
+		mMiso(channels.psMiso, start_sample, end_sample),
+		mClock(channels.psClock, start_sample, end_sample),
+		mAcquisition(sink)
+	{
+		if (channels.psEnable != nullptr)
+		{
+			mEnable.reset(new CaptureChannelData(channels.psEnable, start_sample, end_sample));
+		}
+
+		mAcquisition.Setup(&mMosi, &mMiso, &mClock, mEnable.get(), config);
+	}
+
+	CaptureAcquisition* Get()
+	{
+		return &mAcquisition;
+	}
+
+protected:
+
+	CaptureChannelData mMosi;
+	CaptureChannelData mMiso;
+	CaptureChannelData mClock;
+	std::unique_ptr<CaptureChannelData> mEnable;
+	CaptureAcquisition mAcquisition;
+};
+
+/*
+** Told about each byte pair that ended a packet while a chunk is decoded
+*/
+class ChunkPacketHandler
+{
+public:
+	virtual ~ChunkPacketHandler() {}
+
+	// Returns false to stop decoding
+	virtual bool PacketEnded(const AbccSpiDecoder& decoder, CaptureAcquisition* acquisition) = 0;
+};
+
+/*
+** Keeps the decoder state after the first packets of a chunk decoded from a
+** reset decoder.
+*/
+class CheckpointRecorder : public ChunkPacketHandler
+{
+public:
+
+	CheckpointRecorder(const AbccSpiDecoderRecorder* recorder, std::vector<ChunkCheckpoint_t>* checkpoints_ptr)
+		: mRecorder(recorder),
+		mCheckpoints(checkpoints_ptr)
+	{
+	}
+
+	virtual bool PacketEnded(const AbccSpiDecoder& decoder, CaptureAcquisition* acquisition)
+	{
+		if (mCheckpoints->size() < MAX_CHUNK_CHECKPOINTS)
+		{
+			mCheckpoints->emplace_back();
+
+			ChunkCheckpoint_t& checkpoint = mCheckpoints->back();
+
+			checkpoint.lClockSample = acquisition->GetClockSampleNumber();
+			checkpoint.lCurrentSample = acquisition->GetCurrentSample();
+			checkpoint.nCallCount = mRecorder->GetCallCount();
+			decoder.GetState(&checkpoint.sState);
+		}
+
+		return true;
+	}
+
+protected:
+
+	const AbccSpiDecoderRecorder* mRecorder;
+	std::vector<ChunkCheckpoint_t>* mCheckpoints;
+};
+
+/*
+** Stops the stitch pass at the first checkpoint where its decoder is at the
+** same position and in the same state as the chunk's own decoder.
+*/
+class CheckpointMatcher : public ChunkPacketHandler
+{
+public:
+
+	CheckpointMatcher(const std::vector<ChunkCheckpoint_t>* checkpoints)
+		: mCheckpoints(checkpoints),
+		mNextCheckpoint(0)
+	{
+	}
+
+	virtual bool PacketEnded(const AbccSpiDecoder& decoder, CaptureAcquisition* acquisition)
+	{
+		U64 clockSample = acquisition->GetClockSampleNumber();
+		U64 currentSample = acquisition->GetCurrentSample();
+
+		while ((mNextCheckpoint < mCheckpoints->size()) &&
+			   (((*mCheckpoints)[mNextCheckpoint].lClockSample < clockSample) ||
+				(((*mCheckpoints)[mNextCheckpoint].lClockSample == clockSample) &&
+				 ((*mCheckpoints)[mNextCheckpoint].lCurrentSample < currentSample))))
+		{
+			mNextCheckpoint++;
+		}
+
+		if ((mNextCheckpoint < mCheckpoints->size()) &&
+			((*mCheckpoints)[mNextCheckpoint].lClockSample == clockSample) &&
+			((*mCheckpoints)[mNextCheckpoint].lCurrentSample == currentSample))
+		{
+			decoder.GetState(&mState);
+
+			if (AbccSpiDecoder::IsSameState((*mCheckpoints)[mNextCheckpoint].sState, mState))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	// Valid once the handler stopped decoding
+	size_t GetMatch() const
+	{
+		return mNextCheckpoint;
+	}
+
+	const AbccSpiDecoder::DecoderState_t& GetState() const
+	{
+		return mState;
+	}
+
+protected:
+
+	const std::vector<ChunkCheckpoint_t>* mCheckpoints;
+	size_t mNextCheckpoint;
+	AbccSpiDecoder::DecoderState_t mState;
+};
+
+/*
+** Keeps the position in the recording after the last packet that ended at
+** or before the first sample of a range, and stops decoding after the first
+** packet that ended at or after its last sample.
+*/
+class RangePacketHandler : public ChunkPacketHandler
+{
+public:
+
+	RangePacketHandler(const AbccSpiDecoderRecorder* recorder, U64 first_sample, U64 last_sample)
+		: mRecorder(recorder),
+		mFirstSample(first_sample),
+		mLastSample(last_sample),
+		mFirstCall(0)
+	{
+	}
+
+	virtual bool PacketEnded(const AbccSpiDecoder& /*decoder*/, CaptureAcquisition* acquisition)
+	{
+		U64 clockSample = acquisition->GetClockSampleNumber();
+
+		if (clockSample <= mFirstSample)
+		{
+			mFirstCall = mRecorder->GetCallCount();
+		}
+
+		return (clockSample < mLastSample);
+	}
+
+	size_t GetFirstCall() const
+	{
+		return mFirstCall;
+	}
+
+protected:
+
+	const AbccSpiDecoderRecorder* mRecorder;
+	U64 mFirstSample;
+	U64 mLastSample;
+	size_t mFirstCall;
+};
+
+typedef struct CaptureChunk
+{
+	U64 lStartSample;		// Where the acquisition starts looking for a packet
+	U64 lStopSample;		// No byte is acquired from a clock edge at or after this
+	AbccSpiDecoderRecorder oRecorder;
+	std::vector<ChunkCheckpoint_t> asCheckpoints;
+	AbccSpiDecoder::DecoderState_t sEndState;
+	std::string errorText;
+} CaptureChunk_t;
+
+AbccSpiChunkedDecoder::AbccSpiChunkedDecoder(const CaptureChannels_t& channels, U64 end_sample)
+	: mChannels(channels),
+	mEndSample(end_sample),
+	mAcquisitionConfig(),
+	mDecoderConfig(),
+	mNextChunk(0)
+{
+}
+
+AbccSpiChunkedDecoder::~AbccSpiChunkedDecoder()
+{
+}
+
+void AbccSpiChunkedDecoder::Setup(const AcquisitionConfig_t& acquisition_config, const DecoderConfig_t& decoder_config)
+{
+	mAcquisitionConfig = acquisition_config;
+	mDecoderConfig = decoder_config;
+}
+
+U32 AbccSpiChunkedDecoder::Decode(AbccSpiDecoderSink* sink, U32 thread_count, std::vector<DecoderCheckpoint_t>* checkpoints_ptr)
+{
+	ChunkMerger merger(sink, mAcquisitionConfig.lClockingAlertLimit);
+	AbccSpiDecoder::DecoderState_t state;
+	std::vector<std::thread> workers;
+	U32 chunkCount;
+
+	FindChunks(thread_count);
+	chunkCount = (U32)mChunks.size();
+	mNextChunk = 0;
+
+	for (U32 i = 0; i < chunkCount; i++)
+	{
+		workers.emplace_back(&AbccSpiChunkedDecoder::DecodeWorker, this);
+	}
+
+	for (std::thread& worker : workers)
+	{
+		worker.join();
+	}
+
+	for (const std::unique_ptr<CaptureChunk_t>& chunk : mChunks)
+	{
+		if (!chunk->errorText.empty())
+		{
+			throw std::runtime_error(chunk->errorText);
+		}
+	}
+
+	for (U32 i = 0; i < chunkCount; i++)
+	{
+		if (i == 0)
+		{
+			// Decoded from the start of the capture, just like in one pass
+			std::vector<U32> messageIds;
+			DecoderRecordingView_t recording;
+
+			mChunks[i]->oRecorder.GetView(&recording);
+			ReplayDecoderRecording(recording, 0, &merger, &messageIds);
+
+			state = mChunks[i]->sEndState;
+			state.sMosiVars.dwMsgId = MapRecordedMessageId(messageIds, state.sMosiVars.dwMsgId);
+			state.sMisoVars.dwMsgId = MapRecordedMessageId(messageIds, state.sMisoVars.dwMsgId);
+		}
+		else
+		{
+			if (checkpoints_ptr != nullptr)
+			{
+				// The stitch pass resumes from the same state and position
+				checkpoints_ptr->emplace_back();
+				checkpoints_ptr->back().lStartSample = mChunks[i]->lStartSample;
+				checkpoints_ptr->back().lClockingErrorCount = merger.GetClockingErrorCount();
+				checkpoints_ptr->back().sState = state;
+			}
+
+			StitchChunk(mChunks[i].get(), &merger, &state);
+		}
+
+		// The recording is no longer needed
+		mChunks[i].reset();
+	}
+
+	mChunks.clear();
+
+	return chunkCount;
+}
+
+void AbccSpiChunkedDecoder::DecodeWithCheckpoints(AbccSpiDecoderSink* sink, U32 interval, std::vector<DecoderCheckpoint_t>* checkpoints_ptr)
+{
+	AcquisitionConfig_t config = mAcquisitionConfig;
+
+	// Applied by the merger, which keeps the count for the checkpoints
+	config.lClockingAlertLimit = -1;
+
+	ChunkMerger merger(sink, mAcquisitionConfig.lClockingAlertLimit);
+	ChunkAcquisition acquisition(mChannels, 0, mEndSample, &merger, config);
+	CaptureAcquisition* captureAcquisition = acquisition.Get();
+	AbccSpiDecoder decoder(captureAcquisition, &merger);
+	U64 checkpointPacketCount = interval;
+	U64 startSample = 0;
+	U64 stopSample = UINT64_MAX;
+
+	decoder.Setup(mDecoderConfig);
+	decoder.Reset();
+
+	// Same loop as RunChunk(), the capture ends with an exception
+	try
+	{
+		U64 mosiData;
+		U64 misoData;
+		U64 firstSample;
+		GetByteStatus byteStatus;
+
+		captureAcquisition->AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+
+		for (;;)
+		{
+			if (captureAcquisition->GetSampleOfNextClockEdge() >= stopSample)
+			{
+				// Where a chunk ending at this idle period would have stopped
+				checkpoints_ptr->emplace_back();
+				checkpoints_ptr->back().lStartSample = startSample;
+				checkpoints_ptr->back().lClockingErrorCount = merger.GetClockingErrorCount();
+				decoder.GetState(&checkpoints_ptr->back().sState);
+
+				stopSample = UINT64_MAX;
+				checkpointPacketCount = merger.GetPacketCount() + interval;
+			}
+
+			byteStatus = captureAcquisition->GetByte(&mosiData, &misoData, &firstSample);
+
+			if (byteStatus != GetByteStatus::Skip)
+			{
+				decoder.ProcessBytePair(GetAcquisitionStatus(byteStatus), mosiData, misoData, firstSample);
+			}
+
+			if ((stopSample == UINT64_MAX) && (merger.GetPacketCount() >= checkpointPacketCount))
+			{
+				U64 sample = std::max(captureAcquisition->GetClockSampleNumber(), captureAcquisition->GetCurrentSample());
+
+				if (!FindChunkBoundary(sample, &startSample, &stopSample))
+				{
+					// No idle period left to take a checkpoint at
+					checkpointPacketCount = UINT64_MAX;
+				}
+			}
+		}
+	}
+	catch (CaptureEndOfData&)
+	{
+	}
+}
+
+U64 AbccSpiChunkedDecoder::DecodeRange(AbccSpiDecoderSink* sink, const std::vector<DecoderCheckpoint_t>& checkpoints, U64 first_sample, U64 last_sample)
+{
+	const DecoderCheckpoint_t* checkpoint = nullptr;
+	AcquisitionConfig_t config = mAcquisitionConfig;
+
+	for (const DecoderCheckpoint_t& candidate : checkpoints)
+	{
+		if (candidate.lStartSample <= first_sample)
+		{
+			checkpoint = &candidate;
+		}
+	}
+
+	U64 startSample = (checkpoint != nullptr) ? checkpoint->lStartSample : 0;
+
+	// Applied by the merger, continuing the count of the checkpoint
+	config.lClockingAlertLimit = -1;
+
+	// Decoded into a recording, of which only the range is replayed
+	AbccSpiDecoderRecorder recorder;
+	ChunkMerger merger(&recorder, mAcquisitionConfig.lClockingAlertLimit);
+	ChunkAcquisition acquisition(mChannels, startSample, mEndSample, &merger, config);
+	AbccSpiDecoder decoder(acquisition.Get(), &merger);
+	RangePacketHandler handler(&recorder, first_sample, last_sample);
+	std::vector<U32> messageIds;
+	DecoderRecordingView_t recording;
+
+	decoder.Setup(mDecoderConfig);
+
+	if (checkpoint != nullptr)
+	{
+		AbccSpiDecoder::DecoderState_t state = checkpoint->sState;
+
+		// The messages in progress were opened in another sink
+		state.sMosiVars.dwMsgId = ABCC_MSG_ID_NONE;
+		state.sMisoVars.dwMsgId = ABCC_MSG_ID_NONE;
+
+		decoder.SetState(state);
+		merger.SetClockingErrorCount(checkpoint->lClockingErrorCount);
+	}
+	else
+	{
+		decoder.Reset();
+	}
+
+	RunChunk(UINT64_MAX, &decoder, &merger, &acquisition, &handler);
+
+	recorder.GetView(&recording);
+	ReplayDecoderRecording(recording, handler.GetFirstCall(), sink, &messageIds);
+
+	return startSample;
+}
+
+void AbccSpiChunkedDecoder::FindChunks(U32 chunk_count)
+{
+	mChunks.clear();
+	mChunks.emplace_back(new CaptureChunk_t());
+	mChunks.back()->lStartSample = 0;
+	mChunks.back()->lStopSample = UINT64_MAX;
+
+	for (U32 i = 1; i < chunk_count; i++)
+	{
+		U64 startSample;
+		U64 stopSample;
+
+		if (!FindChunkBoundary(mEndSample / chunk_count * i, &startSample, &stopSample))
+		{
+			break;
+		}
+
+		if (startSample <= mChunks.back()->lStartSample)
+		{
+			// The previous chunk already extends beyond this one's share
+			continue;
+		}
+
+		mChunks.back()->lStopSample = stopSample;
+		mChunks.emplace_back(new CaptureChunk_t());
+		mChunks.back()->lStartSample = startSample;
+		mChunks.back()->lStopSample = UINT64_MAX;
+	}
+}
+
+static BitState GetStateAfterTransition(const CaptureChannel_t* channel, size_t transition)
+{
+	if ((transition & 1) == 0)
+	{
+		return (channel->eInitialState == BIT_HIGH) ? BIT_LOW : BIT_HIGH;
+	}
+
+	return channel->eInitialState;
+}
+
+/*
+** Finds the first period at or after sample in which the bus is idle between
+** two packets: the enable line being inactive in 4-wire mode, or an idle gap
+** on the clock in 3-wire mode. The next chunk starts at the edge that begins
+** the period, and the previous one stops at the edge that ends it.
+*/
+bool AbccSpiChunkedDecoder::FindChunkBoundary(U64 sample, U64* start_sample_ptr, U64* stop_sample_ptr)
+{
+	const CaptureChannel_t* channel;
+	U64 idleGapSamples;
+
+	if ((mChannels.psEnable != nullptr) && !mAcquisitionConfig.f3WireOn4Channels)
+	{
+		channel = mChannels.psEnable;
+		idleGapSamples = 0;
+	}
+	else if (!mAcquisitionConfig.f4WireOn3Channels)
+	{
+		channel = mChannels.psClock;
+		idleGapSamples = CaptureAcquisition::IdleTimeToSampleCount(mAcquisitionConfig.dwIdleGapNs, mAcquisitionConfig.dwSampleRate);
+	}
+	else
+	{
+		// Without an enable line packets can't be told apart from the clock
+		return false;
+	}
+
+	const std::vector<U64>& transitions = channel->alTransitions;
+	size_t i = std::lower_bound(transitions.begin(), transitions.end(), sample) - transitions.begin();
+
+	for (; i + 1 < transitions.size(); i++)
+	{
+		// The enable line is active low, the clock idles high in 3-wire mode
+		if ((GetStateAfterTransition(channel, i) == BIT_HIGH) &&
+			(transitions[i + 1] - transitions[i] >= idleGapSamples))
+		{
+			*start_sample_ptr = transitions[i];
+			*stop_sample_ptr = transitions[i + 1];
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void AbccSpiChunkedDecoder::DecodeWorker()
+{
+	for (;;)
+	{
+		size_t index = mNextChunk++;
+
+		if (index >= mChunks.size())
+		{
+			break;
+		}
+
+		try
+		{
+			DecodeChunk(mChunks[index].get());
+		}
+		catch (std::exception& e)
+		{
+			mChunks[index]->errorText = e.what();
+		}
+	}
+}
+
+/*
+** Decodes a chunk on its own, from a reset decoder
+*/
+void AbccSpiChunkedDecoder::DecodeChunk(CaptureChunk_t* chunk)
+{
+	AcquisitionConfig_t config = mAcquisitionConfig;
+
+	// Applied by the merger
+	config.lClockingAlertLimit = -1;
+
+	ChunkAcquisition acquisition(mChannels, chunk->lStartSample, mEndSample, &chunk->oRecorder, config);
+	AbccSpiDecoder decoder(acquisition.Get(), &chunk->oRecorder);
+	CheckpointRecorder checkpoints(&chunk->oRecorder, &chunk->asCheckpoints);
+
+	decoder.Setup(mDecoderConfig);
+	decoder.Reset();
+
+	// The first chunk needs no stitching
+	RunChunk(chunk->lStopSample, &decoder, &chunk->oRecorder, &acquisition, (chunk->lStartSample > 0) ? &checkpoints : nullptr);
+
+	decoder.GetState(&chunk->sEndState);
+}
+
+/*
+** Decodes the start of a chunk again, continuing from the decoder state at
+** the end of the previous chunk, until it is in the same state as the
+** chunk's own decoder was after the same packet. The rest is replayed from
+** the chunk's recording. Leaves the state at the end of the chunk in
+** state_ptr.
+*/
+void AbccSpiChunkedDecoder::StitchChunk(CaptureChunk_t* chunk, ChunkMerger* merger, AbccSpiDecoder::DecoderState_t* state_ptr)
+{
+	AcquisitionConfig_t config = mAcquisitionConfig;
+
+	// Applied by the merger
+	config.lClockingAlertLimit = -1;
+
+	ChunkAcquisition acquisition(mChannels, chunk->lStartSample, mEndSample, merger, config);
+	AbccSpiDecoder decoder(acquisition.Get(), merger);
+	CheckpointMatcher matcher(&chunk->asCheckpoints);
+
+	decoder.Setup(mDecoderConfig);
+	decoder.SetState(*state_ptr);
+
+	if (RunChunk(chunk->lStopSample, &decoder, merger, &acquisition, &matcher))
+	{
+		// Never caught up, the chunk has been decoded in full
+		decoder.GetState(state_ptr);
+		return;
+	}
+
+	const ChunkCheckpoint_t& checkpoint = chunk->asCheckpoints[matcher.GetMatch()];
+	std::vector<U32> messageIds(chunk->oRecorder.GetMessageCount(), ABCC_MSG_ID_NONE);
+	DecoderRecordingView_t recording;
+
+	// The messages in progress continue in the recording under its own ids
+	if (checkpoint.sState.sMosiVars.dwMsgId < messageIds.size())
+	{
+		messageIds[checkpoint.sState.sMosiVars.dwMsgId] = matcher.GetState().sMosiVars.dwMsgId;
+	}
+
+	if (checkpoint.sState.sMisoVars.dwMsgId < messageIds.size())
+	{
+		messageIds[checkpoint.sState.sMisoVars.dwMsgId] = matcher.GetState().sMisoVars.dwMsgId;
+	}
+
+	chunk->oRecorder.GetView(&recording);
+	ReplayDecoderRecording(recording, checkpoint.nCallCount, merger, &messageIds);
+
+	*state_ptr = chunk->sEndState;
+	state_ptr->sMosiVars.dwMsgId = MapRecordedMessageId(messageIds, state_ptr->sMosiVars.dwMsgId);
+	state_ptr->sMisoVars.dwMsgId = MapRecordedMessageId(messageIds, state_ptr->sMisoVars.dwMsgId);
+}
+
+/*
+** Decodes from the start of a chunk up to stop_sample. The last packet may
+** extend beyond it. Returns false if handler stopped the decoding.
+*/
+bool AbccSpiChunkedDecoder::RunChunk(U64 stop_sample, AbccSpiDecoder* decoder, AbccSpiCountingSink* sink, ChunkAcquisition* acquisition, ChunkPacketHandler* handler)
+{
+	CaptureAcquisition* captureAcquisition = acquisition->Get();
+
+	// Same loop as SpiAnalyzer::WorkerThread, the capture ends with an exception
+	try
+	{
+		U64 mosiData;
+		U64 misoData;
+		U64 firstSample;
+		GetByteStatus byteStatus;
+
+		captureAcquisition->AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+
+		while (captureAcquisition->GetSampleOfNextClockEdge() < stop_sample)
+		{
+			U64 packetCount = sink->GetPacketCount();
+
+			byteStatus = captureAcquisition->GetByte(&mosiData, &misoData, &firstSample);
+
+			if (byteStatus != GetByteStatus::Skip)
+			{
+				decoder->ProcessBytePair(GetAcquisitionStatus(byteStatus), mosiData, misoData, firstSample);
+			}
+
+			if ((handler != nullptr) && (sink->GetPacketCount() != packetCount) &&
+				!handler->PacketEnded(*decoder, captureAcquisition))
+			{
+				return false;
+			}
+		}
+	}
+	catch (CaptureEndOfData&)
+	{
+	}
+
+	return true;
+}
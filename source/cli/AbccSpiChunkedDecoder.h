@@ -0,0 +1,111 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiChunkedDecoder.h
+**    Summary: Decodes a capture in chunks on several threads. The capture is
+**             split where the bus is idle between two packets, the chunks
+**             are decoded in parallel, and a sequential stitch pass passes
+**             their output on in capture order. The decoder state at such
+**             splits can be kept as checkpoints, from which a range of the
+**             capture is decoded later without decoding what comes before.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_SPI_CHUNKED_DECODER_H
+#define ABCC_SPI_CHUNKED_DECODER_H
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "../AbccSpiAcquisition.h"
+#include "../AbccSpiDecoder.h"
+#include "AbccSpiCapture.h"
+#include "AbccSpiDecoderRecording.h"
+
+struct CaptureChunk;
+class ChunkMerger;
+class ChunkAcquisition;
+class ChunkPacketHandler;
+
+/*
+** The decoder state at the start of an idle period of the bus, where the
+** acquisition can restart. The message ids in the state refer to the sink
+** of the decode that took the checkpoint.
+*/
+typedef struct DecoderCheckpoint
+{
+	U64 lStartSample;			// Edge that begins the idle period
+	S32 lClockingErrorCount;	// Reported before the checkpoint, counts towards the alert limit
+	AbccSpiDecoder::DecoderState_t sState;
+} DecoderCheckpoint_t;
+
+/*
+** Each chunk is decoded from a reset decoder, which is only right for the
+** first one. The decoder state carried across packets (fragmentation,
+** last Anybus and application status, toggle bit, network time, ...) is
+** therefore restored by the stitch pass: it decodes the start of each chunk
+** again, continuing from the state at the end of the previous chunk, until
+** its state matches that of the chunk's own decoding after the same packet.
+** The rest of the chunk's output is then used as is. The result is the same
+** as decoding the capture in one pass.
+*/
+class AbccSpiChunkedDecoder
+{
+public:
+
+	AbccSpiChunkedDecoder(const CaptureChannels_t& channels, U64 end_sample);
+	~AbccSpiChunkedDecoder();
+
+	void Setup(const AcquisitionConfig_t& acquisition_config, const DecoderConfig_t& decoder_config);
+
+	/*
+	** Decodes the capture into sink using up to thread_count threads. Returns
+	** the number of chunks, fewer than thread_count if the capture has too
+	** few idle periods to split at. If checkpoints_ptr is given, it receives
+	** a checkpoint at the start of every chunk but the first.
+	*/
+	U32 Decode(AbccSpiDecoderSink* sink, U32 thread_count, std::vector<DecoderCheckpoint_t>* checkpoints_ptr = nullptr);
+
+	/*
+	** Decodes the capture into sink in one pass, taking a checkpoint at the
+	** first idle period after every interval packets.
+	*/
+	void DecodeWithCheckpoints(AbccSpiDecoderSink* sink, U32 interval, std::vector<DecoderCheckpoint_t>* checkpoints_ptr);
+
+	/*
+	** Decodes the packets that end after first_sample, up to and including
+	** the first one that ends at or after last_sample, into sink. Decoding
+	** resumes from the last checkpoint before first_sample, or starts at the
+	** start of the capture if there is none. Messages that were opened
+	** before the range are not added to the sink, their data frames refer to
+	** ABCC_MSG_ID_NONE. Returns the sample decoding resumed at.
+	*/
+	U64 DecodeRange(AbccSpiDecoderSink* sink, const std::vector<DecoderCheckpoint_t>& checkpoints, U64 first_sample, U64 last_sample);
+
+protected:
+
+	CaptureChannels_t mChannels;
+	U64 mEndSample;
+	AcquisitionConfig_t mAcquisitionConfig;
+	DecoderConfig_t mDecoderConfig;
+
+	std::vector<std::unique_ptr<CaptureChunk>> mChunks;
+	std::atomic<size_t> mNextChunk;
+
+protected:
+
+	void FindChunks(U32 chunk_count);
+	bool FindChunkBoundary(U64 sample, U64* start_sample_ptr, U64* stop_sample_ptr);
+
+	void DecodeWorker();
+	void DecodeChunk(CaptureChunk* chunk);
+	void StitchChunk(CaptureChunk* chunk, ChunkMerger* merger, AbccSpiDecoder::DecoderState_t* state_ptr);
+
+	bool RunChunk(U64 stop_sample, AbccSpiDecoder* decoder, AbccSpiCountingSink* sink, ChunkAcquisition* acquisition, ChunkPacketHandler* handler);
+};
+
+#endif /* ABCC_SPI_CHUNKED_DECODER_H */
@@ -0,0 +1,836 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiDecodeCli.cpp
+**    Summary: abcc-spi-decode, a command-line batch decoder. Runs the ABCC
+**             SPI acquisition and protocol decoder on digital captures
+**             exported from Logic and writes the same Frames, Process Data
+**             and Message Data exports as the plugin.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <atomic>
+#include <climits>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../AbccSpiAcquisition.h"
+#include "../AbccSpiDecoder.h"
+#include "../AbccSpiAnalyzerResults.h"
+#include "../AbccSpiAnalyzerSettings.h"
+#include "AbccSpiCapture.h"
+#include "AbccSpiChunkedDecoder.h"
+#include "AbccSpiResultsCache.h"
+
+#define CLI_NAME "abcc-spi-decode"
+
+/* Packets between the decoder checkpoints stored with cached results */
+#define CHECKPOINT_INTERVAL		1024
+
+typedef struct CliOptions
+{
+	U32 dwSampleRate;
+	S32 lMosiIndex;
+	S32 lMisoIndex;
+	S32 lClockIndex;
+	S32 lEnableIndex;
+	U32 dwNetworkType;
+	U32 dwJobs;
+	U32 dwChunks;
+	DisplayBase eDisplayBase;
+	bool fRange;
+	U64 lRangeFirstSample;
+	U64 lRangeLastSample;
+	bool afExport[static_cast<U32>(ExportType::SizeOfEnum)];
+	std::string advSettingsPath;
+	std::string outputDir;
+	std::string cacheDir;
+	std::vector<std::string> inputFiles;
+} CliOptions_t;
+
+static const char* const acExportSuffix[] =
+{
+	".frames.csv",			/* ExportType::Frames */
+	".process_data.csv",	/* ExportType::ProcessData */
+	".message_data.csv",	/* ExportType::MessageData */
+	".packets.csv",			/* ExportType::Packets */
+	".transactions.csv",	/* ExportType::Transactions */
+	".response_latency.csv"	/* ExportType::ResponseLatency */
+};
+
+static_assert(sizeof(acExportSuffix) / sizeof(acExportSuffix[0]) == static_cast<U32>(ExportType::SizeOfEnum),
+	"acExportSuffix must have one entry per ExportType");
+
+/*
+** SpiAnalyzerResults with the timebase taken from the capture file, or from
+** its cached results, instead of a running analyzer.
+*/
+class OfflineAnalyzerResults : public SpiAnalyzerResults
+{
+public:
+
+	OfflineAnalyzerResults(SpiAnalyzerSettings* settings, U32 sample_rate)
+		: SpiAnalyzerResults(nullptr, settings),
+		mSampleRate(sample_rate),
+		mTriggerSample(0)
+	{
+	}
+
+	void SetTriggerSample(U64 trigger_sample)
+	{
+		mTriggerSample = trigger_sample;
+	}
+
+protected:
+
+	virtual U32 GetSampleRate()
+	{
+		return mSampleRate;
+	}
+
+	virtual U64 GetTriggerSample()
+	{
+		return mTriggerSample;
+	}
+
+	U32 mSampleRate;
+	U64 mTriggerSample;
+};
+
+/*
+** Stores the decoder output in the results. Markers only matter for the
+** waveform display and are dropped.
+*/
+class OfflineDecoderSink : public AbccSpiDecoderSink
+{
+public:
+
+	OfflineDecoderSink(SpiAnalyzerResults* results)
+		: mResults(results)
+	{
+	}
+
+	virtual void AddFrame(const DecoderFrame_t& frame)
+	{
+		Frame resultFrame;
+
+		resultFrame.mStartingSampleInclusive = frame.mStartingSampleInclusive;
+		resultFrame.mEndingSampleInclusive = frame.mEndingSampleInclusive;
+		resultFrame.mData1 = frame.mData1;
+		resultFrame.mData2 = frame.mData2;
+		resultFrame.mType = frame.mType;
+		resultFrame.mFlags = frame.mFlags;
+
+		mResults->AddFrame(resultFrame);
+	}
+
+	virtual void AddMarker(U64 /*sample*/, DecoderMarker /*marker*/, DecoderChannel /*channel*/)
+	{
+	}
+
+	virtual U64 StorePayload(const U8* data, U32 length)
+	{
+		return mResults->StorePayload(data, length);
+	}
+
+	virtual U32 OpenMessage(SpiChannel_t channel, bool retransmission)
+	{
+		return mResults->GetMessageTable().OpenMessage(channel, retransmission);
+	}
+
+	virtual void SetMessageHeader(U32 message_id, const MsgHeaderInfo_t& header)
+	{
+		mResults->GetMessageTable().SetHeader(message_id, header);
+	}
+
+	virtual void AddMessageFragment(U32 message_id, const MessageFragmentInfo_t& fragment)
+	{
+		mResults->GetMessageTable().AddFragment(message_id, fragment);
+
+		if (fragment.fLastFragment)
+		{
+			mResults->GetTransactionTable().AddMessage(mResults->GetMessageTable(), message_id);
+		}
+	}
+
+	virtual bool CommitPacketAndStartNewPacket(const PacketSummary_t& summary)
+	{
+		U64 packetIndex = mResults->CommitPacketAndStartNewPacket();
+
+		mResults->GetPacketSummaries().Add(packetIndex, summary);
+
+		return (packetIndex != INVALID_RESULT_INDEX);
+	}
+
+	virtual void CancelPacketAndStartNewPacket()
+	{
+		mResults->CancelPacketAndStartNewPacket();
+	}
+
+	virtual void CommitResults()
+	{
+	}
+
+protected:
+
+	SpiAnalyzerResults* mResults;
+};
+
+static std::mutex sConsoleMutex;
+
+static void PrintUsage()
+{
+	printf(
+		"Usage: " CLI_NAME " [options] <capture.csv>...\n"
+		"\n"
+		"Decodes ABCC SPI traffic in digital captures exported from Logic as CSV\n"
+		"(\"Time [s],<channel>,<channel>,...\") and writes the plugin's exports.\n"
+		"\n"
+		"Options:\n"
+		"  --sample-rate <hz>     Sample rate the capture was taken at (required)\n"
+		"  --mosi <index>         Column of MOSI, counted from 0 after the time column (default 0)\n"
+		"  --miso <index>         Column of MISO (default 1)\n"
+		"  --clock <index>        Column of SCLK (default 2)\n"
+		"  --enable <index>       Column of NSS, or -1 for 3-wire captures (default 3)\n"
+		"  --network-type <n>     Network type index as listed in the plugin settings (default 0)\n"
+		"  --settings <file>      AdvancedSettings.xml to apply\n"
+		"  --export <list>        Comma separated: frames,process,message,packets,\n"
+		"                         transactions,latency (default all)\n"
+		"  --base <base>          hex, dec, bin or ascii (default hex)\n"
+		"  --output-dir <dir>     Directory for the exports (default: next to each capture)\n"
+		"  --cache-dir <dir>      Directory for cached results, a capture that was decoded\n"
+		"                         before with the same settings is not decoded again\n"
+		"  --jobs <n>             Number of captures to decode in parallel, 0 for one per\n"
+		"                         hardware thread (default 1)\n"
+		"  --chunks <n>           Number of threads decoding each capture, 0 for one per\n"
+		"                         hardware thread (default 1)\n"
+		"  --range <first>:<last> Only decode the packets from the one ending after sample\n"
+		"                         <first> up to the one ending at or after <last>. With\n"
+		"                         --cache-dir, decoding resumes from the closest decoder\n"
+		"                         checkpoint stored with the cached results\n"
+		"  --help                 Show this text\n");
+}
+
+static bool ParseInteger(const char* str, long long min_value, long long max_value, long long* value_ptr)
+{
+	char* endPtr;
+	long long value = strtoll(str, &endPtr, 10);
+
+	if ((*str == '\0') || (*endPtr != '\0') || (value < min_value) || (value > max_value))
+	{
+		return false;
+	}
+
+	*value_ptr = value;
+	return true;
+}
+
+static bool ParseRange(const char* str, CliOptions_t* options_ptr)
+{
+	std::string range(str);
+	size_t separator = range.find(':');
+	long long first;
+	long long last;
+
+	if ((separator == std::string::npos) ||
+		!ParseInteger(range.substr(0, separator).c_str(), 0, LLONG_MAX, &first) ||
+		!ParseInteger(range.substr(separator + 1).c_str(), first, LLONG_MAX, &last))
+	{
+		return false;
+	}
+
+	options_ptr->fRange = true;
+	options_ptr->lRangeFirstSample = (U64)first;
+	options_ptr->lRangeLastSample = (U64)last;
+
+	return true;
+}
+
+static bool ParseExportList(const char* str, CliOptions_t* options_ptr)
+{
+	std::string list(str);
+	size_t start = 0;
+
+	for (U32 i = 0; i < static_cast<U32>(ExportType::SizeOfEnum); i++)
+	{
+		options_ptr->afExport[i] = false;
+	}
+
+	while (start <= list.size())
+	{
+		size_t end = list.find(',', start);
+		std::string item = list.substr(start, (end == std::string::npos) ? std::string::npos : end - start);
+
+		if (item == "frames")
+		{
+			options_ptr->afExport[static_cast<U32>(ExportType::Frames)] = true;
+		}
+		else if (item == "process")
+		{
+			options_ptr->afExport[static_cast<U32>(ExportType::ProcessData)] = true;
+		}
+		else if (item == "message")
+		{
+			options_ptr->afExport[static_cast<U32>(ExportType::MessageData)] = true;
+		}
+		else if (item == "packets")
+		{
+			options_ptr->afExport[static_cast<U32>(ExportType::Packets)] = true;
+		}
+		else if (item == "transactions")
+		{
+			options_ptr->afExport[static_cast<U32>(ExportType::Transactions)] = true;
+		}
+		else if (item == "latency")
+		{
+			options_ptr->afExport[static_cast<U32>(ExportType::ResponseLatency)] = true;
+		}
+		else
+		{
+			return false;
+		}
+
+		if (end == std::string::npos)
+		{
+			break;
+		}
+
+		start = end + 1;
+	}
+
+	return true;
+}
+
+static bool ParseArguments(int argc, char* argv[], CliOptions_t* options_ptr)
+{
+	long long value = 0;
+
+	for (int i = 1; i < argc; i++)
+	{
+		const char* arg = argv[i];
+		const char* param = (i + 1 < argc) ? argv[i + 1] : nullptr;
+
+		if ((strcmp(arg, "--help") == 0) || (strcmp(arg, "-h") == 0))
+		{
+			PrintUsage();
+			exit(EXIT_SUCCESS);
+		}
+		else if (strncmp(arg, "--", 2) != 0)
+		{
+			options_ptr->inputFiles.push_back(arg);
+			continue;
+		}
+		else if (param == nullptr)
+		{
+			fprintf(stderr, CLI_NAME ": option %s requires a value\n", arg);
+			return false;
+		}
+
+		bool valid = true;
+
+		if (strcmp(arg, "--sample-rate") == 0)
+		{
+			valid = ParseInteger(param, 1, 0xFFFFFFFF, &value);
+			options_ptr->dwSampleRate = (U32)value;
+		}
+		else if (strcmp(arg, "--mosi") == 0)
+		{
+			valid = ParseInteger(param, 0, 0x7FFFFFFF, &value);
+			options_ptr->lMosiIndex = (S32)value;
+		}
+		else if (strcmp(arg, "--miso") == 0)
+		{
+			valid = ParseInteger(param, 0, 0x7FFFFFFF, &value);
+			options_ptr->lMisoIndex = (S32)value;
+		}
+		else if (strcmp(arg, "--clock") == 0)
+		{
+			valid = ParseInteger(param, 0, 0x7FFFFFFF, &value);
+			options_ptr->lClockIndex = (S32)value;
+		}
+		else if (strcmp(arg, "--enable") == 0)
+		{
+			valid = ParseInteger(param, -1, 0x7FFFFFFF, &value);
+			options_ptr->lEnableIndex = (S32)value;
+		}
+		else if (strcmp(arg, "--network-type") == 0)
+		{
+			valid = ParseInteger(param, 0, NetworkTypeIndex::CIET, &value);
+			options_ptr->dwNetworkType = (U32)value;
+		}
+		else if (strcmp(arg, "--jobs") == 0)
+		{
+			valid = ParseInteger(param, 0, 1024, &value);
+			options_ptr->dwJobs = (U32)value;
+		}
+		else if (strcmp(arg, "--chunks") == 0)
+		{
+			valid = ParseInteger(param, 0, 1024, &value);
+			options_ptr->dwChunks = (U32)value;
+		}
+		else if (strcmp(arg, "--range") == 0)
+		{
+			valid = ParseRange(param, options_ptr);
+		}
+		else if (strcmp(arg, "--settings") == 0)
+		{
+			options_ptr->advSettingsPath = param;
+		}
+		else if (strcmp(arg, "--output-dir") == 0)
+		{
+			options_ptr->outputDir = param;
+		}
+		else if (strcmp(arg, "--cache-dir") == 0)
+		{
+			options_ptr->cacheDir = param;
+		}
+		else if (strcmp(arg, "--export") == 0)
+		{
+			valid = ParseExportList(param, options_ptr);
+		}
+		else if (strcmp(arg, "--base") == 0)
+		{
+			if (strcmp(param, "hex") == 0)
+			{
+				options_ptr->eDisplayBase = DisplayBase::Hexadecimal;
+			}
+			else if (strcmp(param, "dec") == 0)
+			{
+				options_ptr->eDisplayBase = DisplayBase::Decimal;
+			}
+			else if (strcmp(param, "bin") == 0)
+			{
+				options_ptr->eDisplayBase = DisplayBase::Binary;
+			}
+			else if (strcmp(param, "ascii") == 0)
+			{
+				options_ptr->eDisplayBase = DisplayBase::ASCII;
+			}
+			else
+			{
+				valid = false;
+			}
+		}
+		else
+		{
+			fprintf(stderr, CLI_NAME ": unknown option %s\n", arg);
+			return false;
+		}
+
+		if (!valid)
+		{
+			fprintf(stderr, CLI_NAME ": invalid value '%s' for %s\n", param, arg);
+			return false;
+		}
+
+		i++;
+	}
+
+	if (options_ptr->dwSampleRate == 0)
+	{
+		fprintf(stderr, CLI_NAME ": --sample-rate is required\n");
+		return false;
+	}
+
+	if (options_ptr->inputFiles.empty())
+	{
+		fprintf(stderr, CLI_NAME ": no capture files given\n");
+		return false;
+	}
+
+	return true;
+}
+
+static std::string GetExportPath(const CliOptions_t& options, const std::string& input_file, ExportType export_type)
+{
+	std::string stem(input_file);
+	size_t separator = stem.find_last_of("/\\");
+	size_t extension = stem.find_last_of('.');
+
+	if ((extension != std::string::npos) && ((separator == std::string::npos) || (extension > separator)))
+	{
+		stem.erase(extension);
+	}
+
+	if (!options.outputDir.empty())
+	{
+		if (separator != std::string::npos)
+		{
+			stem.erase(0, separator + 1);
+		}
+
+		stem = options.outputDir + "/" + stem;
+	}
+
+	return stem + acExportSuffix[static_cast<U32>(export_type)];
+}
+
+static void DecodeCaptureInOnePass(const AbccSpiCapture& capture, const CaptureChannels_t& channels, AbccSpiDecoderSink* sink,
+	const AcquisitionConfig_t& config, const DecoderConfig_t& decoder_config)
+{
+	AbccSpiAcquisition<CaptureChannelData> acquisition(sink);
+	AbccSpiDecoder decoder(&acquisition, sink);
+
+	CaptureChannelData mosi(channels.psMosi, capture.GetEndSample());
+	CaptureChannelData miso(channels.psMiso, capture.GetEndSample());
+	CaptureChannelData clock(channels.psClock, capture.GetEndSample());
+	std::unique_ptr<CaptureChannelData> enable;
+
+	if (channels.psEnable != nullptr)
+	{
+		enable.reset(new CaptureChannelData(channels.psEnable, capture.GetEndSample()));
+	}
+
+	acquisition.Setup(&mosi, &miso, &clock, enable.get(), config);
+
+	decoder.Setup(decoder_config);
+	decoder.Reset();
+
+	// Same loop as SpiAnalyzer::WorkerThread, the capture ends with an exception
+	try
+	{
+		U64 mosiData;
+		U64 misoData;
+		U64 firstSample;
+		GetByteStatus byteStatus;
+
+		acquisition.AdvanceToActiveEnableEdgeWithCorrectClockPolarity();
+
+		for (;;)
+		{
+			byteStatus = acquisition.GetByte(&mosiData, &misoData, &firstSample);
+
+			if (byteStatus != GetByteStatus::Skip)
+			{
+				decoder.ProcessBytePair(GetAcquisitionStatus(byteStatus), mosiData, misoData, firstSample);
+			}
+		}
+	}
+	catch (CaptureEndOfData&)
+	{
+	}
+}
+
+/*
+** Decodes the whole capture. If checkpoints_ptr is given, it receives the
+** decoder checkpoints taken along the way.
+*/
+static void DecodeChannels(const CliOptions_t& options, const AbccSpiCapture& capture, const CaptureChannels_t& channels,
+	AbccSpiDecoderSink* sink, const AcquisitionConfig_t& config, const DecoderConfig_t& decoder_config,
+	std::vector<DecoderCheckpoint_t>* checkpoints_ptr)
+{
+	if (options.dwChunks > 1)
+	{
+		AbccSpiChunkedDecoder chunkedDecoder(channels, capture.GetEndSample());
+
+		chunkedDecoder.Setup(config, decoder_config);
+		chunkedDecoder.Decode(sink, options.dwChunks, checkpoints_ptr);
+	}
+	else if (checkpoints_ptr != nullptr)
+	{
+		AbccSpiChunkedDecoder checkpointDecoder(channels, capture.GetEndSample());
+
+		checkpointDecoder.Setup(config, decoder_config);
+		checkpointDecoder.DecodeWithCheckpoints(sink, CHECKPOINT_INTERVAL, checkpoints_ptr);
+	}
+	else
+	{
+		DecodeCaptureInOnePass(capture, channels, sink, config, decoder_config);
+	}
+}
+
+/*
+** Decodes the range given with --range, resuming from the checkpoints of
+** the cached results. If there are none yet, the capture is decoded in full
+** and cached first. Returns the sample decoding resumed at.
+*/
+static U64 DecodeChannelRange(const CliOptions_t& options, const AbccSpiCapture& capture, const CaptureChannels_t& channels,
+	AbccSpiDecoderSink* sink, const AcquisitionConfig_t& config, const DecoderConfig_t& decoder_config,
+	const AbccSpiResultsCache* cache, U64 fingerprint)
+{
+	AbccSpiChunkedDecoder rangeDecoder(channels, capture.GetEndSample());
+	std::vector<DecoderCheckpoint_t> checkpoints;
+	CachedCaptureInfo_t captureInfo;
+
+	if ((cache != nullptr) && !cache->Load(fingerprint, nullptr, &captureInfo, &checkpoints))
+	{
+		AbccSpiDecoderRecorder recorder;
+
+		captureInfo.lTriggerSample = capture.GetTriggerSample();
+		captureInfo.dwNumChannels = capture.GetNumChannels();
+
+		DecodeChannels(options, capture, channels, &recorder, config, decoder_config, &checkpoints);
+		cache->Store(fingerprint, captureInfo, recorder, checkpoints);
+	}
+
+	rangeDecoder.Setup(config, decoder_config);
+
+	return rangeDecoder.DecodeRange(sink, checkpoints, options.lRangeFirstSample, options.lRangeLastSample);
+}
+
+static bool AreChannelIndicesValid(const CliOptions_t& options, U32 num_channels, std::string& error_text)
+{
+	S32 numChannels = (S32)num_channels;
+
+	if ((options.lMosiIndex >= numChannels) || (options.lMisoIndex >= numChannels) ||
+		(options.lClockIndex >= numChannels) || (options.lEnableIndex >= numChannels))
+	{
+		error_text = "Capture has " + std::to_string(numChannels) + " channels, a channel index is out of range.";
+		return false;
+	}
+
+	return true;
+}
+
+static bool LoadCapture(const CliOptions_t& options, const std::string& input_file, AbccSpiCapture* capture_ptr,
+	CaptureChannels_t* channels_ptr, std::string& error_text)
+{
+	if (!capture_ptr->LoadCsv(input_file, options.dwSampleRate, error_text) ||
+		!AreChannelIndicesValid(options, capture_ptr->GetNumChannels(), error_text))
+	{
+		return false;
+	}
+
+	channels_ptr->psMosi = capture_ptr->GetChannel(options.lMosiIndex);
+	channels_ptr->psMiso = capture_ptr->GetChannel(options.lMisoIndex);
+	channels_ptr->psClock = capture_ptr->GetChannel(options.lClockIndex);
+	channels_ptr->psEnable = (options.lEnableIndex >= 0) ? capture_ptr->GetChannel(options.lEnableIndex) : nullptr;
+
+	return true;
+}
+
+static bool DecodeCapture(const CliOptions_t& options, const std::string& input_file, std::string& summary, std::string& error_text)
+{
+	AbccSpiCapture capture;
+	CaptureChannels_t channels;
+	SpiAnalyzerSettings settings;
+
+	settings.mMosiChannel = Channel(0, options.lMosiIndex);
+	settings.mMisoChannel = Channel(0, options.lMisoIndex);
+	settings.mClockChannel = Channel(0, options.lClockIndex);
+	settings.mEnableChannel = (options.lEnableIndex >= 0) ? Channel(0, options.lEnableIndex) : UNDEFINED_CHANNEL;
+	settings.mNetworkType = options.dwNetworkType;
+	settings.mAdvSettingsPath = options.advSettingsPath.c_str();
+	settings.UpdateInterfacesFromSettings();
+
+	if (!settings.SetSettingsFromInterfaces())
+	{
+		error_text = settings.GetSaveErrorMessage();
+		return false;
+	}
+
+	OfflineAnalyzerResults results(&settings, options.dwSampleRate);
+	OfflineDecoderSink sink(&results);
+	AcquisitionConfig_t config;
+	DecoderConfig_t decoderConfig;
+
+	config.dwSampleRate = options.dwSampleRate;
+	config.lClockingAlertLimit = settings.mClockingAlertLimit;
+	config.f3WireOn4Channels = settings.m3WireOn4Channels;
+	config.f4WireOn3Channels = settings.m4WireOn3Channels;
+	config.fExpandBitFrames = settings.mExpandBitFrames;
+	config.fTransactionAcquisition = true;
+	config.dwIdleGapNs = settings.m3WireIdleGapNs;
+	config.dwClockIdleNs = settings.m3WireClockIdleNs;
+	config.eMarkerDensity = MarkerDensity::None;	// Markers are not exported
+	config.fGenericAcquisition = false;
+
+	decoderConfig.fCoalesceProcessData = settings.mCoalesceProcessData;
+	decoderConfig.fErrorMarkersOnly = true;
+
+	AbccSpiResultsCache cache(options.cacheDir);
+	U64 fingerprint = 0;
+	CachedCaptureInfo_t captureInfo;
+	U64 resumeSample = 0;
+	bool cached = !options.cacheDir.empty() &&
+		GetCaptureFingerprint(input_file, options.dwSampleRate, settings.GetDecodeSettingsKey(), &fingerprint);
+	bool fromCache = cached && !options.fRange && cache.Load(fingerprint, &sink, &captureInfo);
+
+	if (fromCache)
+	{
+		// The capture file is not parsed at all, the indices are checked
+		// against the channel count it had when it was decoded
+		if (!AreChannelIndicesValid(options, captureInfo.dwNumChannels, error_text))
+		{
+			return false;
+		}
+
+		results.SetTriggerSample(captureInfo.lTriggerSample);
+	}
+	else
+	{
+		if (!LoadCapture(options, input_file, &capture, &channels, error_text))
+		{
+			return false;
+		}
+
+		results.SetTriggerSample(capture.GetTriggerSample());
+
+		if (options.fRange)
+		{
+			resumeSample = DecodeChannelRange(options, capture, channels, &sink, config, decoderConfig,
+				cached ? &cache : nullptr, fingerprint);
+		}
+		else if (cached)
+		{
+			// Decoded into a recording, which is both stored and replayed into the results
+			AbccSpiDecoderRecorder recorder;
+			DecoderRecordingView_t recording;
+			std::vector<U32> messageIds;
+			std::vector<DecoderCheckpoint_t> checkpoints;
+
+			captureInfo.lTriggerSample = capture.GetTriggerSample();
+			captureInfo.dwNumChannels = capture.GetNumChannels();
+
+			DecodeChannels(options, capture, channels, &recorder, config, decoderConfig, &checkpoints);
+			cache.Store(fingerprint, captureInfo, recorder, checkpoints);
+
+			recorder.GetView(&recording);
+			ReplayDecoderRecording(recording, 0, &sink, &messageIds);
+		}
+		else
+		{
+			DecodeChannels(options, capture, channels, &sink, config, decoderConfig, nullptr);
+		}
+	}
+
+	results.CommitResults();
+
+	for (U32 i = 0; i < static_cast<U32>(ExportType::SizeOfEnum); i++)
+	{
+		if (options.afExport[i])
+		{
+			std::string exportPath = GetExportPath(options, input_file, static_cast<ExportType>(i));
+			results.GenerateExportFile(exportPath.c_str(), options.eDisplayBase, i);
+		}
+	}
+
+	summary = std::to_string(results.GetNumFrames()) + " frames, " +
+		std::to_string(results.GetNumPackets()) + " packets";
+
+	if (fromCache)
+	{
+		summary += " (cached)";
+	}
+	else if (options.fRange)
+	{
+		summary += " (range resumed at sample " + std::to_string(resumeSample) + ")";
+	}
+
+	return true;
+}
+
+static void DecodeWorker(const CliOptions_t* options_ptr, std::atomic<size_t>* next_file_ptr, std::atomic<U32>* failures_ptr)
+{
+	for (;;)
+	{
+		size_t index = (*next_file_ptr)++;
+		std::string summary;
+		std::string errorText;
+		bool success;
+
+		if (index >= options_ptr->inputFiles.size())
+		{
+			break;
+		}
+
+		const std::string& inputFile = options_ptr->inputFiles[index];
+
+		try
+		{
+			success = DecodeCapture(*options_ptr, inputFile, summary, errorText);
+		}
+		catch (std::exception& e)
+		{
+			errorText = e.what();
+			success = false;
+		}
+
+		std::lock_guard<std::mutex> lock(sConsoleMutex);
+
+		if (success)
+		{
+			printf("%s: %s\n", inputFile.c_str(), summary.c_str());
+		}
+		else
+		{
+			fprintf(stderr, "%s: error: %s\n", inputFile.c_str(), errorText.c_str());
+			(*failures_ptr)++;
+		}
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	CliOptions_t options;
+	std::atomic<size_t> nextFile(0);
+	std::atomic<U32> failures(0);
+	std::vector<std::thread> workers;
+
+	options.dwSampleRate = 0;
+	options.lMosiIndex = 0;
+	options.lMisoIndex = 1;
+	options.lClockIndex = 2;
+	options.lEnableIndex = 3;
+	options.dwNetworkType = NetworkTypeIndex::Unspecified;
+	options.dwJobs = 1;
+	options.dwChunks = 1;
+	options.fRange = false;
+	options.lRangeFirstSample = 0;
+	options.lRangeLastSample = 0;
+	options.eDisplayBase = DisplayBase::Hexadecimal;
+
+	for (U32 i = 0; i < static_cast<U32>(ExportType::SizeOfEnum); i++)
+	{
+		options.afExport[i] = true;
+	}
+
+	if (!ParseArguments(argc, argv, &options))
+	{
+		fprintf(stderr, "Try '" CLI_NAME " --help' for more information.\n");
+		return EXIT_FAILURE;
+	}
+
+	if (options.dwJobs == 0)
+	{
+		options.dwJobs = std::thread::hardware_concurrency();
+	}
+
+	if (options.dwChunks == 0)
+	{
+		options.dwChunks = std::thread::hardware_concurrency();
+	}
+
+	if (options.dwJobs > options.inputFiles.size())
+	{
+		options.dwJobs = (U32)options.inputFiles.size();
+	}
+
+	if (options.dwJobs <= 1)
+	{
+		DecodeWorker(&options, &nextFile, &failures);
+	}
+	else
+	{
+		for (U32 i = 0; i < options.dwJobs; i++)
+		{
+			workers.emplace_back(DecodeWorker, &options, &nextFile, &failures);
+		}
+
+		for (std::thread& worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	return (failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,301 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiDecoderRecording.cpp
+**    Summary: Records the calls a decoder makes to its sink so that they can
+**             be replayed into another sink later, in another order or from
+**             a file.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include "AbccSpiDecoderRecording.h"
+
+AbccSpiDecoderRecorder::AbccSpiDecoderRecorder()
+	: mFramesInPacket(0),
+	mMessageCount(0)
+{
+}
+
+AbccSpiDecoderRecorder::~AbccSpiDecoderRecorder()
+{
+}
+
+void AbccSpiDecoderRecorder::AddFrame(const DecoderFrame_t& frame)
+{
+	AddCall(RecordedCallType::Frame, mFrames.size());
+	mFrames.push_back(frame);
+	mFramesInPacket++;
+}
+
+void AbccSpiDecoderRecorder::AddMarker(U64 sample, DecoderMarker marker, DecoderChannel channel)
+{
+	RecordedMarker_t recordedMarker = { sample, marker, channel };
+
+	AddCall(RecordedCallType::Marker, mMarkers.size());
+	mMarkers.push_back(recordedMarker);
+}
+
+U64 AbccSpiDecoderRecorder::StorePayload(const U8* data, U32 length)
+{
+	RecordedPayload_t payload = { mBytes.size(), length };
+
+	AddCall(RecordedCallType::Payload, mPayloads.size());
+	mPayloads.push_back(payload);
+	mBytes.insert(mBytes.end(), data, data + length);
+
+	return mPayloads.size() - 1;
+}
+
+U32 AbccSpiDecoderRecorder::OpenMessage(SpiChannel_t channel, bool retransmission)
+{
+	RecordedMessageCall_t call = {};
+
+	call.dwMessageId = mMessageCount++;
+	call.eChannel = channel;
+	call.fRetransmission = retransmission;
+
+	AddCall(RecordedCallType::OpenMessage, mMessageCalls.size());
+	mMessageCalls.push_back(call);
+
+	return call.dwMessageId;
+}
+
+void AbccSpiDecoderRecorder::SetMessageHeader(U32 message_id, const MsgHeaderInfo_t& header)
+{
+	RecordedMessageCall_t call = {};
+
+	call.dwMessageId = message_id;
+	call.sHeader = header;
+
+	AddCall(RecordedCallType::MessageHeader, mMessageCalls.size());
+	mMessageCalls.push_back(call);
+}
+
+void AbccSpiDecoderRecorder::AddMessageFragment(U32 message_id, const MessageFragmentInfo_t& fragment)
+{
+	RecordedMessageCall_t call = {};
+
+	call.dwMessageId = message_id;
+	call.sFragment = fragment;
+	call.sFragment.pbData = nullptr;
+	call.lOffset = mBytes.size();
+
+	AddCall(RecordedCallType::MessageFragment, mMessageCalls.size());
+	mMessageCalls.push_back(call);
+	mBytes.insert(mBytes.end(), fragment.pbData, fragment.pbData + fragment.dwLength);
+}
+
+bool AbccSpiDecoderRecorder::CommitPacketAndStartNewPacket(const PacketSummary_t& summary)
+{
+	// Like the results, a packet needs at least one frame to be committed
+	bool committed = (mFramesInPacket > 0);
+
+	AddCall(RecordedCallType::CommitPacket, mPacketSummaries.size());
+	mPacketSummaries.push_back(summary);
+	mFramesInPacket = 0;
+	mPacketCount++;
+
+	return committed;
+}
+
+void AbccSpiDecoderRecorder::CancelPacketAndStartNewPacket()
+{
+	AddCall(RecordedCallType::CancelPacket, 0);
+	mFramesInPacket = 0;
+	mPacketCount++;
+}
+
+void AbccSpiDecoderRecorder::CommitResults()
+{
+}
+
+size_t AbccSpiDecoderRecorder::GetCallCount() const
+{
+	return mCalls.size();
+}
+
+U32 AbccSpiDecoderRecorder::GetMessageCount() const
+{
+	return mMessageCount;
+}
+
+void AbccSpiDecoderRecorder::GetView(DecoderRecordingView_t* view_ptr) const
+{
+	view_ptr->psCalls = mCalls.data();
+	view_ptr->nCallCount = mCalls.size();
+	view_ptr->psFrames = mFrames.data();
+	view_ptr->nFrameCount = mFrames.size();
+	view_ptr->psMarkers = mMarkers.data();
+	view_ptr->nMarkerCount = mMarkers.size();
+	view_ptr->psPayloads = mPayloads.data();
+	view_ptr->nPayloadCount = mPayloads.size();
+	view_ptr->psMessageCalls = mMessageCalls.data();
+	view_ptr->nMessageCallCount = mMessageCalls.size();
+	view_ptr->psPacketSummaries = mPacketSummaries.data();
+	view_ptr->nPacketSummaryCount = mPacketSummaries.size();
+	view_ptr->pbBytes = mBytes.data();
+	view_ptr->nByteCount = mBytes.size();
+}
+
+void AbccSpiDecoderRecorder::AddCall(RecordedCallType type, size_t index)
+{
+	RecordedCall_t call = { type, (U32)index };
+	mCalls.push_back(call);
+}
+
+U32 MapRecordedMessageId(const std::vector<U32>& message_ids, U32 message_id)
+{
+	return (message_id < message_ids.size()) ? message_ids[message_id] : ABCC_MSG_ID_NONE;
+}
+
+bool IsMessageDataFrame(const DecoderFrame_t& frame)
+{
+	if (frame.HasFlag(SPI_MOSI_FLAG))
+	{
+		return (frame.mType == (U8)AbccMosiStates::MessageField_Data) ||
+			(frame.mType == (U8)AbccMosiStates::MessageField_DataNotValid);
+	}
+
+	return (frame.mType == (U8)AbccMisoStates::MessageField_Data) ||
+		(frame.mType == (U8)AbccMisoStates::MessageField_DataNotValid);
+}
+
+void ReplayDecoderRecording(const DecoderRecordingView_t& recording, size_t first_call, AbccSpiDecoderSink* sink, std::vector<U32>* message_ids_ptr)
+{
+	std::vector<U64> payloadOffsets(recording.nPayloadCount, 0);
+
+	for (size_t i = first_call; i < recording.nCallCount; i++)
+	{
+		const RecordedCall_t& call = recording.psCalls[i];
+
+		switch (call.eType)
+		{
+		case RecordedCallType::Frame:
+		{
+			DecoderFrame_t frame = recording.psFrames[call.dwIndex];
+
+			if (frame.HasFlag(SPI_PD_BLOCK_FLAG))
+			{
+				frame.mData1 = (frame.mData1 < payloadOffsets.size()) ? payloadOffsets[(size_t)frame.mData1] : 0;
+			}
+			else if (IsMessageDataFrame(frame))
+			{
+				MsgDataFrameData2_t* psFrameData2 = (MsgDataFrameData2_t*)&frame.mData2;
+				psFrameData2->msgId = MapRecordedMessageId(*message_ids_ptr, psFrameData2->msgId);
+			}
+
+			sink->AddFrame(frame);
+			break;
+		}
+		case RecordedCallType::Marker:
+		{
+			const RecordedMarker_t& marker = recording.psMarkers[call.dwIndex];
+			sink->AddMarker(marker.lSample, marker.eMarker, marker.eChannel);
+			break;
+		}
+		case RecordedCallType::Payload:
+		{
+			const RecordedPayload_t& payload = recording.psPayloads[call.dwIndex];
+			payloadOffsets[call.dwIndex] = sink->StorePayload(recording.pbBytes + payload.lOffset, payload.dwLength);
+			break;
+		}
+		case RecordedCallType::OpenMessage:
+		{
+			const RecordedMessageCall_t& messageCall = recording.psMessageCalls[call.dwIndex];
+
+			if (message_ids_ptr->size() <= messageCall.dwMessageId)
+			{
+				message_ids_ptr->resize(messageCall.dwMessageId + 1, ABCC_MSG_ID_NONE);
+			}
+
+			(*message_ids_ptr)[messageCall.dwMessageId] = sink->OpenMessage(messageCall.eChannel, messageCall.fRetransmission);
+			break;
+		}
+		case RecordedCallType::MessageHeader:
+		{
+			const RecordedMessageCall_t& messageCall = recording.psMessageCalls[call.dwIndex];
+			sink->SetMessageHeader(MapRecordedMessageId(*message_ids_ptr, messageCall.dwMessageId), messageCall.sHeader);
+			break;
+		}
+		case RecordedCallType::MessageFragment:
+		{
+			const RecordedMessageCall_t& messageCall = recording.psMessageCalls[call.dwIndex];
+			MessageFragmentInfo_t fragment = messageCall.sFragment;
+
+			fragment.pbData = recording.pbBytes + messageCall.lOffset;
+			sink->AddMessageFragment(MapRecordedMessageId(*message_ids_ptr, messageCall.dwMessageId), fragment);
+			break;
+		}
+		case RecordedCallType::CommitPacket:
+			sink->CommitPacketAndStartNewPacket(recording.psPacketSummaries[call.dwIndex]);
+			break;
+		case RecordedCallType::CancelPacket:
+			sink->CancelPacketAndStartNewPacket();
+			break;
+		}
+	}
+}
+
+static bool IsInRange(U64 offset, U64 length, size_t size)
+{
+	return (offset <= size) && (length <= size - offset);
+}
+
+bool IsValidDecoderRecording(const DecoderRecordingView_t& recording)
+{
+	for (size_t i = 0; i < recording.nCallCount; i++)
+	{
+		const RecordedCall_t& call = recording.psCalls[i];
+
+		switch (call.eType)
+		{
+		case RecordedCallType::Frame:
+			if (call.dwIndex >= recording.nFrameCount)
+			{
+				return false;
+			}
+			break;
+		case RecordedCallType::Marker:
+			if (call.dwIndex >= recording.nMarkerCount)
+			{
+				return false;
+			}
+			break;
+		case RecordedCallType::Payload:
+			if ((call.dwIndex >= recording.nPayloadCount) ||
+				!IsInRange(recording.psPayloads[call.dwIndex].lOffset, recording.psPayloads[call.dwIndex].dwLength, recording.nByteCount))
+			{
+				return false;
+			}
+			break;
+		case RecordedCallType::OpenMessage:
+		case RecordedCallType::MessageHeader:
+			if (call.dwIndex >= recording.nMessageCallCount)
+			{
+				return false;
+			}
+			break;
+		case RecordedCallType::MessageFragment:
+			if ((call.dwIndex >= recording.nMessageCallCount) ||
+				!IsInRange(recording.psMessageCalls[call.dwIndex].lOffset, recording.psMessageCalls[call.dwIndex].sFragment.dwLength, recording.nByteCount))
+			{
+				return false;
+			}
+			break;
+		case RecordedCallType::CommitPacket:
+			if (call.dwIndex >= recording.nPacketSummaryCount)
+			{
+				return false;
+			}
+			break;
+		case RecordedCallType::CancelPacket:
+			break;
+		default:
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,168 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiDecoderRecording.h
+**    Summary: Records the calls a decoder makes to its sink so that they can
+**             be replayed into another sink later, in another order or from
+**             a file.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_SPI_DECODER_RECORDING_H
+#define ABCC_SPI_DECODER_RECORDING_H
+
+#include <cstddef>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "../AbccSpiDecoder.h"
+
+enum class RecordedCallType : U8
+{
+	Frame,
+	Marker,
+	Payload,
+	OpenMessage,
+	MessageHeader,
+	MessageFragment,
+	CommitPacket,		// Indexes the packet summaries
+	CancelPacket
+};
+
+typedef struct RecordedCall
+{
+	RecordedCallType eType;
+	U32 dwIndex;			// Into the recording's list for the type of call
+} RecordedCall_t;
+
+typedef struct RecordedMarker
+{
+	U64 lSample;
+	DecoderMarker eMarker;
+	DecoderChannel eChannel;
+} RecordedMarker_t;
+
+typedef struct RecordedPayload
+{
+	U64 lOffset;			// Into the recording's bytes
+	U32 dwLength;
+} RecordedPayload_t;
+
+typedef struct RecordedMessageCall
+{
+	U32 dwMessageId;
+	SpiChannel_t eChannel;			// OpenMessage
+	bool fRetransmission;			// OpenMessage
+	MsgHeaderInfo_t sHeader;		// MessageHeader
+	MessageFragmentInfo_t sFragment;	// MessageFragment, without the data pointer
+	U64 lOffset;					// Of the fragment's data in the recording's bytes
+} RecordedMessageCall_t;
+
+/*
+** A recording laid out as arrays, either held by a recorder or mapped from
+** a file.
+*/
+typedef struct DecoderRecordingView
+{
+	const RecordedCall_t* psCalls;
+	size_t nCallCount;
+	const DecoderFrame_t* psFrames;
+	size_t nFrameCount;
+	const RecordedMarker_t* psMarkers;
+	size_t nMarkerCount;
+	const RecordedPayload_t* psPayloads;
+	size_t nPayloadCount;
+	const RecordedMessageCall_t* psMessageCalls;
+	size_t nMessageCallCount;
+	const PacketSummary_t* psPacketSummaries;
+	size_t nPacketSummaryCount;
+	const U8* pbBytes;
+	size_t nByteCount;
+} DecoderRecordingView_t;
+
+/*
+** A sink that counts the packets it has been given, so that a decode loop
+** can tell when a byte pair ended a packet.
+*/
+class AbccSpiCountingSink : public AbccSpiDecoderSink
+{
+public:
+
+	AbccSpiCountingSink()
+		: mPacketCount(0)
+	{
+	}
+
+	U64 GetPacketCount() const
+	{
+		return mPacketCount;
+	}
+
+protected:
+
+	U64 mPacketCount;		// Committed or cancelled
+};
+
+/*
+** The message ids and payload offsets the recorder hands out are indices
+** into the recording. They are replaced with those of the sink the
+** recording is replayed into.
+*/
+class AbccSpiDecoderRecorder : public AbccSpiCountingSink
+{
+public:
+
+	AbccSpiDecoderRecorder();
+	virtual ~AbccSpiDecoderRecorder();
+
+	virtual void AddFrame(const DecoderFrame_t& frame);
+	virtual void AddMarker(U64 sample, DecoderMarker marker, DecoderChannel channel);
+	virtual U64 StorePayload(const U8* data, U32 length);
+	virtual U32 OpenMessage(SpiChannel_t channel, bool retransmission);
+	virtual void SetMessageHeader(U32 message_id, const MsgHeaderInfo_t& header);
+	virtual void AddMessageFragment(U32 message_id, const MessageFragmentInfo_t& fragment);
+	virtual bool CommitPacketAndStartNewPacket(const PacketSummary_t& summary);
+	virtual void CancelPacketAndStartNewPacket();
+	virtual void CommitResults();
+
+	size_t GetCallCount() const;
+	U32 GetMessageCount() const;
+
+	/* Valid until the next call is recorded */
+	void GetView(DecoderRecordingView_t* view_ptr) const;
+
+protected:
+
+	std::vector<RecordedCall_t> mCalls;
+	std::vector<DecoderFrame_t> mFrames;
+	std::vector<RecordedMarker_t> mMarkers;
+	std::vector<RecordedPayload_t> mPayloads;
+	std::vector<RecordedMessageCall_t> mMessageCalls;
+	std::vector<PacketSummary_t> mPacketSummaries;
+	std::vector<U8> mBytes;
+	U64 mFramesInPacket;
+	U32 mMessageCount;
+
+protected:
+
+	void AddCall(RecordedCallType type, size_t index);
+};
+
+/*
+** Replays a recording from first_call on. message_ids maps the recorded
+** message ids to the sink's, it is extended by the messages opened.
+*/
+void ReplayDecoderRecording(const DecoderRecordingView_t& recording, size_t first_call, AbccSpiDecoderSink* sink, std::vector<U32>* message_ids_ptr);
+
+/* Returns the sink's id for a recorded message id, or ABCC_MSG_ID_NONE */
+U32 MapRecordedMessageId(const std::vector<U32>& message_ids, U32 message_id);
+
+/* True for the message data frames, whose data refers to a message id */
+bool IsMessageDataFrame(const DecoderFrame_t& frame);
+
+/* Checks that every index and offset of a recording read from a file is in range */
+bool IsValidDecoderRecording(const DecoderRecordingView_t& recording);
+
+#endif /* ABCC_SPI_DECODER_RECORDING_H */
@@ -0,0 +1,440 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiResultsCache.cpp
+**    Summary: On-disk cache of decoded results. A capture decoded once is
+**             stored as a recording of the decoder's output, keyed by a
+**             fingerprint of the capture file and the decode settings, and
+**             is replayed from a memory mapping when it is decoded again.
+**             The decoder checkpoints taken while decoding are stored with
+**             it, so that a range of the capture can be decoded on its own.
+**
+*******************************************************************************
+******************************************************************************/
+
+#include <cstdio>
+#include <cstring>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "AbccSpiResultsCache.h"
+
+#define RESULTS_CACHE_MAGIC					0x43525341	/* "ASRC" */
+#define RESULTS_CACHE_VERSION				5
+#define RESULTS_CACHE_EXTENSION				".abccspi"
+
+#define FNV_OFFSET_BASIS					0xCBF29CE484222325ull
+#define FNV_PRIME							0x00000100000001B3ull
+
+typedef enum ResultsCacheSection
+{
+	CallSection,
+	FrameSection,
+	MarkerSection,
+	PayloadSection,
+	MessageCallSection,
+	PacketSummarySection,
+	ByteSection,
+	CheckpointSection,
+	CheckpointByteSection,
+	NumberOfSections
+} ResultsCacheSection_t;
+
+/*
+** A decoder checkpoint without its packet byte buffers, which follow those
+** of the previous checkpoints in the checkpoint bytes.
+*/
+typedef struct CachedCheckpoint
+{
+	U64 lStartSample;
+	S32 lClockingErrorCount;
+	U32 dwMosiPacketBytes;
+	U32 dwMisoPacketBytes;
+	bool fMosiReady;
+	bool fMisoReady;
+	AbccSpiDecoder::MosiVars_t sMosiVars;
+	AbccSpiDecoder::MisoVars_t sMisoVars;
+	AbccSpiDecoder::MosiVars_t sPreviousMosiVars;
+	AbccSpiDecoder::MisoVars_t sPreviousMisoVars;
+	AbccSpiDecoder::ProcessDataBlock_t sMosiPdBlock;
+	AbccSpiDecoder::ProcessDataBlock_t sMisoPdBlock;
+	AbccSpiDecoder::PacketMessageFields_t sMosiMsgFields;
+	AbccSpiDecoder::PacketMessageFields_t sMisoMsgFields;
+	PacketSummary_t sPacketSummary;
+} CachedCheckpoint_t;
+
+/*
+** The file starts with this header, followed by each section's records.
+** Every section starts at a multiple of 8 bytes so that the records can be
+** used in place. The record sizes guard against a layout change that was
+** not followed by a version change.
+*/
+typedef struct ResultsCacheHeader
+{
+	U32 dwMagic;
+	U32 dwVersion;
+	U64 lFingerprint;
+	U32 adwRecordSize[NumberOfSections];
+	U32 dwNumChannels;				// Of the capture, to check the channel indices against
+	U64 alCount[NumberOfSections];
+	U64 lTriggerSample;				// Of the capture, needed by the exports
+} ResultsCacheHeader_t;
+
+static const U32 adwRecordSize[NumberOfSections] =
+{
+	sizeof(RecordedCall_t),
+	sizeof(DecoderFrame_t),
+	sizeof(RecordedMarker_t),
+	sizeof(RecordedPayload_t),
+	sizeof(RecordedMessageCall_t),
+	sizeof(PacketSummary_t),
+	sizeof(U8),
+	sizeof(CachedCheckpoint_t),
+	sizeof(U8)
+};
+
+static U64 HashBytes(U64 hash, const void* data, size_t length)
+{
+	const U8* bytes = (const U8*)data;
+
+	for (size_t i = 0; i < length; i++)
+	{
+		hash ^= bytes[i];
+		hash *= FNV_PRIME;
+	}
+
+	return hash;
+}
+
+bool GetCaptureFingerprint(const std::string& file_path, U32 sample_rate, const std::string& decode_settings_key, U64* fingerprint_ptr)
+{
+	U64 hash = FNV_OFFSET_BASIS;
+	U32 version = RESULTS_CACHE_VERSION;
+	struct stat fileStat;
+	int fd = open(file_path.c_str(), O_RDONLY);
+
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	if (fstat(fd, &fileStat) != 0)
+	{
+		close(fd);
+		return false;
+	}
+
+	U64 fileSize = (U64)fileStat.st_size;
+	S64 modificationTime = (S64)fileStat.st_mtime;
+
+	hash = HashBytes(hash, &version, sizeof(version));
+	hash = HashBytes(hash, &sample_rate, sizeof(sample_rate));
+	hash = HashBytes(hash, &fileSize, sizeof(fileSize));
+	hash = HashBytes(hash, &modificationTime, sizeof(modificationTime));
+
+	if (fileSize > 0)
+	{
+		void* mapping = mmap(nullptr, (size_t)fileSize, PROT_READ, MAP_PRIVATE, fd, 0);
+
+		if (mapping == MAP_FAILED)
+		{
+			close(fd);
+			return false;
+		}
+
+		hash = HashBytes(hash, mapping, (size_t)fileSize);
+		munmap(mapping, (size_t)fileSize);
+	}
+
+	close(fd);
+
+	hash = HashBytes(hash, decode_settings_key.data(), decode_settings_key.size());
+	*fingerprint_ptr = hash;
+
+	return true;
+}
+
+static U64 AlignSection(U64 size)
+{
+	return (size + 7) & ~7ull;
+}
+
+AbccSpiResultsCache::AbccSpiResultsCache(const std::string& directory)
+	: mDirectory(directory)
+{
+}
+
+AbccSpiResultsCache::~AbccSpiResultsCache()
+{
+}
+
+std::string AbccSpiResultsCache::GetPath(U64 fingerprint) const
+{
+	char fileName[32];
+	std::string path(mDirectory);
+
+	snprintf(fileName, sizeof(fileName), "%016llx" RESULTS_CACHE_EXTENSION, (unsigned long long)fingerprint);
+
+	if (!path.empty() && (path.back() != '/'))
+	{
+		path += '/';
+	}
+
+	return path + fileName;
+}
+
+bool AbccSpiResultsCache::Load(U64 fingerprint, AbccSpiDecoderSink* sink, CachedCaptureInfo_t* info_ptr,
+	std::vector<DecoderCheckpoint_t>* checkpoints_ptr) const
+{
+	std::string path = GetPath(fingerprint);
+	struct stat fileStat;
+	int fd = open(path.c_str(), O_RDONLY);
+
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	if ((fstat(fd, &fileStat) != 0) || ((size_t)fileStat.st_size < sizeof(ResultsCacheHeader_t)))
+	{
+		close(fd);
+		return false;
+	}
+
+	size_t size = (size_t)fileStat.st_size;
+	void* mapping = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+
+	// The mapping stays valid after the file is closed
+	close(fd);
+
+	if (mapping == MAP_FAILED)
+	{
+		return false;
+	}
+
+	bool loaded = ReplayMapping((const U8*)mapping, size, fingerprint, sink, info_ptr, checkpoints_ptr);
+
+	munmap(mapping, size);
+
+	return loaded;
+}
+
+static bool ReadCheckpoints(const CachedCheckpoint_t* checkpoints, size_t count, const U8* bytes, size_t byte_count,
+	std::vector<DecoderCheckpoint_t>* checkpoints_ptr)
+{
+	size_t offset = 0;
+
+	checkpoints_ptr->resize(count);
+
+	for (size_t i = 0; i < count; i++)
+	{
+		const CachedCheckpoint_t& cached = checkpoints[i];
+		DecoderCheckpoint_t& checkpoint = (*checkpoints_ptr)[i];
+
+		if ((cached.dwMosiPacketBytes > byte_count - offset) ||
+			(cached.dwMisoPacketBytes > byte_count - offset - cached.dwMosiPacketBytes))
+		{
+			checkpoints_ptr->clear();
+			return false;
+		}
+
+		checkpoint.lStartSample = cached.lStartSample;
+		checkpoint.lClockingErrorCount = cached.lClockingErrorCount;
+		checkpoint.sState.sMosiVars = cached.sMosiVars;
+		checkpoint.sState.sMisoVars = cached.sMisoVars;
+		checkpoint.sState.sPreviousMosiVars = cached.sPreviousMosiVars;
+		checkpoint.sState.sPreviousMisoVars = cached.sPreviousMisoVars;
+		checkpoint.sState.fMosiReady = cached.fMosiReady;
+		checkpoint.sState.fMisoReady = cached.fMisoReady;
+		checkpoint.sState.abMosiPacketBytes.assign(bytes + offset, bytes + offset + cached.dwMosiPacketBytes);
+		offset += cached.dwMosiPacketBytes;
+		checkpoint.sState.abMisoPacketBytes.assign(bytes + offset, bytes + offset + cached.dwMisoPacketBytes);
+		offset += cached.dwMisoPacketBytes;
+		checkpoint.sState.sMosiPdBlock = cached.sMosiPdBlock;
+		checkpoint.sState.sMisoPdBlock = cached.sMisoPdBlock;
+		checkpoint.sState.sMosiMsgFields = cached.sMosiMsgFields;
+		checkpoint.sState.sMisoMsgFields = cached.sMisoMsgFields;
+		checkpoint.sState.sPacketSummary = cached.sPacketSummary;
+	}
+
+	return true;
+}
+
+bool AbccSpiResultsCache::ReplayMapping(const U8* mapping, size_t size, U64 fingerprint, AbccSpiDecoderSink* sink, CachedCaptureInfo_t* info_ptr,
+	std::vector<DecoderCheckpoint_t>* checkpoints_ptr) const
+{
+	const ResultsCacheHeader_t* psHeader = (const ResultsCacheHeader_t*)mapping;
+	const U8* apbSection[NumberOfSections];
+	U64 offset = AlignSection(sizeof(ResultsCacheHeader_t));
+
+	if ((psHeader->dwMagic != RESULTS_CACHE_MAGIC) ||
+		(psHeader->dwVersion != RESULTS_CACHE_VERSION) ||
+		(psHeader->lFingerprint != fingerprint))
+	{
+		return false;
+	}
+
+	for (U32 i = 0; i < NumberOfSections; i++)
+	{
+		if ((psHeader->adwRecordSize[i] != adwRecordSize[i]) ||
+			(offset > size) ||
+			(psHeader->alCount[i] > (size - offset) / adwRecordSize[i]))
+		{
+			return false;
+		}
+
+		apbSection[i] = mapping + offset;
+		offset += AlignSection(psHeader->alCount[i] * adwRecordSize[i]);
+	}
+
+	if (offset != size)
+	{
+		return false;
+	}
+
+	DecoderRecordingView_t recording;
+	std::vector<U32> messageIds;
+
+	recording.psCalls = (const RecordedCall_t*)apbSection[CallSection];
+	recording.nCallCount = (size_t)psHeader->alCount[CallSection];
+	recording.psFrames = (const DecoderFrame_t*)apbSection[FrameSection];
+	recording.nFrameCount = (size_t)psHeader->alCount[FrameSection];
+	recording.psMarkers = (const RecordedMarker_t*)apbSection[MarkerSection];
+	recording.nMarkerCount = (size_t)psHeader->alCount[MarkerSection];
+	recording.psPayloads = (const RecordedPayload_t*)apbSection[PayloadSection];
+	recording.nPayloadCount = (size_t)psHeader->alCount[PayloadSection];
+	recording.psMessageCalls = (const RecordedMessageCall_t*)apbSection[MessageCallSection];
+	recording.nMessageCallCount = (size_t)psHeader->alCount[MessageCallSection];
+	recording.psPacketSummaries = (const PacketSummary_t*)apbSection[PacketSummarySection];
+	recording.nPacketSummaryCount = (size_t)psHeader->alCount[PacketSummarySection];
+	recording.pbBytes = apbSection[ByteSection];
+	recording.nByteCount = (size_t)psHeader->alCount[ByteSection];
+
+	// Checked in full before the sink sees any of it
+	if (!IsValidDecoderRecording(recording))
+	{
+		return false;
+	}
+
+	if ((checkpoints_ptr != nullptr) &&
+		!ReadCheckpoints((const CachedCheckpoint_t*)apbSection[CheckpointSection], (size_t)psHeader->alCount[CheckpointSection],
+			apbSection[CheckpointByteSection], (size_t)psHeader->alCount[CheckpointByteSection], checkpoints_ptr))
+	{
+		return false;
+	}
+
+	if (sink != nullptr)
+	{
+		ReplayDecoderRecording(recording, 0, sink, &messageIds);
+	}
+
+	info_ptr->lTriggerSample = psHeader->lTriggerSample;
+	info_ptr->dwNumChannels = psHeader->dwNumChannels;
+
+	return true;
+}
+
+static bool WriteSection(FILE* file, const void* data, U64 count, U32 record_size)
+{
+	static const U8 abPadding[8] = { 0 };
+	U64 length = count * record_size;
+	U64 padding = AlignSection(length) - length;
+
+	return ((length == 0) || (fwrite(data, 1, (size_t)length, file) == length)) &&
+		((padding == 0) || (fwrite(abPadding, 1, (size_t)padding, file) == padding));
+}
+
+bool AbccSpiResultsCache::Store(U64 fingerprint, const CachedCaptureInfo_t& info, const AbccSpiDecoderRecorder& recorder,
+	const std::vector<DecoderCheckpoint_t>& checkpoints) const
+{
+	std::string path = GetPath(fingerprint);
+	std::string tempPath = path + ".tmp";
+	DecoderRecordingView_t recording;
+	ResultsCacheHeader_t header;
+	std::vector<CachedCheckpoint_t> cachedCheckpoints(checkpoints.size());
+	std::vector<U8> checkpointBytes;
+	FILE* file;
+	bool written;
+
+	recorder.GetView(&recording);
+
+	for (size_t i = 0; i < checkpoints.size(); i++)
+	{
+		const AbccSpiDecoder::DecoderState_t& state = checkpoints[i].sState;
+		CachedCheckpoint_t& cached = cachedCheckpoints[i];
+
+		// The padding between the fields is written to the file as well
+		memset(&cached, 0, sizeof(cached));
+		cached.lStartSample = checkpoints[i].lStartSample;
+		cached.lClockingErrorCount = checkpoints[i].lClockingErrorCount;
+		cached.dwMosiPacketBytes = (U32)state.abMosiPacketBytes.size();
+		cached.dwMisoPacketBytes = (U32)state.abMisoPacketBytes.size();
+		cached.fMosiReady = state.fMosiReady;
+		cached.fMisoReady = state.fMisoReady;
+		cached.sMosiVars = state.sMosiVars;
+		cached.sMisoVars = state.sMisoVars;
+		cached.sPreviousMosiVars = state.sPreviousMosiVars;
+		cached.sPreviousMisoVars = state.sPreviousMisoVars;
+		cached.sMosiPdBlock = state.sMosiPdBlock;
+		cached.sMisoPdBlock = state.sMisoPdBlock;
+		cached.sMosiMsgFields = state.sMosiMsgFields;
+		cached.sMisoMsgFields = state.sMisoMsgFields;
+		cached.sPacketSummary = state.sPacketSummary;
+
+		checkpointBytes.insert(checkpointBytes.end(), state.abMosiPacketBytes.begin(), state.abMosiPacketBytes.end());
+		checkpointBytes.insert(checkpointBytes.end(), state.abMisoPacketBytes.begin(), state.abMisoPacketBytes.end());
+	}
+
+	memset(&header, 0, sizeof(header));
+	header.dwMagic = RESULTS_CACHE_MAGIC;
+	header.dwVersion = RESULTS_CACHE_VERSION;
+	header.lFingerprint = fingerprint;
+	memcpy(header.adwRecordSize, adwRecordSize, sizeof(header.adwRecordSize));
+	header.alCount[CallSection] = recording.nCallCount;
+	header.alCount[FrameSection] = recording.nFrameCount;
+	header.alCount[MarkerSection] = recording.nMarkerCount;
+	header.alCount[PayloadSection] = recording.nPayloadCount;
+	header.alCount[MessageCallSection] = recording.nMessageCallCount;
+	header.alCount[PacketSummarySection] = recording.nPacketSummaryCount;
+	header.alCount[ByteSection] = recording.nByteCount;
+	header.alCount[CheckpointSection] = cachedCheckpoints.size();
+	header.alCount[CheckpointByteSection] = checkpointBytes.size();
+	header.lTriggerSample = info.lTriggerSample;
+	header.dwNumChannels = info.dwNumChannels;
+
+	// The directory is created if needed, but not its parents
+	mkdir(mDirectory.c_str(), 0755);
+
+	file = fopen(tempPath.c_str(), "wb");
+
+	if (file == nullptr)
+	{
+		return false;
+	}
+
+	written = WriteSection(file, &header, 1, sizeof(header)) &&
+		WriteSection(file, recording.psCalls, recording.nCallCount, adwRecordSize[CallSection]) &&
+		WriteSection(file, recording.psFrames, recording.nFrameCount, adwRecordSize[FrameSection]) &&
+		WriteSection(file, recording.psMarkers, recording.nMarkerCount, adwRecordSize[MarkerSection]) &&
+		WriteSection(file, recording.psPayloads, recording.nPayloadCount, adwRecordSize[PayloadSection]) &&
+		WriteSection(file, recording.psMessageCalls, recording.nMessageCallCount, adwRecordSize[MessageCallSection]) &&
+		WriteSection(file, recording.psPacketSummaries, recording.nPacketSummaryCount, adwRecordSize[PacketSummarySection]) &&
+		WriteSection(file, recording.pbBytes, recording.nByteCount, adwRecordSize[ByteSection]) &&
+		WriteSection(file, cachedCheckpoints.data(), cachedCheckpoints.size(), adwRecordSize[CheckpointSection]) &&
+		WriteSection(file, checkpointBytes.data(), checkpointBytes.size(), adwRecordSize[CheckpointByteSection]);
+
+	written = (fclose(file) == 0) && written;
+
+	// Readers never see a partly written file
+	if (!written || (rename(tempPath.c_str(), path.c_str()) != 0))
+	{
+		remove(tempPath.c_str());
+		return false;
+	}
+
+	return true;
+}
@@ -0,0 +1,81 @@
+/******************************************************************************
+**  Copyright (C) 2015-2022 HMS Industrial Networks Inc, all rights reserved
+*******************************************************************************
+**
+**       File: AbccSpiResultsCache.h
+**    Summary: On-disk cache of decoded results. A capture decoded once is
+**             stored as a recording of the decoder's output, keyed by a
+**             fingerprint of the capture file and the decode settings, and
+**             is replayed from a memory mapping when it is decoded again.
+**
+*******************************************************************************
+******************************************************************************/
+
+#ifndef ABCC_SPI_RESULTS_CACHE_H
+#define ABCC_SPI_RESULTS_CACHE_H
+
+#include <string>
+#include <vector>
+
+#include "LogicPublicTypes.h"
+#include "../AbccSpiDecoder.h"
+#include "AbccSpiDecoderRecording.h"
+#include "AbccSpiChunkedDecoder.h"
+
+/*
+** Hash of the capture file's size, modification time and raw bytes, the
+** sample rate and the settings that affect the decoded frames (see
+** SpiAnalyzerSettings::GetDecodeSettingsKey(), which holds the channel
+** assignment). The file is not parsed, so a hit does not pay for loading
+** the capture. Display settings are not part of it, a cached capture is
+** rendered with the current ones. Returns false if the file can't be read.
+*/
+bool GetCaptureFingerprint(const std::string& file_path, U32 sample_rate, const std::string& decode_settings_key, U64* fingerprint_ptr);
+
+/*
+** What is known of the capture that cached results were decoded from, so
+** that a cache hit is exported and checked without loading the capture.
+*/
+typedef struct CachedCaptureInfo
+{
+	U64 lTriggerSample;
+	U32 dwNumChannels;
+} CachedCaptureInfo_t;
+
+/*
+** The cache is a directory with one file per fingerprint. A file that is
+** missing, was written by another version or does not pass the checks is
+** treated as a miss and is overwritten by the next store.
+*/
+class AbccSpiResultsCache
+{
+public:
+
+	AbccSpiResultsCache(const std::string& directory);
+	~AbccSpiResultsCache();
+
+	std::string GetPath(U64 fingerprint) const;
+
+	/*
+	** Replays the cached results into sink and returns what is known of the
+	** capture they were decoded from, returns false on a miss. Without a
+	** sink only the decoder checkpoints stored along with the results are
+	** read, into checkpoints_ptr if given.
+	*/
+	bool Load(U64 fingerprint, AbccSpiDecoderSink* sink, CachedCaptureInfo_t* info_ptr,
+		std::vector<DecoderCheckpoint_t>* checkpoints_ptr = nullptr) const;
+
+	bool Store(U64 fingerprint, const CachedCaptureInfo_t& info, const AbccSpiDecoderRecorder& recorder,
+		const std::vector<DecoderCheckpoint_t>& checkpoints) const;
+
+protected:
+
+	bool ReplayMapping(const U8* mapping, size_t size, U64 fingerprint, AbccSpiDecoderSink* sink, CachedCaptureInfo_t* info_ptr,
+		std::vector<DecoderCheckpoint_t>* checkpoints_ptr) const;
+
+protected:
+
+	std::string mDirectory;
+};
+
+#endif /* ABCC_SPI_RESULTS_CACHE_H */